@@ -1,25 +1,111 @@
 #include "ApplicationFactory.hpp"
 #include "Application.hpp"
 #include "SibMolester.hpp"
+#include "EchoSender.hpp"
+#include "ConnectionReaper.hpp"
 #include "UeConnection/UeConnectionFactory.hpp"
 #include "UeConnection/UeConnectionSpawner.hpp"
 #include "UeRelay/UeRelay.hpp"
 #include "ConsoleCommands.hpp"
+#include "MetricsFileWriter.hpp"
+#include "RelayMetrics.hpp"
+#include "TrafficTop.hpp"
+#include "Time/SteadyClock.hpp"
+#include "Memory/MemoryAccounting.hpp"
+#include <optional>
 
 namespace bts
 {
 
 std::unique_ptr<IComponent> createApplication(IApplicationEnvironment& environment)
+{
+    return createApplication(environment, std::make_shared<common::SteadyClock>(),
+                             std::make_shared<common::SteadyClock>());
+}
+
+std::unique_ptr<IComponent> createApplication(IApplicationEnvironment& environment, common::ClockPtr clock)
+{
+    return createApplication(environment, clock, clock);
+}
+
+std::unique_ptr<IComponent> createApplication(IApplicationEnvironment& environment, common::ClockPtr clock,
+                                              common::ClockPtr fileClock)
 {
     auto syncGuard = std::make_shared<SyncGuard>();
     auto& logger = environment.getLogger();
 
     auto ueRelay = std::make_shared<UeRelay>(environment.getLogger());
-    auto ueConnectionFactory = std::make_shared<UeConnectionFactory>(environment.getLogger(), syncGuard);
+    auto metricsRegistry = std::make_shared<common::MetricsRegistry>();
+    auto relayMetrics = std::make_shared<RelayMetrics>(*metricsRegistry);
+    auto countUe = [syncGuard, weakUeRelay = std::weak_ptr<UeRelay>(ueRelay)](bool attached) -> std::int64_t
+    {
+        SyncLock lock(*syncGuard);
+        auto ueRelay = weakUeRelay.lock();
+        return not ueRelay ? 0 : attached ? ueRelay->countAttached() : ueRelay->countNotAttached();
+    };
+    metricsRegistry->gauge("bts_ue_connections", "Connected UEs", [countUe] { return countUe(true); },
+                           {{"state", "attached"}});
+    metricsRegistry->gauge("bts_ue_connections", "Connected UEs", [countUe] { return countUe(false); },
+                           {{"state", "not_attached"}});
+    common::MemoryAccounting::registerMetrics(*metricsRegistry, "bts");
+    auto trafficTop = std::make_shared<TrafficTop>();
+    auto connectionReaper = std::make_shared<ConnectionReaper>(syncGuard, clock, relayMetrics, environment.getLogger());
+    environment.getConfiguration().subscribe([weakConnectionReaper = std::weak_ptr<ConnectionReaper>(connectionReaper)]
+                                             (const common::MultiLineConfig& configuration)
+    {
+        if (auto connectionReaper = weakConnectionReaper.lock())
+        {
+            auto attachTimeout = configuration.getNumber<long>("attach_timeout_ms", ConnectionReaper::DEFAULT_ATTACH_TIMEOUT.count());
+            auto inactivityTimeout = configuration.getNumber<long>("inactivity_timeout_ms", ConnectionReaper::DEFAULT_INACTIVITY_TIMEOUT.count());
+            connectionReaper->reconfigure(std::chrono::milliseconds(attachTimeout), std::chrono::milliseconds(inactivityTimeout));
+        }
+    });
+    auto ueConnectionFactory = std::make_shared<UeConnectionFactory>(environment.getLogger(), syncGuard, relayMetrics, trafficTop, connectionReaper);
     auto ueConnectionSpawner = std::make_shared<UeConnectionSpawner>(environment, ueConnectionFactory, ueRelay, syncGuard);
-    auto sibMolester = std::make_shared<SibMolester>(ueRelay, syncGuard, environment.getBtsId(), environment.getLogger());
-    auto consoleCommands = std::make_shared<ConsoleCommands>(environment.getConsole(), environment, environment.getLogger(), ueRelay, syncGuard);
-    std::initializer_list<std::shared_ptr<IComponent>> components = {ueConnectionSpawner, sibMolester, consoleCommands};
+    auto sibMolester = std::make_shared<SibMolester>(ueRelay, syncGuard, clock, environment.getBtsId(), environment.getLogger());
+    environment.getConfiguration().subscribe([weakSibMolester = std::weak_ptr<SibMolester>(sibMolester)]
+                                             (const common::MultiLineConfig& configuration)
+    {
+        if (auto sibMolester = weakSibMolester.lock())
+        {
+            auto tickDuration = configuration.getNumber<long>("sib_tick_ms", SibMolester::DEFAULT_TICK_DURATION.count());
+            auto ticksToSendSib = configuration.getNumber<std::size_t>("sib_ticks", SibMolester::DEFAULT_TICKS_TO_SEND_SIB);
+            sibMolester->reconfigure(std::chrono::milliseconds(tickDuration), ticksToSendSib);
+        }
+    });
+    auto echoSender = std::make_shared<EchoSender>(ueRelay, syncGuard, clock, environment.getLogger());
+    environment.getConfiguration().subscribe([weakEchoSender = std::weak_ptr<EchoSender>(echoSender)]
+                                             (const common::MultiLineConfig& configuration)
+    {
+        if (auto echoSender = weakEchoSender.lock())
+        {
+            auto period = configuration.getNumber<long>("echo_period_ms", EchoSender::DEFAULT_PERIOD.count());
+            echoSender->reconfigure(std::chrono::milliseconds(period));
+        }
+    });
+    // applied only when the value changes - reload of other keys shall not undo console "lock on|off"
+    environment.getConfiguration().subscribe([applied = std::optional<bool>{}](const common::MultiLineConfig& configuration) mutable
+    {
+        const bool enabled = configuration.getNumber<int>("lock_profiler", 0) != 0;
+        if (applied != enabled)
+        {
+            applied = enabled;
+            LockProfiler::instance().setEnabled(enabled);
+        }
+    });
+    auto metricsFileWriter = std::make_shared<MetricsFileWriter>(metricsRegistry, fileClock, environment.getLogger());
+    environment.getConfiguration().subscribe([weakMetricsFileWriter = std::weak_ptr<MetricsFileWriter>(metricsFileWriter)]
+                                             (const common::MultiLineConfig& configuration)
+    {
+        if (auto metricsFileWriter = weakMetricsFileWriter.lock())
+        {
+            auto path = configuration.getString("metrics_file", "");
+            auto period = configuration.getNumber<long>("metrics_period_ms", MetricsFileWriter::DEFAULT_PERIOD.count());
+            metricsFileWriter->reconfigure(path, std::chrono::milliseconds(period));
+        }
+    });
+    auto consoleCommands = std::make_shared<ConsoleCommands>(environment.getConsole(), environment, environment.getLogger(), ueRelay, syncGuard, metricsRegistry, trafficTop, relayMetrics);
+    std::initializer_list<std::shared_ptr<IComponent>> components = {ueConnectionSpawner, sibMolester, echoSender, connectionReaper, metricsFileWriter, consoleCommands};
     return std::make_unique<Application>(environment.getLogger(), components);
 }
 
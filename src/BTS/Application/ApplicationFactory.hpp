@@ -2,11 +2,21 @@
 
 #include "IComponent.hpp"
 #include "IApplicationEnvironment.hpp"
+#include "Time/IClock.hpp"
 #include <memory>
 
 namespace bts
 {
 
 std::unique_ptr<IComponent> createApplication(IApplicationEnvironment& environment);
+/**
+ * Timers of the application (SIB ticks) run on given clock - e.g. virtual one in simulation
+ */
+std::unique_ptr<IComponent> createApplication(IApplicationEnvironment& environment, common::ClockPtr clock);
+/**
+ * File writes (metrics file) run on fileClock - a slow disk shall not hold SIB and reaper ticks back
+ */
+std::unique_ptr<IComponent> createApplication(IApplicationEnvironment& environment, common::ClockPtr clock,
+                                              common::ClockPtr fileClock);
 
 }
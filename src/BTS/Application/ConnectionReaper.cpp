@@ -0,0 +1,191 @@
+#include "ConnectionReaper.hpp"
+
+namespace bts
+{
+
+namespace
+{
+
+// disabled check keeps its connection on the wheel with default period - re-enabling covers existing connections
+std::chrono::milliseconds delayOf(std::chrono::milliseconds timeout, std::chrono::milliseconds defaultTimeout)
+{
+    return timeout > std::chrono::milliseconds::zero() ? timeout : defaultTimeout;
+}
+
+}
+
+ConnectionReaper::ConnectionReaper(SyncGuardPtr syncGuard,
+                                   common::ClockPtr clock,
+                                   RelayMetricsPtr metrics,
+                                   common::ILogger &logger,
+                                   std::chrono::milliseconds attachTimeout,
+                                   std::chrono::milliseconds inactivityTimeout)
+    : syncGuard(syncGuard),
+      clock(clock),
+      metrics(metrics),
+      logger(logger, "[REAPER]"),
+      attachTimeout(attachTimeout),
+      inactivityTimeout(inactivityTimeout)
+{}
+
+ConnectionReaper::~ConnectionReaper()
+{
+    std::lock_guard<std::mutex> lock(timerMutex);
+    if (running)
+    {
+        logger.logError("running on destruction!");
+    }
+}
+
+void ConnectionReaper::start()
+{
+    {
+        std::lock_guard<std::mutex> lock(timerMutex);
+        if (running)
+        {
+            logger.logError("attempt to restart!");
+            return;
+        }
+        running = true;
+    }
+    logger.logDebug("started - attach timeout: ", attachTimeout.load().count(),
+                    "ms, inactivity timeout: ", inactivityTimeout.load().count(), "ms");
+    scheduleTick();
+}
+
+void ConnectionReaper::stop()
+{
+    std::optional<common::IClock::TimerId> lastTimer;
+    {
+        std::lock_guard<std::mutex> lock(timerMutex);
+        if (not running)
+        {
+            logger.logError("attempt to stop not running reaper!");
+            return;
+        }
+        running = false;
+        lastTimer = tickTimer;
+        tickTimer.reset();
+    }
+    // not under timerMutex - cancel waits for the tick being run, and that one needs the mutex to finish
+    if (lastTimer)
+    {
+        clock->cancel(*lastTimer);
+    }
+    logger.logDebug("finished");
+}
+
+void ConnectionReaper::reconfigure(std::chrono::milliseconds newAttachTimeout,
+                                   std::chrono::milliseconds newInactivityTimeout)
+{
+    const auto oldAttachTimeout = attachTimeout.exchange(newAttachTimeout);
+    const auto oldInactivityTimeout = inactivityTimeout.exchange(newInactivityTimeout);
+    if (oldAttachTimeout != newAttachTimeout or oldInactivityTimeout != newInactivityTimeout)
+    {
+        logger.logInfo("reconfigured: attach timeout: ", newAttachTimeout.count(),
+                       "ms, inactivity timeout: ", newInactivityTimeout.count(), "ms");
+    }
+}
+
+ConnectionReaper::WatchId ConnectionReaper::watch(IUeConnection &ue)
+{
+    const WatchId id = nextId++;
+    watched.emplace(id, Watched{&ue, ue.framesReceived(), Phase::AwaitingSib});
+    // only to notice UE attached without SIB - attach timeout starts at sibSent
+    wheel.schedule(id, delayOf(inactivityTimeout.load(), DEFAULT_INACTIVITY_TIMEOUT));
+    return id;
+}
+
+void ConnectionReaper::sibSent(WatchId id)
+{
+    auto found = watched.find(id);
+    if (found == watched.end() or found->second.phase != Phase::AwaitingSib)
+    {
+        return;
+    }
+    found->second.phase = Phase::Attaching;
+    wheel.schedule(id, delayOf(attachTimeout.load(), DEFAULT_ATTACH_TIMEOUT));
+}
+
+void ConnectionReaper::forget(WatchId id)
+{
+    watched.erase(id);
+    wheel.cancel(id);
+}
+
+std::size_t ConnectionReaper::watchedCount() const
+{
+    return watched.size();
+}
+
+void ConnectionReaper::tick()
+{
+    SyncLock lock(*syncGuard);
+    expired.clear();
+    wheel.advance(expired);
+    for (const WatchId id : expired)
+    {
+        if (auto found = watched.find(id); found != watched.end())
+        {
+            check(id, found->second);
+        }
+    }
+}
+
+void ConnectionReaper::check(WatchId id, Watched &connection)
+{
+    const std::uint64_t framesReceived = connection.ue->framesReceived();
+    if (connection.phase == Phase::AwaitingSib)
+    {
+        if (connection.ue->isAttached())
+        {
+            connection.phase = Phase::Active;
+        }
+    }
+    else if (connection.phase == Phase::Attaching)
+    {
+        if (attachTimeout.load() > std::chrono::milliseconds::zero() and not connection.ue->isAttached())
+        {
+            reap(id, metrics->reapedNotAttached, "not attached in time: ");
+            return;
+        }
+        connection.phase = Phase::Active;
+    }
+    else if (inactivityTimeout.load() > std::chrono::milliseconds::zero()
+             and framesReceived == connection.framesReceived)
+    {
+        reap(id, metrics->reapedInactive, "inactive: ");
+        return;
+    }
+    connection.framesReceived = framesReceived;
+    wheel.schedule(id, delayOf(inactivityTimeout.load(), DEFAULT_INACTIVITY_TIMEOUT));
+}
+
+void ConnectionReaper::reap(WatchId id, common::Counter &counter, const char *reason)
+{
+    auto found = watched.find(id);
+    IUeConnection& ue = *found->second.ue;
+    // not watched any more - the connection goes away when its transport reports disconnection
+    watched.erase(found);
+    counter.add();
+    static common::LogLimit logLimit = common::LogLimit::rateLimited();
+    logger.logInfo(logLimit, "Closing ", reason, ue);
+    ue.close();
+}
+
+void ConnectionReaper::scheduleTick()
+{
+    std::lock_guard<std::mutex> lock(timerMutex);
+    if (running)
+    {
+        tickTimer = clock->scheduleAfter(TICK, [this] { onTimer(); });
+    }
+}
+
+void ConnectionReaper::onTimer()
+{
+    tick();
+    scheduleTick();
+}
+
+}
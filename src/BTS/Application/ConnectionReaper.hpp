@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "IComponent.hpp"
+#include "Synchronization.hpp"
+#include "RelayMetrics.hpp"
+#include "UeConnection/IUeConnection.hpp"
+#include "Logger/PrefixedLogger.hpp"
+#include "Time/IClock.hpp"
+#include "Time/TimingWheel.hpp"
+
+namespace bts
+{
+
+/**
+ * Closes connections that do not attach within attach timeout from the first SIB sent to them, then the ones that
+ * send nothing for inactivity timeout (EchoReply counts - with echo enabled only dead UEs are silent). Attach timeout
+ * does not run before the first SIB - SIBs go round robin, with many UEs connecting at once the last ones wait long.
+ * Activity is not timestamped per frame: at every deadline frames received are compared with the previous deadline,
+ * so a silent UE is reaped after one to two inactivity timeouts. Deadlines live in a timing wheel - cost per
+ * connection does not depend on their number.
+ * Zero timeout disables that check, but the connection stays on the wheel with default timeout as its period -
+ * so enabling it again covers connections that are already there, from their next deadline.
+ */
+class ConnectionReaper : public IComponent
+{
+public:
+    static constexpr std::chrono::milliseconds TICK{1000};
+    static constexpr std::chrono::milliseconds DEFAULT_ATTACH_TIMEOUT{30000};
+    static constexpr std::chrono::milliseconds DEFAULT_INACTIVITY_TIMEOUT{60000};
+    using WatchId = common::TimingWheel::Key;
+
+    ConnectionReaper(SyncGuardPtr syncGuard,
+                     common::ClockPtr clock,
+                     RelayMetricsPtr metrics,
+                     common::ILogger& logger,
+                     std::chrono::milliseconds attachTimeout = DEFAULT_ATTACH_TIMEOUT,
+                     std::chrono::milliseconds inactivityTimeout = DEFAULT_INACTIVITY_TIMEOUT);
+    ~ConnectionReaper();
+
+    void start() override;
+    void stop() override;
+    /**
+     * Safe to call while running - takes effect from next deadline of each connection
+     */
+    void reconfigure(std::chrono::milliseconds attachTimeout, std::chrono::milliseconds inactivityTimeout);
+
+    /**
+     * Under SyncLock - the connection shall be forgotten before it is destroyed
+     */
+    WatchId watch(IUeConnection& ue);
+    /**
+     * Under SyncLock - starts attach timeout at the first SIB, later SIBs change nothing
+     */
+    void sibSent(WatchId id);
+    void forget(WatchId id);
+    std::size_t watchedCount() const;
+
+    /**
+     * Moves deadlines by one TICK - called by the timer
+     */
+    void tick();
+
+private:
+    enum class Phase : std::uint8_t
+    {
+        AwaitingSib,
+        Attaching,
+        Active
+    };
+    struct Watched
+    {
+        IUeConnection* ue;
+        std::uint64_t framesReceived;
+        Phase phase;
+    };
+
+    void check(WatchId id, Watched& watched);
+    void reap(WatchId id, common::Counter& counter, const char* reason);
+    void scheduleTick();
+    void onTimer();
+
+    SyncGuardPtr syncGuard;
+    common::ClockPtr clock;
+    RelayMetricsPtr metrics;
+    common::PrefixedLogger logger;
+    std::atomic<std::chrono::milliseconds> attachTimeout;
+    std::atomic<std::chrono::milliseconds> inactivityTimeout;
+
+    // under SyncLock
+    common::TimingWheel wheel{TICK};
+    std::unordered_map<WatchId, Watched> watched;
+    WatchId nextId = 0u;
+    std::vector<WatchId> expired;
+
+    std::mutex timerMutex;
+    bool running = false;
+    std::optional<common::IClock::TimerId> tickTimer;
+};
+
+using ConnectionReaperPtr = std::shared_ptr<ConnectionReaper>;
+
+}
@@ -1,19 +1,43 @@
 #include "ConsoleCommands.hpp"
 #include "TestCommands/TestCommands.hpp"
+#include "Trace/FlightRecorder.hpp"
+#include "Trace/FrameTracer.hpp"
+#include "Trace/LoopLagMonitor.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <iomanip>
+#include <optional>
+#include <sstream>
 
 namespace bts
 {
 
+namespace
+{
+
+// far beyond UEs tracked per ranking anyway
+constexpr std::size_t MAX_TOP_COUNT = 1000u;
+
+}
+
 ConsoleCommands::ConsoleCommands(IConsole& console,
                                  IApplicationEnvironment &environment,
                                  common::ILogger& logger,
                                  std::shared_ptr<IUeRelay> ueRelay,
-                                 SyncGuardPtr syncGuard)
+                                 SyncGuardPtr syncGuard,
+                                 std::shared_ptr<common::MetricsRegistry> metricsRegistry,
+                                 TrafficTopPtr trafficTop,
+                                 RelayMetricsPtr relayMetrics)
     : syncGuard(syncGuard),
       logger(logger, "[CONSOLE]"),
       console(console),
       environment(environment),
-      ueRelay(ueRelay)
+      ueRelay(ueRelay),
+      metricsRegistry(metricsRegistry),
+      trafficTop(trafficTop),
+      relayMetrics(relayMetrics),
+      testScheduler(std::make_unique<common::TaskScheduler>())
 {}
 
 ConsoleCommands::~ConsoleCommands()
@@ -27,6 +51,14 @@ void ConsoleCommands::start()
     console.addCommand("a", "Show address", std::bind(&ConsoleCommands::showAddress, this, argsArgument, streamArgument));
     console.addCommand("s", "Show status", std::bind(&ConsoleCommands::showStatus, this, argsArgument, streamArgument));
     console.addCommand("l", "List attached ue", std::bind(&ConsoleCommands::listAttachedUe, this, argsArgument, streamArgument));
+    console.addCommand("top", "Show heaviest ue [count] [sent|sent_bytes|received|received_bytes|unknown]", std::bind(&ConsoleCommands::showTopUe, this, argsArgument, streamArgument));
+    console.addCommand("rtt", "Show echo round trip time per attached ue and aggregated", std::bind(&ConsoleCommands::showRoundTrip, this, argsArgument, streamArgument));
+    console.addCommand("f", "Dump flight recorder [file]", std::bind(&ConsoleCommands::dumpFlightRecorder, this, argsArgument, streamArgument));
+    console.addCommand("m", "Show metrics", std::bind(&ConsoleCommands::showMetrics, this, argsArgument, streamArgument));
+    console.addCommand("p", "Show forward path latency per stage [samples|on|off]", std::bind(&ConsoleCommands::showFrameTrace, this, argsArgument, streamArgument));
+    console.addCommand("lock", "Show relay lock wait/hold times per call site [on|off - kept until lock_profiler config value changes]", std::bind(&ConsoleCommands::showLockProfile, this, argsArgument, streamArgument));
+    console.addCommand("loop", "Show event loop lag, time per socket callback and frames per wakeup", std::bind(&ConsoleCommands::showLoopLag, this, argsArgument, streamArgument));
+    console.addCommand("mem", "Show live heap bytes per subsystem and allocation rates since previous mem", std::bind(&ConsoleCommands::showMemory, this, argsArgument, streamArgument));
     console.addCloseCommand();
     console.addHelpCommand();
     console.addCommand("t", "Test commands - details in implementation",std::bind(&ConsoleCommands::testCommands, this, argsArgument, streamArgument));
@@ -34,7 +66,13 @@ void ConsoleCommands::start()
 
 void ConsoleCommands::stop()
 {
-    // do nothing
+    std::unique_ptr<common::TaskScheduler> stoppedScheduler;
+    {
+        std::lock_guard<std::mutex> lock(testSchedulerGuard);
+        stoppedScheduler = std::move(testScheduler);
+    }
+    // not under the guard - it waits for running plans, "t" called meanwhile finds no scheduler
+    stoppedScheduler.reset();
 }
 
 void ConsoleCommands::showAddress(std::string, std::ostream &os)
@@ -63,6 +101,147 @@ void ConsoleCommands::listAttachedUe(std::string, std::ostream& os)
     });
 }
 
+void ConsoleCommands::showTopUe(std::string args, std::ostream &os)
+{
+    std::size_t count = TrafficTop::DEFAULT_TOP;
+    std::optional<TrafficTop::Ranking> ranking;
+    std::istringstream argsStream(args);
+    std::string arg;
+    while (argsStream >> arg)
+    {
+        TrafficTop::Ranking named;
+        if (TrafficTop::rankingFromString(arg, named))
+        {
+            ranking = named;
+        }
+        else if (std::isdigit(static_cast<unsigned char>(arg.front())))
+        {
+            const auto [end, error] = std::from_chars(arg.data(), arg.data() + arg.size(), count);
+            if (error != std::errc{} or end != arg.data() + arg.size() or count == 0u or count > MAX_TOP_COUNT)
+            {
+                SyncLock lock(*syncGuard);
+                os << "Usage: top [count] [ranking] - count shall be 1.." << MAX_TOP_COUNT << ", got: " << arg << "\n";
+                return;
+            }
+        }
+        else
+        {
+            SyncLock lock(*syncGuard);
+            os << "Unknown top argument: " << arg << "\n";
+            return;
+        }
+    }
+
+    SyncLock lock(*syncGuard);
+    const auto now = TrafficTop::Clock::now();
+    if (ranking)
+    {
+        trafficTop->print(os, *ranking, count, now);
+    }
+    else
+    {
+        trafficTop->print(os, count, now);
+    }
+}
+
+void ConsoleCommands::showRoundTrip(std::string, std::ostream &os)
+{
+    const auto& roundTrip = relayMetrics->echoRoundTrip;
+    SyncLock lock(*syncGuard);
+    ueRelay->visitAttachedUe([&os](IUeConnection& ue) { ue.printRoundTrip(os); });
+
+    const auto flags = os.flags();
+    os << std::fixed << std::setprecision(3)
+       << "all ue: echo sent: " << relayMetrics->echoRequests.value()
+       << ", replies: " << relayMetrics->echoReplies.value()
+       << ", rtt [ms] p50: " << double(roundTrip.percentile(0.5)) / 1e6
+       << " p99: " << double(roundTrip.percentile(0.99)) / 1e6
+       << " max: " << double(roundTrip.percentile(1.0)) / 1e6 << "\n";
+    os.flags(flags);
+}
+
+void ConsoleCommands::dumpFlightRecorder(std::string args, std::ostream &os)
+{
+    std::string path = args.empty() ? "bts" + to_string(environment.getBtsId()) + "_flight.txt" : args;
+    // recorder is lock-free - no need to stop the relay
+    bool dumped = common::FlightRecorder::instance().dumpToFile(path);
+
+    SyncLock lock(*syncGuard);
+    os << (dumped ? "Flight recorder dumped to: " : "Cannot write flight recorder to: ") << path << "\n";
+}
+
+void ConsoleCommands::showMetrics(std::string, std::ostream &os)
+{
+    // not under the lock - some gauges take it when sampled by registry
+    std::ostringstream metrics;
+    metricsRegistry->writePrometheus(metrics);
+
+    SyncLock lock(*syncGuard);
+    os << metrics.str();
+}
+
+void ConsoleCommands::showFrameTrace(std::string args, std::ostream &os)
+{
+    auto& tracer = common::FrameTracer::instance();
+    std::ostringstream trace;
+    if (args == "on" or args == "off")
+    {
+        tracer.setEnabled(args == "on");
+        trace << "Frame tracing " << (tracer.isEnabled() ? "enabled" : "disabled") << "\n";
+    }
+    else if (args == "samples")
+    {
+        tracer.printSamples(trace);
+    }
+    else
+    {
+        tracer.printSummary(trace);
+    }
+
+    SyncLock lock(*syncGuard);
+    os << trace.str();
+}
+
+void ConsoleCommands::showLockProfile(std::string args, std::ostream &os)
+{
+    auto& profiler = LockProfiler::instance();
+    if (args == "on" or args == "off")
+    {
+        profiler.setEnabled(args == "on");
+    }
+    std::ostringstream profile;
+    profiler.print(profile);
+
+    SyncLock lock(*syncGuard);
+    os << profile.str();
+}
+
+void ConsoleCommands::showLoopLag(std::string, std::ostream &os)
+{
+    std::ostringstream summary;
+    common::LoopLagMonitor::instance().print(summary);
+
+    SyncLock lock(*syncGuard);
+    os << summary.str();
+}
+
+void ConsoleCommands::showMemory(std::string, std::ostream &os)
+{
+    using common::MemoryAccounting;
+    const auto now = std::chrono::steady_clock::now();
+    const auto current = MemoryAccounting::snapshot();
+    const double seconds = previousMemoryAt == std::chrono::steady_clock::time_point{}
+            ? 0.0
+            : std::chrono::duration<double>(now - previousMemoryAt).count();
+    std::ostringstream usage;
+    MemoryAccounting::print(usage, current, previousMemory, seconds);
+    previousMemory = current;
+    previousMemoryAt = now;
+
+    SyncLock lock(*syncGuard);
+    os << usage.str();
+}
+
 void ConsoleCommands::testCommands(std::string args, std::ostream &os)
 {
     using common::TestCommands;
@@ -74,16 +253,24 @@ void ConsoleCommands::testCommands(std::string args, std::ostream &os)
                                          PhoneNumber to)
         {
             SyncLock lock(*syncGuard);
-            ueRelay->sendMessage(message, to);
+            return ueRelay->sendMessage(message, to);
         };
+        // console stream outlives the plan - scheduler is stopped on stop()
         parameters.printText = [this, &os] (std::string message)
         {
             SyncLock lock(*syncGuard);
             os << message;
         };
 
-        SyncLock lock(*syncGuard);
-        testParser.run(parameters);
+        // relay is locked only around single sends - waiting plan does not stall forwarding
+        std::lock_guard<std::mutex> schedulerLock(testSchedulerGuard);
+        if (not testScheduler)
+        {
+            SyncLock lock(*syncGuard);
+            os << " test commands stopped";
+            return;
+        }
+        testParser.start(parameters, *testScheduler);
     }
     catch (std::exception& ex)
     {
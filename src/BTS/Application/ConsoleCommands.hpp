@@ -6,6 +6,14 @@
 #include "UeRelay/IUeRelay.hpp"
 #include "IApplicationEnvironment.hpp"
 #include "IComponent.hpp"
+#include "TestCommands/TaskScheduler.hpp"
+#include "Metrics/MetricsRegistry.hpp"
+#include "TrafficTop.hpp"
+#include "RelayMetrics.hpp"
+#include "Memory/MemoryAccounting.hpp"
+#include <chrono>
+#include <memory>
+#include <mutex>
 
 namespace bts
 {
@@ -17,7 +25,10 @@ public:
                     IApplicationEnvironment& environment,
                     common::ILogger& logger,
                     std::shared_ptr<IUeRelay> ueRelay,
-                    SyncGuardPtr syncGuard);
+                    SyncGuardPtr syncGuard,
+                    std::shared_ptr<common::MetricsRegistry> metricsRegistry,
+                    TrafficTopPtr trafficTop,
+                    RelayMetricsPtr relayMetrics);
     ~ConsoleCommands();
 
     void start() override;
@@ -27,6 +38,14 @@ private:
     void showAddress(std::string args, std::ostream &os);
     void showStatus(std::string args, std::ostream &os);
     void listAttachedUe(std::string args, std::ostream &os);
+    void showTopUe(std::string args, std::ostream &os);
+    void showRoundTrip(std::string args, std::ostream &os);
+    void dumpFlightRecorder(std::string args, std::ostream &os);
+    void showMetrics(std::string args, std::ostream &os);
+    void showFrameTrace(std::string args, std::ostream &os);
+    void showLockProfile(std::string args, std::ostream &os);
+    void showLoopLag(std::string, std::ostream &os);
+    void showMemory(std::string, std::ostream &os);
     void testCommands(std::string args, std::ostream &os);
 
     SyncGuardPtr syncGuard;
@@ -34,6 +53,16 @@ private:
     IConsole& console;
     IApplicationEnvironment& environment;
     std::shared_ptr<IUeRelay> ueRelay;
+    std::shared_ptr<common::MetricsRegistry> metricsRegistry;
+    TrafficTopPtr trafficTop;
+    RelayMetricsPtr relayMetrics;
+    // rates of "mem" are since its previous call - console runs one command at a time
+    common::MemoryAccounting::Snapshot previousMemory{};
+    std::chrono::steady_clock::time_point previousMemoryAt{};
+    // console thread starts plans while stop() may run - null after stop()
+    std::mutex testSchedulerGuard;
+    // runs test commands plans - last member, so it is stopped first
+    std::unique_ptr<common::TaskScheduler> testScheduler;
 };
 
 }
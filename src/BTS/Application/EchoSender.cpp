@@ -0,0 +1,100 @@
+#include "EchoSender.hpp"
+
+namespace bts
+{
+
+EchoSender::EchoSender(std::shared_ptr<IUeRelay> ueRelay,
+                       SyncGuardPtr syncGuard,
+                       common::ClockPtr clock,
+                       common::ILogger &logger,
+                       std::chrono::milliseconds period)
+    : ueRelay(ueRelay),
+      syncGuard(syncGuard),
+      clock(clock),
+      logger(logger, "[ECHO]"),
+      period(period)
+{}
+
+EchoSender::~EchoSender()
+{
+    std::lock_guard<std::mutex> lock(timerMutex);
+    if (running)
+    {
+        logger.logError("running on destruction!");
+    }
+}
+
+void EchoSender::start()
+{
+    {
+        std::lock_guard<std::mutex> lock(timerMutex);
+        if (running)
+        {
+            logger.logError("attempt to restart!");
+            return;
+        }
+        running = true;
+    }
+    logger.logDebug("started");
+    scheduleEcho();
+}
+
+void EchoSender::stop()
+{
+    std::optional<common::IClock::TimerId> lastTimer;
+    {
+        std::lock_guard<std::mutex> lock(timerMutex);
+        if (not running)
+        {
+            logger.logError("attempt to stop not running sender!");
+            return;
+        }
+        running = false;
+        lastTimer = echoTimer;
+        echoTimer.reset();
+    }
+    // not under timerMutex - cancel waits for the echo being sent, and that one needs the mutex to finish
+    if (lastTimer)
+    {
+        clock->cancel(*lastTimer);
+    }
+    logger.logDebug("finished");
+}
+
+void EchoSender::reconfigure(std::chrono::milliseconds newPeriod)
+{
+    auto oldPeriod = period.exchange(newPeriod);
+    if (oldPeriod != newPeriod)
+    {
+        logger.logInfo("reconfigured: period: ", newPeriod.count(), "ms");
+    }
+}
+
+void EchoSender::sendEcho()
+{
+    SyncLock lock(*syncGuard);
+    ueRelay->visitAttachedUe([](IUeConnection& ue) { ue.sendEcho(); });
+}
+
+void EchoSender::scheduleEcho()
+{
+    std::lock_guard<std::mutex> lock(timerMutex);
+    if (running)
+    {
+        // when disabled keep polling with default period - reconfiguration is noticed without restart
+        auto delay = period.load();
+        echoTimer = clock->scheduleAfter(delay > std::chrono::milliseconds::zero() ? delay : DEFAULT_PERIOD,
+                                         [this] { onTimer(); });
+    }
+}
+
+void EchoSender::onTimer()
+{
+    if (period.load() > std::chrono::milliseconds::zero())
+    {
+        sendEcho();
+    }
+    scheduleEcho();
+}
+
+}
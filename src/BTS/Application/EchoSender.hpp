@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include "IComponent.hpp"
+#include "Synchronization.hpp"
+#include "UeRelay/IUeRelay.hpp"
+#include "Logger/PrefixedLogger.hpp"
+#include "Time/IClock.hpp"
+
+namespace bts
+{
+
+/**
+ * Sends Echo to all attached UEs every period - round trip times are recorded by the connections
+ */
+class EchoSender : public IComponent
+{
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_PERIOD{1000};
+
+    EchoSender(std::shared_ptr<IUeRelay> ueRelay,
+               SyncGuardPtr syncGuard,
+               common::ClockPtr clock,
+               common::ILogger& logger,
+               std::chrono::milliseconds period = DEFAULT_PERIOD);
+    ~EchoSender();
+
+    void start() override;
+    void stop() override;
+    /**
+     * Safe to call while running - takes effect from next period, zero period stops sending
+     */
+    void reconfigure(std::chrono::milliseconds period);
+    void sendEcho();
+
+private:
+    void scheduleEcho();
+    void onTimer();
+
+    std::shared_ptr<IUeRelay> ueRelay;
+    SyncGuardPtr syncGuard;
+    common::ClockPtr clock;
+    common::PrefixedLogger logger;
+    std::atomic<std::chrono::milliseconds> period;
+
+    std::mutex timerMutex;
+    bool running = false;
+    std::optional<common::IClock::TimerId> echoTimer;
+};
+
+}
@@ -0,0 +1,120 @@
+#include "MetricsFileWriter.hpp"
+#include <cstdio>
+#include <fstream>
+#include "Logger/LogLimit.hpp"
+
+namespace bts
+{
+
+MetricsFileWriter::MetricsFileWriter(std::shared_ptr<common::MetricsRegistry> registry,
+                                     common::ClockPtr clock,
+                                     common::ILogger &logger)
+    : registry(registry),
+      clock(clock),
+      logger(logger, "[METRICS]")
+{}
+
+MetricsFileWriter::~MetricsFileWriter()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running)
+    {
+        logger.logError("running on destruction!");
+    }
+}
+
+void MetricsFileWriter::start()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running)
+    {
+        logger.logError("attempt to restart!");
+        return;
+    }
+    running = true;
+    logger.logDebug("started");
+    writeTimer = clock->scheduleAfter(period, [this] { onTimer(); });
+}
+
+void MetricsFileWriter::stop()
+{
+    std::optional<common::IClock::TimerId> lastTimer;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (not running)
+        {
+            logger.logError("attempt to stop not running writer!");
+            return;
+        }
+        running = false;
+        lastTimer = writeTimer;
+        writeTimer.reset();
+    }
+    // not under mutex - cancel waits for the write being run, and that write needs the mutex to finish
+    if (lastTimer)
+    {
+        clock->cancel(*lastTimer);
+    }
+    logger.logDebug("finished");
+}
+
+void MetricsFileWriter::reconfigure(std::string newPath, std::chrono::milliseconds newPeriod)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (newPath != path or newPeriod != period)
+    {
+        logger.logInfo("reconfigured: file: \"", newPath, "\", period: ", newPeriod.count(), "ms");
+    }
+    path = std::move(newPath);
+    period = newPeriod;
+}
+
+bool MetricsFileWriter::writeFile()
+{
+    std::string target;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        target = path;
+    }
+    if (target.empty())
+    {
+        return false;
+    }
+
+    const std::string temporary = target + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        registry->writePrometheus(file);
+        file.flush();
+        if (not file)
+        {
+            static common::LogLimit logLimit = common::LogLimit::rateLimited();
+            logger.logError(logLimit, "Cannot write metrics to: ", temporary);
+            return false;
+        }
+    }
+    if (std::rename(temporary.c_str(), target.c_str()) != 0)
+    {
+        static common::LogLimit logLimit = common::LogLimit::rateLimited();
+        logger.logError(logLimit, "Cannot replace metrics file: ", target);
+        return false;
+    }
+    return true;
+}
+
+void MetricsFileWriter::scheduleWrite()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running)
+    {
+        writeTimer = clock->scheduleAfter(period, [this] { onTimer(); });
+    }
+}
+
+void MetricsFileWriter::onTimer()
+{
+    writeFile();
+    scheduleWrite();
+}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include "IComponent.hpp"
+#include "Logger/PrefixedLogger.hpp"
+#include "Metrics/MetricsRegistry.hpp"
+#include "Time/IClock.hpp"
+
+namespace bts
+{
+
+/**
+ * Periodically rewrites file with all metrics in Prometheus text format - for node exporter textfile collector.
+ * File is replaced atomically, so readers never see it half written.
+ */
+class MetricsFileWriter : public IComponent
+{
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_PERIOD{5000};
+
+    MetricsFileWriter(std::shared_ptr<common::MetricsRegistry> registry,
+                      common::ClockPtr clock,
+                      common::ILogger& logger);
+    ~MetricsFileWriter();
+
+    void start() override;
+    void stop() override;
+    /**
+     * Safe to call while running - takes effect from next write, empty path disables writing
+     */
+    void reconfigure(std::string path, std::chrono::milliseconds period);
+    /**
+     * @return false when not configured or file cannot be written
+     */
+    bool writeFile();
+
+private:
+    void scheduleWrite();
+    void onTimer();
+
+    std::shared_ptr<common::MetricsRegistry> registry;
+    common::ClockPtr clock;
+    common::PrefixedLogger logger;
+
+    std::mutex mutex;
+    std::string path;
+    std::chrono::milliseconds period = DEFAULT_PERIOD;
+    bool running = false;
+    std::optional<common::IClock::TimerId> writeTimer;
+};
+
+}
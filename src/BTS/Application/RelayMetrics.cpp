@@ -0,0 +1,99 @@
+#include "RelayMetrics.hpp"
+
+namespace bts
+{
+
+using common::MessageId;
+
+namespace
+{
+
+constexpr double NS_TO_S = 1e-9;
+// microsecond to about a minute - 26 buckets per histogram
+constexpr common::HistogramRange LATENCY_RANGE{1000u, 60000000000u};
+
+std::uint64_t nanosecondsSince(RelayMetrics::Clock::time_point start) noexcept
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(RelayMetrics::Clock::now() - start).count();
+}
+
+}
+
+RelayMetrics::RelayMetrics(common::MetricsRegistry &registry)
+    : unknownRecipient(registry.counter("bts_forward_failures_total", "Messages not forwarded",
+                                        {{"reason", "UnknownRecipient"}})),
+      unknownSender(registry.counter("bts_forward_failures_total", "Messages not forwarded",
+                                     {{"reason", "UnknownSender"}})),
+      echoRequests(registry.counter("bts_echo_requests_total", "Echo requests sent to attached UEs")),
+      echoReplies(registry.counter("bts_echo_replies_total", "Echo replies received from UEs")),
+      reapedNotAttached(registry.counter("bts_reaped_connections_total", "Connections closed by BTS",
+                                         {{"reason", "attach_timeout"}})),
+      reapedInactive(registry.counter("bts_reaped_connections_total", "Connections closed by BTS",
+                                      {{"reason", "inactive"}})),
+      attachLatency(registry.histogram("bts_attach_latency_seconds", "From SIB sent to UE attached", NS_TO_S,
+                                       {}, LATENCY_RANGE)),
+      forwardLatency(registry.histogram("bts_forward_latency_seconds", "From message received to forwarded", NS_TO_S,
+                                        {}, LATENCY_RANGE)),
+      echoRoundTrip(registry.histogram("bts_echo_rtt_seconds", "From echo sent to its reply received", NS_TO_S,
+                                       {}, LATENCY_RANGE)),
+      received(registerTraffic(registry, "received")),
+      sent(registerTraffic(registry, "sent"))
+{}
+
+RelayMetrics::TrafficPerMessage RelayMetrics::registerTraffic(common::MetricsRegistry &registry,
+                                                              const std::string &direction)
+{
+    TrafficPerMessage traffic{};
+    for (std::size_t index = 0u; index < traffic.size(); ++index)
+    {
+        const bool known = index + 1u < traffic.size();
+        const std::string message = known ? to_string(MessageId(index)) : "Unknown";
+        traffic[index].frames = &registry.counter("bts_frames_" + direction + "_total", "Frames " + direction,
+                                                  {{"message", message}});
+        traffic[index].bytes = &registry.counter("bts_bytes_" + direction + "_total", "Bytes " + direction,
+                                                 {{"message", message}});
+    }
+    return traffic;
+}
+
+void RelayMetrics::count(TrafficPerMessage &traffic, const common::BinaryMessage &message) noexcept
+{
+    // MessageId is the first byte of header - peek it without decoding
+    const auto& value = message.value;
+    std::size_t index = traffic.size() - 1u;
+    if (not value.empty() and common::EnumRange<MessageId>::contains(MessageId(value[0])))
+    {
+        index = value[0];
+    }
+    traffic[index].frames->add();
+    traffic[index].bytes->add(value.size());
+}
+
+void RelayMetrics::frameReceived(const common::BinaryMessage &message) noexcept
+{
+    count(received, message);
+}
+
+void RelayMetrics::frameSent(const common::BinaryMessage &message) noexcept
+{
+    count(sent, message);
+}
+
+void RelayMetrics::forwarded(Clock::time_point receivedAt) noexcept
+{
+    forwardLatency.record(nanosecondsSince(receivedAt));
+}
+
+void RelayMetrics::attached(Clock::time_point sibSentAt) noexcept
+{
+    attachLatency.record(nanosecondsSince(sibSentAt));
+}
+
+void RelayMetrics::echoReplied(Clock::duration roundTrip) noexcept
+{
+    echoReplies.add();
+    echoRoundTrip.record(std::chrono::duration_cast<std::chrono::nanoseconds>(roundTrip).count());
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include "Messages/BinaryMessage.hpp"
+#include "Messages/MessageId.hpp"
+#include "Metrics/MetricsRegistry.hpp"
+#include "Traits/EnumTraits.hpp"
+
+namespace bts
+{
+
+/**
+ * Relay metrics registered once in the registry - updating them is lock-free and does not allocate
+ */
+class RelayMetrics
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RelayMetrics(common::MetricsRegistry& registry);
+
+    void frameReceived(const common::BinaryMessage& message) noexcept;
+    void frameSent(const common::BinaryMessage& message) noexcept;
+    void forwarded(Clock::time_point receivedAt) noexcept;
+    void attached(Clock::time_point sibSentAt) noexcept;
+    void echoReplied(Clock::duration roundTrip) noexcept;
+
+    common::Counter& unknownRecipient;
+    common::Counter& unknownSender;
+    common::Counter& echoRequests;
+    common::Counter& echoReplies;
+    common::Counter& reapedNotAttached;
+    common::Counter& reapedInactive;
+    common::Histogram& attachLatency;
+    common::Histogram& forwardLatency;
+    common::Histogram& echoRoundTrip;
+
+private:
+    struct Traffic
+    {
+        common::Counter* frames;
+        common::Counter* bytes;
+    };
+    // one entry per MessageId and the last one for frames with unknown id
+    using TrafficPerMessage = std::array<Traffic, common::EnumRange<common::MessageId>::size() + 1u>;
+
+    static TrafficPerMessage registerTraffic(common::MetricsRegistry& registry, const std::string& direction);
+    static void count(TrafficPerMessage& traffic, const common::BinaryMessage& message) noexcept;
+
+    TrafficPerMessage received;
+    TrafficPerMessage sent;
+};
+
+using RelayMetricsPtr = std::shared_ptr<RelayMetrics>;
+
+}
@@ -1,25 +1,29 @@
 #include "SibMolester.hpp"
 #include <chrono>
+#include "Trace/Probes.hpp"
 
 namespace bts
 {
 
 SibMolester::SibMolester(std::shared_ptr<IUeRelay> ueRelay,
                          SyncGuardPtr syncGuard,
+                         common::ClockPtr clock,
                          BtsId btsId,
                          common::ILogger &logger,
                          std::chrono::milliseconds oneTickDuration,
                          std::size_t ticksToSendSib)
     : ueRelay(ueRelay),
       syncGuard(syncGuard),
+      clock(clock),
       btsId(btsId),
       logger(logger, "[SIB]"),
-      TICK_DURATION(oneTickDuration),
-      TICKS_TO_SEND_SIB(ticksToSendSib)
+      tickDuration(oneTickDuration),
+      ticksToSendSib(ticksToSendSib)
 {}
 
 SibMolester::~SibMolester()
 {
+    std::lock_guard<std::mutex> lock(timerMutex);
     if (running)
     {
         logger.logError("running on destruction!");
@@ -28,60 +32,73 @@ SibMolester::~SibMolester()
 
 void SibMolester::start()
 {
-    if (false == running.exchange(true))
-    {
-        molester = std::thread(std::bind(&SibMolester::run, this));
-    }
-    else
+    std::lock_guard<std::mutex> lock(timerMutex);
+    if (running)
     {
         logger.logError("attempt to restart!");
+        return;
     }
+    running = true;
+    logger.logDebug("started");
+    tickTimer = clock->scheduleAfter(tickDuration.load(), [this] { oneTick(); });
 }
 
 void SibMolester::stop()
 {
-    if (true == running.exchange(false))
+    std::optional<common::IClock::TimerId> lastTimer;
     {
-        molester.join();
+        std::lock_guard<std::mutex> lock(timerMutex);
+        if (not running)
+        {
+            logger.logError("attempt to stop not running molester!");
+            return;
+        }
+        running = false;
+        lastTimer = tickTimer;
+        tickTimer.reset();
     }
-    else
+    // not under timerMutex - cancel waits for the tick being run, and that tick needs the mutex to finish
+    if (lastTimer)
     {
-        logger.logError("attempt to stop not running thread!");
+        clock->cancel(*lastTimer);
     }
+    logger.logDebug("finished");
 }
 
-void SibMolester::run()
+void SibMolester::reconfigure(std::chrono::milliseconds newTickDuration, std::size_t newTicksToSendSib)
 {
-    logger.logDebug("started");
-    while (running)
+    auto oldTickDuration = tickDuration.exchange(newTickDuration);
+    auto oldTicksToSendSib = ticksToSendSib.exchange(newTicksToSendSib);
+    if (oldTickDuration != newTickDuration or oldTicksToSendSib != newTicksToSendSib)
     {
-        oneSib();
-        oneTick();
+        logger.logInfo("reconfigured: tick: ", newTickDuration.count(), "ms, ticks to send sib: ", newTicksToSendSib);
+    }
+}
+
+void SibMolester::scheduleTick()
+{
+    std::lock_guard<std::mutex> lock(timerMutex);
+    if (running)
+    {
+        tickTimer = clock->scheduleAfter(tickDuration.load(), [this] { oneTick(); });
     }
-    logger.logDebug("finished");
 }
 
 void SibMolester::oneTick()
 {
-    std::this_thread::sleep_for(TICK_DURATION);
-    ++tickIndex;
+    if (++tickIndex >= ticksToSendSib)
+    {
+        tickIndex = 0;
+        sendSib();
+    }
+    scheduleTick();
 }
 
 void SibMolester::sendSib(IUeConnection &ue)
 {
     logger.logDebug("send to [", sibIndex, "]: ", ue);
     ue.sendSib(btsId);
-}
-
-void SibMolester::oneSib()
-{
-    if (tickIndex < TICKS_TO_SEND_SIB)
-    {
-        // not time yet!
-        return;
-    }
-    tickIndex = 0;
-    sendSib();
+    STH_PROBE(sib_sent, common::probeId(&ue), btsId.value);
 }
 
 void SibMolester::sendSib()
@@ -1,48 +1,65 @@
 #pragma once
 
-#include <thread>
 #include <atomic>
 #include <chrono>
+#include <mutex>
+#include <optional>
 #include "IComponent.hpp"
 #include "Synchronization.hpp"
 #include "UeRelay/IUeRelay.hpp"
 #include "Messages/BtsId.hpp"
 #include "Logger/PrefixedLogger.hpp"
+#include "Time/IClock.hpp"
 
 namespace bts
 {
 
+/**
+ * Sends SIB to not attached UEs - one UE every ticksToSendSib ticks, ticks are timers of the clock
+ */
 class SibMolester : public IComponent
 {
 public:
+    static constexpr std::chrono::milliseconds DEFAULT_TICK_DURATION{100};
+    static constexpr std::size_t DEFAULT_TICKS_TO_SEND_SIB = 50;
+
     SibMolester(std::shared_ptr<IUeRelay> ueRelay,
                 SyncGuardPtr syncGuard,
+                common::ClockPtr clock,
                 BtsId btsId,
                 common::ILogger& logger,
-                std::chrono::milliseconds tickDuration = std::chrono::milliseconds(100),
-                std::size_t ticksToSendSib = 50);
+                std::chrono::milliseconds tickDuration = DEFAULT_TICK_DURATION,
+                std::size_t ticksToSendSib = DEFAULT_TICKS_TO_SEND_SIB);
     ~SibMolester();
 
     void start() override;
     void stop() override;
+    /**
+     * Safe to call while running - takes effect from next tick
+     */
+    void reconfigure(std::chrono::milliseconds tickDuration, std::size_t ticksToSendSib);
+    /**
+     * Sends SIB to the next not attached UE (round robin) - normally called from the tick timer
+     */
+    void sendSib();
 private:
-    void run();
+    void scheduleTick();
     void oneTick();
-    void oneSib();
-    void sendSib();
     void sendSib(IUeConnection &ue);
 
     std::shared_ptr<IUeRelay> ueRelay;
     SyncGuardPtr syncGuard;
+    common::ClockPtr clock;
     common::PrefixedLogger logger;
     BtsId btsId;
-    const std::chrono::milliseconds TICK_DURATION;
-    const std::size_t TICKS_TO_SEND_SIB;
+    std::atomic<std::chrono::milliseconds> tickDuration;
+    std::atomic<std::size_t> ticksToSendSib;
 
     std::size_t sibIndex = 0;
     std::size_t tickIndex = 0;
-    std::atomic_bool running{false};
-    std::thread molester;
+    std::mutex timerMutex;
+    bool running = false;
+    std::optional<common::IClock::TimerId> tickTimer;
 };
 
 }
@@ -1,2 +1,116 @@
 #include "Synchronization.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <vector>
 
+namespace bts
+{
+
+namespace
+{
+
+const char* baseName(const char* path)
+{
+    const char* slash = std::strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+double toMicroseconds(std::uint64_t nanoseconds)
+{
+    return double(nanoseconds) / 1000.0;
+}
+
+}
+
+LockProfiler &LockProfiler::instance()
+{
+    static LockProfiler profiler;
+    return profiler;
+}
+
+LockProfiler::Site *LockProfiler::site(const std::source_location &location) noexcept
+{
+    auto matches = [&location](const Site& site)
+    {
+        return site.line == location.line() and std::strcmp(site.file, location.file_name()) == 0;
+    };
+
+    std::size_t count = siteCount.load(std::memory_order_acquire);
+    for (std::size_t index = 0u; index < count; ++index)
+    {
+        if (matches(sites[index]))
+        {
+            return &sites[index];
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(addSiteMutex);
+    // other thread could add it meanwhile
+    count = siteCount.load(std::memory_order_relaxed);
+    for (std::size_t index = 0u; index < count; ++index)
+    {
+        if (matches(sites[index]))
+        {
+            return &sites[index];
+        }
+    }
+    if (count == MAX_SITES)
+    {
+        notProfiledLocks.fetch_add(1u, std::memory_order_relaxed);
+        return nullptr;
+    }
+    sites[count].file = location.file_name();
+    sites[count].line = location.line();
+    siteCount.store(count + 1u, std::memory_order_release);
+    return &sites[count];
+}
+
+void LockProfiler::print(std::ostream &os) const
+{
+    std::vector<const Site*> sorted;
+    const std::size_t count = siteCount.load(std::memory_order_acquire);
+    for (std::size_t index = 0u; index < count; ++index)
+    {
+        sorted.push_back(&sites[index]);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Site* lhs, const Site* rhs)
+    {
+        return lhs->hold.sum() > rhs->hold.sum();
+    });
+
+    const auto flags = os.flags();
+    os << "Lock profiler " << (isEnabled() ? "on" : "off") << "\n"
+       << std::left << std::setw(32) << "site" << std::right
+       << std::setw(10) << "locks"
+       << std::setw(30) << "wait p50/p99/max [us]"
+       << std::setw(30) << "hold p50/p99/max [us]"
+       << std::setw(14) << "held [ms]" << "\n"
+       << std::fixed << std::setprecision(1);
+    auto percentiles = [](const common::Histogram& histogram)
+    {
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(1)
+             << toMicroseconds(histogram.percentile(0.5)) << "/"
+             << toMicroseconds(histogram.percentile(0.99)) << "/"
+             << toMicroseconds(histogram.percentile(1.0));
+        return text.str();
+    };
+    for (const Site* site : sorted)
+    {
+        const std::string name = std::string(baseName(site->file)) + ":" + std::to_string(site->line);
+        os << std::left << std::setw(32) << name << std::right
+           << std::setw(10) << site->hold.count()
+           << std::setw(30) << percentiles(site->wait)
+           << std::setw(30) << percentiles(site->hold)
+           << std::setw(14) << toMicroseconds(site->hold.sum()) / 1000.0 << "\n";
+    }
+    if (const auto notProfiled = notProfiledLocks.load(std::memory_order_relaxed))
+    {
+        os << "locks not profiled - more than " << MAX_SITES << " sites: " << notProfiled << "\n";
+    }
+    os.flags(flags);
+}
+
+}
@@ -1,13 +1,115 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <memory>
+#include <ostream>
+#include <source_location>
+#include "Metrics/Metrics.hpp"
+#include "Trace/Probes.hpp"
 
 namespace bts
 {
 
 using SyncGuard = std::recursive_mutex;
 using SyncGuardPtr = std::shared_ptr<SyncGuard>;
-using SyncLock = std::lock_guard<SyncGuard>;
+
+/**
+ * Wait and hold time histograms of SyncLock per call site (file:line).
+ * Off by default - then SyncLock pays one relaxed load; build with -DSTH_NO_LOCK_PROFILER to remove even that.
+ */
+class LockProfiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    // ~8kB each - twice the SyncLock sites BTS has, locks of sites beyond are counted as not profiled
+    static constexpr std::size_t MAX_SITES = 64u;
+
+    struct Site
+    {
+        const char* file = nullptr;
+        std::uint32_t line = 0u;
+        common::Histogram wait; // ns
+        common::Histogram hold; // ns
+    };
+
+    static LockProfiler& instance();
+
+    void setEnabled(bool value) noexcept { enabled.store(value, std::memory_order_relaxed); }
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @return nullptr when profiling is off or there is no room for a new site
+     */
+    static Site* siteIfEnabled(const std::source_location& location) noexcept
+    {
+#ifdef STH_NO_LOCK_PROFILER
+        return nullptr;
+#else
+        LockProfiler& profiler = instance();
+        return profiler.isEnabled() ? profiler.site(location) : nullptr;
+#endif
+    }
+
+    /**
+     * Sites sorted by total hold time, and count of locks not profiled for lack of room for their sites
+     */
+    void print(std::ostream& os) const;
+
+private:
+    Site* site(const std::source_location& location) noexcept;
+
+    std::atomic<bool> enabled{false};
+    std::mutex addSiteMutex;
+    // sites [0, siteCount) are complete - new ones are added under the mutex and published by the count
+    std::atomic<std::size_t> siteCount{0u};
+    std::array<Site, MAX_SITES> sites;
+    std::atomic<std::uint64_t> notProfiledLocks{0u};
+};
+
+/**
+ * Scoped lock of SyncGuard - with sync_wait/sync_acquired/sync_release tracepoints and optional LockProfiler statistics
+ */
+class SyncLock
+{
+public:
+    explicit SyncLock(SyncGuard& guard, std::source_location location = std::source_location::current())
+        : guard(guard),
+          site(LockProfiler::siteIfEnabled(location))
+    {
+        STH_PROBE(sync_wait, common::probeId(&guard));
+        const auto requestedAt = site ? LockProfiler::Clock::now() : LockProfiler::Clock::time_point{};
+        guard.lock();
+        STH_PROBE(sync_acquired, common::probeId(&guard));
+        if (site)
+        {
+            acquiredAt = LockProfiler::Clock::now();
+            site->wait.record(nanoseconds(acquiredAt - requestedAt));
+        }
+    }
+    ~SyncLock()
+    {
+        STH_PROBE(sync_release, common::probeId(&guard));
+        if (site)
+        {
+            site->hold.record(nanoseconds(LockProfiler::Clock::now() - acquiredAt));
+        }
+        guard.unlock();
+    }
+    SyncLock(const SyncLock&) = delete;
+    SyncLock& operator=(const SyncLock&) = delete;
+
+private:
+    static std::uint64_t nanoseconds(LockProfiler::Clock::duration duration) noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    }
+
+    SyncGuard& guard;
+    LockProfiler::Site* site;
+    LockProfiler::Clock::time_point acquiredAt;
+};
 
 }
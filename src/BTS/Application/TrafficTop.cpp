@@ -0,0 +1,92 @@
+#include "TrafficTop.hpp"
+
+namespace bts
+{
+
+namespace
+{
+
+struct RankingDescription
+{
+    const char* name;
+    const char* title;
+};
+
+constexpr RankingDescription DESCRIPTIONS[TrafficTop::RANKING_COUNT] = {
+    {"sent", "Top senders by messages"},
+    {"sent_bytes", "Top senders by bytes"},
+    {"received", "Top receivers by messages"},
+    {"received_bytes", "Top receivers by bytes"},
+    {"unknown", "Top senders to unknown recipients"}
+};
+
+}
+
+constexpr std::chrono::seconds TrafficTop::DEFAULT_WINDOW;
+
+TrafficTop::TrafficTop(Clock::duration window, std::size_t capacity)
+    : rankings{common::SlidingTopK(window, WINDOW_COUNT, capacity),
+               common::SlidingTopK(window, WINDOW_COUNT, capacity),
+               common::SlidingTopK(window, WINDOW_COUNT, capacity),
+               common::SlidingTopK(window, WINDOW_COUNT, capacity),
+               common::SlidingTopK(window, WINDOW_COUNT, capacity)}
+{}
+
+void TrafficTop::forwarded(PhoneNumber from, PhoneNumber to, std::size_t size, Clock::time_point now) noexcept
+{
+    ranked(Ranking::SentMessages).add(from.value, 1u, now);
+    ranked(Ranking::SentBytes).add(from.value, size, now);
+    ranked(Ranking::ReceivedMessages).add(to.value, 1u, now);
+    ranked(Ranking::ReceivedBytes).add(to.value, size, now);
+}
+
+void TrafficTop::unknownRecipient(PhoneNumber from, Clock::time_point now) noexcept
+{
+    ranked(Ranking::UnknownRecipient).add(from.value, 1u, now);
+}
+
+std::vector<common::SlidingTopK::Entry> TrafficTop::top(Ranking ranking, std::size_t k, Clock::time_point now) const
+{
+    return rankings[std::size_t(ranking)].top(k, now);
+}
+
+void TrafficTop::print(std::ostream &os, Ranking ranking, std::size_t k, Clock::time_point now) const
+{
+    const auto& ranked = rankings[std::size_t(ranking)];
+    os << DESCRIPTIONS[std::size_t(ranking)].title << " (last "
+       << std::chrono::duration_cast<std::chrono::seconds>(ranked.window()).count() << "s):\n";
+    std::size_t position = 0u;
+    for (const auto& entry : ranked.top(k, now))
+    {
+        os << "\t#" << ++position << ": "
+           << PhoneNumber{static_cast<PhoneNumber::Value>(entry.key)} << ": " << entry.count;
+        if (entry.error != 0u)
+        {
+            os << " (overestimated by up to " << entry.error << ")";
+        }
+        os << "\n";
+    }
+}
+
+void TrafficTop::print(std::ostream &os, std::size_t k, Clock::time_point now) const
+{
+    for (std::size_t ranking = 0u; ranking < RANKING_COUNT; ++ranking)
+    {
+        print(os, Ranking(ranking), k, now);
+    }
+}
+
+bool TrafficTop::rankingFromString(const std::string &name, Ranking &ranking)
+{
+    for (std::size_t index = 0u; index < RANKING_COUNT; ++index)
+    {
+        if (name == DESCRIPTIONS[index].name)
+        {
+            ranking = Ranking(index);
+            return true;
+        }
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include "Messages/PhoneNumber.hpp"
+#include "Metrics/SpaceSaving.hpp"
+
+namespace bts
+{
+
+using common::PhoneNumber;
+
+/**
+ * Heaviest UEs over the last window - senders and receivers of forwarded messages and senders to unknown recipients.
+ * Guarded by SyncGuard, like the relay it watches.
+ */
+class TrafficTop
+{
+public:
+    using Clock = common::SlidingTopK::Clock;
+
+    enum class Ranking
+    {
+        SentMessages,
+        SentBytes,
+        ReceivedMessages,
+        ReceivedBytes,
+        UnknownRecipient
+    };
+    static constexpr std::size_t RANKING_COUNT = 5u;
+
+    static constexpr std::chrono::seconds DEFAULT_WINDOW{60};
+    static constexpr std::size_t WINDOW_COUNT = 6u;
+    // per sub-window - UEs beyond it are tracked only when heavier than the lightest tracked one
+    static constexpr std::size_t DEFAULT_CAPACITY = 32u;
+    static constexpr std::size_t DEFAULT_TOP = 5u;
+
+    explicit TrafficTop(Clock::duration window = DEFAULT_WINDOW, std::size_t capacity = DEFAULT_CAPACITY);
+
+    void forwarded(PhoneNumber from, PhoneNumber to, std::size_t size, Clock::time_point now) noexcept;
+    void unknownRecipient(PhoneNumber from, Clock::time_point now) noexcept;
+
+    std::vector<common::SlidingTopK::Entry> top(Ranking ranking, std::size_t k, Clock::time_point now) const;
+    void print(std::ostream& os, Ranking ranking, std::size_t k, Clock::time_point now) const;
+    void print(std::ostream& os, std::size_t k, Clock::time_point now) const;
+
+    /**
+     * @return false for unknown name - names as printed: sent, sent_bytes, received, received_bytes, unknown
+     */
+    static bool rankingFromString(const std::string& name, Ranking& ranking);
+
+private:
+    common::SlidingTopK& ranked(Ranking ranking) { return rankings[std::size_t(ranking)]; }
+
+    std::array<common::SlidingTopK, RANKING_COUNT> rankings;
+};
+
+using TrafficTopPtr = std::shared_ptr<TrafficTop>;
+
+}
@@ -25,9 +25,22 @@ public:
     virtual void start(UeSlot ueSlot) = 0;
     virtual void sendMessage(BinaryMessage message) = 0;
     virtual void sendSib(BtsId btsId) = 0;
+    /**
+     * Liveness probe - UE answers with EchoReply, its round trip time is recorded by the connection
+     */
+    virtual void sendEcho() = 0;
     virtual PhoneNumber getPhoneNumber() const = 0;
     virtual bool isAttached() const = 0;
+    /**
+     * Frames received from UE so far - activity seen by comparing two readings
+     */
+    virtual std::uint64_t framesReceived() const = 0;
+    /**
+     * Drops the connection - it leaves the relay when the transport reports disconnection
+     */
+    virtual void close() = 0;
     virtual void print(std::ostream&) const = 0;
+    virtual void printRoundTrip(std::ostream&) const = 0;
 };
 
 inline std::ostream& operator << (std::ostream& os, IUeConnection const& ue)
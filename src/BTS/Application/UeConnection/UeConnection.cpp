@@ -1,17 +1,40 @@
 #include "UeConnection.hpp"
 #include "Messages/IncomingMessage.hpp"
 #include "Messages/OutgoingMessage.hpp"
+#include "Trace/FlightRecorder.hpp"
+#include "Trace/FrameTracer.hpp"
+#include "Trace/Probes.hpp"
+#include <iomanip>
 
 namespace bts
 {
 
-using namespace std::placeholders;
 using common::MessageId;
 
-UeConnection::UeConnection(ITransportPtr transport, common::ILogger &logger, SyncGuardPtr syncGuard)
+namespace
+{
+
+std::uint64_t toNanoseconds(RelayMetrics::Clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+double toMilliseconds(std::uint64_t nanoseconds)
+{
+    return double(nanoseconds) / 1e6;
+}
+
+}
+
+UeConnection::UeConnection(ITransportPtr transport, common::ILogger &logger, SyncGuardPtr syncGuard,
+                           RelayMetricsPtr metrics, TrafficTopPtr trafficTop, ConnectionReaperPtr reaper)
     : syncGuard(syncGuard),
       transport(transport),
-      logger(logger, std::bind(&UeConnection::printPrefix, this, _1))
+      // lambda capturing only this fits in std::function without heap allocation, std::bind of member does not
+      logger(logger, [this](std::ostream& os) { printPrefix(os); }),
+      metrics(metrics),
+      trafficTop(trafficTop),
+      reaper(reaper)
 {
 }
 
@@ -23,12 +46,18 @@ UeConnection::~UeConnection()
 void UeConnection::start(UeSlot ueSlot)
 {
     this->ueSlot = ueSlot;
-    transport->registerDisconnectedCallback(std::bind(&UeConnection::onUeDisconnectedCallback, this));
-    transport->registerMessageCallback(std::bind(&UeConnection::onUeMessageCallback, this, _1));
+    reaperWatch = reaper->watch(*this);
+    transport->registerDisconnectedCallback([this] { onUeDisconnectedCallback(); });
+    transport->registerMessageCallback([this](BinaryMessage message) { onUeMessageCallback(std::move(message)); });
 }
 
 void UeConnection::stop()
 {
+    if (reaperWatch)
+    {
+        reaper->forget(*reaperWatch);
+        reaperWatch.reset();
+    }
     transport->registerMessageCallback(nullptr);
     transport->registerDisconnectedCallback(nullptr);
 }
@@ -45,6 +74,24 @@ void UeConnection::sendSib(BtsId btsId)
     common::OutgoingMessage messageBuilder(MessageId::Sib, PhoneNumber{}, PhoneNumber{});
     messageBuilder.writeBtsId(btsId);
     sendMessage(messageBuilder.getMessage());
+    if (not sibSentAt)
+    {
+        sibSentAt = RelayMetrics::Clock::now();
+        if (reaperWatch)
+        {
+            reaper->sibSent(*reaperWatch);
+        }
+    }
+}
+
+void UeConnection::sendEcho()
+{
+    // UE echoes the payload back - no need to remember what is in flight
+    common::OutgoingMessage messageBuilder(MessageId::Echo, PhoneNumber{}, getPhoneNumber());
+    messageBuilder.writeNumber(++echoSequence);
+    messageBuilder.writeNumber(toNanoseconds(RelayMetrics::Clock::now().time_since_epoch()));
+    sendMessage(messageBuilder.getMessage());
+    metrics->echoRequests.add();
 }
 
 PhoneNumber UeConnection::getPhoneNumber() const
@@ -54,11 +101,15 @@ PhoneNumber UeConnection::getPhoneNumber() const
 
 void UeConnection::sendMessage(BinaryMessage messageToSend)
 {
+    common::FlightRecorder::instance().recordFrameSent(messageToSend);
+    STH_PROBE_FRAME(frame_sent, static_cast<IUeConnection*>(this), messageToSend);
+    metrics->frameSent(messageToSend);
     transport->sendMessage(std::move(messageToSend));
 }
 
 void UeConnection::sendUnknownRecipient(const MessageHeader &messageHeader)
 {
+    metrics->unknownRecipient.add();
     common::OutgoingMessage messageBuilder(MessageId::UnknownRecipient, PhoneNumber{}, getPhoneNumber());
     messageBuilder.writeMessageHeader(messageHeader);
     sendMessage(messageBuilder.getMessage());
@@ -66,6 +117,7 @@ void UeConnection::sendUnknownRecipient(const MessageHeader &messageHeader)
 
 void UeConnection::sendUnknownSender(const MessageHeader &messageHeader)
 {
+    metrics->unknownSender.add();
     common::OutgoingMessage messageBuilder(MessageId::UnknownSender, PhoneNumber{}, getPhoneNumber());
     messageBuilder.writeMessageHeader(messageHeader);
     sendMessage(messageBuilder.getMessage());
@@ -87,10 +139,22 @@ bool UeConnection::isAttached() const
     return ueSlot.isAttached();
 }
 
-void UeConnection::onUeMessageCallbackBody(BinaryMessage message)
+std::uint64_t UeConnection::framesReceived() const
+{
+    return receivedFrames;
+}
+
+void UeConnection::close()
+{
+    logger.logDebug("Closing");
+    transport->close();
+}
+
+void UeConnection::onUeMessageCallbackBody(BinaryMessage message, RelayMetrics::Clock::time_point receivedAt)
 {
     common::IncomingMessage incomingMessage(message);
     MessageHeader messageHeader = incomingMessage.readMessageHeader();
+    common::FrameTracer::mark(common::FrameTracer::Stage::Decoded);
 
     if (messageHeader.messageId == MessageId::AttachRequest)
     {
@@ -100,32 +164,52 @@ void UeConnection::onUeMessageCallbackBody(BinaryMessage message)
     {
         if (not isAttached() or getPhoneNumber() != messageHeader.from)
         {
-            logger.logError("Not ready for: ", messageHeader);
+            static common::LogLimit logLimit = common::LogLimit::rateLimited();
+            logger.logError(logLimit, "Not ready for: ", messageHeader);
             sendUnknownSender(messageHeader);
         }
-        else if (not forwardMessage(std::move(message), messageHeader.to))
+        else if (messageHeader.messageId == MessageId::EchoReply)
         {
-            logger.logError("Cannot forward: ", messageHeader);
+            onEchoReply(incomingMessage);
+        }
+        else if (const std::size_t size = message.value.size();
+                 not forwardMessage(std::move(message), messageHeader.to))
+        {
+            static common::LogLimit logLimit = common::LogLimit::rateLimited();
+            logger.logError(logLimit, "Cannot forward: ", messageHeader);
+            trafficTop->unknownRecipient(messageHeader.from, receivedAt);
             sendUnknownRecipient(messageHeader);
         }
         else
         {
-            logger.logDebug("Forwarded: ", messageHeader);
+            metrics->forwarded(receivedAt);
+            trafficTop->forwarded(messageHeader.from, messageHeader.to, size, receivedAt);
+            static common::LogLimit logLimit = common::LogLimit::sampled(FORWARD_LOG_SAMPLING);
+            logger.logDebug(logLimit, "Forwarded: ", messageHeader);
         }
     }
 }
 
 void UeConnection::onUeMessageCallback(BinaryMessage message)
 {
+    // forward latency includes waiting for the lock
+    const auto receivedAt = RelayMetrics::Clock::now();
+    common::FlightRecorder::instance().recordFrameReceived(message);
+    STH_PROBE_FRAME(frame_received, static_cast<IUeConnection*>(this), message);
+    metrics->frameReceived(message);
     SyncLock lock(*syncGuard);
+    ++receivedFrames;
+    common::FrameTracer::mark(common::FrameTracer::Stage::Locked);
     try
     {
-        onUeMessageCallbackBody(message);
+        onUeMessageCallbackBody(std::move(message), receivedAt);
     }
     catch (std::exception& ex)
     {
-        logger.logError("Ue message handling error: ", ex.what());
+        static common::LogLimit logLimit = common::LogLimit::rateLimited();
+        logger.logError(logLimit, "Ue message handling error: ", ex.what());
     }
+    common::FrameTracer::mark(common::FrameTracer::Stage::Handled);
 }
 
 void UeConnection::onAttachRequest(PhoneNumber phoneNumber)
@@ -161,9 +245,33 @@ void UeConnection::onAttachRequest(PhoneNumber phoneNumber)
     }
 
     logger.logInfo("Attached");
+    if (sibSentAt)
+    {
+        metrics->attached(*sibSentAt);
+        sibSentAt.reset();
+    }
     sendAttachResponse(true, phoneNumber);
 }
 
+void UeConnection::onEchoReply(common::IncomingMessage &reply)
+{
+    reply.readNumber<std::uint32_t>();
+    const auto sentAt = RelayMetrics::Clock::time_point(std::chrono::nanoseconds(reply.readNumber<std::uint64_t>()));
+    const auto now = RelayMetrics::Clock::now();
+    if (sentAt > now)
+    {
+        static common::LogLimit logLimit = common::LogLimit::rateLimited();
+        logger.logError(logLimit, "Echo reply from the future - ignored");
+        return;
+    }
+    ++echoReplies;
+    const auto sample = now - sentAt;
+    smoothedRoundTrip = lastRoundTrip ? smoothedRoundTrip + (sample - smoothedRoundTrip) / 8 : sample;
+    maxRoundTrip = std::max(maxRoundTrip, sample);
+    lastRoundTrip = sample;
+    metrics->echoReplied(sample);
+}
+
 bool UeConnection::forwardMessage(BinaryMessage message, PhoneNumber to)
 {
     return ueSlot.sendMessage(std::move(message), to);
@@ -196,4 +304,19 @@ void UeConnection::print(std::ostream &os) const
        << ":" << (isAttached() ? "A" : "I");
 }
 
+void UeConnection::printRoundTrip(std::ostream &os) const
+{
+    const auto flags = os.flags();
+    os << std::fixed << std::setprecision(3)
+       << *this << " echo sent: " << echoSequence << ", replies: " << echoReplies;
+    if (lastRoundTrip)
+    {
+        os << ", rtt [ms] last: " << toMilliseconds(toNanoseconds(*lastRoundTrip))
+           << " smoothed: " << toMilliseconds(toNanoseconds(smoothedRoundTrip))
+           << " max: " << toMilliseconds(toNanoseconds(maxRoundTrip));
+    }
+    os << "\n";
+    os.flags(flags);
+}
+
 }
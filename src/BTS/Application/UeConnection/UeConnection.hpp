@@ -5,34 +5,49 @@
 #include "UeRelay/IUeRelay.hpp"
 #include "Synchronization.hpp"
 #include "Logger/ILogger.hpp"
+#include "RelayMetrics.hpp"
+#include "TrafficTop.hpp"
+#include "ConnectionReaper.hpp"
 
 #include "Messages/MessageHeader.hpp"
 #include "Messages/IncomingMessage.hpp"
 #include "Logger/PrefixedLogger.hpp"
+#include "Memory/SlabPool.hpp"
+#include <optional>
 
 namespace bts
 {
 using common::MessageHeader;
 
-class UeConnection : public IUeConnection
+// one per connected UE, most of them idle - allocated from own slab pool, kept small
+class UeConnection : public IUeConnection, public common::SlabAllocated<UeConnection>
 {
 public:
-    UeConnection(ITransportPtr transport, common::ILogger& logger, SyncGuardPtr syncGuard);
+    // only every Nth forwarded message is logged - forwarding shall not format log lines
+    static constexpr std::uint32_t FORWARD_LOG_SAMPLING = 16u;
+
+    UeConnection(ITransportPtr transport, common::ILogger& logger, SyncGuardPtr syncGuard, RelayMetricsPtr metrics,
+                 TrafficTopPtr trafficTop, ConnectionReaperPtr reaper);
     ~UeConnection() override;
 
     void start(UeSlot ueSlot) override;
 
     void sendMessage(BinaryMessage message) override;
     void sendSib(BtsId btsId) override;
+    void sendEcho() override;
     PhoneNumber getPhoneNumber() const override;
     bool isAttached() const override;
+    std::uint64_t framesReceived() const override;
+    void close() override;
 
     void print(std::ostream& os) const override;
+    void printRoundTrip(std::ostream& os) const override;
 private:
 
     void onUeMessageCallback(BinaryMessage message);
-    void onUeMessageCallbackBody(BinaryMessage message);
+    void onUeMessageCallbackBody(BinaryMessage message, RelayMetrics::Clock::time_point receivedAt);
     void onAttachRequest(PhoneNumber phoneNumber);
+    void onEchoReply(common::IncomingMessage& reply);
     bool forwardMessage(BinaryMessage message, PhoneNumber to);
 
     void onUeDisconnectedCallback();
@@ -51,6 +66,20 @@ private:
     UeSlot ueSlot;
     common::PrefixedLogger logger;
     ITransportPtr transport;
+    RelayMetricsPtr metrics;
+    TrafficTopPtr trafficTop;
+    ConnectionReaperPtr reaper;
+    std::optional<ConnectionReaper::WatchId> reaperWatch;
+    // counted under SyncLock
+    std::uint64_t receivedFrames = 0u;
+    // first SIB not answered yet - start of attach latency
+    std::optional<RelayMetrics::Clock::time_point> sibSentAt;
+    std::uint32_t echoSequence = 0u;
+    std::uint32_t echoReplies = 0u;
+    std::optional<RelayMetrics::Clock::duration> lastRoundTrip;
+    // smoothed as TCP does it - percentiles over all UEs are in RelayMetrics
+    RelayMetrics::Clock::duration smoothedRoundTrip{};
+    RelayMetrics::Clock::duration maxRoundTrip{};
 };
 
 }
@@ -5,14 +5,19 @@
 namespace bts
 {
 
-UeConnectionFactory::UeConnectionFactory(common::ILogger &logger, std::shared_ptr<SyncGuard> syncGuard)
+UeConnectionFactory::UeConnectionFactory(common::ILogger &logger, std::shared_ptr<SyncGuard> syncGuard,
+                                         RelayMetricsPtr metrics, TrafficTopPtr trafficTop,
+                                         ConnectionReaperPtr reaper)
     : logger(logger),
-      syncGuard(syncGuard)
+      syncGuard(syncGuard),
+      metrics(metrics),
+      trafficTop(trafficTop),
+      reaper(reaper)
 {}
 
 IUeRelay::UePtr UeConnectionFactory::createConnection(ITransportPtr transport)
 {
-    return std::make_unique<UeConnection>(transport, logger, syncGuard);
+    return std::make_unique<UeConnection>(transport, logger, syncGuard, metrics, trafficTop, reaper);
 }
 
 }
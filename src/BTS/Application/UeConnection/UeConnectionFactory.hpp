@@ -3,6 +3,9 @@
 #include "IUeConnectionFactory.hpp"
 #include "Logger/ILogger.hpp"
 #include "Synchronization.hpp"
+#include "RelayMetrics.hpp"
+#include "TrafficTop.hpp"
+#include "ConnectionReaper.hpp"
 
 namespace bts
 {
@@ -11,7 +14,10 @@ class UeConnectionFactory : public IUeConnectionFactory
 {
 public:
     UeConnectionFactory(common::ILogger& logger,
-                        std::shared_ptr<SyncGuard> syncGuard);
+                        std::shared_ptr<SyncGuard> syncGuard,
+                        RelayMetricsPtr metrics,
+                        TrafficTopPtr trafficTop,
+                        ConnectionReaperPtr reaper);
 
     IUeRelay::UePtr createConnection(ITransportPtr transport) override;
 
@@ -19,6 +25,9 @@ private:
     std::shared_ptr<IUeRelay> ueRelay;
     common::ILogger& logger;
     std::shared_ptr<SyncGuard> syncGuard;
+    RelayMetricsPtr metrics;
+    TrafficTopPtr trafficTop;
+    ConnectionReaperPtr reaper;
 };
 
 }
@@ -1,4 +1,8 @@
 #include "UeRelay.hpp"
+#include "Trace/FlightRecorder.hpp"
+#include "Trace/FrameTracer.hpp"
+#include "Trace/Probes.hpp"
+#include "Memory/MemoryTag.hpp"
 
 namespace bts
 {
@@ -44,6 +48,17 @@ private:
     AttachedUe::iterator whereAdded;
 };
 
+namespace
+{
+
+// slot is remade on add and on every attach - its object and shared_ptr control block come from one slab pool
+template <typename Slot, typename ...Arg>
+std::shared_ptr<Slot> makeSlot(Arg&& ...arg)
+{
+    return std::allocate_shared<Slot>(common::SlabAllocator<Slot>{}, std::forward<Arg>(arg)...);
+}
+
+}
 
 UeRelay::UeRelay(common::ILogger &logger)
     : logger(logger, "[RELAY]")
@@ -51,7 +66,8 @@ UeRelay::UeRelay(common::ILogger &logger)
 
 UeSlot UeRelay::add(UePtr ue)
 {
-    return UeSlot(std::make_shared<UeSlotAdded>(*this, std::move(ue)));
+    common::MemoryTagScope memoryTag(common::MemoryTag::UeRelay);
+    return UeSlot(makeSlot<UeSlotAdded>(*this, std::move(ue)));
 }
 
 bool UeRelay::sendMessage(BinaryMessage message, PhoneNumber to)
@@ -59,10 +75,12 @@ bool UeRelay::sendMessage(BinaryMessage message, PhoneNumber to)
     auto ueSlot = attachedUe.find(to);
     if (ueSlot == attachedUe.end())
     {
-        logger.logError("Connection does not exist for: ", to);
+        static common::LogLimit logLimit = common::LogLimit::rateLimited();
+        logger.logError(logLimit, "Connection does not exist for: ", to);
         return false;
     }
-    ueSlot->second->sendMessage(message);
+    common::FrameTracer::mark(common::FrameTracer::Stage::Routed);
+    ueSlot->second->sendMessage(std::move(message));
     return true;
 }
 
@@ -126,13 +144,16 @@ UeRelay::UeSlotAdded::UeSlotAdded(UeRelay &relay, UePtr ue)
 
 UeSlot::IImplPtr UeRelay::UeSlotAdded::attach(PhoneNumber phone)
 {
+    common::MemoryTagScope memoryTag(common::MemoryTag::UeRelay);
     auto result = relay.attachedUe.insert(AttachedUe::value_type(phone, UePtr{}));
     if (result.second)
     {
         result.first->second = std::move(*whereAdded);
         logDebug("Attached: ", *result.first->second);
+        common::FlightRecorder::instance().recordAttach(phone);
+        STH_PROBE(ue_attach, common::probeId(result.first->second.get()), phone.value);
         relay.notAttachedUe.erase(whereAdded);
-        return std::make_shared<UeSlotAttached>(relay, result.first);
+        return makeSlot<UeSlotAttached>(relay, result.first);
     }
 
     logError("While attaching: other connection exists for: ", phone);
@@ -153,6 +174,8 @@ void UeRelay::UeSlotAdded::remove()
 {
     auto ue = std::move(*whereAdded);
     logDebug("Removed not attached: ", *ue);
+    common::FlightRecorder::instance().recordDetach(PhoneNumber{});
+    STH_PROBE(ue_detach, common::probeId(ue.get()), PhoneNumber{}.value);
     relay.notAttachedUe.erase(whereAdded);
     ue.reset();
 }
@@ -170,6 +193,7 @@ UeSlot::IImplPtr UeRelay::UeSlotAttached::attach(PhoneNumber phone)
         return shared_from_this();
     }
 
+    common::MemoryTagScope memoryTag(common::MemoryTag::UeRelay);
     UePtr ue = std::move(whereAdded->second);
     struct EraseOnExit
     {
@@ -190,11 +214,15 @@ UeSlot::IImplPtr UeRelay::UeSlotAttached::attach(PhoneNumber phone)
     {
         result.first->second = std::move(ue);
         logDebug("Attached: ", *result.first->second);
-        return std::make_shared<UeSlotAttached>(relay, result.first);
+        common::FlightRecorder::instance().recordDetach(whereAdded->first);
+        common::FlightRecorder::instance().recordAttach(phone);
+        STH_PROBE(ue_detach, common::probeId(result.first->second.get()), whereAdded->first.value);
+        STH_PROBE(ue_attach, common::probeId(result.first->second.get()), phone.value);
+        return makeSlot<UeSlotAttached>(relay, result.first);
     }
 
     logError("While re-attaching: other connection exists for: ", phone);
-    return std::make_shared<UeSlotAdded>(relay, std::move(ue));
+    return makeSlot<UeSlotAdded>(relay, std::move(ue));
 }
 
 bool UeRelay::UeSlotAttached::isAttached() const
@@ -211,6 +239,8 @@ void UeRelay::UeSlotAttached::remove()
 {
     UePtr ue = std::move(whereAdded->second);
     logDebug("Removed attached: ", *ue);
+    common::FlightRecorder::instance().recordDetach(whereAdded->first);
+    STH_PROBE(ue_detach, common::probeId(ue.get()), whereAdded->first.value);
     relay.attachedUe.erase(whereAdded);
     ue.reset();
 }
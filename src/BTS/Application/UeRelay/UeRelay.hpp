@@ -6,6 +6,7 @@
 #include <tuple>
 #include "IUeRelay.hpp"
 #include "Logger/PrefixedLogger.hpp"
+#include "Memory/SlabPool.hpp"
 
 namespace bts
 {
@@ -33,8 +34,10 @@ private:
 
     // the fact that std::map amd std::list iterators are not invalidated on insert or erase is heavily used in the implementation of this class
     // if you decide to use other containers (like std::unsorted_set) do the appropriate changes in the add/attach/removeUe functions and maybe change the UeSlot definition
-    using AttachedUe = std::map<PhoneNumber, UePtr>;
-    using NotAttachedUe = std::list<UePtr>;
+    // nodes come from slab pools - one node per connection
+    using AttachedUe = std::map<PhoneNumber, UePtr, std::less<PhoneNumber>,
+                                common::SlabAllocator<std::pair<const PhoneNumber, UePtr>>>;
+    using NotAttachedUe = std::list<UePtr, common::SlabAllocator<UePtr>>;
 
 
     AttachedUe attachedUe;
@@ -4,6 +4,7 @@
 #include "IConsole.hpp"
 #include "ITransport.hpp"
 #include "Logger/Logger.hpp"
+#include "Config/ReloadableConfig.hpp"
 
 namespace bts
 {
@@ -21,6 +22,7 @@ public:
     virtual ILogger& getLogger() = 0;
     virtual BtsId getBtsId() const = 0;
     virtual std::string getAddress() const = 0;
+    virtual common::ReloadableConfig& getConfiguration() = 0;
 
     virtual void startMessageLoop() = 0;
 };
@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "UeRelay/UeRelay.hpp"
+#include "UeConnection/UeConnectionFactory.hpp"
+#include "Memory/MemoryAccounting.hpp"
+#include "Time/VirtualClock.hpp"
+#include "Memory/SlabPool.hpp"
+#include "Messages/OutgoingMessage.hpp"
+
+/**
+ * Heap bytes held by BTS per idle connection: transport, UeConnection, its callbacks and its place in UeRelay.
+ * Qt is not linked here - IdleTransport stands in for QtTransport and the QTcpSocket it owns (see below),
+ * so totals including them are estimates; measured_bytes/connection is what this benchmark really measures.
+ * Phone numbers are one byte - at most 254 of the connections are attached, the rest wait for attach.
+ */
+
+namespace bts
+{
+
+namespace
+{
+
+constexpr std::size_t MAX_ATTACHED = 254u;
+
+class NullLogger : public common::ILogger
+{
+public:
+    void log(Level, const std::string&) override {}
+};
+
+// Estimates for Qt 5 on x86-64: QObjectPrivate of QtTransport, and QTcpSocket with its private data,
+// native socket engine and socket notifiers. Read/write buffer chunks are allocated on traffic - not included.
+constexpr std::size_t QOBJECT_PRIVATE_BYTES = 112u;
+constexpr std::size_t QTCPSOCKET_BYTES = 1536u;
+
+// same layout as QtTransport: QObject (vptr, d_ptr), logger, socket, callbacks - made as QtTransportEnvironment does
+class IdleTransport : public ITransport
+{
+public:
+    explicit IdleTransport(common::ILogger& logger)
+        : objectPrivate(std::make_unique<std::byte[]>(QOBJECT_PRIVATE_BYTES)),
+          logger(logger),
+          socket(std::make_unique<std::byte[]>(QTCPSOCKET_BYTES))
+    {}
+
+    void registerMessageCallback(MessageCallback callback) override { messageCallback = std::move(callback); }
+    void registerDisconnectedCallback(DisconnectedCallback callback) override { disconnectedCallback = std::move(callback); }
+    bool sendMessage(BinaryMessage) override { return true; }
+    void close() override {}
+    std::string addressToString() const override { return "idle"; }
+
+    MessageCallback messageCallback;
+    DisconnectedCallback disconnectedCallback;
+
+private:
+    void* objectVptr = nullptr;
+    std::unique_ptr<std::byte[]> objectPrivate;
+    common::ILogger& logger;
+    std::unique_ptr<std::byte[]> socket;
+};
+
+std::shared_ptr<IdleTransport> acceptConnection(common::ILogger& logger)
+{
+    common::MemoryTagScope memoryTag(common::MemoryTag::Transport);
+    return std::allocate_shared<IdleTransport>(common::SlabAllocator<IdleTransport>{}, logger);
+}
+
+// live bytes less memory kept free in slab pools - what connections really hold
+std::int64_t bytesInUse()
+{
+    const auto snapshot = common::MemoryAccounting::snapshot();
+    const auto live = std::accumulate(snapshot.begin(), snapshot.end(), std::uint64_t{0u},
+                                      [](std::uint64_t sum, const auto& usage) { return sum + usage.liveBytes; });
+    return std::int64_t(live) - std::int64_t(common::SlabPool::freeBytes());
+}
+
+}
+
+// connections accepted as QtTransportEnvironment and spawned as UeConnectionSpawner does it:
+// transport, create, add to relay, start, SIB
+void BM_UeConnection_idleFootprint(benchmark::State& state)
+{
+    const std::size_t count = state.range(0);
+    NullLogger logger;
+    auto syncGuard = std::make_shared<SyncGuard>();
+    common::MetricsRegistry registry;
+    auto metrics = std::make_shared<RelayMetrics>(registry);
+    auto reaper = std::make_shared<ConnectionReaper>(syncGuard, std::make_shared<common::VirtualClock>(), metrics, logger);
+    auto factory = std::make_shared<UeConnectionFactory>(logger, syncGuard, metrics, std::make_shared<TrafficTop>(), reaper);
+    std::vector<std::shared_ptr<IdleTransport>> transports;
+    transports.reserve(count);
+
+    std::int64_t bytes = 0;
+    std::int64_t transportBytes = 0;
+    for (auto _ : state)
+    {
+        auto relay = std::make_shared<UeRelay>(logger);
+        const auto before = bytesInUse();
+        for (std::size_t i = 0u; i < count; ++i)
+        {
+            transports.push_back(acceptConnection(logger));
+        }
+        transportBytes = bytesInUse() - before;
+        for (std::size_t i = 0u; i < count; ++i)
+        {
+            auto ue = factory->createConnection(transports[i]);
+            auto* connection = ue.get();
+            connection->start(relay->add(std::move(ue)));
+            connection->sendSib(BtsId{1});
+            if (i < MAX_ATTACHED)
+            {
+                const PhoneNumber phone{static_cast<PhoneNumber::Value>(i + 1u)};
+                transports[i]->messageCallback(
+                        common::OutgoingMessage(common::MessageId::AttachRequest, phone, PhoneNumber{}).getMessage());
+            }
+        }
+        bytes = bytesInUse() - before;
+
+        state.PauseTiming();
+        for (auto& transport : transports)
+        {
+            // UE disconnects - connection removes itself from relay
+            transport->disconnectedCallback();
+        }
+        transports.clear();
+        state.ResumeTiming();
+    }
+    // stand-in blocks of Qt are sizes given above, not measured - reported apart, never as a measured footprint
+    constexpr double QT_ESTIMATE = double(QOBJECT_PRIVATE_BYTES + QTCPSOCKET_BYTES);
+    state.counters["measured_bytes/connection"] = double(bytes) / double(count) - QT_ESTIMATE;
+    state.counters["qt_estimate_bytes/connection"] = QT_ESTIMATE;
+    state.counters["bytes/connection (estimated, Qt stubbed)"] = double(bytes) / double(count);
+    state.counters["transport_bytes/connection (estimated, Qt stubbed)"] = double(transportBytes) / double(count);
+    state.counters["slab_free_kB"] = double(common::SlabPool::freeBytes()) / 1024.0;
+}
+BENCHMARK(BM_UeConnection_idleFootprint)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+}
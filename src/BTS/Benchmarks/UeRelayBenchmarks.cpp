@@ -0,0 +1,225 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "UeRelay/UeRelay.hpp"
+#include "SibMolester.hpp"
+#include "AllocationCounter/AllocationCounter.hpp"
+#include "Messages/OutgoingMessage.hpp"
+#include "Time/VirtualClock.hpp"
+
+/**
+ * UeRelay and SIB selection cost vs number of connections, with allocations per operation.
+ * Phone numbers are one byte - at most 255 UE can be attached, not attached UE are not limited.
+ * JSON: BTS_BENCH --benchmark_out=relay.json --benchmark_out_format=json
+ */
+
+namespace bts
+{
+
+namespace
+{
+
+constexpr std::size_t MAX_ATTACHED = 254u; // 1..254, 255 is left for churn
+
+class NullLogger : public common::ILogger
+{
+public:
+    void log(Level, const std::string&) override {}
+};
+
+class FakeUeConnection : public IUeConnection
+{
+public:
+    void start(UeSlot newSlot) override { slot = std::move(newSlot); }
+    void sendMessage(BinaryMessage message) override { benchmark::DoNotOptimize(message); ++sent; }
+    void sendSib(BtsId) override { ++sibs; }
+    void sendEcho() override {}
+    PhoneNumber getPhoneNumber() const override { return slot.getPhoneNumber(); }
+    bool isAttached() const override { return slot.isAttached(); }
+    void print(std::ostream& os) const override { os << "fake"; }
+    void printRoundTrip(std::ostream&) const override {}
+    std::uint64_t framesReceived() const override { return 0u; }
+    void close() override {}
+
+    UeSlot slot;
+    std::size_t sent = 0u;
+    std::size_t sibs = 0u;
+};
+
+class RelayFixture
+{
+public:
+    RelayFixture(std::size_t notAttachedCount, std::size_t attachedCount)
+    {
+        for (std::size_t i = 0u; i < notAttachedCount; ++i)
+        {
+            add();
+        }
+        for (std::size_t i = 1u; i <= std::min(attachedCount, MAX_ATTACHED); ++i)
+        {
+            add().attach(PhoneNumber{static_cast<PhoneNumber::Value>(i)});
+        }
+    }
+    ~RelayFixture()
+    {
+        for (auto* ue : connections)
+        {
+            ue->slot.remove();
+        }
+    }
+
+    UeSlot& add()
+    {
+        auto ue = std::make_unique<FakeUeConnection>();
+        FakeUeConnection& connection = *ue;
+        connection.start(relay->add(std::move(ue)));
+        connections.push_back(&connection);
+        return connection.slot;
+    }
+
+    NullLogger logger;
+    std::shared_ptr<UeRelay> relay = std::make_shared<UeRelay>(logger);
+    std::vector<FakeUeConnection*> connections;
+};
+
+class AllocationsPerOperation
+{
+public:
+    explicit AllocationsPerOperation(benchmark::State& state) : state(state) {}
+    ~AllocationsPerOperation()
+    {
+        state.counters["allocs/op"] = benchmark::Counter(double(counter.count().allocations),
+                                                         benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    benchmark::State& state;
+    const common::ScopedAllocationCounter counter;
+};
+
+BinaryMessage sms(PhoneNumber to)
+{
+    common::OutgoingMessage builder{common::MessageId::Sms, PhoneNumber{1}, to};
+    builder.writeText("benchmark");
+    return builder.getMessage();
+}
+
+// number of not attached UE already in relay
+void relaySizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->RangeMultiplier(8)->Range(16, 1 << 18);
+}
+
+}
+
+// new connection arrives and leaves before attach
+void BM_UeRelay_addRemove(benchmark::State& state)
+{
+    RelayFixture fixture(state.range(0), MAX_ATTACHED);
+    AllocationsPerOperation allocations(state);
+    for (auto _ : state)
+    {
+        auto ue = std::make_unique<FakeUeConnection>();
+        UeSlot slot = fixture.relay->add(std::move(ue));
+        slot.remove();
+    }
+}
+BENCHMARK(BM_UeRelay_addRemove)->Apply(relaySizes);
+
+// attach storm: connect, attach, disconnect
+void BM_UeRelay_addAttachRemove(benchmark::State& state)
+{
+    RelayFixture fixture(state.range(0), MAX_ATTACHED);
+    AllocationsPerOperation allocations(state);
+    for (auto _ : state)
+    {
+        UeSlot slot = fixture.relay->add(std::make_unique<FakeUeConnection>());
+        slot.attach(PhoneNumber{255});
+        slot.remove();
+    }
+}
+BENCHMARK(BM_UeRelay_addAttachRemove)->Apply(relaySizes);
+
+void BM_UeRelay_reattach(benchmark::State& state)
+{
+    RelayFixture fixture(state.range(0), MAX_ATTACHED - 1u);
+    UeSlot& slot = fixture.add();
+    slot.attach(PhoneNumber{254});
+    AllocationsPerOperation allocations(state);
+    for (auto _ : state)
+    {
+        slot.attach(PhoneNumber{255});
+        slot.attach(PhoneNumber{254});
+    }
+}
+BENCHMARK(BM_UeRelay_reattach)->Apply(relaySizes);
+
+// argument: attached count, hit percent
+void BM_UeRelay_sendMessage(benchmark::State& state)
+{
+    const std::size_t attached = state.range(0);
+    const std::size_t hitPercent = state.range(1);
+    RelayFixture fixture(0u, attached);
+    std::vector<BinaryMessage> messages;
+    for (std::size_t i = 0u; i < 100u; ++i)
+    {
+        // hits: 1..attached, misses: above attached
+        const bool hit = i < hitPercent;
+        const std::size_t phone = hit ? 1u + (i * 7u) % attached : attached + 1u + i % (255u - attached);
+        messages.push_back(sms(PhoneNumber{static_cast<PhoneNumber::Value>(phone)}));
+    }
+    std::size_t index = 0u;
+    AllocationsPerOperation allocations(state);
+    for (auto _ : state)
+    {
+        const BinaryMessage& message = messages[index];
+        benchmark::DoNotOptimize(fixture.relay->sendMessage(message, PhoneNumber{message.value[2]}));
+        index = index == messages.size() - 1u ? 0u : index + 1u;
+    }
+}
+BENCHMARK(BM_UeRelay_sendMessage)->ArgsProduct({{16, 128, 254}, {0, 50, 100}});
+
+void BM_UeRelay_visitAttachedUe(benchmark::State& state)
+{
+    RelayFixture fixture(0u, state.range(0));
+    AllocationsPerOperation allocations(state);
+    for (auto _ : state)
+    {
+        std::size_t visited = 0u;
+        fixture.relay->visitAttachedUe([&visited](IUeConnection&) { ++visited; });
+        benchmark::DoNotOptimize(visited);
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_UeRelay_visitAttachedUe)->Arg(16)->Arg(128)->Arg(MAX_ATTACHED);
+
+void BM_UeRelay_visitNotAttachedUe(benchmark::State& state)
+{
+    RelayFixture fixture(state.range(0), 0u);
+    AllocationsPerOperation allocations(state);
+    for (auto _ : state)
+    {
+        std::size_t visited = 0u;
+        fixture.relay->visitNotAttachedUe([&visited](IUeConnection&) { ++visited; });
+        benchmark::DoNotOptimize(visited);
+    }
+    state.SetItemsProcessed(std::int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_UeRelay_visitNotAttachedUe)->Apply(relaySizes);
+
+// one SIB to next not attached UE - round robin over whole list
+void BM_SibMolester_sendSib(benchmark::State& state)
+{
+    RelayFixture fixture(state.range(0), MAX_ATTACHED);
+    SibMolester objectUnderTest(fixture.relay, std::make_shared<SyncGuard>(), std::make_shared<common::VirtualClock>(),
+                                BtsId{1}, fixture.logger);
+    AllocationsPerOperation allocations(state);
+    for (auto _ : state)
+    {
+        objectUnderTest.sendSib();
+    }
+}
+BENCHMARK(BM_SibMolester_sendSib)->Apply(relaySizes);
+
+}
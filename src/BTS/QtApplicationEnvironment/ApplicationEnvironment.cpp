@@ -7,21 +7,44 @@
 #include <iomanip>
 #include <fstream>
 #include <thread>
+#include <csignal>
 #include "Messages.hpp"
+#include "Trace/FlightRecorder.hpp"
+#include "CommonEnvironment/CapturingTransport.hpp"
+#include "Trace/LoopLagMonitor.hpp"
 
 namespace bts
 {
 
 ApplicationEnvironment::ApplicationEnvironment(int& argc, char* argv[])
-    : configuration(ApplicationEnvironment::readConfiguration(argc, argv)),
-      btsId(BtsId{configuration->getNumber("id", generateBtsId().value)}),
+    : commandLineConfiguration(argc - 1, argv + 1),
+      configuration(readConfiguration(commandLineConfiguration)),
+      btsId(BtsId{configuration.get()->getNumber("id", generateBtsId().value)}),
       logFile(logFilename(btsId)),
       logger(logFile),
+      captureWriter(createCaptureWriter(*configuration.get(), logger)),
+      linkImpairment(common::LinkImpairment::fromConfiguration(*configuration.get())),
+      impairmentClock(linkImpairment.isActive() ? std::make_unique<common::SteadyClock>() : nullptr),
       qApplication(argc, argv),
       console(logger),
-      transportEnvironment(logger, *configuration)
+      transportEnvironment(logger, *configuration.get()),
+      configurationWatcher(configurationFilename(commandLineConfiguration), configuration,
+                           [this] { return readConfiguration(commandLineConfiguration); }, logger)
 {
+    configuration.subscribe([this](const common::MultiLineConfig& newConfiguration)
+    {
+        logger.setLevelThreshold(newConfiguration.getNumber("log_level", ILogger::DEBUG_LEVEL));
+        common::LoopLagMonitor::instance().reconfigure(
+            std::chrono::milliseconds(newConfiguration.getNumber<int>("loop_lag_period_ms", 100)),
+            std::chrono::milliseconds(newConfiguration.getNumber<int>("loop_lag_warn_ms", 50)));
+    });
     QObject::connect(&console, SIGNAL(quit()), &qApplication, SLOT(quit()));
+    common::FlightRecorder::installDumpSignalHandler(flightDumpFilename(btsId), SIGUSR1);
+    if (impairmentClock)
+    {
+        logger.logInfo("UE connections impaired - latency: ", linkImpairment.latency.count(), "us, jitter: ",
+                       linkImpairment.jitter.count(), "us, bandwidth: ", linkImpairment.bytesPerSecond, "B/s");
+    }
 }
 
 IConsole &ApplicationEnvironment::getConsole()
@@ -31,6 +54,28 @@ IConsole &ApplicationEnvironment::getConsole()
 
 void ApplicationEnvironment::registerUeConnectedCallback(UeConnectedCallback newCallback)
 {
+    if (captureWriter and newCallback)
+    {
+        newCallback = [captureWriter = captureWriter, newCallback](ITransportPtr transport)
+        {
+            newCallback(std::make_shared<common::CapturingTransport>(std::move(transport), captureWriter));
+        };
+    }
+    // capture records frames as the application sees them - after impairment
+    if (impairmentClock and newCallback)
+    {
+        newCallback = [this, newCallback](ITransportPtr transport)
+        {
+            auto impairment = linkImpairment;
+            impairment.seed += impairedConnectionCount++;
+            // frames delayed on the clock thread are handed to UeConnection on the Qt loop, where it is destroyed
+            newCallback(std::make_shared<common::ImpairedTransport>(std::move(transport), *impairmentClock, impairment,
+                                                                    [this](std::function<void()> handOn)
+            {
+                QMetaObject::invokeMethod(&qApplication, std::move(handOn), Qt::QueuedConnection);
+            }));
+        };
+    }
     transportEnvironment.registerUeConnectedCallback(newCallback);
 }
 
@@ -49,6 +94,11 @@ std::string ApplicationEnvironment::getAddress() const
     return transportEnvironment.getAddress();
 }
 
+common::ReloadableConfig &ApplicationEnvironment::getConfiguration()
+{
+    return configuration;
+}
+
 void ApplicationEnvironment::startMessageLoop()
 {
     std::thread consoleThread([this] {
@@ -58,16 +108,30 @@ void ApplicationEnvironment::startMessageLoop()
     });
     logger.logDebug("Application loop started");
     transportEnvironment.exec();
+    auto& loopLagMonitor = common::LoopLagMonitor::instance();
+    loopLagMonitor.start(loopLagClock, [this](std::function<void()> probe)
+    {
+        QMetaObject::invokeMethod(&qApplication, std::move(probe), Qt::QueuedConnection);
+    }, logger);
+    suppressedLogReporter.start(loopLagClock, logger);
     qApplication.exec();
+    suppressedLogReporter.stop();
+    loopLagMonitor.stop();
     logger.logDebug("Application loop finished");
     consoleThread.join();
 }
 
-std::unique_ptr<common::MultiLineConfig> ApplicationEnvironment::readConfiguration(int argc, char *argv[])
+std::string ApplicationEnvironment::configurationFilename(const common::MultiLineConfig& commandLineConfiguration)
+{
+    return commandLineConfiguration.getString("config", "config");
+}
+
+common::ReloadableConfig::Snapshot ApplicationEnvironment::readConfiguration(const common::MultiLineConfig& commandLineConfiguration)
 {
-    auto commandLineConfig = std::make_unique<common::MultiLineConfig>(argc - 1, argv + 1);
+    // command line values take precedence over file values
+    auto commandLineConfig = std::make_shared<common::MultiLineConfig>(commandLineConfiguration);
 
-    std::string configFile = commandLineConfig->getString("config", "config");
+    std::string configFile = configurationFilename(commandLineConfiguration);
 
     try
     {
@@ -85,6 +149,27 @@ std::unique_ptr<common::MultiLineConfig> ApplicationEnvironment::readConfigurati
     return commandLineConfig;
 }
 
+std::shared_ptr<common::CaptureWriter> ApplicationEnvironment::createCaptureWriter(const common::MultiLineConfig &configuration,
+                                                                                ILogger &logger)
+{
+    std::string captureFile = configuration.getString("capture", "");
+    if (captureFile.empty())
+    {
+        return nullptr;
+    }
+    try
+    {
+        auto writer = std::make_shared<common::CaptureWriter>(captureFile);
+        logger.logInfo("Capturing frames to: ", captureFile);
+        return writer;
+    }
+    catch (std::exception& ex)
+    {
+        logger.logError("Capture disabled: ", ex.what());
+        return nullptr;
+    }
+}
+
 BtsId ApplicationEnvironment::generateBtsId()
 {
     std::srand(time(0));
@@ -103,4 +188,11 @@ std::string ApplicationEnvironment::logFilename(BtsId btsId)
     return os.str();
 }
 
+std::string ApplicationEnvironment::flightDumpFilename(BtsId btsId)
+{
+    std::ostringstream os;
+    os << "bts" << btsId << "_flight.txt";
+    return os.str();
+}
+
 }
@@ -4,7 +4,13 @@
 #include <QCoreApplication>
 #include "Console/TextConsole.hpp"
 #include "Logger/Logger.hpp"
+#include "Logger/SuppressedLogReporter.hpp"
 #include "Config/MultiLineConfig.hpp"
+#include "Config/ReloadableConfig.hpp"
+#include "Config/ConfigFileWatcher.hpp"
+#include "Trace/CaptureFile.hpp"
+#include "CommonEnvironment/ImpairedTransport.hpp"
+#include "Time/SteadyClock.hpp"
 #include "Transport/QtTransportEnvironment.hpp"
 #include <fstream>
 
@@ -20,23 +26,40 @@ public:
     ILogger& getLogger() override;
     BtsId getBtsId() const override;
     std::string getAddress() const override;
+    common::ReloadableConfig& getConfiguration() override;
 
 
     void startMessageLoop() override;
 
 private:
-    std::unique_ptr<common::MultiLineConfig> configuration;
+    common::MultiLineConfig commandLineConfiguration;
+    common::ReloadableConfig configuration;
     BtsId btsId;
     std::ofstream logFile;
     common::Logger logger;
+    // null when capture is off
+    std::shared_ptr<common::CaptureWriter> captureWriter;
+    // net_* configuration keys - every UE connection gets this impairment, for tests on a single machine
+    common::LinkImpairment linkImpairment;
+    // null when impairment is off
+    std::unique_ptr<common::SteadyClock> impairmentClock;
+    std::uint64_t impairedConnectionCount = 0u;
+    // timers of event loop lag probes - must not run on the loop they measure
+    common::SteadyClock loopLagClock;
+    // its timers run on loopLagClock too
+    common::SuppressedLogReporter suppressedLogReporter;
 
     QCoreApplication qApplication;
     TextConsole console;
     QtTransportEnvironment transportEnvironment;
+    common::ConfigFileWatcher configurationWatcher;
 
-    static std::unique_ptr<common::MultiLineConfig> readConfiguration(int argc, char* argv[]);
+    static common::ReloadableConfig::Snapshot readConfiguration(const common::MultiLineConfig& commandLineConfiguration);
+    static std::string configurationFilename(const common::MultiLineConfig& commandLineConfiguration);
     static BtsId generateBtsId();
     static std::string logFilename(BtsId btsId);
+    static std::string flightDumpFilename(BtsId btsId);
+    static std::shared_ptr<common::CaptureWriter> createCaptureWriter(const common::MultiLineConfig& configuration, ILogger& logger);
 };
 
 }
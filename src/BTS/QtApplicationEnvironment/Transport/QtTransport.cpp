@@ -3,16 +3,25 @@
 #include <QHostAddress>
 #include "Messages/OutgoingMessage.hpp"
 #include "Messages/IncomingMessage.hpp"
+#include "Trace/FrameTracer.hpp"
+#include "Trace/LoopLagMonitor.hpp"
+#include "Memory/MemoryTag.hpp"
 
 namespace bts
 {
 
+namespace
+{
+// per frame traces - every frame header is anyway kept by flight recorder
+constexpr std::uint32_t FRAME_LOG_SAMPLING = 16u;
+}
+
 QtTransport::QtTransport(common::ILogger &logger, QAbstractSocket *socket)
     : logger(logger),
       socket(socket)
 {
-    QObject::connect(socket, &QAbstractSocket::readyRead, std::bind(&QtTransport::readMessageFromSocket, this));
-    QObject::connect(socket, &QAbstractSocket::disconnected, std::bind(&QtTransport::handleClosingConnection, this));
+    QObject::connect(socket, &QAbstractSocket::readyRead, this, &QtTransport::readMessageFromSocket);
+    QObject::connect(socket, &QAbstractSocket::disconnected, this, &QtTransport::handleClosingConnection);
     QObject::connect(this, SIGNAL(sendMessageSignal(QByteArray)), this, SLOT(sendMessageSlot(QByteArray)));
 }
 
@@ -20,21 +29,24 @@ QtTransport::~QtTransport()
 {
     QObject::disconnect(socket, &QAbstractSocket::readyRead, 0, 0);
     QObject::disconnect(socket, &QAbstractSocket::disconnected, 0, 0);
+    // socket is a child of the server - without this its descriptor would stay open till BTS exits
+    socket->deleteLater();
     logger.logDebug("QtTransport: bye");
 }
 
 void QtTransport::registerMessageCallback(ITransport::MessageCallback messageCallback)
 {
-    this->messageCallback = messageCallback;
+    this->messageCallback = std::move(messageCallback);
 }
 
 void QtTransport::registerDisconnectedCallback(ITransport::DisconnectedCallback disconnectedCallback)
 {
-    this->disconnectedCallback = disconnectedCallback;
+    this->disconnectedCallback = std::move(disconnectedCallback);
 }
 
 bool QtTransport::sendMessage(BinaryMessage message)
 {
+    common::MemoryTagScope memoryTag(common::MemoryTag::Transport);
     common::OutgoingMessage sizeEncoder;
     sizeEncoder.writeNumber<BinaryMessage::SizeType>(message.value.size());
     BinaryMessage size = sizeEncoder.getMessage();
@@ -42,17 +54,31 @@ bool QtTransport::sendMessage(BinaryMessage message)
     QByteArray array{};
     array.append(reinterpret_cast<char*>(size.value.data()), size.value.size());
     array.append(reinterpret_cast<char*>(message.value.data()), message.value.size());
+    common::FrameTracer::mark(common::FrameTracer::Stage::Enqueued);
     return emit sendMessageSignal(std::move(array));
 }
 
 bool QtTransport::sendMessageSlot(QByteArray message)
 {
-    logger.logDebug("Send message to: ", addressToString());
-    socket->write(std::move(message));
-    socket->flush();
+    static common::LogLimit logLimit = common::LogLimit::sampled(FRAME_LOG_SAMPLING);
+    logger.logDebug(logLimit, "Send message to: ", addressToString());
+    {
+        // socket write buffer grows here
+        common::MemoryTagScope memoryTag(common::MemoryTag::Transport);
+        socket->write(std::move(message));
+        socket->flush();
+    }
+    // only when slot is called directly - queued write happens outside of the frame scope
+    common::FrameTracer::mark(common::FrameTracer::Stage::Written);
     return true;
 }
 
+void QtTransport::close()
+{
+    // callable from any thread - socket is used only by the event loop, disconnected is emitted there
+    QMetaObject::invokeMethod(socket, [socket = socket] { socket->abort(); }, Qt::QueuedConnection);
+}
+
 std::string QtTransport::addressToString() const
 {
     return socket->peerAddress().toString().toStdString() + "-" + std::to_string(socket->peerPort());
@@ -73,6 +99,9 @@ void QtTransport::handleClosingConnection()
 
 void QtTransport::readMessageFromSocket()
 {
+    // kernel receive timestamps need recvmsg(), QAbstractSocket reads with read() - readyRead time is the closest
+    const auto readAt = common::FrameTracer::Clock::now();
+    common::LoopLagMonitor::Wakeup wakeup;
     const std::size_t sizeSize = sizeof(BinaryMessage::SizeType);
     quint64 bytesAvailable;
     while ((bytesAvailable = socket->bytesAvailable()) >= sizeSize)
@@ -84,22 +113,27 @@ void QtTransport::readMessageFromSocket()
 
         if (bytesAvailable < sizeSize + messageLength)
         {
-            logger.logError("Wrong size: ", std::size_t(messageLength),
+            static common::LogLimit wrongSizeLogLimit = common::LogLimit::rateLimited();
+            logger.logError(wrongSizeLogLimit, "Wrong size: ", std::size_t(messageLength),
                             " - available bytes: ", bytesAvailable);
             continue;
         }
 
         BinaryMessage message{ BinaryMessage::Value(messageLength) };
         socket->read(reinterpret_cast<char*>(message.value.data()), messageLength);
-        logger.logDebug("Message received from: ", addressToString(), " body: ", message);
+        static common::LogLimit receivedLogLimit = common::LogLimit::sampled(FRAME_LOG_SAMPLING);
+        logger.logDebug(receivedLogLimit, "Message received from: ", addressToString(), " body: ", message);
 
+        wakeup.frame();
         if (messageCallback)
         {
+            common::FrameTracer::Scope frameScope(readAt, message);
             messageCallback(std::move(message));
         }
         else
         {
-            logger.logError("Message received from: ", addressToString(), " - application not interested");
+            static common::LogLimit notInterestedLogLimit = common::LogLimit::rateLimited();
+            logger.logError(notInterestedLogLimit, "Message received from: ", addressToString(), " - application not interested");
         }
     }
 }
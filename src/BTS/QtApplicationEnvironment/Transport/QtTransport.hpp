@@ -20,6 +20,7 @@ public:
     void registerMessageCallback(MessageCallback messageCallback) override;
     void registerDisconnectedCallback(DisconnectedCallback disconnectedCallback) override;
     bool sendMessage(BinaryMessage message) override;
+    void close() override;
 
     std::string addressToString() const override;
 private:
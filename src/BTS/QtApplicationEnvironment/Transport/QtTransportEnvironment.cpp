@@ -3,13 +3,24 @@
 #include <QTcpSocket>
 #include <QtNetwork>
 #include <QByteArray>
+#include "Memory/MemoryTag.hpp"
+#include "Memory/SlabPool.hpp"
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
 
 namespace bts
 {
 
-QtTransportEnvironment::QtTransportEnvironment(common::ILogger& logger, common::MultiLineConfig &config)
+QtTransportEnvironment::QtTransportEnvironment(common::ILogger& logger, const common::MultiLineConfig &config)
     : logger(logger),
-      port(config.getNumber<decltype(port)>("port", 8181))
+      port(config.getNumber<decltype(port)>("port", 8181)),
+      keepAliveIdle(config.getNumber<int>("tcp_keepalive_idle_s", 30)),
+      keepAliveInterval(config.getNumber<int>("tcp_keepalive_interval_s", 10)),
+      keepAliveCount(config.getNumber<int>("tcp_keepalive_count", 3)),
+      userTimeout(config.getNumber<int>("tcp_user_timeout_ms", 60000))
 {}
 
 QtTransportEnvironment::~QtTransportEnvironment()
@@ -75,7 +86,13 @@ void QtTransportEnvironment::handleNewConnection()
     QAbstractSocket* socket = server->nextPendingConnection();
     if (socket)
     {
-        auto ueTransport = std::make_shared<QtTransport>(logger, socket);
+        configureSocket(*socket);
+        auto ueTransport = [&]
+        {
+            common::MemoryTagScope memoryTag(common::MemoryTag::Transport);
+            // one per connection - object and shared_ptr control block from one slab pool
+            return std::allocate_shared<QtTransport>(common::SlabAllocator<QtTransport>{}, logger, socket);
+        }();
         logger.logDebug("New connection from: ", ueTransport->addressToString());
         if (ueConnectedCallback)
         {
@@ -92,4 +109,29 @@ void QtTransportEnvironment::handleNewConnection()
     }
 }
 
+void QtTransportEnvironment::configureSocket(QAbstractSocket &socket)
+{
+    const int descriptor = static_cast<int>(socket.socketDescriptor());
+    if (keepAliveIdle.count() > 0)
+    {
+        socket.setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+        setTcpOption(descriptor, TCP_KEEPIDLE, static_cast<int>(keepAliveIdle.count()), "TCP_KEEPIDLE");
+        setTcpOption(descriptor, TCP_KEEPINTVL, static_cast<int>(keepAliveInterval.count()), "TCP_KEEPINTVL");
+        setTcpOption(descriptor, TCP_KEEPCNT, keepAliveCount, "TCP_KEEPCNT");
+    }
+    if (userTimeout.count() > 0)
+    {
+        setTcpOption(descriptor, TCP_USER_TIMEOUT, static_cast<int>(userTimeout.count()), "TCP_USER_TIMEOUT");
+    }
+}
+
+void QtTransportEnvironment::setTcpOption(int descriptor, int option, int value, const char *name)
+{
+    if (::setsockopt(descriptor, IPPROTO_TCP, option, &value, sizeof(value)) != 0)
+    {
+        static common::LogLimit logLimit = common::LogLimit::rateLimited();
+        logger.logError(logLimit, "Cannot set ", name, " to ", value, ": ", std::strerror(errno));
+    }
+}
+
 }
@@ -2,6 +2,7 @@
 #include "ITransport.hpp"
 #include "Logger/ILogger.hpp"
 #include "Config/MultiLineConfig.hpp"
+#include <chrono>
 
 class QTcpServer;
 class QNetworkSession;
@@ -13,7 +14,11 @@ namespace bts
 class QtTransportEnvironment
 {
 public:
-    QtTransportEnvironment(common::ILogger& logger, common::MultiLineConfig& config);
+    /**
+     * Keys: port, tcp_keepalive_idle_s, tcp_keepalive_interval_s, tcp_keepalive_count, tcp_user_timeout_ms
+     * Zero keepalive idle or user timeout disables that option.
+     */
+    QtTransportEnvironment(common::ILogger& logger, const common::MultiLineConfig& config);
     ~QtTransportEnvironment();
 
     void exec();
@@ -23,9 +28,17 @@ public:
 private:
     void sessionOpened();
     void handleNewConnection();
+    void configureSocket(QAbstractSocket& socket);
+    void setTcpOption(int descriptor, int option, int value, const char* name);
 
     common::ILogger& logger;
     std::uint32_t port;
+    // kernel finds peers gone without FIN - half-open connections would otherwise wait for the reaper
+    std::chrono::seconds keepAliveIdle;
+    std::chrono::seconds keepAliveInterval;
+    int keepAliveCount;
+    // unacknowledged sent data - dead peer found even while BTS keeps sending
+    std::chrono::milliseconds userTimeout;
     std::unique_ptr<QTcpServer> server;
     std::unique_ptr<QNetworkSession> session;
     UeConnectedCallback ueConnectedCallback;
@@ -0,0 +1,160 @@
+#include "ConnectionReaperTestSuite.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+
+constexpr std::chrono::milliseconds ConnectionReaperTestSuite::ATTACH_TIMEOUT;
+constexpr std::chrono::milliseconds ConnectionReaperTestSuite::INACTIVITY_TIMEOUT;
+constexpr std::size_t ConnectionReaperTestSuite::UE_PENDING_COUNT;
+
+ConnectionReaperTestSuite::ConnectionReaperTestSuite()
+{
+    syncGuard = std::make_shared<SyncGuard>();
+    clock = std::make_shared<common::VirtualClock>();
+    metrics = std::make_shared<RelayMetrics>(metricsRegistry);
+    objectUnderTest = std::make_unique<ConnectionReaper>(syncGuard, clock, metrics, loggerMock,
+                                                         ATTACH_TIMEOUT, INACTIVITY_TIMEOUT);
+    objectUnderTest->start();
+    EXPECT_CALL(ueMock, print(_)).Times(AnyNumber());
+}
+
+ConnectionReaperTestSuite::~ConnectionReaperTestSuite()
+{
+    objectUnderTest->stop();
+}
+
+void ConnectionReaperTestSuite::expectFramesReceived(std::uint64_t frames)
+{
+    EXPECT_CALL(ueMock, framesReceived()).WillRepeatedly(Return(frames));
+}
+
+void ConnectionReaperTestSuite::watchAttached()
+{
+    expectFramesReceived(0u);
+    watchId = objectUnderTest->watch(ueMock);
+    objectUnderTest->sibSent(watchId);
+    EXPECT_CALL(ueMock, isAttached()).WillRepeatedly(Return(true));
+    clock->advance(ATTACH_TIMEOUT);
+    Mock::VerifyAndClearExpectations(&ueMock);
+    EXPECT_CALL(ueMock, print(_)).Times(AnyNumber());
+}
+
+TEST_F(ConnectionReaperTestSuite, shallCloseNotAttachedAfterAttachTimeout)
+{
+    expectFramesReceived(0u);
+    objectUnderTest->sibSent(objectUnderTest->watch(ueMock));
+    clock->advance(ATTACH_TIMEOUT - ConnectionReaper::TICK);
+    Mock::VerifyAndClearExpectations(&ueMock);
+
+    EXPECT_CALL(ueMock, print(_)).Times(AnyNumber());
+    expectFramesReceived(1u);
+    EXPECT_CALL(ueMock, isAttached()).WillOnce(Return(false));
+    EXPECT_CALL(ueMock, close());
+    clock->advance(ConnectionReaper::TICK);
+
+    ASSERT_EQ(0u, objectUnderTest->watchedCount());
+    ASSERT_EQ(1u, metrics->reapedNotAttached.value());
+    ASSERT_EQ(0u, metrics->reapedInactive.value());
+}
+
+TEST_F(ConnectionReaperTestSuite, shallStartAttachTimeoutAtFirstSib)
+{
+    // more UEs wait than SIBs can be sent within attach timeout - none is closed before its SIB
+    std::array<ConnectionReaper::WatchId, UE_PENDING_COUNT> pendingIds{};
+    for (std::size_t i = 0u; i < UE_PENDING_COUNT; ++i)
+    {
+        EXPECT_CALL(uePendingMock[i], framesReceived()).WillRepeatedly(Return(0u));
+        EXPECT_CALL(uePendingMock[i], isAttached()).WillRepeatedly(Return(false));
+        EXPECT_CALL(uePendingMock[i], print(_)).Times(AnyNumber());
+        pendingIds[i] = objectUnderTest->watch(uePendingMock[i]);
+    }
+    clock->advance(3 * ATTACH_TIMEOUT);
+    ASSERT_EQ(UE_PENDING_COUNT, objectUnderTest->watchedCount());
+
+    objectUnderTest->sibSent(pendingIds[0]);
+    clock->advance(ATTACH_TIMEOUT - ConnectionReaper::TICK);
+    objectUnderTest->sibSent(pendingIds[0]);
+    objectUnderTest->sibSent(pendingIds[1]);
+
+    EXPECT_CALL(uePendingMock[0], close());
+    clock->advance(ConnectionReaper::TICK);
+    ASSERT_EQ(UE_PENDING_COUNT - 1u, objectUnderTest->watchedCount());
+    ASSERT_EQ(1u, metrics->reapedNotAttached.value());
+
+    for (std::size_t i = 1u; i < UE_PENDING_COUNT; ++i)
+    {
+        objectUnderTest->forget(pendingIds[i]);
+    }
+}
+
+TEST_F(ConnectionReaperTestSuite, shallNotWaitForSibWhenAttachedWithoutIt)
+{
+    expectFramesReceived(0u);
+    watchId = objectUnderTest->watch(ueMock);
+    EXPECT_CALL(ueMock, isAttached()).WillRepeatedly(Return(true));
+    clock->advance(INACTIVITY_TIMEOUT);
+
+    EXPECT_CALL(ueMock, close());
+    clock->advance(INACTIVITY_TIMEOUT);
+    ASSERT_EQ(1u, metrics->reapedInactive.value());
+}
+
+TEST_F(ConnectionReaperTestSuite, shallKeepActiveConnection)
+{
+    watchAttached();
+
+    for (std::uint64_t frames = 1u; frames <= 3u; ++frames)
+    {
+        expectFramesReceived(frames);
+        clock->advance(INACTIVITY_TIMEOUT);
+    }
+    ASSERT_EQ(1u, objectUnderTest->watchedCount());
+    objectUnderTest->forget(watchId);
+}
+
+TEST_F(ConnectionReaperTestSuite, shallCloseInactiveConnection)
+{
+    watchAttached();
+    expectFramesReceived(0u);
+    EXPECT_CALL(ueMock, close());
+    clock->advance(INACTIVITY_TIMEOUT);
+
+    ASSERT_EQ(0u, objectUnderTest->watchedCount());
+    ASSERT_EQ(1u, metrics->reapedInactive.value());
+}
+
+TEST_F(ConnectionReaperTestSuite, shallNotCheckForgottenConnection)
+{
+    expectFramesReceived(0u);
+    watchId = objectUnderTest->watch(ueMock);
+    objectUnderTest->forget(watchId);
+    Mock::VerifyAndClearExpectations(&ueMock);
+
+    clock->advance(ATTACH_TIMEOUT + INACTIVITY_TIMEOUT);
+    ASSERT_EQ(0u, objectUnderTest->watchedCount());
+}
+
+TEST_F(ConnectionReaperTestSuite, shallNotCloseWhenDisabled)
+{
+    objectUnderTest->reconfigure(std::chrono::milliseconds::zero(), std::chrono::milliseconds::zero());
+    expectFramesReceived(0u);
+    EXPECT_CALL(ueMock, isAttached()).WillRepeatedly(Return(false));
+    watchId = objectUnderTest->watch(ueMock);
+    objectUnderTest->sibSent(watchId);
+
+    // disabled - connection is still checked with default timeouts
+    clock->advance(ConnectionReaper::DEFAULT_ATTACH_TIMEOUT + 3 * ConnectionReaper::DEFAULT_INACTIVITY_TIMEOUT);
+    ASSERT_EQ(1u, objectUnderTest->watchedCount());
+    objectUnderTest->forget(watchId);
+}
+
+TEST_F(ConnectionReaperTestSuite, shallCancelTimerOnStop)
+{
+    objectUnderTest->stop();
+    ASSERT_EQ(0u, clock->pendingCount());
+    objectUnderTest->start();
+}
+
+}
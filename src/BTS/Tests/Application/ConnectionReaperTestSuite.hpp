@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <array>
+
+#include "ConnectionReaper.hpp"
+#include "Time/VirtualClock.hpp"
+
+#include "Mocks/ILoggerMock.hpp"
+#include "Mocks/IUeConnectionMock.hpp"
+
+namespace bts
+{
+
+class ConnectionReaperTestSuite : public ::testing::Test
+{
+protected:
+    ConnectionReaperTestSuite();
+    ~ConnectionReaperTestSuite();
+
+    static constexpr std::chrono::milliseconds ATTACH_TIMEOUT{3000};
+    static constexpr std::chrono::milliseconds INACTIVITY_TIMEOUT{5000};
+    static constexpr std::size_t UE_PENDING_COUNT = 10;
+
+    void expectFramesReceived(std::uint64_t frames);
+    void watchAttached();
+
+    SyncGuardPtr syncGuard;
+    std::shared_ptr<common::VirtualClock> clock;
+    common::MetricsRegistry metricsRegistry;
+    RelayMetricsPtr metrics;
+    testing::NiceMock<common::ILoggerMock> loggerMock;
+
+    testing::StrictMock<IUeConnectionMock> ueMock;
+    std::array<testing::StrictMock<IUeConnectionMock>, UE_PENDING_COUNT> uePendingMock;
+
+    std::unique_ptr<ConnectionReaper> objectUnderTest;
+    ConnectionReaper::WatchId watchId{};
+};
+
+}
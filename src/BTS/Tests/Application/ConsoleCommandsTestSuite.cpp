@@ -1,5 +1,6 @@
 #include "ConsoleCommandsTestSuite.hpp"
 #include <sstream>
+#include <future>
 
 using namespace ::testing;
 
@@ -11,7 +12,11 @@ ConsoleCommandsTestSuite::ConsoleCommandsTestSuite()
 {
     ueRelayMock = std::make_shared<StrictMock<IUeRelayMock>>();
     syncGuard = std::make_shared<SyncGuard>();
-    objectUnderTest = std::make_unique<ConsoleCommands>(consoleMock, environmentMock, loggerMock, ueRelayMock, syncGuard);
+    metricsRegistry = std::make_shared<common::MetricsRegistry>();
+    trafficTop = std::make_shared<TrafficTop>();
+    relayMetrics = std::make_shared<RelayMetrics>(*metricsRegistry);
+    objectUnderTest = std::make_unique<ConsoleCommands>(consoleMock, environmentMock, loggerMock, ueRelayMock, syncGuard,
+                                                        metricsRegistry, trafficTop, relayMetrics);
 }
 
 void ConsoleCommandsTestSuite::expectRegisterCallback(IConsoleMock &consoleMock,
@@ -26,6 +31,14 @@ void ConsoleCommandsTestSuite::expectRegisterCallbacks()
     expectRegisterCallback(consoleMock, "a", showAddressCallback);
     expectRegisterCallback(consoleMock, "s", showStatusCallback);
     expectRegisterCallback(consoleMock, "l", listAttachedUeCallback);
+    expectRegisterCallback(consoleMock, "top", showTopUeCallback);
+    expectRegisterCallback(consoleMock, "rtt", showRoundTripCallback);
+    expectRegisterCallback(consoleMock, "f", dumpFlightRecorderCallback);
+    expectRegisterCallback(consoleMock, "m", showMetricsCallback);
+    expectRegisterCallback(consoleMock, "p", showFrameTraceCallback);
+    expectRegisterCallback(consoleMock, "lock", showLockProfileCallback);
+    expectRegisterCallback(consoleMock, "loop", showLoopLagCallback);
+    expectRegisterCallback(consoleMock, "mem", showMemoryCallback);
     EXPECT_CALL(consoleMock, addCloseCommand(_, _, _));
     EXPECT_CALL(consoleMock, addHelpCommand(_, _));
     expectRegisterCallback(consoleMock, "t", testCommandsCallback);
@@ -145,4 +158,129 @@ TEST_F(ConsoleCommandsAfterStartTestSuite, shallListAttached)
     assertResultContainsAttachedPrintouts();
 }
 
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallShowTopUe)
+{
+    const auto now = TrafficTop::Clock::now();
+    trafficTop->forwarded(PhoneNumber{1}, PhoneNumber{2}, 10u, now);
+    trafficTop->forwarded(PhoneNumber{3}, PhoneNumber{2}, 10u, now);
+    trafficTop->forwarded(PhoneNumber{3}, PhoneNumber{2}, 10u, now);
+
+    onCallback(showTopUeCallback, "1 sent");
+
+    ASSERT_THAT(result, HasSubstr("Top senders by messages (last 60s):\n\t#1: 003: 2\n"));
+    ASSERT_THAT(result, Not(HasSubstr("001")));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallRejectUnknownTopArgument)
+{
+    onCallback(showTopUeCallback, "loudest");
+    ASSERT_THAT(result, HasSubstr("Unknown top argument: loudest"));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallRejectOutOfRangeTopCount)
+{
+    onCallback(showTopUeCallback, "99999999999999999999999");
+    ASSERT_THAT(result, HasSubstr("Usage: top"));
+    onCallback(showTopUeCallback, "0");
+    ASSERT_THAT(result, HasSubstr("Usage: top"));
+    onCallback(showTopUeCallback, "5x");
+    ASSERT_THAT(result, HasSubstr("Usage: top"));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallRejectNonAsciiTopArgument)
+{
+    onCallback(showTopUeCallback, "\xC5\xBC");
+    ASSERT_THAT(result, HasSubstr("Unknown top argument"));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallShowRoundTrip)
+{
+    relayMetrics->echoRequests.add(2);
+    relayMetrics->echoReplied(std::chrono::milliseconds(3));
+    for (std::size_t i = 0u; i < COUNT_ATTACHED_TO_VISIT; ++i)
+    {
+        EXPECT_CALL(ueConnectionAttachedMock[i], printRoundTrip(_)).WillOnce(Invoke([&,i](auto& os) { os << ueConnectionAttachedPrintout[i]; }));
+    }
+    EXPECT_CALL(*ueRelayMock, visitAttachedUe(_)).WillOnce([this](auto visitor) { applyUeAttached(visitor); });
+
+    onCallback(showRoundTripCallback);
+
+    assertResultContainsAttachedPrintouts();
+    ASSERT_THAT(result, HasSubstr("all ue: echo sent: 2, replies: 1, rtt [ms] p50: 3."));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallReportFailedFlightRecorderDump)
+{
+    const std::string path = "/no/such/directory/flight.txt";
+    onCallback(dumpFlightRecorderCallback, path);
+    ASSERT_THAT(result, HasSubstr("Cannot write flight recorder to: " + path));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallShowMetrics)
+{
+    metricsRegistry->counter("bts_test_total", "Test counter").add(3);
+    onCallback(showMetricsCallback);
+    ASSERT_THAT(result, HasSubstr("# TYPE bts_test_total counter\nbts_test_total 3\n"));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallShowFrameTraceSummary)
+{
+    onCallback(showFrameTraceCallback);
+    ASSERT_THAT(result, AllOf(HasSubstr("locked"), HasSubstr("routed"), HasSubstr("total")));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallSwitchLockProfiler)
+{
+    onCallback(showLockProfileCallback, "on");
+    ASSERT_TRUE(LockProfiler::instance().isEnabled());
+    ASSERT_THAT(result, HasSubstr("Lock profiler on"));
+
+    onCallback(showLockProfileCallback, "off");
+    ASSERT_FALSE(LockProfiler::instance().isEnabled());
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallShowLoopLag)
+{
+    onCallback(showLoopLagCallback);
+    ASSERT_THAT(result, AllOf(HasSubstr("lag"), HasSubstr("frames/wakeup"), HasSubstr("stalls:")));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallShowMemoryRatesSincePreviousCall)
+{
+    onCallback(showMemoryCallback);
+    ASSERT_THAT(result, AllOf(HasSubstr("ue_relay"), HasSubstr("message"), Not(HasSubstr("kB/s"))));
+
+    onCallback(showMemoryCallback);
+    ASSERT_THAT(result, HasSubstr("kB/s"));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallNotHoldLockWhileTestCommandsWait)
+{
+    const PhoneNumber TO{2};
+    std::promise<void> sent;
+    EXPECT_CALL(*ueRelayMock, sendMessage(_, TO)).WillOnce(Invoke([&sent](auto, auto)
+    {
+        sent.set_value();
+        return true;
+    }));
+    std::ostringstream resultStream;
+
+    testCommandsCallback("w 50 s Sms 1 2 x", resultStream);
+
+    ASSERT_TRUE(syncGuard->try_lock());
+    syncGuard->unlock();
+    ASSERT_EQ(std::future_status::ready, sent.get_future().wait_for(std::chrono::seconds(2)));
+    objectUnderTest->stop();
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallRejectTestCommandsAfterStop)
+{
+    objectUnderTest->stop();
+    std::ostringstream resultStream;
+
+    testCommandsCallback("s Sms 1 2 x", resultStream);
+
+    ASSERT_THAT(resultStream.str(), HasSubstr("test commands stopped"));
+}
+
 }
@@ -25,11 +25,22 @@ protected:
     testing::StrictMock<IApplicationEnvironmentMock> environmentMock;
     testing::NiceMock<common::ILoggerMock> loggerMock;
     std::shared_ptr<IUeRelayMock> ueRelayMock;
+    std::shared_ptr<common::MetricsRegistry> metricsRegistry;
+    TrafficTopPtr trafficTop;
+    RelayMetricsPtr relayMetrics;
     std::unique_ptr<ConsoleCommands> objectUnderTest;
 
     IConsole::CommandCallback showAddressCallback;
     IConsole::CommandCallback showStatusCallback;
     IConsole::CommandCallback listAttachedUeCallback;
+    IConsole::CommandCallback showTopUeCallback;
+    IConsole::CommandCallback showRoundTripCallback;
+    IConsole::CommandCallback dumpFlightRecorderCallback;
+    IConsole::CommandCallback showMetricsCallback;
+    IConsole::CommandCallback showFrameTraceCallback;
+    IConsole::CommandCallback showLockProfileCallback;
+    IConsole::CommandCallback showLoopLagCallback;
+    IConsole::CommandCallback showMemoryCallback;
     IConsole::CommandCallback testCommandsCallback;
 };
 
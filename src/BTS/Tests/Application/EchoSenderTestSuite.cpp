@@ -0,0 +1,68 @@
+#include "EchoSenderTestSuite.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+
+constexpr std::chrono::milliseconds EchoSenderTestSuite::PERIOD;
+constexpr std::size_t EchoSenderTestSuite::UE_ATTACHED_COUNT;
+
+EchoSenderTestSuite::EchoSenderTestSuite()
+{
+    syncGuard = std::make_shared<SyncGuard>();
+    clock = std::make_shared<common::VirtualClock>();
+    ueRelayMock = std::make_shared<StrictMock<IUeRelayMock>>();
+    objectUnderTest = std::make_unique<EchoSender>(ueRelayMock, syncGuard, clock, loggerMock, PERIOD);
+    objectUnderTest->start();
+}
+
+EchoSenderTestSuite::~EchoSenderTestSuite()
+{
+    objectUnderTest->stop();
+}
+
+void EchoSenderTestSuite::expectEchoToAllAttached()
+{
+    EXPECT_CALL(*ueRelayMock, visitAttachedUe(_)).WillOnce([this](IUeRelay::UeVisitor visitor)
+    {
+        for (auto& ue : ueAttachedMock)
+            visitor(ue);
+    });
+    for (auto& ue : ueAttachedMock)
+        EXPECT_CALL(ue, sendEcho());
+}
+
+TEST_F(EchoSenderTestSuite, shallNotSendBeforePeriod)
+{
+    clock->advance(PERIOD - std::chrono::milliseconds(1));
+}
+
+TEST_F(EchoSenderTestSuite, shallSendEchoToAllAttachedEveryPeriod)
+{
+    expectEchoToAllAttached();
+    clock->advance(PERIOD);
+    Mock::VerifyAndClearExpectations(ueRelayMock.get());
+
+    expectEchoToAllAttached();
+    clock->advance(PERIOD);
+}
+
+TEST_F(EchoSenderTestSuite, shallNotSendWhenDisabled)
+{
+    objectUnderTest->reconfigure(std::chrono::milliseconds::zero());
+    clock->advance(PERIOD);
+
+    // disabled - timer keeps polling with default period
+    clock->advance(10 * EchoSender::DEFAULT_PERIOD);
+    ASSERT_EQ(1u, clock->pendingCount());
+}
+
+TEST_F(EchoSenderTestSuite, shallCancelTimerOnStop)
+{
+    objectUnderTest->stop();
+    ASSERT_EQ(0u, clock->pendingCount());
+    objectUnderTest->start();
+}
+
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <array>
+
+#include "EchoSender.hpp"
+#include "Time/VirtualClock.hpp"
+
+#include "Mocks/ILoggerMock.hpp"
+#include "Mocks/IUeRelayMock.hpp"
+#include "Mocks/IUeConnectionMock.hpp"
+
+namespace bts
+{
+
+class EchoSenderTestSuite : public ::testing::Test
+{
+protected:
+    EchoSenderTestSuite();
+    ~EchoSenderTestSuite();
+
+    static constexpr std::chrono::milliseconds PERIOD{250};
+    static constexpr std::size_t UE_ATTACHED_COUNT = 3;
+
+    void expectEchoToAllAttached();
+
+    SyncGuardPtr syncGuard;
+    std::shared_ptr<common::VirtualClock> clock;
+    std::shared_ptr<testing::StrictMock<IUeRelayMock>> ueRelayMock;
+    testing::NiceMock<common::ILoggerMock> loggerMock;
+
+    std::array<testing::StrictMock<IUeConnectionMock>, UE_ATTACHED_COUNT> ueAttachedMock;
+
+    std::unique_ptr<EchoSender> objectUnderTest;
+};
+
+}
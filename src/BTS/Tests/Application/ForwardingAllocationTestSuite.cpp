@@ -0,0 +1,96 @@
+#include "ForwardingAllocationTestSuite.hpp"
+#include "AllocationCounter/AllocationCounter.hpp"
+#include "Messages/OutgoingMessage.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+using common::MessageId;
+
+ForwardingAllocationTestSuite::ForwardingAllocationTestSuite()
+{
+    syncGuard = std::make_shared<SyncGuard>();
+    relay = std::make_shared<UeRelay>(logger);
+
+    senderTransportMock = std::make_shared<NiceMock<common::ITransportMock>>();
+    ON_CALL(*senderTransportMock, registerMessageCallback(_)).WillByDefault(SaveArg<0>(&senderMessageCallback));
+    ON_CALL(*senderTransportMock, registerDisconnectedCallback(_)).WillByDefault(SaveArg<0>(&senderDisconnectedCallback));
+    ON_CALL(*senderTransportMock, sendMessage(_)).WillByDefault(Return(true));
+    auto metrics = std::make_shared<RelayMetrics>(metricsRegistry);
+    auto reaper = std::make_shared<ConnectionReaper>(syncGuard, std::make_shared<common::VirtualClock>(), metrics, logger);
+    auto newSender = std::make_unique<UeConnection>(senderTransportMock, logger, syncGuard, metrics,
+                                                    std::make_shared<TrafficTop>(), reaper);
+    sender = newSender.get();
+    sender->start(relay->add(std::move(newSender)));
+
+    auto newReceiver = std::make_unique<ReceivingUeConnection>();
+    receiver = newReceiver.get();
+    receiver->start(relay->add(std::move(newReceiver)));
+    receiver->slot.attach(RECEIVER_PHONE);
+
+    common::OutgoingMessage attachRequest{MessageId::AttachRequest, SENDER_PHONE, PhoneNumber{}};
+    attachRequest.writeBtsId(BtsId{1});
+    senderMessageCallback(attachRequest.getMessage());
+}
+
+ForwardingAllocationTestSuite::~ForwardingAllocationTestSuite()
+{
+    receiver->slot.remove();
+    // disconnected sender removes itself from relay
+    auto disconnected = senderDisconnectedCallback;
+    disconnected();
+}
+
+BinaryMessage ForwardingAllocationTestSuite::buildSms() const
+{
+    common::OutgoingMessage builder{MessageId::Sms, SENDER_PHONE, RECEIVER_PHONE};
+    builder.writeText("Hello, how are you?");
+    return builder.getMessage();
+}
+
+TEST_F(ForwardingAllocationTestSuite, shallBeAttachedBeforeForwarding)
+{
+    ASSERT_TRUE(sender->isAttached());
+    ASSERT_EQ(2u, relay->countAttached());
+}
+
+TEST_F(ForwardingAllocationTestSuite, shallForwardWithoutAllocation)
+{
+    // frames come from transport already allocated - they are not part of the budget
+    constexpr std::size_t FORWARD_COUNT = 16u * UeConnection::FORWARD_LOG_SAMPLING;
+    std::vector<BinaryMessage> frames(FORWARD_COUNT, buildSms());
+    std::size_t allocatingForwards = 0u;
+
+    for (auto& frame : frames)
+    {
+        common::ScopedAllocationCounter counter;
+        senderMessageCallback(std::move(frame));
+        if (counter.count().allocations != 0u)
+        {
+            ++allocatingForwards;
+        }
+    }
+
+    ASSERT_EQ(FORWARD_COUNT, receiver->received);
+    // only formatting of sampled debug log line is allowed to allocate,
+    // and of the first suppressed one - kept for the summary until the limit is flushed
+    ASSERT_LE(allocatingForwards, FORWARD_COUNT / UeConnection::FORWARD_LOG_SAMPLING + 1u);
+}
+
+TEST_F(ForwardingAllocationTestSuite, shallReleaseEveryForwardedFrame)
+{
+    std::vector<BinaryMessage> frames(UeConnection::FORWARD_LOG_SAMPLING, buildSms());
+
+    common::ScopedAllocationCounter counter;
+    for (auto& frame : frames)
+    {
+        senderMessageCallback(std::move(frame));
+    }
+
+    // nothing retained on the path - every frame and every log line is freed
+    const auto count = counter.count();
+    ASSERT_EQ(count.allocations + frames.size(), count.deallocations) << count;
+}
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "UeConnection/UeConnection.hpp"
+#include "UeRelay/UeRelay.hpp"
+
+#include "Mocks/ITransportMock.hpp"
+#include "Time/VirtualClock.hpp"
+
+namespace bts
+{
+
+/**
+ * Steady state forwarding path with real UeConnection and UeRelay:
+ * transport callback -> UeConnection -> UeRelay -> receiving IUeConnection
+ */
+class ForwardingAllocationTestSuite : public ::testing::Test
+{
+protected:
+    ForwardingAllocationTestSuite();
+    ~ForwardingAllocationTestSuite();
+
+    class NullLogger : public common::ILogger
+    {
+    public:
+        void log(Level, const std::string&) override {}
+    };
+
+    class ReceivingUeConnection : public IUeConnection
+    {
+    public:
+        void start(UeSlot newSlot) override { slot = std::move(newSlot); }
+        void sendMessage(BinaryMessage) override { ++received; }
+        void sendSib(BtsId) override {}
+        void sendEcho() override {}
+        PhoneNumber getPhoneNumber() const override { return slot.getPhoneNumber(); }
+        bool isAttached() const override { return slot.isAttached(); }
+        void print(std::ostream& os) const override { os << "receiver"; }
+        void printRoundTrip(std::ostream&) const override {}
+        std::uint64_t framesReceived() const override { return 0u; }
+        void close() override {}
+
+        UeSlot slot;
+        std::size_t received = 0u;
+    };
+
+    BinaryMessage buildSms() const;
+
+    const PhoneNumber SENDER_PHONE{11};
+    const PhoneNumber RECEIVER_PHONE{22};
+
+    NullLogger logger;
+    SyncGuardPtr syncGuard;
+    common::MetricsRegistry metricsRegistry;
+    std::shared_ptr<UeRelay> relay;
+    std::shared_ptr<testing::NiceMock<common::ITransportMock>> senderTransportMock;
+    ITransport::MessageCallback senderMessageCallback;
+    ITransport::DisconnectedCallback senderDisconnectedCallback;
+    // both owned by relay
+    UeConnection* sender;
+    ReceivingUeConnection* receiver;
+};
+
+}
@@ -0,0 +1,65 @@
+#include "LockProfilerTestSuite.hpp"
+#include <sstream>
+#include <thread>
+
+using namespace ::testing;
+
+namespace bts
+{
+
+LockProfilerTestSuite::LockProfilerTestSuite()
+    : objectUnderTest(LockProfiler::instance())
+{
+    objectUnderTest.setEnabled(true);
+}
+
+LockProfilerTestSuite::~LockProfilerTestSuite()
+{
+    objectUnderTest.setEnabled(false);
+}
+
+std::string LockProfilerTestSuite::report() const
+{
+    std::ostringstream os;
+    objectUnderTest.print(os);
+    return os.str();
+}
+
+TEST_F(LockProfilerTestSuite, shallReportEachCallSiteSeparately)
+{
+    const std::uint32_t firstLine = std::source_location::current().line() + 1u;
+    { SyncLock lock(guard); }
+    const std::uint32_t secondLine = std::source_location::current().line() + 1u;
+    { SyncLock lock(guard); }
+
+    ASSERT_THAT(report(), AllOf(HasSubstr("LockProfilerTestSuite.cpp:" + std::to_string(firstLine) + " "),
+                                HasSubstr("LockProfilerTestSuite.cpp:" + std::to_string(secondLine) + " ")));
+}
+
+TEST_F(LockProfilerTestSuite, shallMeasureHoldTime)
+{
+    const auto location = std::source_location::current();
+    {
+        SyncLock lock(guard, location);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    auto* site = LockProfiler::siteIfEnabled(location);
+    ASSERT_NE(nullptr, site);
+    ASSERT_EQ(1u, site->hold.count());
+    ASSERT_GE(site->hold.sum(), 2000000u);
+}
+
+TEST_F(LockProfilerTestSuite, shallNotProfileWhenOff)
+{
+    objectUnderTest.setEnabled(false);
+    const auto location = std::source_location::current();
+    { SyncLock lock(guard, location); }
+
+    ASSERT_EQ(nullptr, LockProfiler::siteIfEnabled(location));
+    objectUnderTest.setEnabled(true);
+    auto* site = LockProfiler::siteIfEnabled(location);
+    ASSERT_NE(nullptr, site);
+    ASSERT_EQ(0u, site->hold.count());
+}
+
+}
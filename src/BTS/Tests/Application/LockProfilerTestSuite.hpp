@@ -0,0 +1,21 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "Synchronization.hpp"
+
+namespace bts
+{
+
+class LockProfilerTestSuite : public ::testing::Test
+{
+protected:
+    LockProfilerTestSuite();
+    ~LockProfilerTestSuite();
+
+    std::string report() const;
+
+    LockProfiler& objectUnderTest;
+    SyncGuard guard;
+};
+
+}
@@ -0,0 +1,64 @@
+#include "MetricsFileWriterTestSuite.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+using namespace ::testing;
+
+namespace bts
+{
+
+constexpr std::chrono::milliseconds MetricsFileWriterTestSuite::PERIOD;
+
+MetricsFileWriterTestSuite::MetricsFileWriterTestSuite()
+    : path("bts_metrics_ut_" + std::to_string(::getpid()) + ".prom")
+{
+    registry = std::make_shared<common::MetricsRegistry>();
+    clock = std::make_shared<common::VirtualClock>();
+    objectUnderTest = std::make_unique<MetricsFileWriter>(registry, clock, loggerMock);
+}
+
+MetricsFileWriterTestSuite::~MetricsFileWriterTestSuite()
+{
+    std::remove(path.c_str());
+}
+
+std::string MetricsFileWriterTestSuite::readFile() const
+{
+    std::ifstream file(path);
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+TEST_F(MetricsFileWriterTestSuite, shallNotWriteWhenNotConfigured)
+{
+    ASSERT_FALSE(objectUnderTest->writeFile());
+}
+
+TEST_F(MetricsFileWriterTestSuite, shallReportFailedWrite)
+{
+    objectUnderTest->reconfigure("/no/such/directory/metrics.prom", PERIOD);
+    ASSERT_FALSE(objectUnderTest->writeFile());
+}
+
+TEST_F(MetricsFileWriterTestSuite, shallRewriteFileEveryPeriod)
+{
+    auto& counter = registry->counter("bts_test_total", "Test counter");
+    objectUnderTest->reconfigure(path, PERIOD);
+    objectUnderTest->start();
+
+    counter.add(1);
+    clock->advance(PERIOD);
+    ASSERT_THAT(readFile(), HasSubstr("bts_test_total 1\n"));
+
+    counter.add(1);
+    clock->advance(PERIOD);
+    ASSERT_THAT(readFile(), HasSubstr("bts_test_total 2\n"));
+
+    objectUnderTest->stop();
+    ASSERT_EQ(0u, clock->pendingCount());
+}
+
+}
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "MetricsFileWriter.hpp"
+#include "Time/VirtualClock.hpp"
+
+#include "Mocks/ILoggerMock.hpp"
+
+namespace bts
+{
+
+class MetricsFileWriterTestSuite : public ::testing::Test
+{
+protected:
+    MetricsFileWriterTestSuite();
+    ~MetricsFileWriterTestSuite();
+
+    std::string readFile() const;
+
+    static constexpr std::chrono::milliseconds PERIOD{200};
+
+    const std::string path;
+    std::shared_ptr<common::MetricsRegistry> registry;
+    std::shared_ptr<common::VirtualClock> clock;
+    testing::NiceMock<common::ILoggerMock> loggerMock;
+    std::unique_ptr<MetricsFileWriter> objectUnderTest;
+};
+
+}
@@ -17,6 +17,7 @@ public:
     MOCK_METHOD(ILogger&, getLogger, (), (final));
     MOCK_METHOD(BtsId, getBtsId, (), (const, final));
     MOCK_METHOD(std::string, getAddress, (), (const, final));
+    MOCK_METHOD(common::ReloadableConfig&, getConfiguration, (), (final));
     MOCK_METHOD(void, startMessageLoop, (), (final));
 };
 
@@ -16,9 +16,13 @@ public:
     MOCK_METHOD(void, start, (UeSlot ueSlot), (final));
     MOCK_METHOD(void, sendMessage, (BinaryMessage message), (final));
     MOCK_METHOD(void, sendSib, (BtsId btsId), (final));
+    MOCK_METHOD(void, sendEcho, (), (final));
     MOCK_METHOD(PhoneNumber, getPhoneNumber, (), (const, final));
     MOCK_METHOD(bool, isAttached, (), (const, final));
     MOCK_METHOD(void, print, (std::ostream&), (const, final));
+    MOCK_METHOD(void, printRoundTrip, (std::ostream&), (const, final));
+    MOCK_METHOD(std::uint64_t, framesReceived, (), (const, final));
+    MOCK_METHOD(void, close, (), (final));
 };
 
 
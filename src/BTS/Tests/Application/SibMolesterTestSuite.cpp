@@ -7,21 +7,29 @@ namespace bts
 
 constexpr BtsId SibMolesterTestSuite::BTS_ID;
 constexpr std::chrono::milliseconds SibMolesterTestSuite::TICK_DURATION;
-constexpr std::chrono::milliseconds SibMolesterTestSuite::TICK_DURATION_MARGIN;
 constexpr std::size_t SibMolesterTestSuite::TICKS_TO_SEND_SIB;
 constexpr std::size_t SibMolesterTestSuite::UE_NOT_ATTACHED_COUNT;
 
 SibMolesterTestSuite::SibMolesterTestSuite()
 {
     syncGuard = std::make_shared<SyncGuard>();
+    clock = std::make_shared<common::VirtualClock>();
     ueRelayMock = std::make_shared<StrictMock<IUeRelayMock>>();
-    objectUnderTest = std::make_unique<SibMolester>(ueRelayMock, syncGuard, BTS_ID, loggerMock,
+    objectUnderTest = std::make_unique<SibMolester>(ueRelayMock, syncGuard, clock, BTS_ID, loggerMock,
                                                     TICK_DURATION, TICKS_TO_SEND_SIB);
 }
 
 TEST_F(SibMolesterTestSuite, shallDoNothingWhenNotStarted)
 {
-    std::this_thread::sleep_for(TICKS_TO_SEND_SIB * TICK_DURATION + TICK_DURATION_MARGIN);
+    ASSERT_EQ(0u, clock->advance(TICKS_TO_SEND_SIB * TICK_DURATION));
+}
+
+TEST_F(SibMolesterTestSuite, shallCancelTickOnStop)
+{
+    objectUnderTest->start();
+    ASSERT_EQ(1u, clock->pendingCount());
+    objectUnderTest->stop();
+    ASSERT_EQ(0u, clock->pendingCount());
 }
 
 SibMolesterStartedTestSuite::SibMolesterStartedTestSuite()
@@ -72,7 +80,7 @@ void SibMolesterStartedTestSuite::expectVisitNotAttached()
 void SibMolesterStartedTestSuite::expectVisitAllNotAttachedUeAndSendSibForOne(std::size_t ueIndex)
 {
     expectVisitNotAttached();
-    std::this_thread::sleep_for(TICKS_TO_SEND_SIB * TICK_DURATION + TICK_DURATION_MARGIN);
+    clock->advance(TICKS_TO_SEND_SIB * TICK_DURATION);
     Mock::VerifyAndClearExpectations(&ueRelayMock);
     ASSERT_NE(nullptr, visitor);
     expectUeSendSib(ueIndex);
@@ -80,7 +88,12 @@ void SibMolesterStartedTestSuite::expectVisitAllNotAttachedUeAndSendSibForOne(st
 
 TEST_F(SibMolesterStartedTestSuite, shallNotSendSibAfterFirstTick)
 {
-    std::this_thread::sleep_for(TICK_DURATION + TICK_DURATION_MARGIN);
+    ASSERT_EQ(1u, clock->advance(TICK_DURATION));
+}
+
+TEST_F(SibMolesterStartedTestSuite, shallNotSendSibJustBeforeFullDuration)
+{
+    clock->advance(TICKS_TO_SEND_SIB * TICK_DURATION - std::chrono::milliseconds(1));
 }
 
 TEST_F(SibMolesterStartedTestSuite, shallSendSibAfterFirstFullDuration)
@@ -96,13 +109,46 @@ TEST_F(SibMolesterStartedTestSuite, shallSendSibForTwoUeAfterTwoFullDurations)
 
 TEST_F(SibMolesterStartedTestSuite, shallSendSibsInRound)
 {
-    static_assert((2 + UE_NOT_ATTACHED_COUNT) * TICK_DURATION_MARGIN < TICK_DURATION,
-                  "Would because margin is too wide");
-
     for (std::size_t i = 0; i < UE_NOT_ATTACHED_COUNT; ++i)
         expectVisitAllNotAttachedUeAndSendSibForOne(i);
     expectVisitAllNotAttachedUeAndSendSibForOne(0);
     expectVisitAllNotAttachedUeAndSendSibForOne(1);
 }
 
+TEST_F(SibMolesterStartedTestSuite, shallUseReconfiguredTickFromNextTick)
+{
+    objectUnderTest->reconfigure(10 * TICK_DURATION, 1u);
+
+    // tick already scheduled keeps old duration
+    expectVisitNotAttached();
+    clock->advance(TICK_DURATION);
+    ASSERT_NE(nullptr, visitor);
+    expectUeSendSib(0);
+
+    expectVisitNotAttached();
+    clock->advance(10 * TICK_DURATION - std::chrono::milliseconds(1));
+    ASSERT_EQ(nullptr, visitor);
+    clock->advance(std::chrono::milliseconds(1));
+    ASSERT_NE(nullptr, visitor);
+    expectUeSendSib(1);
+}
+
+TEST_F(SibMolesterStartedTestSuite, shallSendSibsInRoundForHours)
+{
+    constexpr std::chrono::hours SIMULATED_TIME{3};
+    const std::size_t sibCount = SIMULATED_TIME / (TICKS_TO_SEND_SIB * TICK_DURATION);
+    ASSERT_EQ(0u, sibCount % UE_NOT_ATTACHED_COUNT);
+
+    EXPECT_CALL(*ueRelayMock, visitNotAttachedUe(_)).Times(sibCount)
+            .WillRepeatedly([this](IUeRelay::UeVisitor visitor)
+    {
+        for (auto& ue : ueNotAttachedMock)
+            visitor(ue);
+    });
+    for (auto& ue : ueNotAttachedMock)
+        EXPECT_CALL(ue, sendSib(BTS_ID)).Times(sibCount / UE_NOT_ATTACHED_COUNT);
+
+    clock->advance(SIMULATED_TIME);
+}
+
 }
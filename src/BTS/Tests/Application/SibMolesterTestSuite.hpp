@@ -3,6 +3,7 @@
 #include <array>
 
 #include "SibMolester.hpp"
+#include "Time/VirtualClock.hpp"
 
 #include "Mocks/ILoggerMock.hpp"
 #include "Mocks/IUeRelayMock.hpp"
@@ -18,11 +19,11 @@ protected:
 
     static constexpr BtsId BTS_ID{17};
     static constexpr std::chrono::milliseconds TICK_DURATION{150};
-    static constexpr std::chrono::milliseconds TICK_DURATION_MARGIN{20};
     static constexpr std::size_t TICKS_TO_SEND_SIB = 2;
     static constexpr std::size_t UE_NOT_ATTACHED_COUNT = 3;
 
     SyncGuardPtr syncGuard;
+    std::shared_ptr<common::VirtualClock> clock;
     std::shared_ptr<IUeRelayMock> ueRelayMock;
     testing::NiceMock<common::ILoggerMock> loggerMock;
 
@@ -55,7 +55,10 @@ UeConnectionTestSuite::UeConnectionTestSuite()
     ueSlotReattachedMock = std::make_shared<StrictMock<IUeSlotImplMock>>();
     syncGuard = std::make_shared<SyncGuard>();
     transportMock = std::make_shared<StrictMock<common::ITransportMock>>();
-    objectUnderTest = std::make_unique<UeConnection>(transportMock, loggerMock, syncGuard);
+    metrics = std::make_shared<RelayMetrics>(metricsRegistry);
+    trafficTop = std::make_shared<TrafficTop>();
+    reaper = std::make_shared<ConnectionReaper>(syncGuard, std::make_shared<common::VirtualClock>(), metrics, loggerMock);
+    objectUnderTest = std::make_unique<UeConnection>(transportMock, loggerMock, syncGuard, metrics, trafficTop, reaper);
     verifyAndClearExpectations();
 }
 
@@ -87,7 +90,10 @@ void UeConnectionTestSuite::assertDestruction()
 
 void UeConnectionTestSuite::TearDown()
 {
-    assertDestruction();
+    if (objectUnderTest)
+    {
+        assertDestruction();
+    }
     Test::TearDown();
 }
 
@@ -120,6 +126,7 @@ TEST_F(UeConnectionTestSuite, shallSendSibWithBtsId)
                        EqMessageBtsId(HEADER_SIZE, BTS_ID));
     EXPECT_CALL(*transportMock, sendMessage(EqSib));
     objectUnderTest->sendSib(BTS_ID);
+    ASSERT_EQ(1u, metricsRegistry.counter("bts_frames_sent_total", "", {{"message", "Sib"}}).value());
 }
 
 
@@ -187,6 +194,19 @@ TEST_F(UeConnectionWithConnectedTransportTestSuite, shallAcceptAttachOnRequestFr
     handleAttachRequest(PHONE);
     ASSERT_EQ(PHONE, objectUnderTest->getPhoneNumber());
     ASSERT_TRUE(objectUnderTest->isAttached());
+    ASSERT_EQ(1u, metricsRegistry.counter("bts_frames_received_total", "", {{"message", "AttachRequest"}}).value());
+}
+
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallMeasureAttachLatencyFromFirstSib)
+{
+    EXPECT_CALL(*transportMock, sendMessage(_)).Times(2);
+    objectUnderTest->sendSib(BTS_ID);
+    objectUnderTest->sendSib(BTS_ID);
+    EXPECT_CALL(*ueSlotNotAttachedMock, attach(PHONE)).WillOnce(Return(ueSlotAttachedMock));
+    EXPECT_CALL(*transportMock, sendMessage(eqAttachResponseMessage(true)));
+
+    handleAttachRequest(PHONE);
+    ASSERT_EQ(1u, metrics->attachLatency.count());
 }
 
 TEST_F(UeConnectionWithConnectedTransportTestSuite, shallRejectAttachOnRequestFromUeWithoutPhone)
@@ -284,6 +304,12 @@ TEST_F(UeConnectionAttachedTestSuite, shallForwardMessage)
     EXPECT_CALL(*ueSlotAttachedMock, sendMessage(matchMessage, OTHER_PHONE))
             .WillOnce(Return(true));
     ueMessageCallback(otherThanAttachRequestMessage);
+    ASSERT_EQ(1u, metrics->forwardLatency.count());
+
+    auto topReceivers = trafficTop->top(TrafficTop::Ranking::ReceivedBytes, 1u, TrafficTop::Clock::now());
+    ASSERT_EQ(1u, topReceivers.size());
+    ASSERT_EQ(OTHER_PHONE.value, topReceivers[0].key);
+    ASSERT_EQ(otherThanAttachRequestMessage.value.size(), topReceivers[0].count);
 }
 
 TEST_F(UeConnectionAttachedTestSuite, shallIndicateUnknownRecipientForMessageThatCannotBeForwarded)
@@ -298,6 +324,9 @@ TEST_F(UeConnectionAttachedTestSuite, shallIndicateUnknownRecipientForMessageTha
                                               EqMessageHeader(HEADER_SIZE, OTHER_THAN_ATTACH_REQUEST_MESSAGE, PHONE, OTHER_PHONE));
     EXPECT_CALL(*transportMock, sendMessage(matchUnknownRecipientMessage));
     ueMessageCallback(otherThanAttachRequestMessage);
+    ASSERT_EQ(1u, metrics->unknownRecipient.value());
+    ASSERT_EQ(1u, trafficTop->top(TrafficTop::Ranking::UnknownRecipient, 1u, TrafficTop::Clock::now()).size());
+    ASSERT_EQ(0u, metrics->forwardLatency.count());
 }
 
 TEST_F(UeConnectionAttachedTestSuite, shallIndicateUnknownSenderForMessageThatHasWrongFromPhone)
@@ -307,6 +336,7 @@ TEST_F(UeConnectionAttachedTestSuite, shallIndicateUnknownSenderForMessageThatHa
                                            EqMessageHeader(HEADER_SIZE, OTHER_THAN_ATTACH_REQUEST_MESSAGE, NOT_MY_PHONE, OTHER_PHONE));
     EXPECT_CALL(*transportMock, sendMessage(matchUnknownSenderMessage));
     ueMessageCallback(otherThanAttachRequestMessageWithWrongFromPhone);
+    ASSERT_EQ(1u, metrics->unknownSender.value());
 }
 
 TEST_F(UeConnectionAttachedTestSuite, shallHandleExceptionWhenHandlingMessage)
@@ -330,4 +360,60 @@ TEST_F(UeConnectionAttachedTestSuite, shallPrintAsAttached)
                     ));
 }
 
+TEST_F(UeConnectionAttachedTestSuite, shallMeasureEchoRoundTrip)
+{
+    BinaryMessage echo;
+    EXPECT_CALL(*transportMock, sendMessage(EqMessageHeader(0, MessageId::Echo, NO_PHONE, PHONE)))
+            .WillOnce(DoAll(SaveArg<0>(&echo), Return(true)));
+    objectUnderTest->sendEcho();
+    ASSERT_EQ(1u, metrics->echoRequests.value());
+
+    common::IncomingMessage echoReader(echo);
+    echoReader.readMessageHeader();
+    common::OutgoingMessage reply(MessageId::EchoReply, PHONE, NO_PHONE);
+    reply.writeNumber(echoReader.readNumber<std::uint32_t>());
+    reply.writeNumber(echoReader.readNumber<std::uint64_t>());
+    ueMessageCallback(reply.getMessage());
+
+    ASSERT_EQ(1u, metrics->echoReplies.value());
+    ASSERT_EQ(1u, metrics->echoRoundTrip.count());
+    std::ostringstream os;
+    objectUnderTest->printRoundTrip(os);
+    ASSERT_THAT(os.str(), AllOf(HasSubstr("echo sent: 1, replies: 1"), HasSubstr("rtt [ms] last: "),
+                                HasSubstr("smoothed: ")));
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallIgnoreEchoReplyFromTheFuture)
+{
+    common::OutgoingMessage reply(MessageId::EchoReply, PHONE, NO_PHONE);
+    reply.writeNumber(std::uint32_t{1});
+    const auto inOneHour = RelayMetrics::Clock::now().time_since_epoch() + std::chrono::hours(1);
+    reply.writeNumber(std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(inOneHour).count()));
+    ueMessageCallback(reply.getMessage());
+
+    ASSERT_EQ(0u, metrics->echoReplies.value());
+}
+
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallBeWatchedByReaperUntilDestroyed)
+{
+    ASSERT_EQ(1u, reaper->watchedCount());
+    assertDestruction();
+    ASSERT_EQ(0u, reaper->watchedCount());
+}
+
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallCountReceivedFrames)
+{
+    EXPECT_CALL(*ueSlotNotAttachedMock, attach(PHONE)).WillOnce(Return(ueSlotAttachedMock));
+    EXPECT_CALL(*transportMock, sendMessage(_));
+
+    handleAttachRequest(PHONE);
+    ASSERT_EQ(1u, objectUnderTest->framesReceived());
+}
+
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallCloseTransport)
+{
+    EXPECT_CALL(*transportMock, close());
+    objectUnderTest->close();
+}
+
 }
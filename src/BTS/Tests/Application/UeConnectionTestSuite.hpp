@@ -4,6 +4,7 @@
 #include "UeConnection/UeConnection.hpp"
 
 #include "Mocks/ITransportMock.hpp"
+#include "Time/VirtualClock.hpp"
 #include "Mocks/ILoggerMock.hpp"
 #include "Mocks/UeSlotMock.hpp"
 #include "Mocks/IUeConnectionMock.hpp"
@@ -27,6 +28,10 @@ protected:
     void verifyAndClearExpectations();
 
     SyncGuardPtr syncGuard;
+    common::MetricsRegistry metricsRegistry;
+    RelayMetricsPtr metrics;
+    TrafficTopPtr trafficTop;
+    ConnectionReaperPtr reaper;
     const BtsId BTS_ID{17};
     const std::string TRANSPORT_ADDRESS = "CDEF";
     const PhoneNumber NO_PHONE{};
@@ -0,0 +1,152 @@
+#include "AllocationCounter.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include "Memory/MemoryAccounting.hpp"
+
+namespace common
+{
+
+namespace
+{
+// plain thread_local of trivial type - no allocation, no destructor registration
+thread_local AllocationCount threadCount;
+
+// in front of every block - owner and size are needed to account the release
+struct alignas(16) BlockHeader
+{
+    std::uint64_t size;
+    std::uint32_t offset; // from start of malloc'ed memory to user pointer
+    MemoryTag tag;
+    bool accountedByAllocator; // TaggedAllocator or SlabPool counts it - not counted here twice
+};
+static_assert(sizeof(BlockHeader) == 16u, "Header shall keep malloc alignment of user pointer");
+
+[[maybe_unused]] const bool accountingActive = (MemoryAccounting::setActive(), true);
+
+void* account(void* memory, std::size_t size, std::size_t offset) noexcept
+{
+    if (not memory)
+    {
+        return nullptr;
+    }
+    ++threadCount.allocations;
+    threadCount.bytes += size;
+    void* pointer = static_cast<char*>(memory) + offset;
+    auto* header = static_cast<BlockHeader*>(pointer) - 1;
+    header->size = size;
+    header->offset = static_cast<std::uint32_t>(offset);
+    header->tag = currentMemoryTag();
+    header->accountedByAllocator = isAccountedByAllocator();
+    if (not header->accountedByAllocator)
+    {
+        MemoryAccounting::allocated(header->tag, size);
+    }
+    return pointer;
+}
+
+void* allocate(std::size_t size)
+{
+    return account(std::malloc(sizeof(BlockHeader) + size), size, sizeof(BlockHeader));
+}
+
+void* allocate(std::size_t size, std::align_val_t alignment)
+{
+    const std::size_t align = std::max(static_cast<std::size_t>(alignment), sizeof(BlockHeader));
+    // header goes into the padding before user pointer - aligned_alloc requires size to be multiple of alignment
+    const std::size_t total = align + size;
+    return account(std::aligned_alloc(align, (total + align - 1u) / align * align), size, align);
+}
+
+void deallocate(void* pointer) noexcept
+{
+    if (pointer)
+    {
+        ++threadCount.deallocations;
+        const auto* header = static_cast<BlockHeader*>(pointer) - 1;
+        if (not header->accountedByAllocator)
+        {
+            MemoryAccounting::deallocated(header->tag, header->size);
+        }
+        std::free(static_cast<char*>(pointer) - header->offset);
+    }
+}
+
+}
+
+AllocationCount threadAllocationCount() noexcept
+{
+    return threadCount;
+}
+
+AllocationCount operator-(const AllocationCount &end, const AllocationCount &start) noexcept
+{
+    return AllocationCount{end.allocations - start.allocations,
+                           end.deallocations - start.deallocations,
+                           end.bytes - start.bytes};
+}
+
+std::ostream &operator<<(std::ostream &os, const AllocationCount &count)
+{
+    return os << "allocations: " << count.allocations
+              << ", deallocations: " << count.deallocations
+              << ", bytes: " << count.bytes;
+}
+
+ScopedAllocationCounter::ScopedAllocationCounter() noexcept
+    : start(threadAllocationCount())
+{}
+
+AllocationCount ScopedAllocationCounter::count() const noexcept
+{
+    return threadAllocationCount() - start;
+}
+
+}
+
+void* operator new(std::size_t size)
+{
+    if (void* pointer = common::allocate(size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return common::allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return common::allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void* pointer = common::allocate(size, alignment))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept { common::deallocate(pointer); }
+void operator delete[](void* pointer) noexcept { common::deallocate(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { common::deallocate(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { common::deallocate(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { common::deallocate(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { common::deallocate(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { common::deallocate(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { common::deallocate(pointer); }
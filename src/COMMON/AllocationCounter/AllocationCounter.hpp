@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+namespace common
+{
+
+/**
+ * Heap usage of the calling thread, counted by replaced global operator new/delete.
+ * Only executables linked with AllocationCounter library are counted: tests and benchmarks always, BTS and UE
+ * only when built with -DSTH_HEAP_ACCOUNTING=ON - every block carries 16 byte header with its size and MemoryTag,
+ * the same operators feed MemoryAccounting with heap not counted by tagged allocators.
+ */
+struct AllocationCount
+{
+    std::uint64_t allocations = 0u;
+    std::uint64_t deallocations = 0u;
+    std::uint64_t bytes = 0u;
+};
+
+AllocationCount threadAllocationCount() noexcept;
+
+AllocationCount operator-(const AllocationCount& end, const AllocationCount& start) noexcept;
+std::ostream& operator<<(std::ostream& os, const AllocationCount& count);
+
+/**
+ * Heap usage of the calling thread since construction - allocation budget of a code path in unit tests:
+ *     ScopedAllocationCounter counter;
+ *     objectUnderTest.doSomething();
+ *     ASSERT_EQ(0u, counter.count().allocations) << counter.count();
+ * Work done by other threads is not counted.
+ */
+class ScopedAllocationCounter
+{
+public:
+    ScopedAllocationCounter() noexcept;
+
+    AllocationCount count() const noexcept;
+
+private:
+    const AllocationCount start;
+};
+
+}
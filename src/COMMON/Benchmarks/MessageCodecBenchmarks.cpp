@@ -0,0 +1,223 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <sstream>
+
+#include "Messages/IncomingMessage.hpp"
+#include "Messages/OutgoingMessage.hpp"
+
+/**
+ * Encode/decode primitives of COMMON/Messages.
+ * JSON for comparing commits: COMMON_BENCH --benchmark_out=codec.json --benchmark_out_format=json
+ */
+
+namespace common
+{
+
+namespace
+{
+
+constexpr std::size_t HEADER_SIZE = sizeof(MessageHeader);
+const MessageHeader HEADER{MessageId::Sms, PhoneNumber{12}, PhoneNumber{34}};
+
+// whole message sizes: header only ... biggest possible frame
+void messageSizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->RangeMultiplier(8)->Range(HEADER_SIZE, BinaryMessage::MAX_SIZE);
+}
+
+// bytes of numbers: one number ... biggest possible frame - no empty loop
+template <typename T>
+void numberSizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->RangeMultiplier(8)->Range(sizeof(T), BinaryMessage::MAX_SIZE);
+}
+
+BinaryMessage message(std::size_t size)
+{
+    OutgoingMessage builder;
+    builder.writeMessageHeader(HEADER);
+    builder.writeText(std::string(size - HEADER_SIZE, 'x'));
+    return builder.getMessage();
+}
+
+void setBytesProcessed(benchmark::State& state, std::size_t bytesPerIteration)
+{
+    state.SetBytesProcessed(std::int64_t(state.iterations()) * std::int64_t(bytesPerIteration));
+}
+
+void setBytesProcessed(benchmark::State& state)
+{
+    setBytesProcessed(state, state.range(0));
+}
+
+}
+
+void BM_OutgoingMessage_writeMessageHeader(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        OutgoingMessage builder;
+        builder.writeMessageHeader(HEADER);
+        benchmark::DoNotOptimize(builder.getMessage());
+    }
+}
+BENCHMARK(BM_OutgoingMessage_writeMessageHeader);
+
+template <typename T>
+void BM_OutgoingMessage_writeNumber(benchmark::State& state)
+{
+    const std::size_t count = state.range(0) / sizeof(T);
+    for (auto _ : state)
+    {
+        OutgoingMessage builder;
+        for (std::size_t i = 0u; i < count; ++i)
+        {
+            builder.writeNumber(static_cast<T>(i));
+        }
+        benchmark::DoNotOptimize(builder.getMessage());
+    }
+    setBytesProcessed(state, count * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_OutgoingMessage_writeNumber, std::uint8_t)->Apply(numberSizes<std::uint8_t>);
+BENCHMARK_TEMPLATE(BM_OutgoingMessage_writeNumber, std::uint32_t)->Apply(numberSizes<std::uint32_t>);
+BENCHMARK_TEMPLATE(BM_OutgoingMessage_writeNumber, std::uint64_t)->Apply(numberSizes<std::uint64_t>);
+
+void BM_OutgoingMessage_writeText(benchmark::State& state)
+{
+    const std::string text(state.range(0) - HEADER_SIZE, 'x');
+    for (auto _ : state)
+    {
+        OutgoingMessage builder{HEADER.messageId, HEADER.from, HEADER.to};
+        builder.writeText(text);
+        benchmark::DoNotOptimize(builder.getMessage());
+    }
+    setBytesProcessed(state);
+}
+BENCHMARK(BM_OutgoingMessage_writeText)->Apply(messageSizes);
+
+void BM_IncomingMessage_readMessageHeader(benchmark::State& state)
+{
+    const BinaryMessage encoded = message(HEADER_SIZE);
+    for (auto _ : state)
+    {
+        IncomingMessage reader(encoded);
+        benchmark::DoNotOptimize(reader.readMessageHeader());
+    }
+}
+BENCHMARK(BM_IncomingMessage_readMessageHeader);
+
+template <typename T>
+void BM_IncomingMessage_readNumber(benchmark::State& state)
+{
+    const BinaryMessage encoded = message(std::max<std::size_t>(state.range(0), HEADER_SIZE));
+    const std::size_t count = state.range(0) / sizeof(T);
+    for (auto _ : state)
+    {
+        IncomingMessage reader(encoded);
+        for (std::size_t i = 0u; i < count; ++i)
+        {
+            benchmark::DoNotOptimize(reader.readNumber<T>());
+        }
+    }
+    setBytesProcessed(state, count * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_IncomingMessage_readNumber, std::uint8_t)->Apply(numberSizes<std::uint8_t>);
+BENCHMARK_TEMPLATE(BM_IncomingMessage_readNumber, std::uint32_t)->Apply(numberSizes<std::uint32_t>);
+BENCHMARK_TEMPLATE(BM_IncomingMessage_readNumber, std::uint64_t)->Apply(numberSizes<std::uint64_t>);
+
+void BM_IncomingMessage_readRemainingText(benchmark::State& state)
+{
+    const BinaryMessage encoded = message(state.range(0));
+    for (auto _ : state)
+    {
+        IncomingMessage reader(encoded);
+        reader.readMessageHeader();
+        benchmark::DoNotOptimize(reader.readRemainingText());
+    }
+    setBytesProcessed(state);
+}
+BENCHMARK(BM_IncomingMessage_readRemainingText)->Apply(messageSizes);
+
+void BM_BinaryMessage_writeHex(benchmark::State& state)
+{
+    const BinaryMessage encoded = message(state.range(0));
+    for (auto _ : state)
+    {
+        std::ostringstream os;
+        os << encoded;
+        benchmark::DoNotOptimize(os.str());
+    }
+    setBytesProcessed(state);
+}
+BENCHMARK(BM_BinaryMessage_writeHex)->Apply(messageSizes);
+
+void BM_BinaryMessage_readHex(benchmark::State& state)
+{
+    std::ostringstream os;
+    os << message(state.range(0));
+    const std::string hex = os.str();
+    for (auto _ : state)
+    {
+        std::istringstream is(hex);
+        BinaryMessage decoded;
+        is >> decoded;
+        benchmark::DoNotOptimize(decoded);
+    }
+    setBytesProcessed(state);
+}
+BENCHMARK(BM_BinaryMessage_readHex)->Apply(messageSizes);
+
+void BM_LimitedVector_push_back(benchmark::State& state)
+{
+    const std::size_t size = state.range(0);
+    for (auto _ : state)
+    {
+        BinaryMessage::Value value;
+        for (std::size_t i = 0u; i < size; ++i)
+        {
+            value.push_back(static_cast<BinaryMessage::ValueType>(i));
+        }
+        benchmark::DoNotOptimize(value.data());
+    }
+    setBytesProcessed(state);
+}
+BENCHMARK(BM_LimitedVector_push_back)->Apply(messageSizes);
+
+void BM_PhoneNumber_format(benchmark::State& state)
+{
+    std::ostringstream os;
+    for (auto _ : state)
+    {
+        os.str({});
+        os << HEADER.from;
+        benchmark::DoNotOptimize(os);
+    }
+}
+BENCHMARK(BM_PhoneNumber_format);
+
+void BM_MessageId_format(benchmark::State& state)
+{
+    std::ostringstream os;
+    for (auto _ : state)
+    {
+        os.str({});
+        os << HEADER.messageId;
+        benchmark::DoNotOptimize(os);
+    }
+}
+BENCHMARK(BM_MessageId_format);
+
+void BM_MessageId_parse(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::istringstream is("CallTalk");
+        MessageId messageId{};
+        is >> messageId;
+        benchmark::DoNotOptimize(messageId);
+    }
+}
+BENCHMARK(BM_MessageId_parse);
+
+}
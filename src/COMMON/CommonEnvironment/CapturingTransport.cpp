@@ -0,0 +1,47 @@
+#include "CapturingTransport.hpp"
+
+namespace common
+{
+
+CapturingTransport::CapturingTransport(std::shared_ptr<ITransport> transport, std::shared_ptr<CaptureWriter> captureWriter)
+    : transport(std::move(transport)),
+      captureWriter(std::move(captureWriter)),
+      connectionId(this->captureWriter->newConnectionId())
+{}
+
+void CapturingTransport::registerMessageCallback(MessageCallback messageCallback)
+{
+    if (not messageCallback)
+    {
+        transport->registerMessageCallback(nullptr);
+        return;
+    }
+    transport->registerMessageCallback([captureWriter = captureWriter, connectionId = connectionId, messageCallback](BinaryMessage message)
+    {
+        captureWriter->write(connectionId, CaptureRecord::Direction::Received, message);
+        messageCallback(std::move(message));
+    });
+}
+
+void CapturingTransport::registerDisconnectedCallback(DisconnectedCallback disconnectedCallback)
+{
+    transport->registerDisconnectedCallback(std::move(disconnectedCallback));
+}
+
+bool CapturingTransport::sendMessage(BinaryMessage message)
+{
+    captureWriter->write(connectionId, CaptureRecord::Direction::Sent, message);
+    return transport->sendMessage(std::move(message));
+}
+
+void CapturingTransport::close()
+{
+    transport->close();
+}
+
+std::string CapturingTransport::addressToString() const
+{
+    return transport->addressToString();
+}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <memory>
+#include "ITransport.hpp"
+#include "Trace/CaptureFile.hpp"
+
+namespace common
+{
+
+/**
+ * Transport decorator writing every received and sent frame to capture file
+ */
+class CapturingTransport : public ITransport
+{
+public:
+    CapturingTransport(std::shared_ptr<ITransport> transport, std::shared_ptr<CaptureWriter> captureWriter);
+
+    void registerMessageCallback(MessageCallback messageCallback) override;
+    void registerDisconnectedCallback(DisconnectedCallback disconnectedCallback) override;
+    bool sendMessage(BinaryMessage message) override;
+    void close() override;
+    std::string addressToString() const override;
+
+private:
+    std::shared_ptr<ITransport> transport;
+    std::shared_ptr<CaptureWriter> captureWriter;
+    const std::uint32_t connectionId;
+};
+
+}
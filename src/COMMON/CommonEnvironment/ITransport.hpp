@@ -18,6 +18,10 @@ public:
     virtual void registerDisconnectedCallback(DisconnectedCallback) = 0;
 
     virtual bool sendMessage(BinaryMessage) = 0;
+    /**
+     * Drops the connection at once - disconnected callback follows, but never from inside close
+     */
+    virtual void close() = 0;
 
     virtual std::string addressToString() const = 0;
 };
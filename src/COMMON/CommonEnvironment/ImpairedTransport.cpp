@@ -0,0 +1,298 @@
+#include "ImpairedTransport.hpp"
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <stdexcept>
+
+namespace common
+{
+
+LinkImpairment LinkImpairment::fromConfiguration(const MultiLineConfig &configuration)
+{
+    LinkImpairment impairment;
+    impairment.latency = std::chrono::microseconds(configuration.getNumber<std::uint32_t>("net_latency_us", 0u));
+    impairment.jitter = std::chrono::microseconds(configuration.getNumber<std::uint32_t>("net_jitter_us", 0u));
+    impairment.bytesPerSecond = configuration.getNumber<std::uint64_t>("net_bandwidth_bytes_s", 0u);
+    impairment.reorderPercent = configuration.getNumber<unsigned>("net_reorder_percent", 0u);
+    impairment.meanTimeBetweenDisconnects =
+        std::chrono::milliseconds(configuration.getNumber<std::uint32_t>("net_disconnect_mtbf_ms", 0u));
+    impairment.outageDuration = std::chrono::milliseconds(configuration.getNumber<std::uint32_t>("net_outage_ms", 1000u));
+    impairment.seed = configuration.getNumber<std::uint64_t>("net_seed", 0u);
+    if (impairment.reorderPercent > 100u)
+    {
+        throw std::invalid_argument("net_reorder_percent shall be at most 100");
+    }
+    return impairment;
+}
+
+bool LinkImpairment::isActive() const
+{
+    return latency.count() != 0 or jitter.count() != 0 or bytesPerSecond != 0u
+        or reorderPercent != 0u or meanTimeBetweenDisconnects.count() != 0;
+}
+
+/**
+ * State shared with clock timers - they keep only weak pointer, so pending frames of destroyed transport are dropped
+ */
+class ImpairedTransport::Link : public std::enable_shared_from_this<Link>
+{
+public:
+    Link(std::shared_ptr<ITransport> transport, IClock& clock, LinkImpairment impairment, Post post)
+        : transport(std::move(transport)),
+          clock(clock),
+          impairment(impairment),
+          post(std::move(post)),
+          random(impairment.seed)
+    {}
+
+    void start()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        scheduleOutage();
+    }
+
+    void stop()
+    {
+        std::optional<IClock::TimerId> timer;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            timer.swap(outageTimer);
+            messageCallback = nullptr;
+        }
+        if (timer)
+        {
+            clock.cancel(*timer);
+        }
+    }
+
+    void registerMessageCallback(MessageCallback callback)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            messageCallback = std::move(callback);
+        }
+        transport->registerMessageCallback([weakLink = weak_from_this()](BinaryMessage message)
+        {
+            if (auto link = weakLink.lock())
+            {
+                link->receive(std::move(message));
+            }
+        });
+    }
+
+    void registerDisconnectedCallback(DisconnectedCallback callback)
+    {
+        // real disconnection is passed on at once - nothing left to delay
+        transport->registerDisconnectedCallback(std::move(callback));
+    }
+
+    bool send(BinaryMessage message)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (not up)
+        {
+            return false;
+        }
+        const IClock::TimePoint arrival = arrivalTime(outgoing, message.value.size());
+        clock.scheduleAt(arrival, [weakLink = weak_from_this(), epoch = epoch, message = std::move(message)]() mutable
+        {
+            if (auto link = weakLink.lock(); link and link->isCurrent(epoch))
+            {
+                link->transport->sendMessage(std::move(message));
+            }
+        });
+        return true;
+    }
+
+    void close()
+    {
+        transport->close();
+    }
+
+    std::string addressToString() const
+    {
+        return transport->addressToString();
+    }
+
+private:
+    struct Pacing
+    {
+        IClock::TimePoint linkFreeAt{};
+        IClock::TimePoint lastArrival{};
+    };
+
+    void receive(BinaryMessage message)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (not up)
+        {
+            return;
+        }
+        const IClock::TimePoint arrival = arrivalTime(incoming, message.value.size());
+        clock.scheduleAt(arrival, [weakLink = weak_from_this(), epoch = epoch, message = std::move(message)]() mutable
+        {
+            if (auto link = weakLink.lock())
+            {
+                link->deliver(epoch, std::move(message));
+            }
+        });
+    }
+
+    void deliver(std::uint64_t messageEpoch, BinaryMessage message)
+    {
+        // callback taken where it is called - not one unregistered since the frame arrived
+        auto handOn = [weakLink = weak_from_this(), messageEpoch, message = std::move(message)]() mutable
+        {
+            if (auto link = weakLink.lock())
+            {
+                if (auto callback = link->currentMessageCallback(messageEpoch))
+                {
+                    callback(std::move(message));
+                }
+            }
+        };
+        if (post)
+        {
+            post(std::move(handOn));
+        }
+        else
+        {
+            handOn();
+        }
+    }
+
+    bool isCurrent(std::uint64_t messageEpoch)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return up and epoch == messageEpoch;
+    }
+
+    MessageCallback currentMessageCallback(std::uint64_t messageEpoch)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return up and epoch == messageEpoch ? messageCallback : nullptr;
+    }
+
+    IClock::TimePoint arrivalTime(Pacing& pacing, std::size_t size)
+    {
+        using namespace std::chrono;
+        IClock::TimePoint departure = std::max(clock.now(), pacing.linkFreeAt);
+        if (impairment.bytesPerSecond != 0u)
+        {
+            departure += duration_cast<IClock::Duration>(duration<double>(double(size) / double(impairment.bytesPerSecond)));
+            pacing.linkFreeAt = departure;
+        }
+        const IClock::Duration jitter{std::uniform_int_distribution<IClock::Duration::rep>(
+                                          0, duration_cast<IClock::Duration>(impairment.jitter).count())(random)};
+        IClock::TimePoint arrival = departure + impairment.latency + jitter;
+        if (impairment.reorderPercent != 0u
+            and std::uniform_int_distribution<unsigned>(0u, 99u)(random) < impairment.reorderPercent)
+        {
+            return arrival + impairment.latency + impairment.jitter;
+        }
+        // in order otherwise - jitter does not let frames overtake each other
+        arrival = std::max(arrival, pacing.lastArrival);
+        pacing.lastArrival = arrival;
+        return arrival;
+    }
+
+    void scheduleOutage()
+    {
+        if (impairment.meanTimeBetweenDisconnects.count() == 0)
+        {
+            return;
+        }
+        const std::chrono::duration<double, std::milli> delay{std::exponential_distribution<double>(
+            1.0 / double(impairment.meanTimeBetweenDisconnects.count()))(random)};
+        outageTimer = clock.scheduleAfter(std::chrono::duration_cast<IClock::Duration>(delay),
+                                          [weakLink = weak_from_this()]
+        {
+            if (auto link = weakLink.lock())
+            {
+                link->beginOutage();
+            }
+        });
+    }
+
+    void beginOutage()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            up = false;
+            ++epoch;
+            outageTimer = clock.scheduleAfter(impairment.outageDuration, [weakLink = weak_from_this()]
+            {
+                if (auto link = weakLink.lock())
+                {
+                    link->endOutage();
+                }
+            });
+        }
+        // not under mutex - disconnected callback of underlying transport follows, passed on as registered
+        transport->close();
+    }
+
+    void endOutage()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        up = true;
+        outgoing = Pacing{};
+        incoming = Pacing{};
+        scheduleOutage();
+    }
+
+    std::shared_ptr<ITransport> transport;
+    IClock& clock;
+    const LinkImpairment impairment;
+    const Post post;
+
+    std::mutex mutex;
+    std::mt19937_64 random;
+    MessageCallback messageCallback;
+    bool up = true;
+    // frames scheduled before an outage carry old epoch and are dropped
+    std::uint64_t epoch = 0u;
+    Pacing outgoing;
+    Pacing incoming;
+    std::optional<IClock::TimerId> outageTimer;
+};
+
+ImpairedTransport::ImpairedTransport(std::shared_ptr<ITransport> transport, IClock &clock, LinkImpairment impairment,
+                                     Post post)
+    : link(std::make_shared<Link>(std::move(transport), clock, impairment, std::move(post)))
+{
+    link->start();
+}
+
+ImpairedTransport::~ImpairedTransport()
+{
+    link->stop();
+}
+
+void ImpairedTransport::registerMessageCallback(MessageCallback messageCallback)
+{
+    link->registerMessageCallback(std::move(messageCallback));
+}
+
+void ImpairedTransport::registerDisconnectedCallback(DisconnectedCallback disconnectedCallback)
+{
+    link->registerDisconnectedCallback(std::move(disconnectedCallback));
+}
+
+bool ImpairedTransport::sendMessage(BinaryMessage message)
+{
+    return link->send(std::move(message));
+}
+
+void ImpairedTransport::close()
+{
+    link->close();
+}
+
+std::string ImpairedTransport::addressToString() const
+{
+    return link->addressToString();
+}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "ITransport.hpp"
+#include "Config/MultiLineConfig.hpp"
+#include "Time/IClock.hpp"
+
+namespace common
+{
+
+/**
+ * Poor link conditions - applied to each direction separately
+ */
+struct LinkImpairment
+{
+    std::chrono::microseconds latency{};
+    // uniformly distributed extra delay
+    std::chrono::microseconds jitter{};
+    // zero - no cap, otherwise frames queue behind each other
+    std::uint64_t bytesPerSecond = 0u;
+    // such frames are held back by one more latency + jitter and overtaken by next ones
+    unsigned reorderPercent = 0u;
+    // zero - never, otherwise exponentially distributed time between outages
+    std::chrono::milliseconds meanTimeBetweenDisconnects{};
+    std::chrono::milliseconds outageDuration{1000};
+    std::uint64_t seed = 0u;
+
+    /**
+     * Keys: net_latency_us, net_jitter_us, net_bandwidth_bytes_s, net_reorder_percent,
+     *       net_disconnect_mtbf_ms, net_outage_ms, net_seed
+     * @throw std::invalid_argument for reorder percent above 100
+     */
+    static LinkImpairment fromConfiguration(const MultiLineConfig& configuration);
+
+    bool isActive() const;
+};
+
+/**
+ * Transport decorator delaying, pacing and reordering frames in both directions, with simulated outages.
+ * Outage closes the underlying connection - both sides see a real disconnection, reconnecting is up to the owner
+ * of the underlying transport (as after any lost connection). Frames in flight are dropped, and so are frames
+ * in both directions until the outage ends, also over a connection reopened meanwhile.
+ * Delayed frames are passed on from clock timer callbacks, clock must outlive this transport.
+ * Received frames are handed to the message callback through post - on the loop that registers callbacks,
+ * so a callback unregistered there is never called afterwards. Without post they are handed on from the timer
+ * callback: only for clocks whose timers run on that loop (VirtualClock, Qt timers).
+ */
+class ImpairedTransport : public ITransport
+{
+public:
+    using Post = std::function<void(std::function<void()>)>;
+
+    ImpairedTransport(std::shared_ptr<ITransport> transport, IClock& clock, LinkImpairment impairment,
+                      Post post = {});
+    ~ImpairedTransport() override;
+
+    void registerMessageCallback(MessageCallback messageCallback) override;
+    void registerDisconnectedCallback(DisconnectedCallback disconnectedCallback) override;
+    bool sendMessage(BinaryMessage message) override;
+    void close() override;
+    std::string addressToString() const override;
+
+private:
+    class Link;
+
+    std::shared_ptr<Link> link;
+};
+
+}
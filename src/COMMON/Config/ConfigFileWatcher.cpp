@@ -0,0 +1,100 @@
+#include "ConfigFileWatcher.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace common
+{
+
+ConfigFileWatcher::ConfigFileWatcher(const std::string &path, ReloadableConfig &config, Loader loader, ILogger &logger)
+    : config(config),
+      loader(std::move(loader)),
+      logger(logger, "[CONFIG]")
+{
+    const auto slash = path.rfind('/');
+    const std::string directory = slash == std::string::npos ? "." : path.substr(0u, slash + 1u);
+    fileName = slash == std::string::npos ? path : path.substr(slash + 1u);
+
+    inotifyDescriptor = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyDescriptor < 0
+        or ::inotify_add_watch(inotifyDescriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0
+        or ::pipe2(stopPipe, O_CLOEXEC) != 0)
+    {
+        this->logger.logError("Cannot watch: ", path, " - ", std::strerror(errno), " - no reload on change");
+        return;
+    }
+    running = true;
+    watcher = std::thread(std::bind(&ConfigFileWatcher::run, this));
+}
+
+ConfigFileWatcher::~ConfigFileWatcher()
+{
+    if (running.exchange(false))
+    {
+        const char wakeUp = 0;
+        [[maybe_unused]] auto written = ::write(stopPipe[1], &wakeUp, sizeof(wakeUp));
+        watcher.join();
+    }
+    for (int descriptor : {inotifyDescriptor, stopPipe[0], stopPipe[1]})
+    {
+        if (descriptor >= 0)
+        {
+            ::close(descriptor);
+        }
+    }
+}
+
+void ConfigFileWatcher::run()
+{
+    while (running)
+    {
+        if (waitForChange())
+        {
+            reload();
+        }
+    }
+}
+
+bool ConfigFileWatcher::waitForChange()
+{
+    // sleeps until change or stop - no periodic wake ups in idle process
+    pollfd pollDescriptors[] = {{inotifyDescriptor, POLLIN, 0}, {stopPipe[0], POLLIN, 0}};
+    if (::poll(pollDescriptors, 2, -1) <= 0 or not running)
+    {
+        return false;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    bool changed = false;
+    ssize_t length;
+    while ((length = ::read(inotifyDescriptor, buffer, sizeof(buffer))) > 0)
+    {
+        for (char* position = buffer; position < buffer + length; )
+        {
+            auto* event = reinterpret_cast<inotify_event*>(position);
+            if (event->len > 0u and fileName == event->name)
+            {
+                changed = true;
+            }
+            position += sizeof(inotify_event) + event->len;
+        }
+    }
+    return changed;
+}
+
+void ConfigFileWatcher::reload()
+{
+    try
+    {
+        config.publish(loader());
+        logger.logInfo("Reloaded: ", fileName);
+    }
+    catch (std::exception& ex)
+    {
+        logger.logError("Reload of: ", fileName, " failed: ", ex.what());
+    }
+}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include "ReloadableConfig.hpp"
+#include "Logger/PrefixedLogger.hpp"
+
+namespace common
+{
+
+/**
+ * Watches config file (via inotify on its directory - editors usually replace files)
+ * and publishes freshly loaded snapshot after each change.
+ */
+class ConfigFileWatcher
+{
+public:
+    using Loader = std::function<ReloadableConfig::Snapshot()>;
+
+    ConfigFileWatcher(const std::string& path, ReloadableConfig& config, Loader loader, ILogger& logger);
+    ~ConfigFileWatcher();
+
+private:
+    void run();
+    bool waitForChange();
+    void reload();
+
+    std::string fileName;
+    ReloadableConfig& config;
+    Loader loader;
+    PrefixedLogger logger;
+    int inotifyDescriptor = -1;
+    int stopPipe[2] = {-1, -1};
+    std::atomic_bool running{false};
+    std::thread watcher;
+};
+
+}
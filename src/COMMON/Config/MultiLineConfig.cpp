@@ -1,9 +1,114 @@
 #include "MultiLineConfig.hpp"
-#include <regex>
+#include <charconv>
+#include <limits>
 
 namespace common
 {
 
+namespace
+{
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+std::string_view trim(std::string_view text)
+{
+    while (not text.empty() and isSpace(text.front()))
+    {
+        text.remove_prefix(1u);
+    }
+    while (not text.empty() and isSpace(text.back()))
+    {
+        text.remove_suffix(1u);
+    }
+    return text;
+}
+
+struct Number
+{
+    bool ok = false;
+    bool outOfRange = false;
+    bool negative = false;
+    unsigned long long magnitude = 0u;
+};
+
+// same syntax as std::stoll(text, &pos, 0) consuming whole text: [+-][0x|0X|0]digits
+Number parseNumber(std::string_view text)
+{
+    Number number{};
+    if (not text.empty() and (text.front() == '+' or text.front() == '-'))
+    {
+        number.negative = text.front() == '-';
+        text.remove_prefix(1u);
+    }
+    int base = 10;
+    if (text.size() > 2u and text[0] == '0' and (text[1] == 'x' or text[1] == 'X'))
+    {
+        base = 16;
+        text.remove_prefix(2u);
+    }
+    else if (text.size() > 1u and text[0] == '0')
+    {
+        base = 8;
+        text.remove_prefix(1u);
+    }
+    if (text.empty())
+    {
+        return number;
+    }
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), number.magnitude, base);
+    if (end != text.data() + text.size())
+    {
+        return number;
+    }
+    number.ok = error == std::errc{};
+    number.outOfRange = error == std::errc::result_out_of_range;
+    return number;
+}
+
+}
+
+MultiLineConfig::Value::Value(std::string valueText)
+    : text(std::move(valueText)),
+      signedStatus(NumberStatus::Invalid),
+      unsignedStatus(NumberStatus::Invalid)
+{
+    using Signed = Details::NumberTypeToRead<true>;
+    using Unsigned = Details::NumberTypeToRead<false>;
+    const Number number = parseNumber(text);
+    if (number.outOfRange)
+    {
+        signedStatus = unsignedStatus = NumberStatus::OutOfRange;
+    }
+    if (not number.ok)
+    {
+        return;
+    }
+
+    const Unsigned maxSignedMagnitude = static_cast<Unsigned>(std::numeric_limits<Signed>::max()) + (number.negative ? 1u : 0u);
+    if (number.magnitude > maxSignedMagnitude)
+    {
+        signedStatus = NumberStatus::OutOfRange;
+    }
+    else
+    {
+        signedStatus = NumberStatus::Ok;
+        signedNumber = number.negative ? static_cast<Signed>(0u - number.magnitude) : static_cast<Signed>(number.magnitude);
+    }
+
+    if (number.negative and number.magnitude != 0u)
+    {
+        unsignedStatus = NumberStatus::OutOfRange;
+    }
+    else
+    {
+        unsignedStatus = NumberStatus::Ok;
+        unsignedNumber = number.magnitude;
+    }
+}
+
 MultiLineConfig::MultiLineConfig(std::istream &is)
 {
     std::string line;
@@ -39,22 +144,13 @@ MultiLineConfig::MultiLineConfig(int argc, char *argv[])
 
 std::string MultiLineConfig::getString(const std::string& key) const
 {
-    auto it = values.find(key);
-    if (it == values.end())
-        throw std::invalid_argument("Key not present: \"" + key + "\"");
-    return it->second;
+    return at(key).text;
 }
 
 std::string MultiLineConfig::getString(const std::string &key, const std::string &defaultValue) const
 {
-    try
-    {
-        return getString(key);
-    }
-    catch (std::invalid_argument&)
-    {
-        return defaultValue;
-    }
+    auto it = values.find(key);
+    return it == values.end() ? defaultValue : it->second.text;
 }
 
 void MultiLineConfig::insertFrom(const MultiLineConfig &other)
@@ -62,66 +158,44 @@ void MultiLineConfig::insertFrom(const MultiLineConfig &other)
     values.insert(other.values.begin(), other.values.end());
 }
 
-const MultiLineConfig::KeyValueRegex MultiLineConfig::keyValueRegex = makeKeyValueRegex();
-MultiLineConfig::KeyValueRegex MultiLineConfig::makeKeyValueRegex()
-{
-    KeyValueRegex returnValue{};
-    // ignoring leading and following whitespaces,
-    // takes everything that is not any of "=#"
-    const std::string keyRegex = "\\s*([^\\s=#]([^=#]*[^\\s=#])?)\\s*";
-    // str(2) is key                  ^^^^^^^^^^^^^^^^^^^^^^^^^^^
-    // str(3) is key w/o 1st char              ^^^^^^^^^^^^^^^^
-    returnValue.keyIndex = 2;
-
-    // ignoring leading and following whitespaces,
-    // takes everything that is not "#"
-    const std::string valueRegex = "\\s*([^\\s#]([^#]*[^\\s#])?)?\\s*";
-    // str(4) is value                  ^^^^^^^^^^^^^^^^^^^^^^^^
-    // str(5) is value w/o 1st char             ^^^^^^^^^^^^^
-    returnValue.valueIndex = 4;
-
-    returnValue.lineRegex = std::regex("(" + keyRegex + "=" + valueRegex + ")?(#.*)?");
-    // str(1) is key=value              ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-    // str(6) is for comment                                                  ^^^^^
-
-    return returnValue;
+const MultiLineConfig::Value &MultiLineConfig::at(const Key &key) const
+{
+    auto it = values.find(key);
+    if (it == values.end())
+        throw std::invalid_argument("Key not present: \"" + key + "\"");
+    return it->second;
 }
 
-void MultiLineConfig::parseLine(const std::string &line)
+void MultiLineConfig::parseLine(std::string_view line)
 {
-    std::smatch matchKeyValue;
-    if (std::regex_search(line, matchKeyValue, keyValueRegex.lineRegex)
-        && matchKeyValue.size() >= std::max(keyValueRegex.keyIndex, keyValueRegex.valueIndex))
+    // [ws] key [ws] = [ws] value [ws] [# comment]
+    // key cannot contain "=#", value cannot contain "#"
+    const auto comment = line.find('#');
+    line = line.substr(0u, comment);
+    const auto equalSign = line.find('=');
+    if (equalSign == std::string_view::npos)
     {
-        std::string key = matchKeyValue.str(keyValueRegex.keyIndex);
-        std::string value = matchKeyValue.str(keyValueRegex.valueIndex);
-        if (not key.empty())
-        {
-            values[key] = value;
-        }
+        return;
     }
-}
-
-void MultiLineConfig::assertNumberLength(std::size_t readSequenceLength, const std::string &text) const
-{
-    if (readSequenceLength != text.length())
+    const std::string_view key = trim(line.substr(0u, equalSign));
+    if (key.empty())
     {
-        throw std::invalid_argument("There are characters in \"" + text + "\" after pos: " + std::to_string(readSequenceLength));
+        return;
     }
+    const std::string_view value = trim(line.substr(equalSign + 1u));
+    values.insert_or_assign(std::string(key), Value(std::string(value)));
 }
 
-void MultiLineConfig::getNumber(Details::NumberTypeToRead<true> &valueToRetrieve, const std::string &text) const
+MultiLineConfig::NumberStatus MultiLineConfig::readNumber(const Value &value, Details::NumberTypeToRead<true> &valueToRetrieve)
 {
-    std::size_t pos = 0;
-    valueToRetrieve = stoll(text, &pos, 0);
-    assertNumberLength(pos, text);
+    valueToRetrieve = value.signedNumber;
+    return value.signedStatus;
 }
 
-void MultiLineConfig::getNumber(Details::NumberTypeToRead<false> &valueToRetrieve, const std::string &text) const
+MultiLineConfig::NumberStatus MultiLineConfig::readNumber(const Value &value, Details::NumberTypeToRead<false> &valueToRetrieve)
 {
-    std::size_t pos = 0;
-    valueToRetrieve = stoull(text, &pos, 0);
-    assertNumberLength(pos, text);
+    valueToRetrieve = value.unsignedNumber;
+    return value.unsignedStatus;
 }
 
 }
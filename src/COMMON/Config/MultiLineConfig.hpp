@@ -7,7 +7,7 @@
 #include <stdexcept>
 #include <cstdint>
 #include <map>
-#include <regex>
+#include <string_view>
 
 namespace common
 {
@@ -88,54 +88,82 @@ public:
     void insertFrom(const MultiLineConfig& other);
 
 private:
-    void parseLine(const std::string& line);
+    enum class NumberStatus : std::uint8_t
+    {
+        Ok,
+        Invalid,
+        OutOfRange
+    };
 
-    void getNumber(Details::NumberTypeToRead<true>& valueToRetrieve, const std::string& text) const;
-    void getNumber(Details::NumberTypeToRead<false>& valueToRetrieve, const std::string& text) const;
+    // numbers are parsed once - when value is inserted
+    struct Value
+    {
+        explicit Value(std::string text);
 
-    void assertNumberLength(std::size_t readSequenceLength, const std::string& text) const;
+        std::string text;
+        NumberStatus signedStatus;
+        NumberStatus unsignedStatus;
+        Details::NumberTypeToRead<true> signedNumber{};
+        Details::NumberTypeToRead<false> unsignedNumber{};
+    };
 
-    using Values = std::map<Key,std::string>;
-    Values values;
+    void parseLine(std::string_view line);
 
-    struct KeyValueRegex
-    {
-        std::smatch::size_type keyIndex;
-        std::smatch::size_type valueIndex;
-        std::regex lineRegex;
-    };
+    const Value& at(const Key& key) const;
+
+    template <typename T>
+    static NumberStatus readNumber(const Value& value, T& valueToRetrieve);
+    static NumberStatus readNumber(const Value& value, Details::NumberTypeToRead<true>& valueToRetrieve);
+    static NumberStatus readNumber(const Value& value, Details::NumberTypeToRead<false>& valueToRetrieve);
 
-    static KeyValueRegex makeKeyValueRegex();
-    static const KeyValueRegex keyValueRegex;
+    using Values = std::map<Key, Value, std::less<>>;
+    Values values;
 };
 
 
 template <typename T>
-T MultiLineConfig::getNumber(const Key& key) const
+MultiLineConfig::NumberStatus MultiLineConfig::readNumber(const Value& value, T& valueToRetrieve)
 {
     Details::NumberTypeToRead<std::is_signed<T>::value> numberFromText{};
-    getNumber(numberFromText, this->getString(key));
-
-    T returnValue = static_cast<T>(numberFromText);
-
-    if (returnValue != numberFromText)
+    NumberStatus status = readNumber(value, numberFromText);
+    if (status == NumberStatus::Ok)
     {
-        throw std::out_of_range(std::to_string(numberFromText) + " is out of range!");
+        valueToRetrieve = static_cast<T>(numberFromText);
+        if (valueToRetrieve != numberFromText)
+        {
+            status = NumberStatus::OutOfRange;
+        }
     }
+    return status;
+}
 
+template <typename T>
+T MultiLineConfig::getNumber(const Key& key) const
+{
+    const Value& value = at(key);
+    T returnValue{};
+    switch (readNumber(value, returnValue))
+    {
+    case NumberStatus::Ok:
+        break;
+    case NumberStatus::Invalid:
+        throw std::invalid_argument("\"" + value.text + "\" is not a number");
+    case NumberStatus::OutOfRange:
+        throw std::out_of_range(value.text + " is out of range!");
+    }
     return returnValue;
 }
 
 template <typename T>
 T MultiLineConfig::getNumber(const Key& key, T defaultValue) const
 {
-    try
-    {
-        return this->template getNumber<T>(key);
-    }
-    catch (std::exception&)
+    auto it = values.find(key);
+    T returnValue{};
+    if (it == values.end() or readNumber(it->second, returnValue) != NumberStatus::Ok)
     {
         return defaultValue;
     }
+    return returnValue;
 }
+
 }
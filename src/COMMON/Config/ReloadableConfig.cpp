@@ -0,0 +1,33 @@
+#include "ReloadableConfig.hpp"
+
+namespace common
+{
+
+ReloadableConfig::ReloadableConfig(Snapshot initial)
+    : current(std::move(initial))
+{}
+
+ReloadableConfig::Snapshot ReloadableConfig::get() const
+{
+    return current.load(std::memory_order_acquire);
+}
+
+void ReloadableConfig::publish(Snapshot next)
+{
+    current.store(next, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(subscribersGuard);
+    for (auto& subscriber : subscribers)
+    {
+        subscriber(*next);
+    }
+}
+
+void ReloadableConfig::subscribe(Subscriber subscriber)
+{
+    std::lock_guard<std::mutex> lock(subscribersGuard);
+    subscriber(*get());
+    subscribers.push_back(std::move(subscriber));
+}
+
+}
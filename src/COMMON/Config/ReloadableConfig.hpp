@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "MultiLineConfig.hpp"
+
+namespace common
+{
+
+/**
+ * Holder of immutable configuration snapshots.
+ * Readers take current snapshot without locking and keep using it while new one is published.
+ */
+class ReloadableConfig
+{
+public:
+    using Snapshot = std::shared_ptr<const MultiLineConfig>;
+    using Subscriber = std::function<void(const MultiLineConfig&)>;
+
+    explicit ReloadableConfig(Snapshot initial);
+
+    Snapshot get() const;
+    /**
+     * Replaces current snapshot then notifies subscribers - from calling thread
+     */
+    void publish(Snapshot next);
+    /**
+     * Subscriber is called at once with current snapshot and then after each publish
+     */
+    void subscribe(Subscriber subscriber);
+
+private:
+    std::atomic<Snapshot> current;
+    std::mutex subscribersGuard;
+    std::vector<Subscriber> subscribers;
+};
+
+}
@@ -6,6 +6,8 @@
 #include <sstream>
 #include <type_traits>
 #include <tuple>
+#include "LogLimit.hpp"
+#include "Memory/MemoryTag.hpp"
 
 namespace common
 {
@@ -24,6 +26,19 @@ public:
     template <typename ...Value>
     void logDebug(Value&& ...value);
 
+    // limited variants - message is formatted only when level is enabled and limit accepts it
+    // (or it is the rejected one that queued the limit - its text is kept for the summary),
+    // count of dropped messages is appended to the next accepted one,
+    // or reported by LogLimit::flushSuppressed when the window closes first
+    template <typename ...Value>
+    void logError(LogLimit& limit, Value&& ...value);
+
+    template <typename ...Value>
+    void logInfo(LogLimit& limit, Value&& ...value);
+
+    template <typename ...Value>
+    void logDebug(LogLimit& limit, Value&& ...value);
+
     using Level = int;
     static constexpr Level DEBUG_LEVEL = 0;
     static constexpr Level INFO_LEVEL = 1;
@@ -31,11 +46,17 @@ public:
     // user might define more levels, these are just predefined...
 
     virtual void log(Level level, const std::string& message) = 0;
+    /**
+     * False when messages of level would be dropped anyway - limited variants skip the limit then
+     */
+    virtual bool isEnabled(Level) const { return true; }
 
     // shortcuts machinery
     template <typename ...Value>
     void log(Level level, Value&& ...value);
     void log(Level level, std::string_view);
+    template <typename ...Value>
+    void log(Level level, LogLimit& limit, Value&& ...value);
 };
 
 template <typename ...Value>
@@ -53,11 +74,27 @@ inline void ILogger::logDebug(Value&& ...value)
 {
     log(DEBUG_LEVEL, std::forward<Value>(value)...);
 }
+template <typename ...Value>
+inline void ILogger::logError(LogLimit& limit, Value&& ...value)
+{
+    log(ERROR_LEVEL, limit, std::forward<Value>(value)...);
+}
+template <typename ...Value>
+inline void ILogger::logInfo(LogLimit& limit, Value&& ...value)
+{
+    log(INFO_LEVEL, limit, std::forward<Value>(value)...);
+}
+template <typename ...Value>
+inline void ILogger::logDebug(LogLimit& limit, Value&& ...value)
+{
+    log(DEBUG_LEVEL, limit, std::forward<Value>(value)...);
+}
 
 // shortcuts machinery
 template <typename ...Value>
 inline void ILogger::log(Level level, Value&& ...value)
 {
+    MemoryTagScope memoryTag(MemoryTag::Logger);
     std::ostringstream os;
     ((os << std::forward<Value>(value)), ...);
     const std::string message = std::move(os).str();
@@ -66,7 +103,37 @@ inline void ILogger::log(Level level, Value&& ...value)
 
 inline void ILogger::log(Level level, std::string_view value)
 {
+    MemoryTagScope memoryTag(MemoryTag::Logger);
     log(level, std::string(value));
 }
 
+template <typename ...Value>
+inline void ILogger::log(Level level, LogLimit& limit, Value&& ...value)
+{
+    if (not isEnabled(level))
+    {
+        return;
+    }
+    std::uint64_t suppressed = 0u;
+    const bool accepted = limit.tryAcquire(suppressed);
+    if (not accepted and suppressed != 1u)
+    {
+        return;
+    }
+    MemoryTagScope memoryTag(MemoryTag::Logger);
+    std::ostringstream os;
+    ((os << std::forward<Value>(value)), ...);
+    std::string message = std::move(os).str();
+    if (not accepted)
+    {
+        limit.remember(level, message);
+        return;
+    }
+    if (suppressed != 0u)
+    {
+        message += " (suppressed " + std::to_string(suppressed) + " similar messages)";
+    }
+    log(level, message);
+}
+
 } // namespace common
@@ -0,0 +1,174 @@
+#include "LogLimit.hpp"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace common
+{
+
+namespace
+{
+
+// static limits are destroyed at exit - the list must outlive them
+std::mutex& pendingMutex()
+{
+    static std::mutex* mutex = new std::mutex;
+    return *mutex;
+}
+
+LogLimit* pendingHead = nullptr;
+
+std::int64_t toNanoseconds(LogLimit::Clock::time_point now)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+}
+
+}
+
+LogLimit LogLimit::sampled(std::uint32_t everyNth)
+{
+    if (everyNth == 0u)
+    {
+        throw std::invalid_argument("LogLimit: sampling of every 0th message");
+    }
+    return LogLimit(everyNth, 0, 0);
+}
+
+LogLimit LogLimit::rateLimited(std::uint32_t burst, std::uint32_t perSecond)
+{
+    if (burst == 0u || perSecond == 0u)
+    {
+        throw std::invalid_argument("LogLimit: zero burst or rate");
+    }
+    constexpr std::int64_t NS_IN_S = 1000000000;
+    const std::int64_t emissionIntervalNs = NS_IN_S / perSecond;
+    return LogLimit(0u, emissionIntervalNs, emissionIntervalNs * (burst - 1u));
+}
+
+LogLimit::LogLimit(std::uint32_t everyNth, std::int64_t emissionIntervalNs, std::int64_t burstToleranceNs)
+    : everyNth(everyNth),
+      emissionIntervalNs(emissionIntervalNs),
+      burstToleranceNs(burstToleranceNs)
+{}
+
+LogLimit::~LogLimit()
+{
+    std::lock_guard<std::mutex> lock(pendingMutex());
+    for (LogLimit** link = &pendingHead; *link; link = &(*link)->nextPending)
+    {
+        if (*link == this)
+        {
+            *link = nextPending;
+            break;
+        }
+    }
+}
+
+bool LogLimit::tryAcquire(std::uint64_t &suppressed) noexcept
+{
+    return tryAcquire(suppressed, Clock::now());
+}
+
+bool LogLimit::tryAcquire(std::uint64_t &suppressed, Clock::time_point now) noexcept
+{
+    if (not accept(now))
+    {
+        suppressed = 0u;
+        if (suppressedCount.fetch_add(1u, std::memory_order_relaxed) == 0u and queueForFlush())
+        {
+            suppressed = 1u;
+        }
+        return false;
+    }
+    suppressed = suppressedCount.exchange(0u, std::memory_order_relaxed);
+    return true;
+}
+
+bool LogLimit::accept(Clock::time_point now) noexcept
+{
+    if (everyNth != 0u)
+    {
+        return counter.fetch_add(1u, std::memory_order_relaxed) % everyNth == 0u;
+    }
+
+    const std::int64_t nowNs = toNanoseconds(now);
+    std::int64_t arrival = theoreticalArrivalNs.load(std::memory_order_relaxed);
+    std::int64_t nextArrival;
+    do
+    {
+        if (nowNs < arrival - burstToleranceNs)
+        {
+            return false;
+        }
+        nextArrival = std::max(arrival, nowNs) + emissionIntervalNs;
+    }
+    while (not theoreticalArrivalNs.compare_exchange_weak(arrival, nextArrival, std::memory_order_relaxed));
+    return true;
+}
+
+bool LogLimit::windowClosed(Clock::time_point now) const noexcept
+{
+    // sampling has no window - whatever was suppressed since the last flush is reported
+    return everyNth != 0u
+        or toNanoseconds(now) >= theoreticalArrivalNs.load(std::memory_order_relaxed) - burstToleranceNs;
+}
+
+bool LogLimit::queueForFlush() noexcept
+{
+    std::lock_guard<std::mutex> lock(pendingMutex());
+    if (pending)
+    {
+        return false;
+    }
+    pending = true;
+    nextPending = pendingHead;
+    pendingHead = this;
+    return true;
+}
+
+void LogLimit::remember(int newLevel, std::string_view message)
+{
+    std::lock_guard<std::mutex> lock(pendingMutex());
+    level = newLevel;
+    rememberedLength = message.copy(rememberedMessage.data(), rememberedMessage.size());
+}
+
+void LogLimit::flushSuppressed(const Summary &summary)
+{
+    flushSuppressed(summary, Clock::now());
+}
+
+void LogLimit::flushSuppressed(const Summary &summary, Clock::time_point now)
+{
+    std::vector<std::pair<int, std::string>> lines;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex());
+        for (LogLimit** link = &pendingHead; *link;)
+        {
+            LogLimit& limit = **link;
+            if (not limit.windowClosed(now))
+            {
+                link = &limit.nextPending;
+                continue;
+            }
+            *link = limit.nextPending;
+            limit.nextPending = nullptr;
+            limit.pending = false;
+            // zero when the next accepted message has already reported them
+            if (auto suppressed = limit.suppressedCount.exchange(0u, std::memory_order_relaxed))
+            {
+                lines.emplace_back(limit.level, "suppressed " + std::to_string(suppressed) + " similar messages: "
+                                                + std::string(limit.rememberedMessage.data(),
+                                                              limit.rememberedLength));
+            }
+        }
+    }
+    // not under mutex - logging limited messages from summary would deadlock
+    for (const auto& [level, line] : lines)
+    {
+        summary(level, line);
+    }
+}
+
+}
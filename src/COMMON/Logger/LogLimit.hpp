@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace common
+{
+
+/**
+ * Per call site limit of repetitive log lines - meant to be static local next to log call:
+ *     static LogLimit limit = LogLimit::rateLimited(10, 5);
+ *     logger.logError(limit, "Something failed for: ", who);
+ * Decision is taken before message is formatted, lock-free - only the first rejection after a reported one
+ * takes a process wide mutex, to queue the limit for flushSuppressed. Text for the summary is taken only when
+ * the limit gets queued - at most once per flush. Accepted messages never take the mutex.
+ */
+class LogLimit
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::uint32_t DEFAULT_BURST = 10u;
+    static constexpr std::uint32_t DEFAULT_PER_SECOND = 5u;
+
+    /**
+     * Logs 1st, (N+1)th, (2N+1)th... message
+     * @throw std::invalid_argument for zero
+     */
+    static LogLimit sampled(std::uint32_t everyNth);
+    /**
+     * Token bucket: up to burst messages at once, refilled with perSecond messages per second
+     * @throw std::invalid_argument for zero
+     */
+    static LogLimit rateLimited(std::uint32_t burst = DEFAULT_BURST, std::uint32_t perSecond = DEFAULT_PER_SECOND);
+
+    /**
+     * Level and text (truncated) of a suppressed line for flushSuppressed
+     */
+    using Summary = std::function<void(int level, std::string_view line)>;
+    static constexpr std::size_t MAX_REMEMBERED_LENGTH = 120u;
+
+    ~LogLimit();
+    LogLimit(const LogLimit&) = delete;
+    LogLimit& operator=(const LogLimit&) = delete;
+
+    /**
+     * @param suppressed when accepted - number of messages suppressed since last accepted one,
+     *                   when rejected - 1 when this message queued the limit for flushSuppressed
+     *                   (its text shall be given to remember), otherwise 0
+     * @return true when message shall be logged
+     */
+    bool tryAcquire(std::uint64_t& suppressed) noexcept;
+    bool tryAcquire(std::uint64_t& suppressed, Clock::time_point now) noexcept;
+    /**
+     * Message that queued the limit - flushSuppressed names it in the summary
+     */
+    void remember(int level, std::string_view message);
+
+    /**
+     * Reports count of messages suppressed by every limit whose window has closed (token available again,
+     * any time for sampled limits) - otherwise a flood that stops would never report its tail.
+     * Shall be called periodically; the next accepted message still reports the count when it comes first.
+     */
+    static void flushSuppressed(const Summary& summary);
+    static void flushSuppressed(const Summary& summary, Clock::time_point now);
+
+private:
+    LogLimit(std::uint32_t everyNth, std::int64_t emissionIntervalNs, std::int64_t burstToleranceNs);
+
+    bool accept(Clock::time_point now) noexcept;
+    bool windowClosed(Clock::time_point now) const noexcept;
+    bool queueForFlush() noexcept;
+
+    const std::uint32_t everyNth;
+    const std::int64_t emissionIntervalNs;
+    const std::int64_t burstToleranceNs;
+    std::atomic<std::uint64_t> counter{0};
+    // GCRA form of token bucket - theoretical arrival time of next message
+    std::atomic<std::int64_t> theoreticalArrivalNs{0};
+    std::atomic<std::uint64_t> suppressedCount{0};
+    // guarded by process wide mutex of pending limits
+    bool pending = false;
+    LogLimit* nextPending = nullptr;
+    int level = 0;
+    // in place - a remembered line is not a heap block retained by the limit
+    std::array<char, MAX_REMEMBERED_LENGTH> rememberedMessage{};
+    std::size_t rememberedLength = 0u;
+};
+
+}
@@ -26,8 +26,23 @@ Logger::Logger(std::initializer_list<LevelInfo> streamsForLevels)
 Logger::~Logger()
 {}
 
+void Logger::setLevelThreshold(Level level)
+{
+    levelThreshold = level;
+}
+
+bool Logger::isEnabled(Level level) const
+{
+    return level >= levelThreshold.load(std::memory_order_relaxed);
+}
+
 void Logger::log(Level level, const std::string &message)
 {
+    if (not isEnabled(level))
+    {
+        return;
+    }
+    MemoryTagScope memoryTag(MemoryTag::Logger);
     auto& levelInfo = streamsForLevels.at(level);
     auto number = ++printoutNumber;
     auto thisThreadId = std::this_thread::get_id();
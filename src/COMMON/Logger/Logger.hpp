@@ -23,11 +23,17 @@ public:
     ~Logger() override;
 
     void log(Level level, const std::string& message) override;
+    bool isEnabled(Level level) const override;
+    /**
+     * Messages with level below threshold are dropped - can be changed at any time
+     */
+    void setLevelThreshold(Level level);
 
 private:
     std::vector<LevelInfo> streamsForLevels;
     std::mutex printoutGuard;
     std::atomic_size_t printoutNumber{};
+    std::atomic<Level> levelThreshold{DEBUG_LEVEL};
 };
 
 } // namespace ue
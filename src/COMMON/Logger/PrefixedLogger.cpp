@@ -26,4 +26,9 @@ void PrefixedLogger::log(Level level, const std::string &message)
     adaptee.log(level, prefix, message);
 }
 
+bool PrefixedLogger::isEnabled(Level level) const
+{
+    return adaptee.isEnabled(level);
+}
+
 } // namespace common
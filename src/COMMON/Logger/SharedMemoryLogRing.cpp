@@ -0,0 +1,326 @@
+#include "SharedMemoryLogRing.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <streambuf>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace common
+{
+
+// layout shared by all processes - keep it trivial and address-free
+struct SharedMemoryLogRing::Header
+{
+    std::atomic<std::uint64_t> magic;
+    std::uint64_t slotCount;
+    std::atomic<std::uint64_t> head;
+    // 0 when no collector is attached
+    std::atomic<std::uint32_t> collectorPid;
+};
+
+struct SharedMemoryLogRing::Slot
+{
+    // 2 * index + 1 while being written, 2 * index + 2 when record #index is committed
+    std::atomic<std::uint64_t> sequence;
+    std::uint64_t timestampNs;
+    std::uint32_t pid;
+    std::uint16_t phoneNumber;
+    std::uint16_t length;
+    char text[TEXT_SIZE];
+};
+
+namespace
+{
+
+constexpr std::uint64_t MAGIC = 0x5354484c4f473032; // "STHLOG02"
+// collector gives up waiting for a record whose writer died in the middle of push
+constexpr std::size_t MAX_STALLED_DRAINS = 100u;
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free and std::atomic<std::uint32_t>::is_always_lock_free,
+              "Shared memory atomics must be lock-free");
+
+std::uint64_t writingSequence(std::uint64_t index) { return 2u * index + 1u; }
+std::uint64_t committedSequence(std::uint64_t index) { return 2u * index + 2u; }
+
+std::size_t roundUpToPowerOf2(std::size_t value)
+{
+    std::size_t result = 1u;
+    while (result < value)
+    {
+        result <<= 1u;
+    }
+    return result;
+}
+
+std::runtime_error systemError(const std::string& what, const std::string& name)
+{
+    return std::runtime_error(what + " \"" + name + "\": " + std::strerror(errno));
+}
+
+}
+
+std::unique_ptr<SharedMemoryLogRing> SharedMemoryLogRing::create(const std::string &name, std::size_t slotCount)
+{
+    slotCount = roundUpToPowerOf2(std::max<std::size_t>(slotCount, 1u));
+    const std::size_t mappingSize = sizeof(Header) + slotCount * sizeof(Slot);
+
+    int fileDescriptor = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+    if (fileDescriptor < 0)
+    {
+        if (errno != EEXIST)
+        {
+            throw systemError("Cannot create log ring", name);
+        }
+        // unlinking it would orphan producers still writing to it
+        auto ring = map(name, true);
+        ring->attachCollector();
+        return ring;
+    }
+    if (::ftruncate(fileDescriptor, static_cast<off_t>(mappingSize)) != 0)
+    {
+        ::close(fileDescriptor);
+        ::shm_unlink(name.c_str());
+        throw systemError("Cannot resize log ring", name);
+    }
+    void* mapping = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    if (mapping == MAP_FAILED)
+    {
+        ::close(fileDescriptor);
+        ::shm_unlink(name.c_str());
+        throw systemError("Cannot map log ring", name);
+    }
+
+    // fresh shm object is zero filled - sequence 0 means "never written"
+    auto* header = static_cast<Header*>(mapping);
+    header->slotCount = slotCount;
+    header->head.store(0u, std::memory_order_relaxed);
+    header->collectorPid.store(static_cast<std::uint32_t>(::getpid()), std::memory_order_relaxed);
+    header->magic.store(MAGIC, std::memory_order_release);
+
+    return std::unique_ptr<SharedMemoryLogRing>(
+        new SharedMemoryLogRing(name, true, fileDescriptor, mapping, mappingSize));
+}
+
+std::unique_ptr<SharedMemoryLogRing> SharedMemoryLogRing::open(const std::string &name)
+{
+    return map(name, false);
+}
+
+void SharedMemoryLogRing::remove(const std::string &name)
+{
+    ::shm_unlink(name.c_str());
+}
+
+std::unique_ptr<SharedMemoryLogRing> SharedMemoryLogRing::map(const std::string &name, bool owner)
+{
+    int fileDescriptor = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fileDescriptor < 0)
+    {
+        throw systemError("Cannot open log ring", name);
+    }
+    struct stat status{};
+    if (::fstat(fileDescriptor, &status) != 0 or std::size_t(status.st_size) < sizeof(Header))
+    {
+        ::close(fileDescriptor);
+        throw std::runtime_error("Log ring \"" + name + "\" not initialized");
+    }
+    const std::size_t mappingSize = status.st_size;
+    void* mapping = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    if (mapping == MAP_FAILED)
+    {
+        ::close(fileDescriptor);
+        throw systemError("Cannot map log ring", name);
+    }
+
+    std::unique_ptr<SharedMemoryLogRing> ring(new SharedMemoryLogRing(name, owner, fileDescriptor, mapping, mappingSize));
+    const Header& header = ring->header();
+    if (header.magic.load(std::memory_order_acquire) != MAGIC
+        or sizeof(Header) + header.slotCount * sizeof(Slot) != mappingSize)
+    {
+        throw std::runtime_error("Log ring \"" + name + "\" has wrong format");
+    }
+    return ring;
+}
+
+SharedMemoryLogRing::SharedMemoryLogRing(std::string name, bool owner, int fileDescriptor, void *mapping, std::size_t mappingSize)
+    : name(std::move(name)),
+      owner(owner),
+      fileDescriptor(fileDescriptor),
+      mapping(mapping),
+      mappingSize(mappingSize),
+      pid(static_cast<std::uint32_t>(::getpid()))
+{}
+
+SharedMemoryLogRing::~SharedMemoryLogRing()
+{
+    if (owner)
+    {
+        // not ours when attaching failed
+        std::uint32_t attached = pid;
+        header().collectorPid.compare_exchange_strong(attached, 0u, std::memory_order_release);
+    }
+    ::munmap(mapping, mappingSize);
+    ::close(fileDescriptor);
+}
+
+void SharedMemoryLogRing::attachCollector()
+{
+    auto& collectorPid = header().collectorPid;
+    std::uint32_t attached = collectorPid.load(std::memory_order_acquire);
+    do
+    {
+        // pid of collector that died without detaching can be taken over
+        if (attached != 0u and (::kill(static_cast<pid_t>(attached), 0) == 0 or errno != ESRCH))
+        {
+            throw std::runtime_error("Log ring \"" + name + "\" is drained by other collector, pid: "
+                                     + std::to_string(attached));
+        }
+    }
+    while (not collectorPid.compare_exchange_weak(attached, pid, std::memory_order_acq_rel));
+    // records pushed before are either drained by previous collector or abandoned
+    readIndex = header().head.load(std::memory_order_acquire);
+}
+
+std::size_t SharedMemoryLogRing::slotCount() const noexcept
+{
+    return header().slotCount;
+}
+
+SharedMemoryLogRing::Header &SharedMemoryLogRing::header() const noexcept
+{
+    return *static_cast<Header*>(mapping);
+}
+
+SharedMemoryLogRing::Slot &SharedMemoryLogRing::slot(std::uint64_t index) const noexcept
+{
+    auto* slots = reinterpret_cast<Slot*>(static_cast<char*>(mapping) + sizeof(Header));
+    return slots[index & (header().slotCount - 1u)];
+}
+
+void SharedMemoryLogRing::push(PhoneNumber phoneNumber, const std::string &text) noexcept
+{
+    using namespace std::chrono;
+    const std::uint64_t index = header().head.fetch_add(1u, std::memory_order_relaxed);
+    Slot& target = slot(index);
+
+    target.sequence.store(writingSequence(index), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    target.timestampNs = duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+    target.pid = pid;
+    target.phoneNumber = phoneNumber.value;
+    target.length = static_cast<std::uint16_t>(std::min(text.size(), TEXT_SIZE));
+    std::memcpy(target.text, text.data(), target.length);
+    target.sequence.store(committedSequence(index), std::memory_order_release);
+}
+
+std::uint64_t SharedMemoryLogRing::drain(std::vector<Record> &records)
+{
+    std::uint64_t lost = 0u;
+    const std::uint64_t head = header().head.load(std::memory_order_acquire);
+    const std::uint64_t capacity = header().slotCount;
+    if (head - readIndex > capacity)
+    {
+        lost += head - capacity - readIndex;
+        readIndex = head - capacity;
+        stalledDrains = 0u;
+    }
+
+    while (readIndex < head)
+    {
+        Slot& source = slot(readIndex);
+        const std::uint64_t sequence = source.sequence.load(std::memory_order_acquire);
+        if (sequence < committedSequence(readIndex))
+        {
+            if (++stalledDrains < MAX_STALLED_DRAINS)
+            {
+                break;
+            }
+            ++lost;
+        }
+        else if (sequence == committedSequence(readIndex))
+        {
+            Record record{source.timestampNs, source.pid, PhoneNumber{static_cast<PhoneNumber::Value>(source.phoneNumber)},
+                          std::string(source.text, std::min<std::size_t>(source.length, TEXT_SIZE))};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (source.sequence.load(std::memory_order_relaxed) == sequence)
+            {
+                records.push_back(std::move(record));
+            }
+            else
+            {
+                ++lost;
+            }
+        }
+        else
+        {
+            ++lost;
+        }
+        ++readIndex;
+        stalledDrains = 0u;
+    }
+    return lost;
+}
+
+class SharedMemoryLogStream::Buffer : public std::streambuf
+{
+public:
+    Buffer(const std::string& ringName, PhoneNumber phoneNumber)
+        : ring(SharedMemoryLogRing::open(ringName)),
+          phoneNumber(phoneNumber)
+    {}
+
+protected:
+    int_type overflow(int_type character) override
+    {
+        if (not traits_type::eq_int_type(character, traits_type::eof()))
+        {
+            line.push_back(traits_type::to_char_type(character));
+        }
+        return traits_type::not_eof(character);
+    }
+
+    std::streamsize xsputn(const char_type* text, std::streamsize count) override
+    {
+        line.append(text, count);
+        return count;
+    }
+
+    int sync() override
+    {
+        while (not line.empty() and line.back() == '\n')
+        {
+            line.pop_back();
+        }
+        if (not line.empty())
+        {
+            ring->push(phoneNumber, line);
+            line.clear();
+        }
+        return 0;
+    }
+
+private:
+    std::unique_ptr<SharedMemoryLogRing> ring;
+    PhoneNumber phoneNumber;
+    std::string line;
+};
+
+SharedMemoryLogStream::SharedMemoryLogStream(const std::string &ringName, PhoneNumber phoneNumber)
+    : std::ostream(nullptr),
+      buffer(std::make_unique<Buffer>(ringName, phoneNumber))
+{
+    rdbuf(buffer.get());
+}
+
+SharedMemoryLogStream::~SharedMemoryLogStream()
+{
+    flush();
+}
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Messages/PhoneNumber.hpp"
+
+namespace common
+{
+
+/**
+ * Host wide multi-producer ring of log records in POSIX shared memory.
+ * One collector at a time drains it, any number of processes append to it.
+ * When collector is too slow the oldest records are overwritten (and counted as lost).
+ * The ring outlives its collector - producers started earlier keep writing to it, and the next collector
+ * attaches to the same ring. Records are committed in ring order, which is time order only within one producer.
+ */
+class SharedMemoryLogRing
+{
+public:
+    static constexpr const char* DEFAULT_NAME = "/sth_log_ring";
+    static constexpr std::size_t DEFAULT_SLOT_COUNT = 1u << 13;
+    static constexpr std::size_t TEXT_SIZE = 488u;
+
+    struct Record
+    {
+        std::uint64_t timestampNs; // since epoch
+        std::uint32_t pid;
+        PhoneNumber phoneNumber;
+        std::string text;
+    };
+
+    /**
+     * For collector - creates the ring, or attaches to the existing one and drains records pushed from now on
+     * @param slotCount rounded up to power of 2, existing ring keeps its own size
+     * @throw std::runtime_error also when other live collector is attached or existing ring has other format
+     */
+    static std::unique_ptr<SharedMemoryLogRing> create(const std::string& name,
+                                                       std::size_t slotCount = DEFAULT_SLOT_COUNT);
+    /**
+     * For producers - ring must already be created by collector
+     * @throw std::runtime_error
+     */
+    static std::unique_ptr<SharedMemoryLogRing> open(const std::string& name);
+    /**
+     * Unlinks the ring - producers still running keep writing to the unlinked one, nobody can drain it
+     */
+    static void remove(const std::string& name);
+
+    ~SharedMemoryLogRing();
+    SharedMemoryLogRing(const SharedMemoryLogRing&) = delete;
+    SharedMemoryLogRing& operator=(const SharedMemoryLogRing&) = delete;
+
+    /**
+     * Text longer than TEXT_SIZE is truncated
+     */
+    void push(PhoneNumber phoneNumber, const std::string& text) noexcept;
+    /**
+     * Collector side - appends committed records in ring order, stops at the first one still being written
+     * @return number of records lost (overwritten or abandoned) since previous call
+     */
+    std::uint64_t drain(std::vector<Record>& records);
+
+    std::size_t slotCount() const noexcept;
+
+private:
+    struct Header;
+    struct Slot;
+
+    SharedMemoryLogRing(std::string name, bool owner, int fileDescriptor, void* mapping, std::size_t mappingSize);
+
+    static std::unique_ptr<SharedMemoryLogRing> map(const std::string& name, bool owner);
+    void attachCollector();
+
+    Header& header() const noexcept;
+    Slot& slot(std::uint64_t index) const noexcept;
+
+    std::string name;
+    bool owner;
+    int fileDescriptor;
+    void* mapping;
+    std::size_t mappingSize;
+    std::uint32_t pid;
+
+    // collector only
+    std::uint64_t readIndex = 0u;
+    std::size_t stalledDrains = 0u;
+};
+
+/**
+ * Log sink for Logger - every flushed line becomes one record in the ring
+ */
+class SharedMemoryLogStream : public std::ostream
+{
+public:
+    /**
+     * @throw std::runtime_error when ring was not created yet
+     */
+    SharedMemoryLogStream(const std::string& ringName, PhoneNumber phoneNumber);
+    ~SharedMemoryLogStream() override;
+
+private:
+    class Buffer;
+    std::unique_ptr<Buffer> buffer;
+};
+
+}
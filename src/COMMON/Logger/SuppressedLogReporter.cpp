@@ -0,0 +1,68 @@
+#include "SuppressedLogReporter.hpp"
+
+namespace common
+{
+
+SuppressedLogReporter::SuppressedLogReporter(std::chrono::milliseconds period)
+    : period(period)
+{}
+
+SuppressedLogReporter::~SuppressedLogReporter()
+{
+    stop();
+}
+
+void SuppressedLogReporter::start(IClock &timerClock, ILogger &newLogger)
+{
+    std::lock_guard<std::mutex> lock(timerMutex);
+    if (running)
+    {
+        return;
+    }
+    clock = &timerClock;
+    logger = &newLogger;
+    running = true;
+    flushTimer = clock->scheduleAfter(period, [this] { onTimer(); });
+}
+
+void SuppressedLogReporter::stop()
+{
+    std::optional<IClock::TimerId> lastTimer;
+    {
+        std::lock_guard<std::mutex> lock(timerMutex);
+        if (not running)
+        {
+            return;
+        }
+        running = false;
+        lastTimer = flushTimer;
+        flushTimer.reset();
+    }
+    // not under mutex - cancel waits for the timer being run, and that timer needs the mutex to finish
+    if (lastTimer)
+    {
+        clock->cancel(*lastTimer);
+    }
+    // as if every window had closed
+    flush(LogLimit::Clock::time_point::max());
+}
+
+void SuppressedLogReporter::onTimer()
+{
+    flush(LogLimit::Clock::now());
+    std::lock_guard<std::mutex> lock(timerMutex);
+    if (running)
+    {
+        flushTimer = clock->scheduleAfter(period, [this] { onTimer(); });
+    }
+}
+
+void SuppressedLogReporter::flush(LogLimit::Clock::time_point now)
+{
+    LogLimit::flushSuppressed([this](int level, std::string_view line)
+    {
+        logger->log(level, line);
+    }, now);
+}
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include "ILogger.hpp"
+#include "Time/IClock.hpp"
+
+namespace common
+{
+
+/**
+ * Periodically calls LogLimit::flushSuppressed, so count of lines dropped by a limit is logged
+ * shortly after the flood stops - not only with the next accepted line, which might never come.
+ */
+class SuppressedLogReporter
+{
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_PERIOD{1000};
+
+    explicit SuppressedLogReporter(std::chrono::milliseconds period = DEFAULT_PERIOD);
+    ~SuppressedLogReporter();
+
+    /**
+     * @param timerClock summaries are logged from its timers
+     */
+    void start(IClock& timerClock, ILogger& logger);
+    /**
+     * Last flush is done here - nothing suppressed before stop is lost
+     */
+    void stop();
+
+private:
+    void onTimer();
+    void flush(LogLimit::Clock::time_point now);
+
+    const std::chrono::milliseconds period;
+    std::mutex timerMutex;
+    IClock* clock = nullptr;
+    ILogger* logger = nullptr;
+    bool running = false;
+    std::optional<IClock::TimerId> flushTimer;
+};
+
+}
@@ -0,0 +1,148 @@
+#include "MemoryAccounting.hpp"
+#include "SlabPool.hpp"
+#include <atomic>
+#include <iomanip>
+
+namespace common
+{
+
+namespace
+{
+
+struct TagUsage
+{
+    std::atomic<std::uint64_t> liveBytes{0u};
+    std::atomic<std::uint64_t> allocatedBytes{0u};
+    std::atomic<std::uint64_t> allocations{0u};
+    std::atomic<std::uint64_t> deallocations{0u};
+};
+
+// threads are spread over shards, each on its own cache lines - no line shared by all allocating threads.
+// Block released by other thread than its owner makes live bytes of one shard wrap - only the sum has meaning.
+constexpr std::size_t SHARD_COUNT = 16u;
+constexpr std::size_t CACHE_LINE_SIZE = 64u;
+struct alignas(CACHE_LINE_SIZE) Shard
+{
+    std::array<TagUsage, MEMORY_TAG_COUNT> tags{};
+};
+
+// constant initialized - allocations done by static constructors of other translation units are counted too
+constinit std::array<Shard, SHARD_COUNT> shards{};
+constinit std::atomic<std::uint32_t> nextShard{0u};
+constinit std::atomic<bool> active{false};
+
+constexpr std::uint32_t NO_SHARD = ~std::uint32_t{0u};
+// plain thread_local of trivial type - usable from operator new, no destructor registration
+thread_local std::uint32_t threadShard = NO_SHARD;
+
+TagUsage& usageOf(MemoryTag tag) noexcept
+{
+    if (threadShard == NO_SHARD)
+    {
+        threadShard = nextShard.fetch_add(1u, std::memory_order_relaxed) % SHARD_COUNT;
+    }
+    const auto index = std::size_t(tag);
+    return shards[threadShard].tags[index < MEMORY_TAG_COUNT ? index : 0u];
+}
+
+std::uint64_t sumOf(std::size_t tagIndex, std::atomic<std::uint64_t> TagUsage::*field) noexcept
+{
+    std::uint64_t sum = 0u;
+    for (const Shard& shard : shards)
+    {
+        sum += (shard.tags[tagIndex].*field).load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+}
+
+void MemoryAccounting::allocated(MemoryTag tag, std::uint64_t size) noexcept
+{
+    auto& tagUsage = usageOf(tag);
+    tagUsage.liveBytes.fetch_add(size, std::memory_order_relaxed);
+    tagUsage.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    tagUsage.allocations.fetch_add(1u, std::memory_order_relaxed);
+}
+
+void MemoryAccounting::deallocated(MemoryTag tag, std::uint64_t size) noexcept
+{
+    auto& tagUsage = usageOf(tag);
+    tagUsage.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+    tagUsage.deallocations.fetch_add(1u, std::memory_order_relaxed);
+}
+
+void MemoryAccounting::setActive() noexcept
+{
+    active.store(true, std::memory_order_relaxed);
+}
+
+bool MemoryAccounting::isActive() noexcept
+{
+    return active.load(std::memory_order_relaxed);
+}
+
+MemoryAccounting::Snapshot MemoryAccounting::snapshot() noexcept
+{
+    Snapshot result{};
+    for (std::size_t index = 0u; index < MEMORY_TAG_COUNT; ++index)
+    {
+        result[index].liveBytes = sumOf(index, &TagUsage::liveBytes);
+        result[index].allocatedBytes = sumOf(index, &TagUsage::allocatedBytes);
+        result[index].allocations = sumOf(index, &TagUsage::allocations);
+        result[index].deallocations = sumOf(index, &TagUsage::deallocations);
+    }
+    return result;
+}
+
+void MemoryAccounting::print(std::ostream &os, const Snapshot &current, const Snapshot &previous, double seconds)
+{
+    const auto flags = os.flags();
+    os << std::fixed << std::setprecision(1)
+       << "tag          live [kB]   allocations   allocated [kB]"
+       << (seconds > 0.0 ? "   alloc/s   kB/s\n" : "\n");
+    for (std::size_t index = 0u; index < MEMORY_TAG_COUNT; ++index)
+    {
+        const Usage& now = current[index];
+        os << std::left << std::setw(10) << to_string(MemoryTag(index)) << std::right
+           << std::setw(13) << double(now.liveBytes) / 1024.0
+           << std::setw(14) << now.allocations
+           << std::setw(17) << double(now.allocatedBytes) / 1024.0;
+        if (seconds > 0.0)
+        {
+            const Usage& before = previous[index];
+            os << std::setw(10) << double(now.allocations - before.allocations) / seconds
+               << std::setw(7) << double(now.allocatedBytes - before.allocatedBytes) / 1024.0 / seconds;
+        }
+        os << "\n";
+    }
+    // counted as live above, in the tag that made pools grow
+    os << "free in slab pools [kB]: " << double(SlabPool::freeBytes()) / 1024.0 << "\n";
+    if (not isActive())
+    {
+        os << "only tagged allocators and slab pools counted - build with -DSTH_HEAP_ACCOUNTING=ON for all heap\n";
+    }
+    os.flags(flags);
+}
+
+void MemoryAccounting::registerMetrics(MetricsRegistry &registry, const std::string &prefix)
+{
+    for (std::size_t index = 0u; index < MEMORY_TAG_COUNT; ++index)
+    {
+        const MetricsRegistry::Labels labels{{"tag", to_string(MemoryTag(index))}};
+        registry.gauge(prefix + "_memory_live_bytes", "Heap bytes in use per owner", [index]
+        {
+            return std::int64_t(sumOf(index, &TagUsage::liveBytes));
+        }, labels);
+        registry.counter(prefix + "_memory_allocated_bytes_total", "Heap bytes allocated per owner", [index]
+        {
+            return std::int64_t(sumOf(index, &TagUsage::allocatedBytes));
+        }, labels);
+        registry.counter(prefix + "_memory_allocations_total", "Heap allocations per owner", [index]
+        {
+            return std::int64_t(sumOf(index, &TagUsage::allocations));
+        }, labels);
+    }
+}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include "MemoryTag.hpp"
+#include "Metrics/MetricsRegistry.hpp"
+
+namespace common
+{
+
+/**
+ * Heap usage per MemoryTag. Always counted: TaggedAllocator and SlabPool slabs, the latter in the tag of
+ * MemoryTagScope current when the pool grows. All other heap is counted only in executables linked with
+ * AllocationCounter library, which replaces global operator new/delete - tests and benchmarks, BTS and UE only
+ * when built with -DSTH_HEAP_ACCOUNTING=ON.
+ * Counters are sharded per thread on separate cache lines - allocating threads do not contend on them.
+ */
+class MemoryAccounting
+{
+public:
+    struct Usage
+    {
+        std::uint64_t liveBytes = 0u;
+        std::uint64_t allocatedBytes = 0u;
+        std::uint64_t allocations = 0u;
+        std::uint64_t deallocations = 0u;
+    };
+    using Snapshot = std::array<Usage, MEMORY_TAG_COUNT>;
+
+    /**
+     * For allocators and replaced operator new/delete only
+     */
+    static void allocated(MemoryTag tag, std::uint64_t size) noexcept;
+    static void deallocated(MemoryTag tag, std::uint64_t size) noexcept;
+    static void setActive() noexcept;
+
+    /**
+     * True when global operator new/delete are replaced - all heap is counted
+     */
+    static bool isActive() noexcept;
+    static Snapshot snapshot() noexcept;
+    /**
+     * Rates are computed from the previous snapshot taken given seconds ago - zero seconds prints no rates
+     */
+    static void print(std::ostream& os, const Snapshot& current, const Snapshot& previous, double seconds);
+    /**
+     * Live bytes as gauges, allocated bytes and allocation counts as counters - with label tag
+     */
+    static void registerMetrics(MetricsRegistry& registry, const std::string& prefix);
+};
+
+}
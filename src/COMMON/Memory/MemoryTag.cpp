@@ -0,0 +1,73 @@
+#include "MemoryTag.hpp"
+#include <new>
+#include "MemoryAccounting.hpp"
+
+namespace common
+{
+
+namespace
+{
+// plain thread_local of trivial type - usable from operator new, no destructor registration
+thread_local MemoryTag currentTag = MemoryTag::Untagged;
+thread_local bool accountedByAllocator = false;
+}
+
+const char *to_string(MemoryTag tag) noexcept
+{
+    static const char* const names[MEMORY_TAG_COUNT] = {
+        "untagged", "transport", "message", "ue_relay", "logger", "sms_db"
+    };
+    const auto index = std::size_t(tag);
+    return index < MEMORY_TAG_COUNT ? names[index] : "?";
+}
+
+MemoryTag currentMemoryTag() noexcept
+{
+    return currentTag;
+}
+
+MemoryTagScope::MemoryTagScope(MemoryTag tag) noexcept
+    : outer(currentTag)
+{
+    currentTag = tag;
+}
+
+MemoryTagScope::~MemoryTagScope()
+{
+    currentTag = outer;
+}
+
+AllocatorAccountingScope::AllocatorAccountingScope() noexcept
+    : outer(accountedByAllocator)
+{
+    accountedByAllocator = true;
+}
+
+AllocatorAccountingScope::~AllocatorAccountingScope()
+{
+    accountedByAllocator = outer;
+}
+
+bool isAccountedByAllocator() noexcept
+{
+    return accountedByAllocator;
+}
+
+void *allocateTagged(MemoryTag tag, std::size_t size)
+{
+    void* pointer;
+    {
+        AllocatorAccountingScope accounting;
+        pointer = ::operator new(size);
+    }
+    MemoryAccounting::allocated(tag, size);
+    return pointer;
+}
+
+void deallocateTagged(MemoryTag tag, void *pointer, std::size_t size) noexcept
+{
+    MemoryAccounting::deallocated(tag, size);
+    ::operator delete(pointer);
+}
+
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace common
+{
+
+/**
+ * Owner of heap memory - every allocation is attributed to the tag current at the moment of allocation,
+ * its release is attributed to the same tag whichever code releases it
+ */
+enum class MemoryTag : std::uint8_t
+{
+    Untagged,
+    Transport, // socket and transport buffers
+    Message,   // BinaryMessage payloads
+    UeRelay,   // relay structures
+    Logger,    // log line formatting and sinks
+    SmsDb      // UE SMS storage
+};
+constexpr std::size_t MEMORY_TAG_COUNT = 6u;
+
+const char* to_string(MemoryTag tag) noexcept;
+MemoryTag currentMemoryTag() noexcept;
+
+/**
+ * Allocations of the current thread are attributed to given tag until destroyed - keep it on the stack:
+ *     MemoryTagScope memoryTag(MemoryTag::UeRelay);
+ * Scopes nest, the innermost one wins.
+ */
+class MemoryTagScope
+{
+public:
+    explicit MemoryTagScope(MemoryTag tag) noexcept;
+    ~MemoryTagScope();
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+private:
+    MemoryTag outer;
+};
+
+/**
+ * For allocators that account their memory themselves (TaggedAllocator, SlabPool) - replaced global operator new
+ * does not count again what the current thread allocates until destroyed
+ */
+class AllocatorAccountingScope
+{
+public:
+    AllocatorAccountingScope() noexcept;
+    ~AllocatorAccountingScope();
+    AllocatorAccountingScope(const AllocatorAccountingScope&) = delete;
+    AllocatorAccountingScope& operator=(const AllocatorAccountingScope&) = delete;
+
+private:
+    bool outer;
+};
+bool isAccountedByAllocator() noexcept;
+
+/**
+ * Global operator new/delete with the memory accounted to tag - always, replaced operators are not needed
+ */
+void* allocateTagged(MemoryTag tag, std::size_t size);
+void deallocateTagged(MemoryTag tag, void* pointer, std::size_t size) noexcept;
+
+/**
+ * Standard allocator that attributes its allocations to Tag - for containers owned by one subsystem.
+ * Counted in every executable, not only the ones with replaced operator new/delete.
+ */
+template <typename T, MemoryTag Tag>
+struct TaggedAllocator : std::allocator<T>
+{
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Over-aligned types are not supported");
+
+    template <typename U>
+    struct rebind { using other = TaggedAllocator<U, Tag>; };
+
+    TaggedAllocator() noexcept = default;
+    template <typename U>
+    TaggedAllocator(const TaggedAllocator<U, Tag>&) noexcept {}
+
+    T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(allocateTagged(Tag, count * sizeof(T)));
+    }
+    void deallocate(T* pointer, std::size_t count) noexcept
+    {
+        deallocateTagged(Tag, pointer, count * sizeof(T));
+    }
+};
+
+}
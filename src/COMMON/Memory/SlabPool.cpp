@@ -0,0 +1,101 @@
+#include "SlabPool.hpp"
+#include "MemoryAccounting.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace common
+{
+
+namespace
+{
+
+std::atomic<std::uint64_t> freeBytesOfAllPools{0u};
+
+std::size_t blockSizeFor(std::size_t blockSize, std::size_t blockAlignment)
+{
+    // released block keeps the free list link
+    const std::size_t alignment = std::max(blockAlignment, alignof(void*));
+    const std::size_t size = std::max(blockSize, sizeof(void*));
+    return (size + alignment - 1u) / alignment * alignment;
+}
+
+}
+
+SlabPool::SlabPool(std::size_t blockSize, std::size_t blockAlignment)
+    : size(blockSizeFor(blockSize, blockAlignment)),
+      blocksPerSlab(std::max<std::size_t>(1u, SLAB_SIZE / size))
+{}
+
+SlabPool::~SlabPool()
+{
+    freeBytesOfAllPools.fetch_sub((slabs.size() * blocksPerSlab - inUse) * size, std::memory_order_relaxed);
+    for (const Slab& slab : slabs)
+    {
+        MemoryAccounting::deallocated(slab.tag, blocksPerSlab * size);
+    }
+}
+
+void* SlabPool::allocate()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not freeList)
+    {
+        grow();
+    }
+    FreeBlock* block = freeList;
+    freeList = block->next;
+    ++inUse;
+    freeBytesOfAllPools.fetch_sub(size, std::memory_order_relaxed);
+    return block;
+}
+
+void SlabPool::deallocate(void *block) noexcept
+{
+    if (not block)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    freeList = ::new (block) FreeBlock{freeList};
+    --inUse;
+    freeBytesOfAllPools.fetch_add(size, std::memory_order_relaxed);
+}
+
+std::size_t SlabPool::blocksInUse() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return inUse;
+}
+
+std::size_t SlabPool::blocksReserved() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return slabs.size() * blocksPerSlab;
+}
+
+std::uint64_t SlabPool::freeBytes() noexcept
+{
+    return freeBytesOfAllPools.load(std::memory_order_relaxed);
+}
+
+void SlabPool::grow()
+{
+    const std::size_t slabBytes = blocksPerSlab * size;
+    std::unique_ptr<std::byte[]> memory;
+    {
+        AllocatorAccountingScope accounting;
+        memory.reset(new std::byte[slabBytes]);
+    }
+    // kept before linking its blocks - push_back may throw
+    slabs.push_back(Slab{std::move(memory), currentMemoryTag()});
+    MemoryAccounting::allocated(slabs.back().tag, slabBytes);
+    std::byte* const begin = slabs.back().memory.get();
+    // first block of the slab ends up first on the free list
+    for (std::size_t index = blocksPerSlab; index-- > 0u;)
+    {
+        freeList = ::new (begin + index * size) FreeBlock{freeList};
+    }
+    freeBytesOfAllPools.fetch_add(blocksPerSlab * size, std::memory_order_relaxed);
+}
+
+}
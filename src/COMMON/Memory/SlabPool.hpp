@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "MemoryTag.hpp"
+
+namespace common
+{
+
+/**
+ * Fixed size blocks carved from slabs of SLAB_SIZE bytes - for objects of one type made and released in large
+ * numbers (one per connection). No per-block heap header, no fragmentation between types.
+ * Slabs are never given back: memory of released blocks stays in the pool for next objects of the same type.
+ */
+class SlabPool
+{
+public:
+    static constexpr std::size_t SLAB_SIZE = 64u * 1024u;
+
+    SlabPool(std::size_t blockSize, std::size_t blockAlignment);
+    ~SlabPool();
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    /**
+     * Slab allocation is accounted to MemoryTag current at the moment pool grows - with or without replaced
+     * operator new
+     * @throw std::bad_alloc
+     */
+    void* allocate();
+    void deallocate(void* block) noexcept;
+
+    std::size_t blockSize() const noexcept { return size; }
+    std::size_t blocksInUse() const;
+    std::size_t blocksReserved() const;
+
+    /**
+     * Bytes of released blocks kept by all pools of the process
+     */
+    static std::uint64_t freeBytes() noexcept;
+
+    /**
+     * Pool of blocks for objects of type T - process wide, never destroyed:
+     * objects may be released by static destructors of other translation units
+     */
+    template <typename T>
+    static SlabPool& of()
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+        static SlabPool* const pool = new SlabPool(sizeof(T), alignof(T));
+        return *pool;
+    }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+    struct Slab
+    {
+        std::unique_ptr<std::byte[]> memory;
+        MemoryTag tag;
+    };
+
+    void grow();
+
+    const std::size_t size;
+    const std::size_t blocksPerSlab;
+    mutable std::mutex mutex;
+    FreeBlock* freeList = nullptr;
+    std::vector<Slab> slabs;
+    std::size_t inUse = 0u;
+};
+
+/**
+ * Standard allocator of single objects from SlabPool::of<T> - for std::allocate_shared and node based containers.
+ * Arrays go to global operator new.
+ */
+template <typename T>
+struct SlabAllocator
+{
+    using value_type = T;
+
+    SlabAllocator() noexcept = default;
+    template <typename U>
+    SlabAllocator(const SlabAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t count)
+    {
+        return count == 1u
+                ? static_cast<T*>(SlabPool::of<T>().allocate())
+                : std::allocator<T>{}.allocate(count);
+    }
+    void deallocate(T* pointer, std::size_t count) noexcept
+    {
+        if (count == 1u)
+        {
+            SlabPool::of<T>().deallocate(pointer);
+        }
+        else
+        {
+            std::allocator<T>{}.deallocate(pointer, count);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const SlabAllocator<U>&) const noexcept { return true; }
+};
+
+/**
+ * Base of classes allocated with new from their own SlabPool:
+ *     class UeConnection : public IUeConnection, public common::SlabAllocated<UeConnection>
+ * Derived classes of different size go to global operator new.
+ */
+template <typename Derived>
+class SlabAllocated
+{
+public:
+    static void* operator new(std::size_t size)
+    {
+        return size == sizeof(Derived) ? SlabPool::of<Derived>().allocate() : ::operator new(size);
+    }
+    static void operator delete(void* pointer, std::size_t size) noexcept
+    {
+        if (size == sizeof(Derived))
+        {
+            SlabPool::of<Derived>().deallocate(pointer);
+        }
+        else
+        {
+            ::operator delete(pointer, size);
+        }
+    }
+};
+
+}
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <limits>
 #include "LimitedVector.hpp"
+#include "Memory/MemoryTag.hpp"
 
 namespace common
 {
@@ -20,7 +21,7 @@ struct BinaryMessage
     // for bigger types than uint8_t - consider to use other value than max (lower)
     static constexpr std::size_t MAX_SIZE = max_size_min(5000, std::numeric_limits<SizeType>::max());
 
-    using Value = LimitedVector<ValueType, SizeType, MAX_SIZE>;
+    using Value = LimitedVector<ValueType, SizeType, MAX_SIZE, TaggedAllocator<ValueType, MemoryTag::Message>>;
 
     Value value;
 };
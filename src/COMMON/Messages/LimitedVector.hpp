@@ -1,15 +1,16 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 #include <algorithm> // for std::min
 
 namespace common
 {
 
-template <typename ValueType, typename SizeType, SizeType MaxSize>
-class LimitedVector : private std::vector<ValueType>
+template <typename ValueType, typename SizeType, SizeType MaxSize, typename Allocator = std::allocator<ValueType>>
+class LimitedVector : private std::vector<ValueType, Allocator>
 {
-    using Impl = std::vector<ValueType>;
+    using Impl = std::vector<ValueType, Allocator>;
 public:
     using value_type = typename Impl::value_type;
     using Impl::pointer;
@@ -4,6 +4,7 @@
 #include <type_traits>
 #include <iostream>
 #include <string>
+#include "Traits/EnumTraits.hpp"
 
 namespace common
 {
@@ -19,6 +20,8 @@ namespace common
     ACTION(CallAccepted)            \
     ACTION(CallDropped)             \
     ACTION(CallTalk)                \
+    ACTION(Echo)                    \
+    ACTION(EchoReply)               \
 
 #define MESSAGE_ID_ENTRY(X) X,
 enum class MessageId : std::uint8_t
@@ -27,6 +30,13 @@ enum class MessageId : std::uint8_t
 };
 #undef MESSAGE_ID_ENTRY
 
+#define MESSAGE_ID_COUNT(X) + 1
+template <>
+struct EnumLast<MessageId>
+        : std::integral_constant<MessageId, enumValue<MessageId>((0 FOR_ALL_MESSAGE_IDS(MESSAGE_ID_COUNT)) - 1)>
+{};
+#undef MESSAGE_ID_COUNT
+
 constexpr auto get(MessageId messageId)
 {
     return static_cast<std::underlying_type_t<MessageId>>(messageId);
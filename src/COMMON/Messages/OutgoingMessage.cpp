@@ -6,12 +6,15 @@ namespace common
 {
 
 OutgoingMessage::OutgoingMessage(MessageId messageId, PhoneNumber from, PhoneNumber to)
+    : OutgoingMessage()
 {
     writeMessageHeader(MessageHeader{messageId, from, to});
 }
 
 OutgoingMessage::OutgoingMessage()
-{}
+{
+    message.value.reserve(INITIAL_CAPACITY);
+}
 
 void OutgoingMessage::writeNumber(bool value)
 {
@@ -35,6 +38,11 @@ void OutgoingMessage::writeMessageId(MessageId messageId)
 
 void OutgoingMessage::writeText(const std::string &text)
 {
+    if (message.value.size() + text.size() > message.value.capacity())
+    {
+        message.value.reserve(static_cast<BinaryMessage::Value::size_type>(
+            std::min(message.value.size() + text.size(), BinaryMessage::MAX_SIZE)));
+    }
     std::copy(text.begin(), text.end(), std::back_inserter(message.value));
 }
 
@@ -14,6 +14,9 @@ namespace common
 class OutgoingMessage
 {
 public:
+    // header and any fixed-size payload fit without reallocation
+    static constexpr std::size_t INITIAL_CAPACITY = 64u;
+
     class WriteEx : public std::logic_error
     {
     public:
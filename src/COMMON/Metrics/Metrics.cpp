@@ -0,0 +1,97 @@
+#include "Metrics.hpp"
+
+namespace common
+{
+
+std::size_t Counter::shardIndex() noexcept
+{
+    static std::atomic<std::size_t> nextThread{0u};
+    thread_local const std::size_t index = nextThread.fetch_add(1u, std::memory_order_relaxed) % SHARD_COUNT;
+    return index;
+}
+
+std::uint64_t Counter::value() const noexcept
+{
+    std::uint64_t result = 0u;
+    for (const auto& shard : shards)
+    {
+        result += shard.value.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+Gauge::Gauge(Sampler sampler)
+    : sampler(std::move(sampler))
+{}
+
+std::int64_t Gauge::value() const
+{
+    return sampler ? sampler() : current.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Histogram::count() const noexcept
+{
+    std::uint64_t result = 0u;
+    for (const auto& bucket : buckets)
+    {
+        result += bucket.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+std::uint64_t Histogram::sum() const noexcept
+{
+    return sumOfValues.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Histogram::bucketCount(std::size_t index) const noexcept
+{
+    return index < BUCKET_COUNT ? buckets[index].load(std::memory_order_relaxed) : 0u;
+}
+
+std::uint64_t Histogram::percentile(double fraction) const noexcept
+{
+    const std::uint64_t total = count();
+    if (total == 0u)
+    {
+        return 0u;
+    }
+    const auto rank = std::uint64_t(fraction * double(total - 1u));
+    std::uint64_t cumulative = 0u;
+    for (std::size_t index = 0u; index < BUCKET_COUNT; ++index)
+    {
+        cumulative += buckets[index].load(std::memory_order_relaxed);
+        if (cumulative > rank)
+        {
+            return bucketUpperBound(index);
+        }
+    }
+    return bucketUpperBound(BUCKET_COUNT - 1u);
+}
+
+std::size_t Histogram::bucketIndex(std::uint64_t value) noexcept
+{
+    if (value < SUB_BUCKET_COUNT)
+    {
+        return static_cast<std::size_t>(value);
+    }
+    // values of [2^exponent, 2^(exponent + 1)) share exponent, next bits choose the sub-bucket
+    const unsigned exponent = 63u - static_cast<unsigned>(__builtin_clzll(value));
+    const unsigned shift = exponent - SUB_BUCKET_BITS;
+    const std::uint64_t subBucket = (value >> shift) & (SUB_BUCKET_COUNT - 1u);
+    return static_cast<std::size_t>((shift + 1u) * SUB_BUCKET_COUNT + subBucket);
+}
+
+std::uint64_t Histogram::bucketUpperBound(std::size_t index) noexcept
+{
+    if (index < SUB_BUCKET_COUNT)
+    {
+        return index;
+    }
+    const unsigned shift = static_cast<unsigned>(index / SUB_BUCKET_COUNT) - 1u;
+    const std::uint64_t subBucket = index % SUB_BUCKET_COUNT;
+    const std::uint64_t lowerBound = (SUB_BUCKET_COUNT + subBucket) << shift;
+    return lowerBound + ((std::uint64_t(1u) << shift) - 1u);
+}
+
+}
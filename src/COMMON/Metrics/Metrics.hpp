@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace common
+{
+
+/**
+ * Monotonic counter - every thread adds to its own shard, so hot counters do not bounce cache lines
+ */
+class Counter
+{
+public:
+    static constexpr std::size_t SHARD_COUNT = 16u;
+
+    void add(std::uint64_t value = 1u) noexcept
+    {
+        shards[shardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+    std::uint64_t value() const noexcept;
+
+private:
+    struct alignas(64) Shard
+    {
+        std::atomic<std::uint64_t> value{0u};
+    };
+
+    static std::size_t shardIndex() noexcept;
+
+    std::array<Shard, SHARD_COUNT> shards;
+};
+
+/**
+ * Value that goes up and down - either set directly or sampled from callback at export time
+ */
+class Gauge
+{
+public:
+    using Sampler = std::function<std::int64_t()>;
+
+    Gauge() = default;
+    explicit Gauge(Sampler sampler);
+
+    void set(std::int64_t value) noexcept
+    {
+        current.store(value, std::memory_order_relaxed);
+    }
+    void add(std::int64_t value) noexcept
+    {
+        current.fetch_add(value, std::memory_order_relaxed);
+    }
+    std::int64_t value() const;
+
+private:
+    std::atomic<std::int64_t> current{0};
+    Sampler sampler;
+};
+
+/**
+ * HDR-style log-linear histogram of unsigned values: each power of 2 is split into SUB_BUCKET_COUNT
+ * equal buckets, so any recorded value is known within 1/SUB_BUCKET_COUNT relative error.
+ * Recording is one relaxed increment - no locks, no allocations.
+ */
+class Histogram
+{
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 3u;
+    static constexpr std::uint64_t SUB_BUCKET_COUNT = 1u << SUB_BUCKET_BITS;
+    static constexpr std::size_t BUCKET_COUNT = SUB_BUCKET_COUNT * (64u - SUB_BUCKET_BITS + 1u);
+
+    void record(std::uint64_t value) noexcept
+    {
+        buckets[bucketIndex(value)].fetch_add(1u, std::memory_order_relaxed);
+        sumOfValues.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    std::uint64_t count() const noexcept;
+    std::uint64_t sum() const noexcept;
+    std::uint64_t bucketCount(std::size_t index) const noexcept;
+    /**
+     * @return upper bound of the bucket holding given fraction (0..1) of recorded values, 0 when empty
+     */
+    std::uint64_t percentile(double fraction) const noexcept;
+
+    static std::size_t bucketIndex(std::uint64_t value) noexcept;
+    /**
+     * Highest value falling into given bucket
+     */
+    static std::uint64_t bucketUpperBound(std::size_t index) noexcept;
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets{};
+    std::atomic<std::uint64_t> sumOfValues{0u};
+};
+
+}
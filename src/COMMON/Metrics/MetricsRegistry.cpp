@@ -0,0 +1,199 @@
+#include "MetricsRegistry.hpp"
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace common
+{
+
+namespace
+{
+
+void writeLabels(std::ostream& os, const MetricsRegistry::Labels& labels, const std::string& extraName = "",
+                 const std::string& extraValue = "")
+{
+    if (labels.empty() and extraName.empty())
+    {
+        return;
+    }
+    os << '{';
+    const char* separator = "";
+    for (const auto& [name, value] : labels)
+    {
+        os << separator << name << "=\"" << value << '"';
+        separator = ",";
+    }
+    if (not extraName.empty())
+    {
+        os << separator << extraName << "=\"" << extraValue << '"';
+    }
+    os << '}';
+}
+
+std::string formatValue(double value)
+{
+    std::ostringstream os;
+    os.precision(std::numeric_limits<double>::max_digits10);
+    os << value;
+    return os.str();
+}
+
+}
+
+Counter &MetricsRegistry::counter(const std::string &name, const std::string &help, const Labels &labels)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    Metric& metric = findOrAdd(name, help, Type::Counter, 1.0, labels);
+    if (not metric.counter)
+    {
+        metric.counter = std::make_unique<Counter>();
+    }
+    return *metric.counter;
+}
+
+void MetricsRegistry::counter(const std::string &name, const std::string &help, Gauge::Sampler sampler,
+                              const Labels &labels)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    Metric& metric = findOrAdd(name, help, Type::Counter, 1.0, labels);
+    if (not metric.counter and not metric.gauge)
+    {
+        // exported the same way as sampled gauge, only family type differs
+        metric.gauge = std::make_unique<Gauge>(std::move(sampler));
+    }
+}
+
+Gauge &MetricsRegistry::gauge(const std::string &name, const std::string &help, const Labels &labels)
+{
+    return gauge(name, help, nullptr, labels);
+}
+
+Gauge &MetricsRegistry::gauge(const std::string &name, const std::string &help, Gauge::Sampler sampler,
+                              const Labels &labels)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    Metric& metric = findOrAdd(name, help, Type::Gauge, 1.0, labels);
+    if (not metric.gauge)
+    {
+        metric.gauge = sampler ? std::make_unique<Gauge>(std::move(sampler)) : std::make_unique<Gauge>();
+    }
+    return *metric.gauge;
+}
+
+Histogram &MetricsRegistry::histogram(const std::string &name, const std::string &help, double exportScale,
+                                      const Labels &labels, HistogramRange range)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    Metric& metric = findOrAdd(name, help, Type::Histogram, exportScale, labels, range);
+    if (not metric.histogram)
+    {
+        metric.histogram = std::make_unique<Histogram>();
+    }
+    return *metric.histogram;
+}
+
+MetricsRegistry::Metric &MetricsRegistry::findOrAdd(const std::string &name, const std::string &help, Type type,
+                                                    double exportScale, const Labels &labels,
+                                                    HistogramRange range)
+{
+    auto family = std::find_if(families.begin(), families.end(), [&name](const auto& family)
+    {
+        return family->name == name;
+    });
+    if (family == families.end())
+    {
+        families.push_back(std::make_unique<Family>(Family{name, help, type, exportScale, range, {}}));
+        family = std::prev(families.end());
+    }
+    else if ((*family)->type != type)
+    {
+        throw std::invalid_argument("Metric " + name + " already registered as other type");
+    }
+
+    auto& metrics = (*family)->metrics;
+    auto metric = std::find_if(metrics.begin(), metrics.end(), [&labels](const Metric& metric)
+    {
+        return metric.labels == labels;
+    });
+    if (metric == metrics.end())
+    {
+        // metric objects are owned by pointers - growing the vector does not move them
+        metrics.push_back(Metric{labels, nullptr, nullptr, nullptr});
+        return metrics.back();
+    }
+    return *metric;
+}
+
+void MetricsRegistry::writePrometheus(std::ostream &os) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& family : families)
+    {
+        writeFamily(os, *family);
+    }
+}
+
+const char *MetricsRegistry::typeName(Type type)
+{
+    switch (type)
+    {
+    case Type::Counter: return "counter";
+    case Type::Gauge: return "gauge";
+    case Type::Histogram: return "histogram";
+    }
+    return "untyped";
+}
+
+void MetricsRegistry::writeFamily(std::ostream &os, const Family &family)
+{
+    os << "# HELP " << family.name << ' ' << family.help << '\n'
+       << "# TYPE " << family.name << ' '
+       << typeName(family.type) << '\n';
+
+    for (const Metric& metric : family.metrics)
+    {
+        if (metric.counter)
+        {
+            os << family.name;
+            writeLabels(os, metric.labels);
+            os << ' ' << metric.counter->value() << '\n';
+        }
+        else if (metric.gauge)
+        {
+            os << family.name;
+            writeLabels(os, metric.labels);
+            os << ' ' << metric.gauge->value() << '\n';
+        }
+        else if (metric.histogram)
+        {
+            // cumulative buckets at ends of powers of 2 within the range - fixed layout, series do not come and go
+            const Histogram& histogram = *metric.histogram;
+            std::uint64_t cumulative = 0u;
+            for (std::size_t index = 0u; index < Histogram::BUCKET_COUNT; ++index)
+            {
+                cumulative += histogram.bucketCount(index);
+                const std::uint64_t upperBound = Histogram::bucketUpperBound(index);
+                const bool endOfPowerOf2 = index % Histogram::SUB_BUCKET_COUNT == Histogram::SUB_BUCKET_COUNT - 1u;
+                if (endOfPowerOf2 and upperBound >= family.range.lowest and upperBound <= family.range.highest)
+                {
+                    os << family.name << "_bucket";
+                    writeLabels(os, metric.labels, "le",
+                                formatValue(double(upperBound) * family.exportScale));
+                    os << ' ' << cumulative << '\n';
+                }
+            }
+            os << family.name << "_bucket";
+            writeLabels(os, metric.labels, "le", "+Inf");
+            os << ' ' << cumulative << '\n';
+            os << family.name << "_sum";
+            writeLabels(os, metric.labels);
+            os << ' ' << formatValue(double(histogram.sum()) * family.exportScale) << '\n';
+            os << family.name << "_count";
+            writeLabels(os, metric.labels);
+            os << ' ' << cumulative << '\n';
+        }
+    }
+}
+
+}
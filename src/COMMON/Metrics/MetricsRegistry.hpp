@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Metrics.hpp"
+
+namespace common
+{
+
+/**
+ * Recorded values covered by exported histogram buckets - the same bucket layout on every export, whatever was
+ * recorded: one bucket for each power of 2, bounds 2^k - 1 (k >= 3) from lowest to highest, then +Inf
+ */
+struct HistogramRange
+{
+    std::uint64_t lowest = 1u;
+    std::uint64_t highest = std::numeric_limits<std::uint64_t>::max();
+};
+
+/**
+ * Named metrics exported in Prometheus text format. Registration locks, updates of registered metrics do not -
+ * register at start up and keep the references, they stay valid as long as the registry.
+ */
+class MetricsRegistry
+{
+public:
+    using Labels = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * The same name and labels give the same metric
+     * @throw std::invalid_argument when name is already registered as other type
+     */
+    Counter& counter(const std::string& name, const std::string& help, const Labels& labels = {});
+    /**
+     * Counter kept elsewhere - sampler shall return monotonic value, it is called from writePrometheus
+     */
+    void counter(const std::string& name, const std::string& help, Gauge::Sampler sampler, const Labels& labels = {});
+    Gauge& gauge(const std::string& name, const std::string& help, const Labels& labels = {});
+    /**
+     * @param sampler called from writePrometheus - it must not register metrics
+     */
+    Gauge& gauge(const std::string& name, const std::string& help, Gauge::Sampler sampler, const Labels& labels = {});
+    /**
+     * @param exportScale recorded values are multiplied by it on export - e.g. 1e-9 for nanoseconds exported as seconds
+     * @param range of recorded values exported as buckets - of the family, taken at its first registration
+     */
+    Histogram& histogram(const std::string& name, const std::string& help, double exportScale = 1.0,
+                         const Labels& labels = {}, HistogramRange range = {});
+
+    void writePrometheus(std::ostream& os) const;
+
+private:
+    enum class Type { Counter, Gauge, Histogram };
+
+    struct Metric
+    {
+        Labels labels;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    struct Family
+    {
+        std::string name;
+        std::string help;
+        Type type;
+        double exportScale;
+        HistogramRange range;
+        std::vector<Metric> metrics;
+    };
+
+    Metric& findOrAdd(const std::string& name, const std::string& help, Type type, double exportScale,
+                      const Labels& labels, HistogramRange range = {});
+    static const char* typeName(Type type);
+    static void writeFamily(std::ostream& os, const Family& family);
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Family>> families;
+};
+
+}
@@ -0,0 +1,152 @@
+#include "SpaceSaving.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace common
+{
+
+namespace
+{
+// epoch of slots not used yet - never current
+constexpr std::int64_t NO_EPOCH = INT64_MIN;
+}
+
+SpaceSaving::SpaceSaving(std::size_t capacity)
+    : maxSize(capacity)
+{
+    if (capacity == 0u)
+    {
+        throw std::invalid_argument("Space saving capacity shall not be zero");
+    }
+    tracked.reserve(capacity);
+}
+
+void SpaceSaving::add(Key key, std::uint64_t amount) noexcept
+{
+    auto found = std::find_if(tracked.begin(), tracked.end(), [key](const Entry& entry) { return entry.key == key; });
+    if (found != tracked.end())
+    {
+        found->count += amount;
+        return;
+    }
+    if (not isFull())
+    {
+        tracked.push_back(Entry{key, amount, 0u});
+        return;
+    }
+    auto smallest = std::min_element(tracked.begin(), tracked.end(), [](const Entry& lhs, const Entry& rhs)
+    {
+        return lhs.count < rhs.count;
+    });
+    *smallest = Entry{key, smallest->count + amount, smallest->count};
+}
+
+void SpaceSaving::clear() noexcept
+{
+    tracked.clear();
+}
+
+std::uint64_t SpaceSaving::minCount() const noexcept
+{
+    if (not isFull())
+    {
+        return 0u;
+    }
+    return std::min_element(tracked.begin(), tracked.end(), [](const Entry& lhs, const Entry& rhs)
+    {
+        return lhs.count < rhs.count;
+    })->count;
+}
+
+SlidingTopK::SlidingTopK(Clock::duration window, std::size_t windowCount, std::size_t capacity)
+    : subWindow(windowCount == 0u ? Clock::duration::zero() : window / static_cast<Clock::rep>(windowCount))
+{
+    if (subWindow <= Clock::duration::zero())
+    {
+        throw std::invalid_argument("Sliding top-k window shall not be zero");
+    }
+    slots.reserve(windowCount);
+    for (std::size_t index = 0u; index < windowCount; ++index)
+    {
+        slots.push_back(Slot{NO_EPOCH, SpaceSaving(capacity)});
+    }
+}
+
+std::int64_t SlidingTopK::epochOf(Clock::time_point time) const noexcept
+{
+    return time.time_since_epoch() / subWindow;
+}
+
+void SlidingTopK::add(SpaceSaving::Key key, std::uint64_t amount, Clock::time_point now) noexcept
+{
+    const std::int64_t epoch = epochOf(now);
+    Slot& slot = slots[static_cast<std::size_t>(epoch) % slots.size()];
+    if (slot.epoch != epoch)
+    {
+        slot.epoch = epoch;
+        slot.counter.clear();
+    }
+    slot.counter.add(key, amount);
+}
+
+std::vector<SlidingTopK::Entry> SlidingTopK::top(std::size_t k, Clock::time_point now) const
+{
+    const std::int64_t current = epochOf(now);
+    auto isLive = [&](const Slot& slot)
+    {
+        return slot.epoch != NO_EPOCH and slot.epoch <= current and current - slot.epoch < std::int64_t(slots.size());
+    };
+
+    std::vector<Entry> merged;
+    for (const Slot& slot : slots)
+    {
+        if (not isLive(slot))
+        {
+            continue;
+        }
+        for (const Entry& entry : slot.counter.entries())
+        {
+            auto found = std::find_if(merged.begin(), merged.end(), [&entry](const Entry& other)
+            {
+                return other.key == entry.key;
+            });
+            if (found == merged.end())
+            {
+                merged.push_back(Entry{entry.key, 0u, 0u});
+                found = std::prev(merged.end());
+            }
+            found->count += entry.count;
+            found->error += entry.error;
+        }
+    }
+    // in sub-windows where a key is missing it may still have had up to their smallest count
+    for (const Slot& slot : slots)
+    {
+        if (not isLive(slot) or not slot.counter.isFull())
+        {
+            continue;
+        }
+        const std::uint64_t missing = slot.counter.minCount();
+        for (Entry& entry : merged)
+        {
+            const auto& entries = slot.counter.entries();
+            if (std::none_of(entries.begin(), entries.end(), [&entry](const Entry& other) { return other.key == entry.key; }))
+            {
+                entry.count += missing;
+                entry.error += missing;
+            }
+        }
+    }
+
+    std::sort(merged.begin(), merged.end(), [](const Entry& lhs, const Entry& rhs)
+    {
+        return lhs.count != rhs.count ? lhs.count > rhs.count : lhs.key < rhs.key;
+    });
+    if (merged.size() > k)
+    {
+        merged.resize(k);
+    }
+    return merged;
+}
+
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace common
+{
+
+/**
+ * Space-saving top-k counter (Metwally et al.) - tracks at most capacity keys in fixed memory.
+ * When full, a new key takes the place of the smallest one and inherits its count as error, so for every
+ * tracked key: count - error <= true count <= count, and any key with more than total/capacity is tracked.
+ * Not thread-safe. Adding does not allocate.
+ */
+class SpaceSaving
+{
+public:
+    using Key = std::uint32_t;
+
+    struct Entry
+    {
+        Key key;
+        std::uint64_t count;
+        std::uint64_t error;
+    };
+
+    /**
+     * @throw std::invalid_argument for zero capacity
+     */
+    explicit SpaceSaving(std::size_t capacity);
+
+    void add(Key key, std::uint64_t amount = 1u) noexcept;
+    void clear() noexcept;
+
+    /**
+     * Not sorted
+     */
+    const std::vector<Entry>& entries() const noexcept { return tracked; }
+    std::size_t capacity() const noexcept { return maxSize; }
+    bool isFull() const noexcept { return tracked.size() == maxSize; }
+    /**
+     * Upper bound of the true count of any not tracked key
+     */
+    std::uint64_t minCount() const noexcept;
+
+private:
+    std::size_t maxSize;
+    std::vector<Entry> tracked;
+};
+
+/**
+ * Top-k over a sliding window made of windowCount consecutive sub-windows - the oldest one is dropped as time goes
+ */
+class SlidingTopK
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Entry = SpaceSaving::Entry;
+
+    /**
+     * @param capacity of each sub-window
+     * @throw std::invalid_argument for zero window, window count or capacity
+     */
+    SlidingTopK(Clock::duration window, std::size_t windowCount, std::size_t capacity);
+
+    void add(SpaceSaving::Key key, std::uint64_t amount, Clock::time_point now) noexcept;
+    /**
+     * @return up to k entries from the last window, highest count first
+     */
+    std::vector<Entry> top(std::size_t k, Clock::time_point now) const;
+
+    Clock::duration window() const noexcept { return subWindow * static_cast<Clock::rep>(slots.size()); }
+
+private:
+    struct Slot
+    {
+        std::int64_t epoch;
+        SpaceSaving counter;
+    };
+
+    std::int64_t epochOf(Clock::time_point time) const noexcept;
+
+    Clock::duration subWindow;
+    std::vector<Slot> slots;
+};
+
+}
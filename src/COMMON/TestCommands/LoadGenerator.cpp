@@ -0,0 +1,169 @@
+#include "LoadGenerator.hpp"
+#include "Messages/OutgoingMessage.hpp"
+#include "Messages/MessageHeader.hpp"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+
+namespace common
+{
+
+namespace
+{
+
+template <typename T>
+void assertRange(const LoadGenerator::Range<T>& range, const std::string& name)
+{
+    if (range.last < range.first)
+    {
+        throw std::invalid_argument("load: empty " + name + " range");
+    }
+}
+
+const char* toString(LoadGenerator::Profile profile)
+{
+    switch (profile)
+    {
+    case LoadGenerator::Profile::Constant: return "constant";
+    case LoadGenerator::Profile::Poisson: return "poisson";
+    case LoadGenerator::Profile::Burst: return "burst";
+    }
+    return "?";
+}
+
+}
+
+double LoadGenerator::Report::achievedRate() const
+{
+    using Seconds = std::chrono::duration<double>;
+    const double seconds = std::chrono::duration_cast<Seconds>(elapsed).count();
+    return seconds > 0.0 ? sent / seconds : 0.0;
+}
+
+LoadGenerator::LoadGenerator(Settings settings)
+    : settings(settings)
+{
+    if (not (settings.messagesPerSecond > 0.0) or settings.burstSize == 0u)
+    {
+        throw std::invalid_argument("load: rate and burst size shall be positive");
+    }
+    if (settings.messagesPerSecond > MAX_MESSAGES_PER_SECOND or settings.burstSize > MAX_BURST_SIZE)
+    {
+        std::ostringstream os;
+        os << "load: rate above " << MAX_MESSAGES_PER_SECOND << "/s or burst size above " << MAX_BURST_SIZE;
+        throw std::invalid_argument(os.str());
+    }
+    constexpr std::size_t MAX_PAYLOAD_SIZE = BinaryMessage::MAX_SIZE - sizeof(MessageHeader);
+    if (settings.payloadSize.last > MAX_PAYLOAD_SIZE)
+    {
+        throw std::invalid_argument("load: payload bigger than " + std::to_string(MAX_PAYLOAD_SIZE));
+    }
+    assertRange(settings.from, "from");
+    assertRange(settings.to, "to");
+    assertRange(settings.payloadSize, "payload size");
+}
+
+LoadGenerator::Session LoadGenerator::start(Clock::time_point now) const
+{
+    return Session{settings, now};
+}
+
+LoadGenerator::Report LoadGenerator::run(const SendMessage& sendMessage) const
+{
+    Session session = start();
+    while (auto next = session.sendDue(sendMessage))
+    {
+        std::this_thread::sleep_until(*next);
+    }
+    return session.report();
+}
+
+LoadGenerator::Session::Session(const Settings &settings, Clock::time_point start)
+    : settings(settings),
+      random(std::random_device{}()),
+      fromDistribution(settings.from.first.value, settings.from.last.value),
+      toDistribution(settings.to.first.value, settings.to.last.value),
+      sizeDistribution(settings.payloadSize.first, settings.payloadSize.last),
+      poissonInterval(settings.messagesPerSecond),
+      payloadPattern(settings.payloadSize.last, 'x'),
+      start(start)
+{}
+
+std::optional<LoadGenerator::Clock::time_point> LoadGenerator::Session::sendDue(const SendMessage &sendMessage, Clock::time_point now)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    const auto end = start + settings.duration;
+    for (std::size_t sends = 0u;; ++sends)
+    {
+        const auto sendTime = start + duration_cast<Clock::duration>(planned);
+        if (sendTime >= end)
+        {
+            // the whole run window - not just up to the last send
+            result.elapsed = duration_cast<microseconds>(std::max(now, end) - start);
+            return std::nullopt;
+        }
+        if (sendTime > now or sends == MAX_SENDS_PER_CALL)
+        {
+            return sendTime;
+        }
+        result.maxLag = std::max(result.maxLag, duration_cast<microseconds>(now - sendTime));
+
+        const PhoneNumber to{static_cast<PhoneNumber::Value>(toDistribution(random))};
+        OutgoingMessage messageBuilder(settings.messageId,
+                                       PhoneNumber{static_cast<PhoneNumber::Value>(fromDistribution(random))},
+                                       to);
+        messageBuilder.writeText(payloadPattern.substr(0u, sizeDistribution(random)));
+        if (sendMessage(messageBuilder.getMessage(), to))
+        {
+            ++result.sent;
+        }
+        else
+        {
+            ++result.failed;
+        }
+        planNext();
+    }
+}
+
+void LoadGenerator::Session::planNext()
+{
+    using Seconds = std::chrono::duration<double>;
+    const Seconds meanInterval{1.0 / settings.messagesPerSecond};
+
+    switch (settings.profile)
+    {
+    case Profile::Constant:
+        planned += meanInterval;
+        break;
+    case Profile::Poisson:
+        planned += Seconds{poissonInterval(random)};
+        break;
+    case Profile::Burst:
+        if (++index % settings.burstSize == 0u)
+        {
+            planned += meanInterval * double(settings.burstSize);
+        }
+        break;
+    }
+}
+
+std::string LoadGenerator::toString(const Settings& settings, const Report& report)
+{
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(1)
+       << "load " << common::toString(settings.profile)
+       << ": sent: " << report.sent
+       << ", failed: " << report.failed
+       << ", elapsed: " << report.elapsed.count() / 1000.0 << "ms"
+       << ", achieved: " << report.achievedRate() << "/s"
+       << " (target: " << settings.messagesPerSecond << "/s)"
+       << ", max lag: " << report.maxLag.count() / 1000.0 << "ms\n";
+    return os.str();
+}
+
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Messages/MessageId.hpp"
+#include "Messages/PhoneNumber.hpp"
+#include "Messages/BinaryMessage.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <random>
+#include <string>
+
+namespace common
+{
+
+/**
+ * Open-loop sender: send times are planned in advance from the profile,
+ * a slow send does not shift following ones (they are sent as soon as possible).
+ */
+class LoadGenerator
+{
+public:
+    enum class Profile
+    {
+        Constant,   // equal intervals
+        Poisson,    // exponentially distributed intervals
+        Burst       // burstSize messages at once, bursts at equal intervals
+    };
+
+    template <typename T>
+    struct Range
+    {
+        T first;
+        T last;
+    };
+
+    struct Settings
+    {
+        Profile profile = Profile::Constant;
+        std::size_t burstSize = 1u;
+        double messagesPerSecond = 1.0;
+        std::chrono::milliseconds duration{1000};
+        MessageId messageId = MessageId::Sms;
+        Range<PhoneNumber> from{};
+        Range<PhoneNumber> to{};
+        Range<std::size_t> payloadSize{};
+    };
+
+    struct Report
+    {
+        std::size_t sent = 0u;
+        std::size_t failed = 0u;
+        std::chrono::microseconds elapsed{0};
+        std::chrono::microseconds maxLag{0};
+
+        double achievedRate() const;
+    };
+
+    using SendMessage = std::function<bool(const BinaryMessage&, PhoneNumber /*to*/)>;
+    using Clock = std::chrono::steady_clock;
+
+    // above these intervals round to nothing and a single sendDue would never catch up
+    static constexpr double MAX_MESSAGES_PER_SECOND = 1e6;
+    static constexpr std::size_t MAX_BURST_SIZE = 10000u;
+    // sendDue returns after that many sends even when more are due - lets the caller's loop breathe
+    static constexpr std::size_t MAX_SENDS_PER_CALL = 1000u;
+
+    /**
+     * One run of the generator - lets the caller decide how to wait for the next send time
+     */
+    class Session
+    {
+    public:
+        Session(const Settings& settings, Clock::time_point start);
+
+        /**
+         * Sends messages planned up to now, at most MAX_SENDS_PER_CALL of them
+         * @return planned time of the next message (already past when the limit was hit),
+         *         nothing when the run is over
+         */
+        std::optional<Clock::time_point> sendDue(const SendMessage& sendMessage,
+                                                 Clock::time_point now = Clock::now());
+        const Report& report() const { return result; }
+
+    private:
+        void planNext();
+
+        const Settings& settings;
+        std::mt19937 random;
+        std::uniform_int_distribution<unsigned> fromDistribution;
+        std::uniform_int_distribution<unsigned> toDistribution;
+        std::uniform_int_distribution<std::size_t> sizeDistribution;
+        std::exponential_distribution<double> poissonInterval;
+        const std::string payloadPattern;
+        const Clock::time_point start;
+        std::chrono::duration<double> planned{0};
+        std::size_t index = 0u;
+        Report result{};
+    };
+
+    /** @throw std::invalid_argument for inconsistent settings */
+    explicit LoadGenerator(Settings settings);
+
+    const Settings& getSettings() const { return settings; }
+
+    /** Session keeps reference to this generator */
+    Session start(Clock::time_point now = Clock::now()) const;
+    /** Blocking run - sleeps between sends */
+    Report run(const SendMessage& sendMessage) const;
+
+    static std::string toString(const Settings& settings, const Report& report);
+
+private:
+    Settings settings;
+};
+
+}
@@ -0,0 +1,135 @@
+#include "TaskScheduler.hpp"
+#include "Time/SteadyClock.hpp"
+#include <stdexcept>
+
+namespace common
+{
+
+TaskScheduler::TaskScheduler(std::size_t threadCount)
+    : TaskScheduler(std::make_shared<SteadyClock>(), threadCount)
+{}
+
+TaskScheduler::TaskScheduler(ClockPtr clock, std::size_t threadCount)
+    : clock(std::move(clock)),
+      queue(std::make_shared<Queue>())
+{
+    if (threadCount == 0u)
+    {
+        throw std::invalid_argument("TaskScheduler needs at least one thread");
+    }
+    if (not this->clock)
+    {
+        throw std::invalid_argument("TaskScheduler needs clock");
+    }
+    workers.reserve(threadCount);
+    for (std::size_t i = 0u; i < threadCount; ++i)
+    {
+        workers.emplace_back(&TaskScheduler::work, this);
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->stopping = true;
+        queue->tasks.clear();
+    }
+    queue->changed.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+TaskScheduler::Clock::time_point TaskScheduler::now() const
+{
+    return clock->now();
+}
+
+void TaskScheduler::post(Task task)
+{
+    postAt(now(), std::move(task));
+}
+
+void TaskScheduler::postAfter(Clock::duration delay, Task task)
+{
+    postAt(now() + delay, std::move(task));
+}
+
+void TaskScheduler::postAt(Clock::time_point when, Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (queue->stopping)
+        {
+            return;
+        }
+        queue->tasks.emplace(when, std::move(task));
+    }
+    // new task might be earlier than the one workers wait for
+    queue->changed.notify_one();
+}
+
+std::size_t TaskScheduler::pendingCount() const
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->tasks.size();
+}
+
+void TaskScheduler::armWakeUp(Clock::time_point when)
+{
+    // called with queue locked, earlier wake-up already armed is good enough
+    if (queue->wakeUpAt and *queue->wakeUpAt <= when)
+    {
+        return;
+    }
+    queue->wakeUpAt = when;
+    // superseded wake-up is not cancelled - it just wakes workers for nothing
+    clock->scheduleAt(when, [weakQueue = std::weak_ptr<Queue>(queue), when]
+    {
+        if (auto queue = weakQueue.lock())
+        {
+            {
+                std::lock_guard<std::mutex> lock(queue->mutex);
+                if (queue->wakeUpAt == when)
+                {
+                    queue->wakeUpAt.reset();
+                }
+            }
+            queue->changed.notify_all();
+        }
+    });
+}
+
+void TaskScheduler::work()
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    while (not queue->stopping)
+    {
+        if (queue->tasks.empty())
+        {
+            queue->changed.wait(lock);
+            continue;
+        }
+        auto first = queue->tasks.begin();
+        if (first->first > clock->now())
+        {
+            armWakeUp(first->first);
+            queue->changed.wait(lock);
+            continue;
+        }
+        Task task = std::move(first->second);
+        queue->tasks.erase(first);
+        // let other worker take the next due task
+        if (not queue->tasks.empty())
+        {
+            queue->changed.notify_one();
+        }
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "Time/IClock.hpp"
+
+namespace common
+{
+
+/**
+ * Small fixed pool of worker threads running immediate and delayed tasks.
+ * Nothing sleeps on behalf of a task - delayed task just waits in the queue
+ * until a timer of the clock wakes the workers up.
+ * Tasks shall not throw.
+ */
+class TaskScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Task = std::function<void()>;
+    static constexpr std::size_t DEFAULT_THREAD_COUNT = 2u;
+
+    /**
+     * Runs on real time (own SteadyClock)
+     * @throw std::invalid_argument for zero threads
+     */
+    explicit TaskScheduler(std::size_t threadCount = DEFAULT_THREAD_COUNT);
+    /** @throw std::invalid_argument for zero threads or no clock */
+    TaskScheduler(ClockPtr clock, std::size_t threadCount = DEFAULT_THREAD_COUNT);
+    /** Drops not started tasks, waits for running ones */
+    ~TaskScheduler();
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    Clock::time_point now() const;
+
+    void post(Task task);
+    void postAt(Clock::time_point when, Task task);
+    void postAfter(Clock::duration delay, Task task);
+
+    std::size_t pendingCount() const;
+
+private:
+    // outlives scheduler when clock still holds a wake-up timer
+    struct Queue
+    {
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool stopping = false;
+        // tasks with the same time point keep posting order
+        std::multimap<Clock::time_point, Task> tasks;
+        std::optional<Clock::time_point> wakeUpAt;
+    };
+
+    void work();
+    void armWakeUp(Clock::time_point when);
+
+    ClockPtr clock;
+    std::shared_ptr<Queue> queue;
+    std::vector<std::thread> workers;
+};
+
+}
@@ -2,13 +2,75 @@
 #include <sstream>
 #include <stdexcept>
 #include <chrono>
-#include <thread>
+#include <atomic>
+#include <future>
 #include "Messages/OutgoingMessage.hpp"
 #include "Messages/MessageId.hpp"
+#include "LoadGenerator.hpp"
 
 namespace common
 {
 
+class TestCommands::Context : public std::enable_shared_from_this<Context>
+{
+public:
+    Context(Parameters parameters, TaskScheduler& scheduler, Finished finished)
+        : parameters(std::move(parameters)),
+          scheduler(scheduler),
+          finished(std::move(finished))
+    {}
+
+    const Parameters parameters;
+
+    TaskScheduler::Clock::time_point now() const
+    {
+        return scheduler.now();
+    }
+
+    // exception from the task is reported and finishes the plan
+    void schedule(TaskScheduler::Clock::time_point when, Continuation task)
+    {
+        scheduler.postAt(when, [self = shared_from_this(), task = std::move(task)]
+        {
+            try
+            {
+                task();
+            }
+            catch (std::exception& ex)
+            {
+                self->parameters.printText(std::string("test commands failed: ") + ex.what() + "\n");
+                self->finish(false);
+            }
+        });
+    }
+
+    void finish(bool succeeded)
+    {
+        if (not finishedAlready.exchange(true) and finished)
+        {
+            finished(succeeded);
+        }
+    }
+
+private:
+    TaskScheduler& scheduler;
+    const Finished finished;
+    std::atomic<bool> finishedAlready{false};
+};
+
+namespace
+{
+
+// completion state of one step of the sequence - see runSequence
+enum StepState : int
+{
+    RUNNING,
+    COMPLETED,
+    SUSPENDED
+};
+
+}
+
 const TestCommands::TextCommandMap TestCommands::textCommandMap =
 {
 
@@ -32,23 +94,78 @@ const TestCommands::TextCommandMap TestCommands::textCommandMap =
     {"echo", &TestCommands::readWriteCommand },
     {"e", &TestCommands::readWriteCommand },
 
+    {"load", &TestCommands::readLoadCommand },
+    {"l", &TestCommands::readLoadCommand },
+
 };
 
 TestCommands::TestCommands(std::string args)
 {
     std::istringstream iss(args);
+    Commands plan;
     while (Command command = readCommand(iss))
     {
-        commands.push_back(command);
+        plan.push_back(command);
     }
+    commands = std::make_shared<const Commands>(std::move(plan));
 }
 
-void TestCommands::run(Parameters parameters)
+void TestCommands::start(Parameters parameters, TaskScheduler &scheduler, Finished finished) const
 {
-    for (auto&& command : commands)
+    auto context = std::make_shared<Context>(std::move(parameters), scheduler, std::move(finished));
+    context->schedule(context->now(), [context, plan = commands]
     {
-        command(parameters);
-    }
+        runSequence(context, plan, 1u, [context] { context->finish(true); });
+    });
+}
+
+bool TestCommands::run(Parameters parameters) const
+{
+    TaskScheduler scheduler{1u};
+    std::promise<bool> finished;
+    start(std::move(parameters), scheduler, [&finished](bool succeeded) { finished.set_value(succeeded); });
+    return finished.get_future().get();
+}
+
+void TestCommands::runSequence(const ContextPtr &context, CommandsPtr sequence, std::size_t rounds, Continuation continuation)
+{
+    // Step completing synchronously (send, write) just lets the loop go on,
+    // step completing later (wait) resumes the loop from its continuation - stack never grows with step count.
+    struct Sequence : std::enable_shared_from_this<Sequence>
+    {
+        ContextPtr context;
+        CommandsPtr steps;
+        std::size_t count;
+        Continuation continuation;
+        std::size_t next = 0u;
+
+        void proceed()
+        {
+            while (next < count)
+            {
+                const Command& step = (*steps)[next++ % steps->size()];
+                auto state = std::make_shared<std::atomic<int>>(RUNNING);
+                step(context, [self = shared_from_this(), state]
+                {
+                    if (state->exchange(COMPLETED) == SUSPENDED)
+                    {
+                        self->proceed();
+                    }
+                });
+                if (state->exchange(SUSPENDED) == RUNNING)
+                {
+                    return;
+                }
+            }
+            continuation();
+        }
+    };
+    auto run = std::make_shared<Sequence>();
+    run->context = context;
+    run->count = sequence->size() * rounds;
+    run->steps = std::move(sequence);
+    run->continuation = std::move(continuation);
+    run->proceed();
 }
 
 TestCommands::Command TestCommands::readCommand(std::istream &is)
@@ -77,12 +194,10 @@ TestCommands::Command TestCommands::readRepeatCommand(std::istream &is)
     {
         throwError("'repeat' needs sub command!");
     }
-    return [howMany, subCommand](Parameters parameters)
+    auto body = std::make_shared<const Commands>(Commands{subCommand});
+    return [howMany, body](const ContextPtr& context, Continuation continuation)
     {
-        for (unsigned i = 0; i < howMany; ++i)
-        {
-            subCommand(parameters);
-        }
+        runSequence(context, body, howMany, std::move(continuation));
     };
 }
 
@@ -100,12 +215,10 @@ TestCommands::Command TestCommands::readGroupCommand(std::istream &is)
         }
         subCommands.push_back(subCommand);
     }
-    return [subCommands](Parameters parameters)
+    auto body = std::make_shared<const Commands>(std::move(subCommands));
+    return [body](const ContextPtr& context, Continuation continuation)
     {
-        for (auto&& subCommand: subCommands)
-        {
-            subCommand(parameters);
-        }
+        runSequence(context, body, 1u, std::move(continuation));
     };
 }
 
@@ -116,30 +229,32 @@ TestCommands::Command TestCommands::readThreadCommand(std::istream &is)
     {
         throwError("'thread' needs sub command!");
     }
-    return [subCommand](Parameters parameters)
+    return [subCommand](const ContextPtr& context, Continuation continuation)
     {
-        std::thread t([subCommand, parameters] {
-            subCommand(parameters);
+        context->schedule(context->now(), [subCommand, context]
+        {
+            subCommand(context, [] {});
         });
-        t.detach();
+        continuation();
     };
 }
 
 TestCommands::Command TestCommands::readWriteCommand(std::istream &is)
 {
     std::string message = readArg<std::string>(is, "`write` needs message to write!");
-    return [message](Parameters parameters)
+    return [message](const ContextPtr& context, Continuation continuation)
     {
-        parameters.printText(message);
+        context->parameters.printText(message);
+        continuation();
     };
 }
 
 TestCommands::Command TestCommands::readWaitCommand(std::istream &is)
 {
     std::uint32_t waitTime = readArg<std::uint32_t>(is, "'wait' needs wait time (ms)");
-    return [waitTime](Parameters)
+    return [waitTime](const ContextPtr& context, Continuation continuation)
     {
-        std::this_thread::sleep_for(std::chrono::milliseconds(waitTime));
+        context->schedule(context->now() + std::chrono::milliseconds(waitTime), std::move(continuation));
     };
 }
 
@@ -156,9 +271,80 @@ TestCommands::Command TestCommands::readSendCommand(std::istream &is)
     }
     auto message = messageBuilder.getMessage();
 
-    return [to, message](Parameters parameters)
+    return [to, message](const ContextPtr& context, Continuation continuation)
+    {
+        context->parameters.sendMessage(message, to);
+        continuation();
+    };
+}
+
+TestCommands::Command TestCommands::readLoadCommand(std::istream &is)
+{
+    LoadGenerator::Settings settings{};
+    std::string profile = readArg<std::string>(is, "'load' needs profile: constant, poisson or burst:N");
+    const std::string burstPrefix = "burst:";
+    if (profile == "constant")
+    {
+        settings.profile = LoadGenerator::Profile::Constant;
+    }
+    else if (profile == "poisson")
+    {
+        settings.profile = LoadGenerator::Profile::Poisson;
+    }
+    else if (profile.substr(0, burstPrefix.length()) == burstPrefix)
+    {
+        settings.profile = LoadGenerator::Profile::Burst;
+        std::istringstream burstSize(profile.substr(burstPrefix.length()));
+        settings.burstSize = readArg<std::size_t>(burstSize, "'load burst:N' needs burst size");
+    }
+    else
+    {
+        throwError("'load' unknown profile: " + profile);
+    }
+    settings.messagesPerSecond = readArg<double>(is, "'load' needs rate (messages per second)");
+    settings.duration = std::chrono::milliseconds(readArg<std::uint32_t>(is, "'load' needs duration (ms)"));
+    settings.messageId = readArg<MessageId>(is, "'load' needs MessageId", MessageId::Sms);
+    readRange(is, "'load' needs From(PhoneNumber) or From range (N-M)", settings.from.first, settings.from.last);
+    readRange(is, "'load' needs To(PhoneNumber) or To range (N-M)", settings.to.first, settings.to.last);
+    readRange(is, "'load' needs payload size or size range (N-M)", settings.payloadSize.first, settings.payloadSize.last);
+
+    std::shared_ptr<LoadGenerator> generator;
+    try
+    {
+        generator = std::make_shared<LoadGenerator>(settings);
+    }
+    catch (std::invalid_argument& ex)
     {
-        parameters.sendMessage(message, to);
+        throwError(ex.what());
+    }
+    return [generator](const ContextPtr& context, Continuation continuation)
+    {
+        // one scheduler task per batch of due messages, nothing sleeps in between
+        struct Run : std::enable_shared_from_this<Run>
+        {
+            Run(std::shared_ptr<LoadGenerator> generator, ContextPtr context, Continuation continuation)
+                : generator(std::move(generator)),
+                  session(this->generator->start(context->now())),
+                  context(std::move(context)),
+                  continuation(std::move(continuation))
+            {}
+            std::shared_ptr<LoadGenerator> generator;
+            LoadGenerator::Session session;
+            ContextPtr context;
+            Continuation continuation;
+
+            void sendDue()
+            {
+                if (auto next = session.sendDue(context->parameters.sendMessage, context->now()))
+                {
+                    context->schedule(*next, [self = shared_from_this()] { self->sendDue(); });
+                    return;
+                }
+                context->parameters.printText(LoadGenerator::toString(generator->getSettings(), session.report()));
+                continuation();
+            }
+        };
+        std::make_shared<Run>(generator, context, std::move(continuation))->sendDue();
     };
 }
 
@@ -173,6 +359,24 @@ T TestCommands::readArg(std::istream& is, std::string onFailure, T defaultValue)
     return value;
 }
 
+template <typename T>
+void TestCommands::readRange(std::istream &is, std::string onFailure, T &first, T &last)
+{
+    // "N" or "N-M"
+    std::istringstream range(readArg<std::string>(is, onFailure));
+    first = readArg<T>(range, onFailure);
+    last = first;
+    if (range.peek() == '-')
+    {
+        range.ignore();
+        last = readArg<T>(range, onFailure);
+    }
+    if (not range.eof() and range.peek() != std::char_traits<char>::eof())
+    {
+        throwError(onFailure);
+    }
+}
+
 std::string TestCommands::readMessageBody(std::istream &is)
 {
     std::string body = readArg<std::string>(is, "Message body missing (for 0-bytes use 0x)");
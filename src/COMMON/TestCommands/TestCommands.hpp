@@ -2,33 +2,59 @@
 
 #include "Messages/PhoneNumber.hpp"
 #include "Messages/BinaryMessage.hpp"
+#include "TaskScheduler.hpp"
 #include <vector>
 #include <map>
+#include <memory>
 #include <functional>
 #include <string>
 
 namespace common
 {
 
+/**
+ * Test script compiled into a plan of steps.
+ * Steps run on TaskScheduler: 'wait' reschedules the rest of the plan instead of sleeping,
+ * 'thread' starts its sub command as separate plan on the same scheduler.
+ */
 class TestCommands
 {
 public:
     TestCommands(std::string args);
 
     using PrintText = std::function<void(std::string)>;
-    using SendMessage = std::function<void(const BinaryMessage&,
+    // false when message could not be delivered (e.g. unknown recipient)
+    using SendMessage = std::function<bool(const BinaryMessage&,
                                            PhoneNumber /*to*/)>;
     struct Parameters
     {
         PrintText printText;
         SendMessage sendMessage;
     };
-    void run(Parameters parameters);
+    // false when some command failed - the rest of plan is then skipped
+    using Finished = std::function<void(bool)>;
+
+    /**
+     * Returns immediately, plan continues on scheduler - parameters shall stay valid till it finishes.
+     * Failure is reported through printText.
+     */
+    void start(Parameters parameters, TaskScheduler& scheduler, Finished finished = {}) const;
+    /**
+     * Blocks till the plan finishes, 'thread' sub commands still running then are dropped
+     * @return false when some command failed
+     */
+    bool run(Parameters parameters) const;
 
 private:
-    using Command = std::function<void(Parameters)>;
+    class Context;
+    using ContextPtr = std::shared_ptr<Context>;
+    using Continuation = std::function<void()>;
+    using Command = std::function<void(const ContextPtr&, Continuation)>;
     using Commands = std::vector<Command>;
-    Commands commands;
+    using CommandsPtr = std::shared_ptr<const Commands>;
+    CommandsPtr commands;
+
+    static void runSequence(const ContextPtr& context, CommandsPtr sequence, std::size_t rounds, Continuation continuation);
 
     Command readCommand(std::istream& is);
     Command readRepeatCommand(std::istream& is);
@@ -37,10 +63,13 @@ private:
     Command readGroupCommand(std::istream& is);
     Command readThreadCommand(std::istream& is);
     Command readWriteCommand(std::istream& is);
+    Command readLoadCommand(std::istream& is);
 
     template <typename T>
     T readArg(std::istream& is, std::string onFailure, T defaultValue = T{});
     std::string readMessageBody(std::istream& is);
+    template <typename T>
+    void readRange(std::istream& is, std::string onFailure, T& first, T& last);
 
     void throwError(std::string msg);
 
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+#include "Trace/CaptureFile.hpp"
+#include "CommonEnvironment/CapturingTransport.hpp"
+#include "Messages/OutgoingMessage.hpp"
+#include "Mocks/ITransportMock.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+
+class CaptureFileTestSuite : public Test
+{
+protected:
+    ~CaptureFileTestSuite() override
+    {
+        std::remove(PATH.c_str());
+    }
+
+    BinaryMessage message(const std::string& text)
+    {
+        OutgoingMessage builder{MessageId::Sms, PhoneNumber{1}, PhoneNumber{2}};
+        builder.writeText(text);
+        return builder.getMessage();
+    }
+
+    std::vector<CaptureRecord> readAll()
+    {
+        CaptureReader reader(PATH);
+        std::vector<CaptureRecord> records;
+        CaptureRecord record;
+        while (reader.read(record))
+        {
+            records.push_back(record);
+        }
+        return records;
+    }
+
+    // records are written by writer's own thread - file might be caught in the middle of a write
+    std::size_t waitForRecords(std::size_t count)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        std::size_t written = 0u;
+        while (written < count and std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            try
+            {
+                written = readAll().size();
+            }
+            catch (std::runtime_error&)
+            {}
+        }
+        return written;
+    }
+
+    const std::string PATH = "capture_ut_" + std::to_string(::getpid()) + ".bin";
+};
+
+TEST_F(CaptureFileTestSuite, shallReadBackWrittenRecords)
+{
+    {
+        CaptureWriter objectUnderTest(PATH);
+        objectUnderTest.write(CaptureRecord{0x0102030405060708u, 7u, CaptureRecord::Direction::Received, message("hi")});
+        objectUnderTest.write(3u, CaptureRecord::Direction::Sent, message(""));
+        ASSERT_EQ(2u, objectUnderTest.writtenCount());
+    }
+
+    auto records = readAll();
+    ASSERT_EQ(2u, records.size());
+    EXPECT_EQ(0x0102030405060708u, records[0].timestampNs);
+    EXPECT_EQ(7u, records[0].connectionId);
+    EXPECT_EQ(CaptureRecord::Direction::Received, records[0].direction);
+    EXPECT_EQ(message("hi").value, records[0].message.value);
+    EXPECT_EQ(3u, records[1].connectionId);
+    EXPECT_EQ(CaptureRecord::Direction::Sent, records[1].direction);
+    EXPECT_EQ(message("").value, records[1].message.value);
+}
+
+TEST_F(CaptureFileTestSuite, shallFlushWhenBufferIsFull)
+{
+    CaptureWriter objectUnderTest(PATH, 0u);
+    for (int i = 0; i < 100; ++i)
+    {
+        objectUnderTest.write(1u, CaptureRecord::Direction::Received, message(std::string(100u, 'x')));
+    }
+    // buffer is never smaller than one biggest record
+    ASSERT_GT(waitForRecords(1u), 0u);
+    objectUnderTest.flush();
+    ASSERT_THAT(readAll(), SizeIs(100u));
+}
+
+TEST_F(CaptureFileTestSuite, shallWriteRecordsEveryFlushPeriod)
+{
+    CaptureWriter objectUnderTest(PATH, CaptureWriter::DEFAULT_BUFFER_SIZE, std::chrono::milliseconds(1));
+    objectUnderTest.write(1u, CaptureRecord::Direction::Received, message("tail"));
+
+    ASSERT_EQ(1u, waitForRecords(1u));
+}
+
+TEST_F(CaptureFileTestSuite, shallRejectNotCaptureFile)
+{
+    std::ofstream(PATH) << "not a capture";
+    ASSERT_THROW(CaptureReader{PATH}, std::runtime_error);
+}
+
+TEST_F(CaptureFileTestSuite, shallRejectTruncatedRecord)
+{
+    {
+        CaptureWriter objectUnderTest(PATH);
+        objectUnderTest.write(1u, CaptureRecord::Direction::Received, message("hello"));
+    }
+    ::truncate(PATH.c_str(), 8 + 15 + 3);
+    CaptureReader reader(PATH);
+    CaptureRecord record;
+    ASSERT_THROW(reader.read(record), std::runtime_error);
+}
+
+TEST_F(CaptureFileTestSuite, shallCaptureFramesPassingTransport)
+{
+    auto transportMock = std::make_shared<StrictMock<ITransportMock>>();
+    ITransport::MessageCallback receivedCallback;
+    {
+        auto writer = std::make_shared<CaptureWriter>(PATH);
+        CapturingTransport objectUnderTest(transportMock, writer);
+
+        EXPECT_CALL(*transportMock, registerMessageCallback(_)).WillOnce(SaveArg<0>(&receivedCallback));
+        BinaryMessage forwarded;
+        objectUnderTest.registerMessageCallback([&forwarded](BinaryMessage message) { forwarded = message; });
+        receivedCallback(message("rx"));
+        ASSERT_EQ(message("rx").value, forwarded.value);
+
+        EXPECT_CALL(*transportMock, sendMessage(_)).WillOnce(Return(true));
+        ASSERT_TRUE(objectUnderTest.sendMessage(message("tx")));
+        // callback shares the writer - release it to get file closed
+        receivedCallback = nullptr;
+    }
+
+    auto records = readAll();
+    ASSERT_EQ(2u, records.size());
+    EXPECT_EQ(CaptureRecord::Direction::Received, records[0].direction);
+    EXPECT_EQ(message("rx").value, records[0].message.value);
+    EXPECT_EQ(CaptureRecord::Direction::Sent, records[1].direction);
+    EXPECT_EQ(records[0].connectionId, records[1].connectionId);
+}
+
+}
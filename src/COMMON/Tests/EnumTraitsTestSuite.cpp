@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include "Traits/EnumTraits.hpp"
+#include "Messages/MessageId.hpp"
 
 using namespace ::testing;
 namespace common
@@ -40,9 +41,23 @@ TYPED_TEST_P(EnumTraitsTestSuite, forOneShallUseProperOneEnumValue)
 {
     ASSERT_EQ("B", (EnumRange<TypeParam>::template forOne<EnumTraitsTestSuite<TypeParam>::template GetName>(TypeParam::B)));
 }
+TYPED_TEST_P(EnumTraitsTestSuite, forOneShallReturnDefaultForValueOutOfRange)
+{
+    const TypeParam outOfRange = enumValue<TypeParam>(enumUnderlyingValue(TypeParam::C) + 1);
+    ASSERT_EQ(nullptr, (EnumRange<TypeParam>::template forOne<EnumTraitsTestSuite<TypeParam>::template GetName>(outOfRange)));
+}
+TYPED_TEST_P(EnumTraitsTestSuite, containsShallAcceptOnlyValuesInRange)
+{
+    static_assert(EnumRange<TypeParam>::contains(TypeParam::A), "A shall be in range");
+    static_assert(EnumRange<TypeParam>::contains(TypeParam::C), "C shall be in range");
+    ASSERT_FALSE(EnumRange<TypeParam>::contains(enumValue<TypeParam>(enumUnderlyingValue(TypeParam::C) + 1)));
+    ASSERT_FALSE(EnumRange<TypeParam>::contains(enumValue<TypeParam>(enumUnderlyingValue(TypeParam::A) - 1)));
+}
 REGISTER_TYPED_TEST_SUITE_P(EnumTraitsTestSuite,
                            forEachShallUseAllEnumValues,
-                           forOneShallUseProperOneEnumValue);
+                           forOneShallUseProperOneEnumValue,
+                           forOneShallReturnDefaultForValueOutOfRange,
+                           containsShallAcceptOnlyValuesInRange);
 
 
 
@@ -145,4 +160,12 @@ constexpr const char* EnumTraitsTestSuite<EnumTraitsNotFollower>::template GetNa
 }
 
 INSTANTIATE_TYPED_TEST_SUITE_P(NotFollowEnumTraits, EnumTraitsTestSuite, EnumTraitsNotFollower);
+
+TEST(EnumTraitsMessageIdTestSuite, shallCoverAllMessageIds)
+{
+    static_assert(EnumRange<MessageId>::size() == 12u, "Wrong size!");
+    static_assert(EnumRange<MessageId>::contains(MessageId::EchoReply), "Last message id shall be in range");
+    ASSERT_FALSE(EnumRange<MessageId>::contains(enumValue<MessageId>(get(MessageId::EchoReply) + 1)));
+}
+
 }
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+
+#include "Trace/FlightRecorder.hpp"
+#include "Messages/OutgoingMessage.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+
+class FlightRecorderTestSuite : public Test
+{
+protected:
+    const PhoneNumber PHONE_NUMBER_FROM{12};
+    const PhoneNumber PHONE_NUMBER_TO{34};
+
+    std::string dump(const FlightRecorder& recorder)
+    {
+        std::ostringstream os;
+        recorder.dump(os);
+        return os.str();
+    }
+};
+
+TEST_F(FlightRecorderTestSuite, shallRoundCapacityUpToPowerOf2)
+{
+    FlightRecorder objectUnderTest{5};
+    ASSERT_EQ(8u, objectUnderTest.capacity());
+}
+
+TEST_F(FlightRecorderTestSuite, shallDumpNothingWhenEmpty)
+{
+    FlightRecorder objectUnderTest{4};
+    ASSERT_EQ("", dump(objectUnderTest));
+}
+
+TEST_F(FlightRecorderTestSuite, shallRecordFrameHeader)
+{
+    FlightRecorder objectUnderTest{4};
+    OutgoingMessage message{MessageId::Sms, PHONE_NUMBER_FROM, PHONE_NUMBER_TO};
+    message.writeText("Hi");
+
+    objectUnderTest.recordFrameReceived(message.getMessage());
+
+    ASSERT_EQ(1u, objectUnderTest.recordedCount());
+    ASSERT_THAT(dump(objectUnderTest), HasSubstr("rx Sms from: 012 to: 034 size: "));
+}
+
+TEST_F(FlightRecorderTestSuite, shallRecordAllEventTypesInOrder)
+{
+    FlightRecorder objectUnderTest{8};
+    objectUnderTest.recordAttach(PHONE_NUMBER_FROM);
+    objectUnderTest.recordStateChange("ConnectedState");
+    objectUnderTest.recordTimerStart(std::chrono::milliseconds{500});
+    objectUnderTest.recordTimerStop();
+    objectUnderTest.recordDetach(PHONE_NUMBER_FROM);
+
+    ASSERT_THAT(dump(objectUnderTest),
+                MatchesRegex("[0-9]+\\.[0-9]{9} attach phone: 012\n"
+                             "[0-9]+\\.[0-9]{9} state ConnectedState\n"
+                             "[0-9]+\\.[0-9]{9} timer-start 500ms\n"
+                             "[0-9]+\\.[0-9]{9} timer-stop\n"
+                             "[0-9]+\\.[0-9]{9} detach phone: 012\n"));
+}
+
+TEST_F(FlightRecorderTestSuite, shallKeepOnlyLastEventsWhenWrapped)
+{
+    FlightRecorder objectUnderTest{2};
+    objectUnderTest.recordAttach(PhoneNumber{1});
+    objectUnderTest.recordAttach(PhoneNumber{2});
+    objectUnderTest.recordAttach(PhoneNumber{3});
+
+    std::string result = dump(objectUnderTest);
+    ASSERT_EQ(3u, objectUnderTest.recordedCount());
+    ASSERT_THAT(result, Not(HasSubstr("phone: 001")));
+    ASSERT_THAT(result, HasSubstr("phone: 002"));
+    ASSERT_THAT(result, HasSubstr("phone: 003"));
+}
+
+}
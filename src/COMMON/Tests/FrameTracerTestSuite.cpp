@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+
+#include "Trace/FrameTracer.hpp"
+#include "Messages/OutgoingMessage.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+using Stage = FrameTracer::Stage;
+
+class FrameTracerTestSuite : public Test
+{
+protected:
+    BinaryMessage sms() const
+    {
+        OutgoingMessage message{MessageId::Sms, PhoneNumber{12}, PhoneNumber{34}};
+        message.writeText("Hi");
+        return message.getMessage();
+    }
+
+    FrameTracer objectUnderTest{1u};
+};
+
+TEST_F(FrameTracerTestSuite, shallIgnoreMarksOutsideScope)
+{
+    FrameTracer::mark(Stage::Locked);
+    ASSERT_EQ(0u, objectUnderTest.stageLatency(Stage::Locked).count());
+}
+
+TEST_F(FrameTracerTestSuite, shallRecordEachStageOncePerFrame)
+{
+    {
+        FrameTracer::Scope scope(FrameTracer::Clock::now(), sms(), objectUnderTest);
+        FrameTracer::mark(Stage::Locked);
+        FrameTracer::mark(Stage::Routed);
+        FrameTracer::mark(Stage::Routed);
+    }
+    FrameTracer::mark(Stage::Handled);
+
+    ASSERT_EQ(1u, objectUnderTest.stageLatency(Stage::Received).count());
+    ASSERT_EQ(1u, objectUnderTest.stageLatency(Stage::Locked).count());
+    ASSERT_EQ(0u, objectUnderTest.stageLatency(Stage::Decoded).count());
+    ASSERT_EQ(1u, objectUnderTest.stageLatency(Stage::Routed).count());
+    ASSERT_EQ(0u, objectUnderTest.stageLatency(Stage::Handled).count());
+    ASSERT_EQ(1u, objectUnderTest.totalLatency().count());
+}
+
+TEST_F(FrameTracerTestSuite, shallKeepSampledTraces)
+{
+    {
+        FrameTracer::Scope scope(FrameTracer::Clock::now(), sms(), objectUnderTest);
+        FrameTracer::mark(Stage::Enqueued);
+    }
+    std::ostringstream os;
+    objectUnderTest.printSamples(os);
+
+    ASSERT_THAT(os.str(), MatchesRegex("Sms from: 12 to: 34 received: \\+[0-9.]+ enqueued: \\+[0-9.]+\n"));
+}
+
+TEST_F(FrameTracerTestSuite, shallNotTraceWhenDisabled)
+{
+    objectUnderTest.setEnabled(false);
+    {
+        FrameTracer::Scope scope(FrameTracer::Clock::now(), sms(), objectUnderTest);
+        FrameTracer::mark(Stage::Locked);
+    }
+    ASSERT_EQ(0u, objectUnderTest.totalLatency().count());
+}
+
+}
@@ -52,4 +52,39 @@ TEST_F(ILoggerTestSuite, shallPrintValuesToErrorStream)
     objectUnderTest.logError(message2, number2);
 }
 
+TEST_F(ILoggerTestSuite, shallNotFormatMessagesRejectedByLimit)
+{
+    LogLimit limit = LogLimit::sampled(3u);
+
+    EXPECT_CALL(objectUnderTest, log(ILogger::ERROR_LEVEL, message1));
+    objectUnderTest.logError(limit, message1);
+    objectUnderTest.logError(limit, message1);
+    objectUnderTest.logError(limit, message1);
+    Mock::VerifyAndClearExpectations(&objectUnderTest);
+
+    EXPECT_CALL(objectUnderTest, log(ILogger::ERROR_LEVEL, AllOf(HasSubstr(message1),
+                                                                 HasSubstr("suppressed 2 similar messages"))));
+    objectUnderTest.logError(limit, message1);
+}
+
+TEST_F(ILoggerTestSuite, shallReportSuppressedMessagesOnFlush)
+{
+    LogLimit limit = LogLimit::sampled(3u);
+
+    EXPECT_CALL(objectUnderTest, log(ILogger::ERROR_LEVEL, message1));
+    objectUnderTest.logError(limit, message1);
+    objectUnderTest.logError(limit, message1);
+    objectUnderTest.logError(limit, message1);
+    Mock::VerifyAndClearExpectations(&objectUnderTest);
+
+    EXPECT_CALL(objectUnderTest, log(ILogger::ERROR_LEVEL, "suppressed 2 similar messages: " + message1));
+    LogLimit::flushSuppressed([this](int level, std::string_view line)
+    {
+        if (line.find(message1) != std::string_view::npos)
+        {
+            objectUnderTest.log(level, std::string(line));
+        }
+    });
+}
+
 } // namespace common
@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+
+#include "CommonEnvironment/ImpairedTransport.hpp"
+#include "Time/VirtualClock.hpp"
+#include "Mocks/ITransportMock.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+class ImpairedTransportTestSuite : public Test
+{
+protected:
+    ImpairedTransportTestSuite()
+    {
+        EXPECT_CALL(*transportMock, registerMessageCallback(_)).WillRepeatedly(SaveArg<0>(&receivedCallback));
+        ON_CALL(*transportMock, sendMessage(_)).WillByDefault(Invoke([this](BinaryMessage message)
+        {
+            sent.push_back(message.value.at(0));
+            return true;
+        }));
+    }
+
+    std::unique_ptr<ImpairedTransport> create(LinkImpairment impairment)
+    {
+        auto transport = std::make_unique<ImpairedTransport>(transportMock, clock, impairment);
+        transport->registerMessageCallback([this](BinaryMessage message)
+        {
+            received.push_back(message.value.at(0));
+        });
+        return transport;
+    }
+
+    static BinaryMessage frame(std::uint8_t number, std::size_t size = 1u)
+    {
+        BinaryMessage message{BinaryMessage::Value(size)};
+        message.value[0] = number;
+        return message;
+    }
+
+    std::shared_ptr<NiceMock<ITransportMock>> transportMock = std::make_shared<NiceMock<ITransportMock>>();
+    VirtualClock clock;
+    ITransport::MessageCallback receivedCallback;
+    std::vector<std::uint8_t> sent;
+    std::vector<std::uint8_t> received;
+};
+
+TEST_F(ImpairedTransportTestSuite, shallReadImpairmentFromConfiguration)
+{
+    std::istringstream text("net_latency_us=1500\nnet_jitter_us=200\nnet_bandwidth_bytes_s=1000\n"
+                            "net_reorder_percent=5\nnet_disconnect_mtbf_ms=60000\nnet_outage_ms=300\nnet_seed=7\n");
+    MultiLineConfig configuration(text);
+
+    auto impairment = LinkImpairment::fromConfiguration(configuration);
+
+    EXPECT_EQ(1500us, impairment.latency);
+    EXPECT_EQ(200us, impairment.jitter);
+    EXPECT_EQ(1000u, impairment.bytesPerSecond);
+    EXPECT_EQ(5u, impairment.reorderPercent);
+    EXPECT_EQ(60000ms, impairment.meanTimeBetweenDisconnects);
+    EXPECT_EQ(300ms, impairment.outageDuration);
+    EXPECT_EQ(7u, impairment.seed);
+    EXPECT_TRUE(impairment.isActive());
+}
+
+TEST_F(ImpairedTransportTestSuite, shallBeInactiveByDefaultAndRejectWrongPercent)
+{
+    std::istringstream text("net_reorder_percent=101\n");
+    MultiLineConfig configuration(text);
+
+    EXPECT_FALSE(LinkImpairment{}.isActive());
+    EXPECT_THROW(LinkImpairment::fromConfiguration(configuration), std::invalid_argument);
+}
+
+TEST_F(ImpairedTransportTestSuite, shallDelayFramesInBothDirections)
+{
+    LinkImpairment impairment;
+    impairment.latency = 10ms;
+    auto objectUnderTest = create(impairment);
+
+    ASSERT_TRUE(objectUnderTest->sendMessage(frame(1)));
+    receivedCallback(frame(2));
+    clock.advance(9ms);
+    EXPECT_THAT(sent, IsEmpty());
+    EXPECT_THAT(received, IsEmpty());
+
+    clock.advance(1ms);
+    EXPECT_THAT(sent, ElementsAre(1));
+    EXPECT_THAT(received, ElementsAre(2));
+}
+
+TEST_F(ImpairedTransportTestSuite, shallKeepOrderDespiteJitter)
+{
+    LinkImpairment impairment;
+    impairment.jitter = 10ms;
+    auto objectUnderTest = create(impairment);
+
+    for (std::uint8_t number = 0u; number < 50u; ++number)
+    {
+        objectUnderTest->sendMessage(frame(number));
+        clock.advance(100us);
+    }
+    clock.advance(10ms);
+
+    ASSERT_EQ(50u, sent.size());
+    EXPECT_TRUE(std::is_sorted(sent.begin(), sent.end()));
+}
+
+TEST_F(ImpairedTransportTestSuite, shallQueueFramesBehindBandwidthCap)
+{
+    LinkImpairment impairment;
+    impairment.bytesPerSecond = 1000u;
+    auto objectUnderTest = create(impairment);
+
+    objectUnderTest->sendMessage(frame(1, 10u));
+    objectUnderTest->sendMessage(frame(2, 10u));
+    clock.advance(10ms);
+    EXPECT_THAT(sent, ElementsAre(1));
+    clock.advance(10ms);
+    EXPECT_THAT(sent, ElementsAre(1, 2));
+}
+
+TEST_F(ImpairedTransportTestSuite, shallLetFramesOvertakeHeldBackOnes)
+{
+    LinkImpairment impairment;
+    impairment.latency = 1ms;
+    impairment.reorderPercent = 30u;
+    impairment.seed = 1u;
+    auto objectUnderTest = create(impairment);
+
+    for (std::uint8_t number = 0u; number < 50u; ++number)
+    {
+        objectUnderTest->sendMessage(frame(number));
+        clock.advance(100us);
+    }
+    clock.advance(10ms);
+
+    ASSERT_EQ(50u, sent.size());
+    EXPECT_FALSE(std::is_sorted(sent.begin(), sent.end()));
+}
+
+TEST_F(ImpairedTransportTestSuite, shallCloseConnectionOnOutageAndDropFramesUntilItEnds)
+{
+    LinkImpairment impairment;
+    impairment.latency = 1ms;
+    impairment.meanTimeBetweenDisconnects = 1s;
+    impairment.outageDuration = 100ms;
+    ITransport::DisconnectedCallback underlyingDisconnectedCallback;
+    EXPECT_CALL(*transportMock, registerDisconnectedCallback(_))
+        .WillOnce(SaveArg<0>(&underlyingDisconnectedCallback));
+    auto objectUnderTest = create(impairment);
+    unsigned disconnections = 0u;
+    objectUnderTest->registerDisconnectedCallback([&disconnections] { ++disconnections; });
+
+    bool closed = false;
+    EXPECT_CALL(*transportMock, close()).WillOnce(Assign(&closed, true));
+    while (not closed)
+    {
+        objectUnderTest->sendMessage(frame(1));
+        clock.advance(500us);
+    }
+    const std::size_t sentBeforeOutage = sent.size();
+    // underlying transport reports the real disconnection
+    ASSERT_TRUE(underlyingDisconnectedCallback);
+    underlyingDisconnectedCallback();
+    EXPECT_EQ(1u, disconnections);
+
+    EXPECT_FALSE(objectUnderTest->sendMessage(frame(2)));
+    receivedCallback(frame(3));
+    clock.advance(99ms);
+    EXPECT_EQ(sentBeforeOutage, sent.size());
+    EXPECT_THAT(received, IsEmpty());
+
+    clock.advance(1ms);
+    EXPECT_TRUE(objectUnderTest->sendMessage(frame(4)));
+    clock.advance(1ms);
+    EXPECT_EQ(4u, sent.back());
+}
+
+TEST_F(ImpairedTransportTestSuite, shallDropPendingFramesOfDestroyedTransport)
+{
+    LinkImpairment impairment;
+    impairment.latency = 10ms;
+    auto objectUnderTest = create(impairment);
+
+    objectUnderTest->sendMessage(frame(1));
+    receivedCallback(frame(2));
+    objectUnderTest.reset();
+    clock.advance(10ms);
+
+    EXPECT_THAT(sent, IsEmpty());
+    EXPECT_THAT(received, IsEmpty());
+}
+
+TEST_F(ImpairedTransportTestSuite, shallNotCallCallbackUnregisteredWhileFrameInFlight)
+{
+    LinkImpairment impairment;
+    impairment.latency = 10ms;
+    std::vector<std::function<void()>> loop;
+    ImpairedTransport objectUnderTest(transportMock, clock, impairment, [&loop](std::function<void()> handOn)
+    {
+        loop.push_back(std::move(handOn));
+    });
+    bool oldCallbackCalled = false;
+    objectUnderTest.registerMessageCallback([&oldCallbackCalled](BinaryMessage) { oldCallbackCalled = true; });
+
+    receivedCallback(frame(1));
+    clock.advance(10ms);
+    ASSERT_THAT(loop, SizeIs(1u));
+    EXPECT_FALSE(oldCallbackCalled);
+
+    // as UeConnection::stop on the loop, before the posted frame runs
+    objectUnderTest.registerMessageCallback(nullptr);
+    for (auto& handOn : loop)
+    {
+        handOn();
+    }
+
+    EXPECT_FALSE(oldCallbackCalled);
+}
+
+TEST_F(ImpairedTransportTestSuite, shallHandFramesOnThroughPost)
+{
+    LinkImpairment impairment;
+    impairment.latency = 10ms;
+    std::vector<std::function<void()>> loop;
+    ImpairedTransport objectUnderTest(transportMock, clock, impairment, [&loop](std::function<void()> handOn)
+    {
+        loop.push_back(std::move(handOn));
+    });
+    objectUnderTest.registerMessageCallback([this](BinaryMessage message) { received.push_back(message.value.at(0)); });
+
+    receivedCallback(frame(3));
+    clock.advance(10ms);
+    EXPECT_THAT(received, IsEmpty());
+
+    loop.at(0)();
+    EXPECT_THAT(received, ElementsAre(3));
+}
+
+}
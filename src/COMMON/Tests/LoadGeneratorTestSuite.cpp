@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "TestCommands/LoadGenerator.hpp"
+#include "TestCommands/TestCommands.hpp"
+#include "Messages/IncomingMessage.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+
+class LoadGeneratorTestSuite : public Test
+{
+protected:
+    LoadGenerator::Settings settings()
+    {
+        LoadGenerator::Settings result{};
+        result.messagesPerSecond = 200.0;
+        result.duration = std::chrono::milliseconds{98};
+        result.from = {PhoneNumber{10}, PhoneNumber{19}};
+        result.to = {PhoneNumber{20}, PhoneNumber{29}};
+        result.payloadSize = {5u, 50u};
+        return result;
+    }
+
+    std::vector<BinaryMessage> sent;
+    LoadGenerator::SendMessage sendMessage = [this](const BinaryMessage& message, PhoneNumber)
+    {
+        sent.push_back(message);
+        return true;
+    };
+};
+
+TEST_F(LoadGeneratorTestSuite, shallRejectEmptyRange)
+{
+    auto wrongSettings = settings();
+    wrongSettings.to = {PhoneNumber{29}, PhoneNumber{20}};
+    ASSERT_THROW(LoadGenerator{wrongSettings}, std::invalid_argument);
+}
+
+TEST_F(LoadGeneratorTestSuite, shallRejectZeroRate)
+{
+    auto wrongSettings = settings();
+    wrongSettings.messagesPerSecond = 0.0;
+    ASSERT_THROW(LoadGenerator{wrongSettings}, std::invalid_argument);
+}
+
+TEST_F(LoadGeneratorTestSuite, shallRejectRateAndBurstAboveMaximum)
+{
+    auto wrongSettings = settings();
+    wrongSettings.messagesPerSecond = LoadGenerator::MAX_MESSAGES_PER_SECOND * 2.0;
+    ASSERT_THROW(LoadGenerator{wrongSettings}, std::invalid_argument);
+
+    wrongSettings = settings();
+    wrongSettings.profile = LoadGenerator::Profile::Burst;
+    wrongSettings.burstSize = LoadGenerator::MAX_BURST_SIZE + 1u;
+    ASSERT_THROW(LoadGenerator{wrongSettings}, std::invalid_argument);
+
+    wrongSettings.burstSize = LoadGenerator::MAX_BURST_SIZE;
+    wrongSettings.messagesPerSecond = LoadGenerator::MAX_MESSAGES_PER_SECOND;
+    ASSERT_NO_THROW(LoadGenerator{wrongSettings});
+}
+
+TEST_F(LoadGeneratorTestSuite, shallReturnAfterBoundedNumberOfSends)
+{
+    auto fastSettings = settings();
+    fastSettings.messagesPerSecond = LoadGenerator::MAX_MESSAGES_PER_SECOND;
+    LoadGenerator objectUnderTest{fastSettings};
+    const auto start = LoadGenerator::Clock::time_point{};
+    auto session = objectUnderTest.start(start);
+
+    // whole run is overdue
+    auto next = session.sendDue(sendMessage, start + fastSettings.duration);
+
+    ASSERT_TRUE(next.has_value());
+    ASSERT_EQ(LoadGenerator::MAX_SENDS_PER_CALL, sent.size());
+}
+
+TEST_F(LoadGeneratorTestSuite, shallSendWithConstantRateWithinRanges)
+{
+    LoadGenerator objectUnderTest{settings()};
+
+    auto report = objectUnderTest.run(sendMessage);
+
+    // 98ms at 200/s: 20 messages planned at 0, 5, ... 95ms
+    ASSERT_EQ(20u, report.sent);
+    ASSERT_EQ(0u, report.failed);
+    ASSERT_EQ(20u, sent.size());
+    for (auto&& message : sent)
+    {
+        IncomingMessage reader(message);
+        ASSERT_EQ(MessageId::Sms, reader.readMessageId());
+        auto from = reader.readPhoneNumber();
+        auto to = reader.readPhoneNumber();
+        ASSERT_THAT(from.value, AllOf(Ge(10), Le(19)));
+        ASSERT_THAT(to.value, AllOf(Ge(20), Le(29)));
+        ASSERT_THAT(reader.readRemainingText().size(), AllOf(Ge(5u), Le(50u)));
+    }
+}
+
+TEST_F(LoadGeneratorTestSuite, shallSendBurstsOfGivenSize)
+{
+    auto burstSettings = settings();
+    burstSettings.profile = LoadGenerator::Profile::Burst;
+    burstSettings.burstSize = 8u;
+    LoadGenerator objectUnderTest{burstSettings};
+
+    auto report = objectUnderTest.run(sendMessage);
+
+    // bursts every 40ms: at 0, 40 and 80ms
+    ASSERT_EQ(24u, report.sent);
+}
+
+TEST_F(LoadGeneratorTestSuite, shallAchieveTargetRateOverWholeRun)
+{
+    // virtual time - every message is sent exactly when planned
+    auto runAt = [this](const LoadGenerator::Settings& settings)
+    {
+        LoadGenerator objectUnderTest{settings};
+        const auto start = LoadGenerator::Clock::time_point{};
+        auto session = objectUnderTest.start(start);
+        auto now = start;
+        while (auto next = session.sendDue(sendMessage, now))
+        {
+            now = *next;
+        }
+        return session.report();
+    };
+    auto constantSettings = settings();
+    constantSettings.duration = std::chrono::milliseconds{1000};
+    auto burstSettings = constantSettings;
+    burstSettings.profile = LoadGenerator::Profile::Burst;
+    burstSettings.burstSize = 8u;
+
+    const auto constant = runAt(constantSettings);
+    const auto burst = runAt(burstSettings);
+
+    EXPECT_EQ(std::chrono::microseconds{1000000}, constant.elapsed);
+    EXPECT_NEAR(200.0, constant.achievedRate(), 1.0);
+    EXPECT_EQ(std::chrono::microseconds{1000000}, burst.elapsed);
+    EXPECT_NEAR(200.0, burst.achievedRate(), 1.0);
+}
+
+TEST_F(LoadGeneratorTestSuite, shallCountFailures)
+{
+    LoadGenerator objectUnderTest{settings()};
+
+    auto report = objectUnderTest.run([](const BinaryMessage&, PhoneNumber) { return false; });
+
+    ASSERT_EQ(0u, report.sent);
+    ASSERT_EQ(20u, report.failed);
+}
+
+TEST_F(LoadGeneratorTestSuite, shallReportThroughTestCommand)
+{
+    TestCommands objectUnderTest{"load poisson 500 50 CallTalk 1-2 3 0-10"};
+    std::string printed;
+    std::size_t sentCount = 0u;
+    objectUnderTest.run({[&printed](std::string text) { printed += text; },
+                         [&sentCount](const BinaryMessage&, PhoneNumber to)
+                         {
+                             EXPECT_EQ(PhoneNumber{3}, to);
+                             ++sentCount;
+                             return true;
+                         }});
+
+    ASSERT_THAT(printed, StartsWith("load poisson: sent: " + std::to_string(sentCount) + ", failed: 0"));
+    ASSERT_THAT(printed, HasSubstr("(target: 500.0/s)"));
+}
+
+TEST_F(LoadGeneratorTestSuite, shallNotParseWrongLoadCommand)
+{
+    ASSERT_THROW(TestCommands{"load sinus 10 10 Sms 1 2 3"}, std::runtime_error);
+    ASSERT_THROW(TestCommands{"load burst:0 10 10 Sms 1 2 3"}, std::runtime_error);
+    ASSERT_THROW(TestCommands{"load constant 1e12 1000 Sms 1 2 3"}, std::runtime_error);
+    ASSERT_THROW(TestCommands{"load burst:1000000000 10 10 Sms 1 2 3"}, std::runtime_error);
+    ASSERT_THROW(TestCommands{"load constant 10 10 Sms 1-x 2 3"}, std::runtime_error);
+    ASSERT_THROW(TestCommands{"load constant 10 10 Sms 5-1 2 3"}, std::runtime_error);
+}
+
+}
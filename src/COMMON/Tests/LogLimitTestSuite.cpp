@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Logger/LogLimit.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+class LogLimitTestSuite : public Test
+{
+protected:
+    const LogLimit::Clock::time_point START{1h};
+
+    std::uint64_t suppressed = 0u;
+    std::vector<std::string> summaries;
+
+    void flush(LogLimit::Clock::time_point now)
+    {
+        // limits of other tests might be pending too
+        LogLimit::flushSuppressed([this](int level, std::string_view line)
+        {
+            if (line.find("flood") != std::string_view::npos)
+            {
+                summaries.push_back(std::to_string(level) + ":" + std::string(line));
+            }
+        }, now);
+    }
+};
+
+TEST_F(LogLimitTestSuite, shallRejectZeroParameters)
+{
+    ASSERT_THROW(LogLimit::sampled(0u), std::invalid_argument);
+    ASSERT_THROW(LogLimit::rateLimited(0u, 1u), std::invalid_argument);
+    ASSERT_THROW(LogLimit::rateLimited(1u, 0u), std::invalid_argument);
+}
+
+TEST_F(LogLimitTestSuite, shallAcceptEveryNthWhenSampled)
+{
+    LogLimit objectUnderTest = LogLimit::sampled(3u);
+
+    ASSERT_TRUE(objectUnderTest.tryAcquire(suppressed, START));
+    ASSERT_EQ(0u, suppressed);
+    ASSERT_FALSE(objectUnderTest.tryAcquire(suppressed, START));
+    ASSERT_FALSE(objectUnderTest.tryAcquire(suppressed, START));
+    ASSERT_TRUE(objectUnderTest.tryAcquire(suppressed, START));
+    ASSERT_EQ(2u, suppressed);
+}
+
+TEST_F(LogLimitTestSuite, shallAcceptBurstThenRejectUntilRefilled)
+{
+    LogLimit objectUnderTest = LogLimit::rateLimited(2u, 10u);
+
+    ASSERT_TRUE(objectUnderTest.tryAcquire(suppressed, START));
+    ASSERT_TRUE(objectUnderTest.tryAcquire(suppressed, START));
+    ASSERT_FALSE(objectUnderTest.tryAcquire(suppressed, START));
+    ASSERT_FALSE(objectUnderTest.tryAcquire(suppressed, START + 50ms));
+
+    ASSERT_TRUE(objectUnderTest.tryAcquire(suppressed, START + 100ms));
+    ASSERT_EQ(2u, suppressed);
+    ASSERT_FALSE(objectUnderTest.tryAcquire(suppressed, START + 100ms));
+}
+
+TEST_F(LogLimitTestSuite, shallRefillWholeBurstAfterQuietPeriod)
+{
+    LogLimit objectUnderTest = LogLimit::rateLimited(3u, 10u);
+    for (int i = 0; i < 10; ++i)
+    {
+        objectUnderTest.tryAcquire(suppressed, START);
+    }
+
+    const auto later = START + 1s;
+    ASSERT_TRUE(objectUnderTest.tryAcquire(suppressed, later));
+    ASSERT_EQ(7u, suppressed);
+    ASSERT_TRUE(objectUnderTest.tryAcquire(suppressed, later));
+    ASSERT_TRUE(objectUnderTest.tryAcquire(suppressed, later));
+    ASSERT_FALSE(objectUnderTest.tryAcquire(suppressed, later));
+}
+
+TEST_F(LogLimitTestSuite, shallReportSuppressedWhenWindowClosesWithoutNextMessage)
+{
+    LogLimit objectUnderTest = LogLimit::rateLimited(1u, 10u);
+    ASSERT_TRUE(objectUnderTest.tryAcquire(suppressed, START));
+    ASSERT_FALSE(objectUnderTest.tryAcquire(suppressed, START));
+    ASSERT_EQ(1u, suppressed);
+    objectUnderTest.remember(2, "flood of errors");
+    ASSERT_FALSE(objectUnderTest.tryAcquire(suppressed, START + 10ms));
+    ASSERT_EQ(0u, suppressed);
+
+    flush(START + 50ms);
+    ASSERT_THAT(summaries, IsEmpty());
+
+    flush(START + 100ms);
+    ASSERT_THAT(summaries, ElementsAre("2:suppressed 2 similar messages: flood of errors"));
+
+    flush(START + 1s);
+    ASSERT_THAT(summaries, SizeIs(1u));
+}
+
+TEST_F(LogLimitTestSuite, shallNotReportSuppressedTwiceWhenNextMessageReportedThem)
+{
+    LogLimit objectUnderTest = LogLimit::sampled(2u);
+    ASSERT_TRUE(objectUnderTest.tryAcquire(suppressed, START));
+    ASSERT_FALSE(objectUnderTest.tryAcquire(suppressed, START));
+    objectUnderTest.remember(1, "flood of infos");
+    ASSERT_TRUE(objectUnderTest.tryAcquire(suppressed, START));
+    ASSERT_EQ(1u, suppressed);
+
+    flush(START);
+    ASSERT_THAT(summaries, IsEmpty());
+
+    ASSERT_FALSE(objectUnderTest.tryAcquire(suppressed, START));
+    flush(START);
+    ASSERT_THAT(summaries, ElementsAre("1:suppressed 1 similar messages: flood of infos"));
+}
+
+TEST_F(LogLimitTestSuite, shallForgetDestroyedLimit)
+{
+    {
+        LogLimit objectUnderTest = LogLimit::sampled(2u);
+        objectUnderTest.tryAcquire(suppressed, START);
+        objectUnderTest.tryAcquire(suppressed, START);
+        objectUnderTest.remember(0, "flood of debugs");
+    }
+    flush(LogLimit::Clock::time_point::max());
+    ASSERT_THAT(summaries, IsEmpty());
+}
+
+}
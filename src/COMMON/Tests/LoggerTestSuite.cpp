@@ -92,4 +92,29 @@ TEST_P(LoggerTestSuite, shallPrintMultipleLinesForMultipleLogsToStreams)
     ASSERT_EQ(2, std::count(str.begin(), str.end(), '\n'));
 }
 
+TEST_P(LoggerTestSuite, shallDropMessagesBelowLevelThreshold)
+{
+    objectUnderTest.setLevelThreshold(GetParam() + 1);
+    printLog(message1);
+    ASSERT_EQ("", getLog1());
+
+    objectUnderTest.setLevelThreshold(GetParam());
+    printLog(message1);
+    ASSERT_THAT(getLog1(), HasSubstr(message1));
+}
+
+TEST_P(LoggerTestSuite, shallNotUseLimitBelowLevelThreshold)
+{
+    LogLimit limit = LogLimit::sampled(2u);
+    ILogger& logger = objectUnderTest;
+    objectUnderTest.setLevelThreshold(GetParam() + 1);
+    logger.log(GetParam(), limit, message1);
+    logger.log(GetParam(), limit, message1);
+
+    objectUnderTest.setLevelThreshold(GetParam());
+    logger.log(GetParam(), limit, message1);
+    ASSERT_THAT(getLog1(), HasSubstr(message1));
+    ASSERT_THAT(getLog1(), Not(HasSubstr("suppressed")));
+}
+
 } // namespace common
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+#include <vector>
+
+#include "Trace/LoopLagMonitor.hpp"
+#include "Time/VirtualClock.hpp"
+#include "Mocks/ILoggerMock.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+class LoopLagMonitorTestSuite : public Test
+{
+protected:
+    LoopLagMonitorTestSuite()
+    {
+        EXPECT_CALL(loggerMock, log(_, _)).Times(AnyNumber());
+        objectUnderTest.reconfigure(100ms, 50ms);
+        objectUnderTest.start(clock, [this](std::function<void()> probe) { loop.push_back(std::move(probe)); },
+                              loggerMock);
+    }
+    ~LoopLagMonitorTestSuite()
+    {
+        objectUnderTest.stop();
+    }
+
+    void runLoop()
+    {
+        auto queued = std::move(loop);
+        loop.clear();
+        for (auto& callback : queued)
+        {
+            callback();
+        }
+    }
+
+    NiceMock<ILoggerMock> loggerMock;
+    VirtualClock clock;
+    std::vector<std::function<void()>> loop;
+    LoopLagMonitor objectUnderTest;
+};
+
+TEST_F(LoopLagMonitorTestSuite, shallPostProbeEveryPeriod)
+{
+    clock.advance(100ms);
+    ASSERT_EQ(1u, loop.size());
+    runLoop();
+
+    clock.advance(100ms);
+    ASSERT_EQ(1u, loop.size());
+}
+
+TEST_F(LoopLagMonitorTestSuite, shallMeasureProbeLag)
+{
+    clock.advance(100ms);
+    clock.advance(20ms);
+    runLoop();
+
+    ASSERT_EQ(1u, objectUnderTest.lag().count());
+    ASSERT_EQ(20'000'000u, objectUnderTest.lag().sum());
+}
+
+TEST_F(LoopLagMonitorTestSuite, shallKeepOneProbeInFlight)
+{
+    EXPECT_CALL(loggerMock, log(ILogger::ERROR_LEVEL, HasSubstr("stalled for: 100")));
+    clock.advance(300ms);
+    ASSERT_EQ(1u, loop.size());
+    ASSERT_EQ(1u, objectUnderTest.stallCount());
+
+    EXPECT_CALL(loggerMock, log(ILogger::ERROR_LEVEL, HasSubstr("lag: 200")));
+    runLoop();
+    ASSERT_EQ(1u, objectUnderTest.lag().count());
+}
+
+TEST_F(LoopLagMonitorTestSuite, shallNotWarnBelowThreshold)
+{
+    EXPECT_CALL(loggerMock, log(ILogger::ERROR_LEVEL, _)).Times(0);
+    clock.advance(100ms);
+    clock.advance(50ms);
+    runLoop();
+}
+
+TEST_F(LoopLagMonitorTestSuite, shallIgnoreProbeRunAfterStop)
+{
+    clock.advance(100ms);
+    objectUnderTest.stop();
+    runLoop();
+
+    ASSERT_EQ(0u, objectUnderTest.lag().count());
+    ASSERT_EQ(0u, clock.pendingCount());
+}
+
+TEST_F(LoopLagMonitorTestSuite, shallMeasureWakeups)
+{
+    {
+        LoopLagMonitor::Wakeup wakeup(objectUnderTest);
+        wakeup.frame();
+        wakeup.frame();
+    }
+    ASSERT_EQ(1u, objectUnderTest.callbackTime().count());
+    ASSERT_EQ(2u, objectUnderTest.framesPerWakeup().sum());
+
+    std::ostringstream os;
+    objectUnderTest.print(os);
+    ASSERT_THAT(os.str(), AllOf(HasSubstr("lag"), HasSubstr("callback"), HasSubstr("frames/wakeup"),
+                                HasSubstr("stalls: 0")));
+}
+
+}
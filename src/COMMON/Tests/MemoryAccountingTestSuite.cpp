@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "Memory/MemoryAccounting.hpp"
+#include "Memory/SlabPool.hpp"
+#include "Messages/BinaryMessage.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+
+// tests are linked with AllocationCounter - accounting is active
+class MemoryAccountingTestSuite : public Test
+{
+protected:
+    static constexpr std::size_t SIZE = 1000u;
+
+    static const MemoryAccounting::Usage& of(const MemoryAccounting::Snapshot& snapshot, MemoryTag tag)
+    {
+        return snapshot[std::size_t(tag)];
+    }
+
+    const MemoryAccounting::Snapshot before = MemoryAccounting::snapshot();
+};
+
+TEST_F(MemoryAccountingTestSuite, shallBeActive)
+{
+    ASSERT_TRUE(MemoryAccounting::isActive());
+}
+
+TEST_F(MemoryAccountingTestSuite, shallAttributeAllocationToTagOfScope)
+{
+    std::unique_ptr<char[]> buffer;
+    {
+        MemoryTagScope memoryTag(MemoryTag::UeRelay);
+        ASSERT_EQ(MemoryTag::UeRelay, currentMemoryTag());
+        buffer = std::make_unique<char[]>(SIZE);
+    }
+    ASSERT_EQ(MemoryTag::Untagged, currentMemoryTag());
+    const auto allocated = MemoryAccounting::snapshot();
+    ASSERT_EQ(1u, of(allocated, MemoryTag::UeRelay).allocations - of(before, MemoryTag::UeRelay).allocations);
+    ASSERT_GE(of(allocated, MemoryTag::UeRelay).liveBytes - of(before, MemoryTag::UeRelay).liveBytes, SIZE);
+
+    // released out of the scope - still attributed to owner
+    buffer.reset();
+    const auto released = MemoryAccounting::snapshot();
+    ASSERT_EQ(of(before, MemoryTag::UeRelay).liveBytes, of(released, MemoryTag::UeRelay).liveBytes);
+    ASSERT_EQ(1u, of(released, MemoryTag::UeRelay).deallocations - of(before, MemoryTag::UeRelay).deallocations);
+}
+
+TEST_F(MemoryAccountingTestSuite, shallLetInnermostScopeWin)
+{
+    MemoryTagScope outer(MemoryTag::Logger);
+    {
+        MemoryTagScope inner(MemoryTag::Transport);
+        ASSERT_EQ(MemoryTag::Transport, currentMemoryTag());
+    }
+    ASSERT_EQ(MemoryTag::Logger, currentMemoryTag());
+}
+
+TEST_F(MemoryAccountingTestSuite, shallAttributeBinaryMessageToMessageTagInAnyScope)
+{
+    MemoryTagScope memoryTag(MemoryTag::Transport);
+    BinaryMessage message{BinaryMessage::Value(SIZE)};
+
+    const auto allocated = MemoryAccounting::snapshot();
+    ASSERT_GE(of(allocated, MemoryTag::Message).liveBytes - of(before, MemoryTag::Message).liveBytes, SIZE);
+    ASSERT_EQ(of(before, MemoryTag::Transport).allocations, of(allocated, MemoryTag::Transport).allocations);
+}
+
+TEST_F(MemoryAccountingTestSuite, shallCountTaggedAllocatorOnceWithReplacedOperatorNew)
+{
+    BinaryMessage message{BinaryMessage::Value(SIZE)};
+
+    const auto allocated = MemoryAccounting::snapshot();
+    ASSERT_EQ(1u, of(allocated, MemoryTag::Message).allocations - of(before, MemoryTag::Message).allocations);
+    ASSERT_EQ(SIZE, of(allocated, MemoryTag::Message).liveBytes - of(before, MemoryTag::Message).liveBytes);
+}
+
+TEST_F(MemoryAccountingTestSuite, shallCountSlabOnceInTagOfScope)
+{
+    SlabPool pool(SIZE, alignof(std::max_align_t));
+    MemoryTagScope memoryTag(MemoryTag::UeRelay);
+    void* block = pool.allocate();
+
+    const auto allocated = MemoryAccounting::snapshot();
+    const auto slabBytes = pool.blocksReserved() * pool.blockSize();
+    const auto liveBytes = of(allocated, MemoryTag::UeRelay).liveBytes - of(before, MemoryTag::UeRelay).liveBytes;
+    // slab list of the pool is counted by operator new too
+    ASSERT_GE(liveBytes, slabBytes);
+    ASSERT_LT(liveBytes, 2u * slabBytes);
+    pool.deallocate(block);
+}
+
+TEST_F(MemoryAccountingTestSuite, shallPrintRatesOnlyWithPreviousSnapshot)
+{
+    std::ostringstream withoutRates;
+    MemoryAccounting::print(withoutRates, MemoryAccounting::snapshot(), before, 0.0);
+    ASSERT_THAT(withoutRates.str(), AllOf(HasSubstr("transport"), HasSubstr("sms_db"), Not(HasSubstr("alloc/s"))));
+
+    std::ostringstream withRates;
+    MemoryAccounting::print(withRates, MemoryAccounting::snapshot(), before, 1.0);
+    ASSERT_THAT(withRates.str(), HasSubstr("alloc/s"));
+}
+
+TEST_F(MemoryAccountingTestSuite, shallExportUsageAsMetrics)
+{
+    MetricsRegistry registry;
+    MemoryAccounting::registerMetrics(registry, "test");
+
+    std::ostringstream os;
+    registry.writePrometheus(os);
+
+    ASSERT_THAT(os.str(), AllOf(HasSubstr("# TYPE test_memory_live_bytes gauge\n"),
+                                HasSubstr("# TYPE test_memory_allocated_bytes_total counter\n"),
+                                HasSubstr("# TYPE test_memory_allocations_total counter\n"),
+                                HasSubstr("test_memory_live_bytes{tag=\"message\"} ")));
+}
+
+}
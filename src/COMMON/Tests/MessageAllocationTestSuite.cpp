@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "AllocationCounter/AllocationCounter.hpp"
+#include "Messages/IncomingMessage.hpp"
+#include "Messages/OutgoingMessage.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+
+// allocation budget of encode/decode of fixed-size messages
+class MessageAllocationTestSuite : public Test
+{
+protected:
+    // builder buffer + exact-size copy returned by getMessage
+    static constexpr std::uint64_t ENCODE_BUDGET = 2u;
+
+    const PhoneNumber PHONE_NUMBER_FROM{12};
+    const PhoneNumber PHONE_NUMBER_TO{34};
+    const BtsId BTS_ID{0x12345678u};
+};
+
+TEST_F(MessageAllocationTestSuite, shallEncodeAttachRequestWithinBudget)
+{
+    ScopedAllocationCounter counter;
+    OutgoingMessage objectUnderTest{MessageId::AttachRequest, PHONE_NUMBER_FROM, PhoneNumber{}};
+    objectUnderTest.writeBtsId(BTS_ID);
+    BinaryMessage message = objectUnderTest.getMessage();
+
+    ASSERT_LE(counter.count().allocations, ENCODE_BUDGET) << counter.count();
+}
+
+TEST_F(MessageAllocationTestSuite, shallEncodeUnknownRecipientWithinBudget)
+{
+    ScopedAllocationCounter counter;
+    OutgoingMessage objectUnderTest{MessageId::UnknownRecipient, PhoneNumber{}, PHONE_NUMBER_FROM};
+    objectUnderTest.writeMessageHeader(MessageHeader{MessageId::Sms, PHONE_NUMBER_FROM, PHONE_NUMBER_TO});
+    BinaryMessage message = objectUnderTest.getMessage();
+
+    ASSERT_LE(counter.count().allocations, ENCODE_BUDGET) << counter.count();
+}
+
+TEST_F(MessageAllocationTestSuite, shallEncodeTextWithOneGrowthAtMost)
+{
+    const std::string text(1000u, 'x');
+
+    ScopedAllocationCounter counter;
+    OutgoingMessage objectUnderTest{MessageId::Sms, PHONE_NUMBER_FROM, PHONE_NUMBER_TO};
+    objectUnderTest.writeText(text);
+    BinaryMessage message = objectUnderTest.getMessage();
+
+    ASSERT_LE(counter.count().allocations, ENCODE_BUDGET + 1u) << counter.count();
+}
+
+TEST_F(MessageAllocationTestSuite, shallDecodeFixedSizeMessageWithoutAllocation)
+{
+    OutgoingMessage builder{MessageId::AttachResponse, PhoneNumber{}, PHONE_NUMBER_TO};
+    builder.writeNumber(true);
+    builder.writeBtsId(BTS_ID);
+    const BinaryMessage message = builder.getMessage();
+
+    ScopedAllocationCounter counter;
+    IncomingMessage objectUnderTest{message};
+    MessageHeader header = objectUnderTest.readMessageHeader();
+    bool accepted = objectUnderTest.readNumber<bool>();
+    BtsId btsId = objectUnderTest.readBtsId();
+
+    ASSERT_EQ(0u, counter.count().allocations) << counter.count();
+    ASSERT_EQ(MessageId::AttachResponse, header.messageId);
+    ASSERT_TRUE(accepted);
+    ASSERT_EQ(BTS_ID, btsId);
+}
+
+}
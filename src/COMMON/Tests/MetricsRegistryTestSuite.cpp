@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Metrics/MetricsRegistry.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+
+class MetricsRegistryTestSuite : public Test
+{
+protected:
+    std::string exported() const
+    {
+        std::ostringstream os;
+        objectUnderTest.writePrometheus(os);
+        return os.str();
+    }
+
+    MetricsRegistry objectUnderTest;
+};
+
+TEST_F(MetricsRegistryTestSuite, shallSumCounterOverThreads)
+{
+    constexpr std::size_t THREADS = 8u;
+    constexpr std::size_t ADDS = 10000u;
+    Counter& counter = objectUnderTest.counter("test_total", "Test");
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0u; i < THREADS; ++i)
+    {
+        threads.emplace_back([&counter] { for (std::size_t j = 0u; j < ADDS; ++j) counter.add(); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(THREADS * ADDS, counter.value());
+}
+
+TEST_F(MetricsRegistryTestSuite, shallReturnSameMetricForSameNameAndLabels)
+{
+    Counter& first = objectUnderTest.counter("test_total", "Test", {{"kind", "a"}});
+    Counter& same = objectUnderTest.counter("test_total", "Test", {{"kind", "a"}});
+    Counter& other = objectUnderTest.counter("test_total", "Test", {{"kind", "b"}});
+
+    ASSERT_EQ(&first, &same);
+    ASSERT_NE(&first, &other);
+}
+
+TEST_F(MetricsRegistryTestSuite, shallRejectNameRegisteredAsOtherType)
+{
+    objectUnderTest.counter("test", "Test");
+    ASSERT_THROW(objectUnderTest.gauge("test", "Test"), std::invalid_argument);
+}
+
+TEST_F(MetricsRegistryTestSuite, shallExportCountersAndGaugesWithLabels)
+{
+    objectUnderTest.counter("test_total", "Test counter", {{"kind", "a"}}).add(2);
+    objectUnderTest.counter("test_total", "Test counter", {{"kind", "b"}}).add(5);
+    objectUnderTest.gauge("test_level", "Test gauge").set(-3);
+    objectUnderTest.gauge("test_sampled", "Sampled gauge", [] { return 42; });
+
+    ASSERT_EQ("# HELP test_total Test counter\n"
+              "# TYPE test_total counter\n"
+              "test_total{kind=\"a\"} 2\n"
+              "test_total{kind=\"b\"} 5\n"
+              "# HELP test_level Test gauge\n"
+              "# TYPE test_level gauge\n"
+              "test_level -3\n"
+              "# HELP test_sampled Sampled gauge\n"
+              "# TYPE test_sampled gauge\n"
+              "test_sampled 42\n",
+              exported());
+}
+
+TEST_F(MetricsRegistryTestSuite, shallExportHistogramAsCumulativeBuckets)
+{
+    Histogram& histogram = objectUnderTest.histogram("test_latency", "Test histogram", 0.5, {}, {1u, 40u});
+    histogram.record(3);
+    histogram.record(12);
+    histogram.record(12);
+    histogram.record(100);
+
+    ASSERT_EQ("# HELP test_latency Test histogram\n"
+              "# TYPE test_latency histogram\n"
+              "test_latency_bucket{le=\"3.5\"} 1\n"
+              "test_latency_bucket{le=\"7.5\"} 3\n"
+              "test_latency_bucket{le=\"15.5\"} 3\n"
+              "test_latency_bucket{le=\"+Inf\"} 4\n"
+              "test_latency_sum 63.5\n"
+              "test_latency_count 4\n",
+              exported());
+}
+
+TEST_F(MetricsRegistryTestSuite, shallExportSameHistogramBucketsWhenEmpty)
+{
+    objectUnderTest.histogram("test_latency", "Test histogram", 1.0, {}, {100u, 1000u});
+
+    ASSERT_EQ("# HELP test_latency Test histogram\n"
+              "# TYPE test_latency histogram\n"
+              "test_latency_bucket{le=\"127\"} 0\n"
+              "test_latency_bucket{le=\"255\"} 0\n"
+              "test_latency_bucket{le=\"511\"} 0\n"
+              "test_latency_bucket{le=\"+Inf\"} 0\n"
+              "test_latency_sum 0\n"
+              "test_latency_count 0\n",
+              exported());
+}
+
+TEST(HistogramTestSuite, shallKeepSmallValuesExact)
+{
+    for (std::uint64_t value = 0u; value < 2u * Histogram::SUB_BUCKET_COUNT; ++value)
+    {
+        ASSERT_EQ(value, Histogram::bucketUpperBound(Histogram::bucketIndex(value)));
+    }
+}
+
+TEST(HistogramTestSuite, shallBoundRelativeErrorOfLargeValues)
+{
+    for (std::uint64_t value : {100u, 1000u, 123456u, 987654321u})
+    {
+        const std::uint64_t upperBound = Histogram::bucketUpperBound(Histogram::bucketIndex(value));
+        ASSERT_GE(upperBound, value);
+        ASSERT_LE(double(upperBound - value), double(value) / Histogram::SUB_BUCKET_COUNT);
+    }
+    ASSERT_EQ(Histogram::BUCKET_COUNT - 1u, Histogram::bucketIndex(UINT64_MAX));
+}
+
+TEST(HistogramTestSuite, shallFindPercentiles)
+{
+    Histogram histogram;
+    for (std::uint64_t value = 1u; value <= 100u; ++value)
+    {
+        histogram.record(value);
+    }
+
+    ASSERT_EQ(100u, histogram.count());
+    ASSERT_EQ(5050u, histogram.sum());
+    ASSERT_EQ(Histogram::bucketUpperBound(Histogram::bucketIndex(50u)), histogram.percentile(0.5));
+    ASSERT_EQ(Histogram::bucketUpperBound(Histogram::bucketIndex(100u)), histogram.percentile(1.0));
+}
+
+}
@@ -14,6 +14,7 @@ struct ITransportMock : public ITransport
     MOCK_METHOD(void, registerMessageCallback, (MessageCallback), (final));
     MOCK_METHOD(void, registerDisconnectedCallback, (DisconnectedCallback), (final));
     MOCK_METHOD(bool, sendMessage, (BinaryMessage), (final));
+    MOCK_METHOD(void, close, (), (final));
     MOCK_METHOD(std::string, addressToString, (), (const, final));
 };
 
@@ -263,6 +263,46 @@ TEST_F(MultiLineConfigTestSuite, shallNotThrowExceptionWhileParsingEOF)
     ASSERT_EQ("value1", value1);
 }
 
+TEST_F(MultiLineConfigTestSuite, shallFailToReadNumberWithTrailingCharacters)
+{
+    makeObjectUnderTest("key = 123abc");
+    ASSERT_THROW(objectUnderTest->getNumber<int>("key"), std::invalid_argument);
+    ASSERT_EQ(7, objectUnderTest->getNumber("key", 7));
+}
+
+TEST_F(MultiLineConfigTestSuite, shallReadOctalValue)
+{
+    makeObjectUnderTest("key = 017");
+    ASSERT_EQ(017, objectUnderTest->getNumber<int>("key"));
+}
+
+TEST_F(MultiLineConfigTestSuite, shallFailToReadTooBigValue)
+{
+    makeObjectUnderTest("key1 = 300\nkey2 = 99999999999999999999999");
+    ASSERT_THROW(objectUnderTest->getNumber<std::uint8_t>("key1"), std::out_of_range);
+    ASSERT_THROW(objectUnderTest->getNumber<long long>("key2"), std::out_of_range);
+    ASSERT_EQ(300, objectUnderTest->getNumber<int>("key1"));
+}
 
+TEST_F(MultiLineConfigTestSuite, shallReadExtremeValues)
+{
+    makeObjectUnderTest("min = -9223372036854775808\nmax = 18446744073709551615");
+    ASSERT_EQ(std::numeric_limits<long long>::min(), objectUnderTest->getNumber<long long>("min"));
+    ASSERT_EQ(std::numeric_limits<unsigned long long>::max(), objectUnderTest->getNumber<unsigned long long>("max"));
+    ASSERT_THROW(objectUnderTest->getNumber<long long>("max"), std::out_of_range);
+}
+
+TEST_F(MultiLineConfigTestSuite, shallKeepEqualSignsInValueAndIgnoreLinesWithoutKey)
+{
+    makeObjectUnderTest("key = a = b\n = value\nno equal sign\nkey2 # = commented");
+    ASSERT_EQ("a = b", objectUnderTest->getString("key"));
+    ASSERT_THROW(objectUnderTest->getString("key2"), std::invalid_argument);
+}
+
+TEST_F(MultiLineConfigTestSuite, shallReadEmptyValue)
+{
+    makeObjectUnderTest("key =   # nothing");
+    ASSERT_EQ("", objectUnderTest->getString("key"));
+}
 
 } // namespace common
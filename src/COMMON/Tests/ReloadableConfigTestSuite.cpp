@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+#include "Config/ReloadableConfig.hpp"
+#include "Config/ConfigFileWatcher.hpp"
+#include "Mocks/ILoggerMock.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+
+class ReloadableConfigTestSuite : public Test
+{
+protected:
+    static ReloadableConfig::Snapshot makeConfig(const std::string& text)
+    {
+        std::istringstream is(text);
+        return std::make_shared<const MultiLineConfig>(is);
+    }
+
+    ReloadableConfig objectUnderTest{makeConfig("key = 1")};
+    StrictMock<MockFunction<void(const MultiLineConfig&)>> subscriberMock;
+};
+
+TEST_F(ReloadableConfigTestSuite, shallKeepOldSnapshotValidAfterPublish)
+{
+    auto oldSnapshot = objectUnderTest.get();
+    objectUnderTest.publish(makeConfig("key = 2"));
+
+    ASSERT_EQ(1, oldSnapshot->getNumber<int>("key"));
+    ASSERT_EQ(2, objectUnderTest.get()->getNumber<int>("key"));
+}
+
+TEST_F(ReloadableConfigTestSuite, shallNotifySubscriberAtOnceAndOnPublish)
+{
+    EXPECT_CALL(subscriberMock, Call(Truly([](auto& config) { return config.getString("key") == "1"; })));
+    objectUnderTest.subscribe(subscriberMock.AsStdFunction());
+    Mock::VerifyAndClearExpectations(&subscriberMock);
+
+    EXPECT_CALL(subscriberMock, Call(Truly([](auto& config) { return config.getString("key") == "2"; })));
+    objectUnderTest.publish(makeConfig("key = 2"));
+}
+
+TEST_F(ReloadableConfigTestSuite, shallPublishReloadedFileAfterChange)
+{
+    const std::string path = "/tmp/sth_config_ut_" + std::to_string(::getpid());
+    NiceMock<ILoggerMock> loggerMock;
+    std::mutex guard;
+    std::condition_variable reloaded;
+    int loadCount = 0;
+
+    ConfigFileWatcher watcher(path, objectUnderTest, [&]
+    {
+        std::lock_guard<std::mutex> lock(guard);
+        ++loadCount;
+        reloaded.notify_all();
+        std::ifstream file(path);
+        return std::make_shared<const MultiLineConfig>(file);
+    }, loggerMock);
+
+    std::ofstream(path) << "key = 3\n";
+
+    std::unique_lock<std::mutex> lock(guard);
+    ASSERT_TRUE(reloaded.wait_for(lock, std::chrono::seconds(5), [&] { return loadCount > 0; }));
+    lock.unlock();
+    // loader result is published right after loader returns
+    for (int i = 0; i < 100 and objectUnderTest.get()->getString("key") != "3"; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ("3", objectUnderTest.get()->getString("key"));
+    std::remove(path.c_str());
+}
+
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <unistd.h>
+
+#include "Logger/SharedMemoryLogRing.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+
+class SharedMemoryLogRingTestSuite : public Test
+{
+protected:
+    const std::string RING_NAME = "/sth_log_ring_ut_" + std::to_string(::getpid());
+    const PhoneNumber PHONE_NUMBER{112};
+
+    std::unique_ptr<SharedMemoryLogRing> collector = SharedMemoryLogRing::create(RING_NAME, 4u);
+    std::vector<SharedMemoryLogRing::Record> records;
+
+    void TearDown() override
+    {
+        collector.reset();
+        SharedMemoryLogRing::remove(RING_NAME);
+    }
+};
+
+TEST_F(SharedMemoryLogRingTestSuite, shallNotOpenNotCreatedRing)
+{
+    ASSERT_THROW(SharedMemoryLogRing::open(RING_NAME + "_missing"), std::runtime_error);
+}
+
+TEST_F(SharedMemoryLogRingTestSuite, shallDrainRecordsPushedByProducer)
+{
+    auto producer = SharedMemoryLogRing::open(RING_NAME);
+    producer->push(PHONE_NUMBER, "first");
+    producer->push(PHONE_NUMBER, "second");
+
+    ASSERT_EQ(0u, collector->drain(records));
+    ASSERT_EQ(2u, records.size());
+    EXPECT_EQ("first", records[0].text);
+    EXPECT_EQ("second", records[1].text);
+    EXPECT_EQ(PHONE_NUMBER, records[1].phoneNumber);
+    EXPECT_EQ(std::uint32_t(::getpid()), records[1].pid);
+    EXPECT_LE(records[0].timestampNs, records[1].timestampNs);
+
+    records.clear();
+    ASSERT_EQ(0u, collector->drain(records));
+    ASSERT_TRUE(records.empty());
+}
+
+TEST_F(SharedMemoryLogRingTestSuite, shallCountOverwrittenRecordsAsLost)
+{
+    auto producer = SharedMemoryLogRing::open(RING_NAME);
+    for (int i = 0; i < 6; ++i)
+    {
+        producer->push(PHONE_NUMBER, std::to_string(i));
+    }
+
+    ASSERT_EQ(2u, collector->drain(records));
+    ASSERT_EQ(4u, records.size());
+    EXPECT_EQ("2", records.front().text);
+    EXPECT_EQ("5", records.back().text);
+}
+
+TEST_F(SharedMemoryLogRingTestSuite, shallRefuseSecondCollector)
+{
+    ASSERT_THROW(SharedMemoryLogRing::create(RING_NAME, 4u), std::runtime_error);
+
+    auto producer = SharedMemoryLogRing::open(RING_NAME);
+    producer->push(PHONE_NUMBER, "still collected");
+    collector->drain(records);
+    ASSERT_EQ(1u, records.size());
+}
+
+TEST_F(SharedMemoryLogRingTestSuite, shallAttachNextCollectorToRingOfRunningProducers)
+{
+    auto producer = SharedMemoryLogRing::open(RING_NAME);
+    producer->push(PHONE_NUMBER, "drained");
+    collector->drain(records);
+    collector.reset();
+    producer->push(PHONE_NUMBER, "abandoned");
+
+    collector = SharedMemoryLogRing::create(RING_NAME, 64u);
+    EXPECT_EQ(4u, collector->slotCount());
+    producer->push(PHONE_NUMBER, "after restart");
+
+    records.clear();
+    ASSERT_EQ(0u, collector->drain(records));
+    ASSERT_EQ(1u, records.size());
+    EXPECT_EQ("after restart", records[0].text);
+}
+
+TEST_F(SharedMemoryLogRingTestSuite, shallTruncateTooLongText)
+{
+    auto producer = SharedMemoryLogRing::open(RING_NAME);
+    producer->push(PHONE_NUMBER, std::string(SharedMemoryLogRing::TEXT_SIZE + 10u, 'x'));
+
+    collector->drain(records);
+    ASSERT_EQ(1u, records.size());
+    EXPECT_EQ(SharedMemoryLogRing::TEXT_SIZE, records[0].text.size());
+}
+
+TEST_F(SharedMemoryLogRingTestSuite, shallPushOneRecordPerFlushedLine)
+{
+    {
+        SharedMemoryLogStream objectUnderTest(RING_NAME, PHONE_NUMBER);
+        objectUnderTest << "line " << 1 << std::endl;
+        objectUnderTest << "line " << 2 << std::endl;
+    }
+
+    collector->drain(records);
+    ASSERT_EQ(2u, records.size());
+    EXPECT_EQ("line 1", records[0].text);
+    EXPECT_EQ("line 2", records[1].text);
+}
+
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <list>
+#include <memory>
+#include <set>
+
+#include "Memory/SlabPool.hpp"
+#include "AllocationCounter/AllocationCounter.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+
+class SlabPoolTestSuite : public Test
+{
+protected:
+    static constexpr std::size_t BLOCK_SIZE = 24u;
+
+    SlabPool objectUnderTest{BLOCK_SIZE, alignof(std::uint64_t)};
+};
+
+TEST_F(SlabPoolTestSuite, shallReserveWholeSlabOnFirstAllocation)
+{
+    void* block = objectUnderTest.allocate();
+    ASSERT_EQ(1u, objectUnderTest.blocksInUse());
+    ASSERT_EQ(SlabPool::SLAB_SIZE / BLOCK_SIZE, objectUnderTest.blocksReserved());
+    objectUnderTest.deallocate(block);
+    ASSERT_EQ(0u, objectUnderTest.blocksInUse());
+}
+
+TEST_F(SlabPoolTestSuite, shallReuseReleasedBlock)
+{
+    void* block = objectUnderTest.allocate();
+    objectUnderTest.deallocate(block);
+    ASSERT_EQ(block, objectUnderTest.allocate());
+}
+
+TEST_F(SlabPoolTestSuite, shallGiveDistinctAlignedBlocksOverManySlabs)
+{
+    const std::size_t count = 3u * (SlabPool::SLAB_SIZE / BLOCK_SIZE);
+    std::set<void*> blocks;
+    for (std::size_t i = 0u; i < count; ++i)
+    {
+        void* block = objectUnderTest.allocate();
+        ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(block) % alignof(std::uint64_t));
+        blocks.insert(block);
+    }
+    ASSERT_EQ(count, blocks.size());
+    ASSERT_EQ(count, objectUnderTest.blocksReserved());
+    for (void* block : blocks)
+    {
+        objectUnderTest.deallocate(block);
+    }
+}
+
+TEST_F(SlabPoolTestSuite, shallRoundBlockToAlignmentAndLink)
+{
+    ASSERT_EQ(8u, SlabPool(1u, 1u).blockSize());
+    ASSERT_EQ(32u, SlabPool(20u, 16u).blockSize());
+}
+
+TEST_F(SlabPoolTestSuite, shallCountFreeBytesOfPool)
+{
+    const auto before = SlabPool::freeBytes();
+    void* block = objectUnderTest.allocate();
+    ASSERT_EQ(before + (objectUnderTest.blocksReserved() - 1u) * BLOCK_SIZE, SlabPool::freeBytes());
+    objectUnderTest.deallocate(block);
+}
+
+namespace
+{
+struct Pooled : SlabAllocated<Pooled>
+{
+    std::uint64_t value[4];
+};
+}
+
+TEST(SlabAllocatedTestSuite, shallNotHitHeapWhenPoolsHaveFreeBlocks)
+{
+    auto makeAndRelease = []
+    {
+        auto pooled = std::make_unique<Pooled>();
+        auto shared = std::allocate_shared<Pooled>(SlabAllocator<Pooled>{});
+        std::list<int, SlabAllocator<int>> nodes{1, 2, 3};
+    };
+    // grows the pools
+    makeAndRelease();
+
+    ScopedAllocationCounter counter;
+    makeAndRelease();
+
+    ASSERT_EQ(0u, counter.count().allocations) << counter.count();
+    ASSERT_EQ(0u, SlabPool::of<Pooled>().blocksInUse());
+}
+
+}
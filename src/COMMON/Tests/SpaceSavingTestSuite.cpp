@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <stdexcept>
+
+#include "Metrics/SpaceSaving.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+TEST(SpaceSavingTestSuite, shallCountExactlyWhileNotFull)
+{
+    SpaceSaving objectUnderTest{4};
+    objectUnderTest.add(1);
+    objectUnderTest.add(2, 5);
+    objectUnderTest.add(1);
+
+    ASSERT_THAT(objectUnderTest.entries(), UnorderedElementsAre(
+                    AllOf(Field(&SpaceSaving::Entry::key, 1u), Field(&SpaceSaving::Entry::count, 2u),
+                          Field(&SpaceSaving::Entry::error, 0u)),
+                    AllOf(Field(&SpaceSaving::Entry::key, 2u), Field(&SpaceSaving::Entry::count, 5u))));
+    ASSERT_EQ(0u, objectUnderTest.minCount());
+}
+
+TEST(SpaceSavingTestSuite, shallReplaceSmallestWhenFull)
+{
+    SpaceSaving objectUnderTest{2};
+    objectUnderTest.add(1, 10);
+    objectUnderTest.add(2, 3);
+    objectUnderTest.add(3);
+
+    ASSERT_THAT(objectUnderTest.entries(), UnorderedElementsAre(
+                    Field(&SpaceSaving::Entry::key, 1u),
+                    AllOf(Field(&SpaceSaving::Entry::key, 3u), Field(&SpaceSaving::Entry::count, 4u),
+                          Field(&SpaceSaving::Entry::error, 3u))));
+}
+
+TEST(SpaceSavingTestSuite, shallKeepHeavyHitterAmongManyLightKeys)
+{
+    SpaceSaving objectUnderTest{8};
+    for (SpaceSaving::Key key = 100u; key < 1100u; ++key)
+    {
+        objectUnderTest.add(key);
+        objectUnderTest.add(7u);
+    }
+    ASSERT_THAT(objectUnderTest.entries(), Contains(AllOf(Field(&SpaceSaving::Entry::key, 7u),
+                                                          Field(&SpaceSaving::Entry::count, Ge(1000u)))));
+}
+
+TEST(SpaceSavingTestSuite, shallRejectZeroCapacity)
+{
+    ASSERT_THROW(SpaceSaving{0}, std::invalid_argument);
+}
+
+class SlidingTopKTestSuite : public Test
+{
+protected:
+    const SlidingTopK::Clock::time_point START{1h};
+    SlidingTopK objectUnderTest{60s, 6, 4};
+};
+
+TEST_F(SlidingTopKTestSuite, shallSumOverSubWindowsHighestFirst)
+{
+    objectUnderTest.add(1, 3, START);
+    objectUnderTest.add(2, 2, START);
+    objectUnderTest.add(2, 2, START + 20s);
+
+    ASSERT_THAT(objectUnderTest.top(5, START + 30s), ElementsAre(
+                    AllOf(Field(&SlidingTopK::Entry::key, 2u), Field(&SlidingTopK::Entry::count, 4u)),
+                    AllOf(Field(&SlidingTopK::Entry::key, 1u), Field(&SlidingTopK::Entry::count, 3u))));
+    ASSERT_EQ(1u, objectUnderTest.top(1, START + 30s).size());
+}
+
+TEST_F(SlidingTopKTestSuite, shallForgetOldSubWindows)
+{
+    objectUnderTest.add(1, 3, START);
+    objectUnderTest.add(2, 1, START + 50s);
+
+    ASSERT_THAT(objectUnderTest.top(5, START + 65s), ElementsAre(Field(&SlidingTopK::Entry::key, 2u)));
+    ASSERT_THAT(objectUnderTest.top(5, START + 2min), IsEmpty());
+}
+
+}
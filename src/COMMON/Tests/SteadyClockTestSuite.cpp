@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <future>
+
+#include "Time/SteadyClock.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+class SteadyClockTestSuite : public Test
+{
+protected:
+    SteadyClock objectUnderTest;
+};
+
+TEST_F(SteadyClockTestSuite, shallFireTimerNotBeforeDueTime)
+{
+    std::promise<IClock::TimePoint> fired;
+    auto when = objectUnderTest.now() + 20ms;
+    objectUnderTest.scheduleAt(when, [&] { fired.set_value(objectUnderTest.now()); });
+
+    auto result = fired.get_future();
+    ASSERT_EQ(std::future_status::ready, result.wait_for(1s));
+    ASSERT_GE(result.get(), when);
+}
+
+TEST_F(SteadyClockTestSuite, shallFireEarlierTimerScheduledLater)
+{
+    std::promise<void> early;
+    std::atomic<bool> lateFired{false};
+    objectUnderTest.scheduleAfter(1h, [&] { lateFired = true; });
+    objectUnderTest.scheduleAfter(1ms, [&] { early.set_value(); });
+
+    ASSERT_EQ(std::future_status::ready, early.get_future().wait_for(1s));
+    ASSERT_FALSE(lateFired);
+    ASSERT_EQ(1u, objectUnderTest.pendingCount());
+}
+
+TEST_F(SteadyClockTestSuite, shallNotFireCancelledTimer)
+{
+    auto timerId = objectUnderTest.scheduleAfter(1h, [] { FAIL() << "cancelled timer fired"; });
+    ASSERT_TRUE(objectUnderTest.cancel(timerId));
+    ASSERT_EQ(0u, objectUnderTest.pendingCount());
+}
+
+TEST_F(SteadyClockTestSuite, shallWaitForFiringTimerOnCancel)
+{
+    std::promise<void> started;
+    std::atomic<bool> finished{false};
+    auto timerId = objectUnderTest.scheduleAfter(0ms, [&]
+    {
+        started.set_value();
+        std::this_thread::sleep_for(50ms);
+        finished = true;
+    });
+    started.get_future().wait();
+
+    ASSERT_FALSE(objectUnderTest.cancel(timerId));
+    ASSERT_TRUE(finished);
+}
+
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "Logger/SuppressedLogReporter.hpp"
+#include "Time/VirtualClock.hpp"
+#include "Mocks/ILoggerMock.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+class SuppressedLogReporterTestSuite : public Test
+{
+protected:
+    const std::string message = "reporter flood";
+
+    NiceMock<ILoggerMock> loggerMock;
+    VirtualClock clock;
+    LogLimit limit = LogLimit::sampled(10u);
+    SuppressedLogReporter objectUnderTest{100ms};
+
+    void SetUp() override
+    {
+        // limits left pending by other tests
+        LogLimit::flushSuppressed([](int, std::string_view) {}, LogLimit::Clock::time_point::max());
+    }
+
+    void flood(unsigned count)
+    {
+        for (unsigned i = 0u; i < count; ++i)
+        {
+            loggerMock.logInfo(limit, message);
+        }
+    }
+};
+
+TEST_F(SuppressedLogReporterTestSuite, shallReportSuppressedMessagesPeriodically)
+{
+    EXPECT_CALL(loggerMock, log(ILogger::INFO_LEVEL, message));
+    objectUnderTest.start(clock, loggerMock);
+    flood(4u);
+    Mock::VerifyAndClearExpectations(&loggerMock);
+
+    EXPECT_CALL(loggerMock, log(ILogger::INFO_LEVEL, "suppressed 3 similar messages: " + message));
+    clock.advance(100ms);
+    Mock::VerifyAndClearExpectations(&loggerMock);
+
+    EXPECT_CALL(loggerMock, log(ILogger::INFO_LEVEL, "suppressed 2 similar messages: " + message));
+    flood(2u);
+    clock.advance(100ms);
+    objectUnderTest.stop();
+}
+
+TEST_F(SuppressedLogReporterTestSuite, shallReportSuppressedMessagesOnStop)
+{
+    objectUnderTest.start(clock, loggerMock);
+    flood(3u);
+
+    EXPECT_CALL(loggerMock, log(ILogger::INFO_LEVEL, "suppressed 2 similar messages: " + message));
+    objectUnderTest.stop();
+    ASSERT_EQ(0u, clock.pendingCount());
+}
+
+}
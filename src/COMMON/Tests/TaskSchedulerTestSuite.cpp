@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <future>
+
+#include "TestCommands/TaskScheduler.hpp"
+#include "Time/VirtualClock.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+class TaskSchedulerTestSuite : public Test
+{
+protected:
+    TaskScheduler objectUnderTest{2u};
+};
+
+TEST_F(TaskSchedulerTestSuite, shallRejectZeroThreads)
+{
+    ASSERT_THROW(TaskScheduler{0u}, std::invalid_argument);
+}
+
+TEST_F(TaskSchedulerTestSuite, shallRunPostedTask)
+{
+    std::promise<void> done;
+    objectUnderTest.post([&done] { done.set_value(); });
+    ASSERT_EQ(std::future_status::ready, done.get_future().wait_for(1s));
+}
+
+TEST_F(TaskSchedulerTestSuite, shallRunDelayedTaskAfterLaterPostedImmediateOne)
+{
+    std::mutex mutex;
+    std::vector<int> order;
+    std::promise<void> done;
+    auto start = TaskScheduler::Clock::now();
+    objectUnderTest.postAfter(50ms, [&]
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(2);
+        done.set_value();
+    });
+    objectUnderTest.post([&]
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(1);
+    });
+
+    ASSERT_EQ(std::future_status::ready, done.get_future().wait_for(1s));
+    ASSERT_GE(TaskScheduler::Clock::now() - start, 50ms);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_THAT(order, ElementsAre(1, 2));
+}
+
+TEST_F(TaskSchedulerTestSuite, shallRunDelayedTaskWhenVirtualClockAdvanced)
+{
+    auto clock = std::make_shared<VirtualClock>();
+    TaskScheduler scheduler{clock, 1u};
+    std::promise<void> done;
+    scheduler.postAfter(1h, [&done] { done.set_value(); });
+    auto result = done.get_future();
+
+    // worker arms clock timer for the task asynchronously
+    auto deadline = std::chrono::steady_clock::now() + 1s;
+    while (clock->pendingCount() == 0u and std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    clock->advance(59min);
+    ASSERT_EQ(std::future_status::timeout, result.wait_for(10ms));
+    clock->advance(1min);
+    ASSERT_EQ(std::future_status::ready, result.wait_for(1s));
+}
+
+TEST_F(TaskSchedulerTestSuite, shallDropPendingTasksOnDestruction)
+{
+    bool executed = false;
+    {
+        TaskScheduler scheduler{1u};
+        scheduler.postAfter(1h, [&executed] { executed = true; });
+        ASSERT_EQ(1u, scheduler.pendingCount());
+    }
+    ASSERT_FALSE(executed);
+}
+
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <future>
+#include <mutex>
+
+#include "TestCommands/TestCommands.hpp"
+#include "Time/VirtualClock.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+class TestCommandsTestSuite : public Test
+{
+protected:
+    std::string printedText()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return printed;
+    }
+
+    std::mutex mutex;
+    std::string printed;
+    std::size_t sentCount = 0u;
+    TestCommands::Parameters parameters{
+        [this](std::string text)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            printed += text;
+        },
+        [this](const BinaryMessage&, PhoneNumber)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++sentCount;
+            return true;
+        }};
+};
+
+TEST_F(TestCommandsTestSuite, shallRunCommandsInOrder)
+{
+    TestCommands objectUnderTest{"e a g 2 e b w 1 r 3 e c"};
+    ASSERT_TRUE(objectUnderTest.run(parameters));
+    ASSERT_EQ("abccc", printedText());
+}
+
+TEST_F(TestCommandsTestSuite, shallNotBlockCallerOnWait)
+{
+    TaskScheduler scheduler{1u};
+    TestCommands objectUnderTest{"e a w 100 e b"};
+    std::promise<bool> finished;
+
+    auto start = TaskScheduler::Clock::now();
+    objectUnderTest.start(parameters, scheduler, [&finished](bool succeeded) { finished.set_value(succeeded); });
+    ASSERT_LT(TaskScheduler::Clock::now() - start, 100ms);
+
+    auto result = finished.get_future();
+    ASSERT_EQ(std::future_status::ready, result.wait_for(2s));
+    ASSERT_TRUE(result.get());
+    ASSERT_GE(TaskScheduler::Clock::now() - start, 100ms);
+    ASSERT_EQ("ab", printedText());
+}
+
+TEST_F(TestCommandsTestSuite, shallWaitOnVirtualClock)
+{
+    auto clock = std::make_shared<VirtualClock>();
+    TaskScheduler scheduler{clock, 1u};
+    TestCommands objectUnderTest{"e a w 3600000 e b"};
+    std::promise<bool> finished;
+    auto result = finished.get_future();
+
+    objectUnderTest.start(parameters, scheduler, [&finished](bool succeeded) { finished.set_value(succeeded); });
+    // worker arms clock timer for the wait asynchronously
+    auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (clock->pendingCount() == 0u and std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    ASSERT_EQ("a", printedText());
+    ASSERT_EQ(std::future_status::timeout, result.wait_for(10ms));
+
+    ASSERT_EQ(1u, clock->advance(1h));
+    ASSERT_EQ(std::future_status::ready, result.wait_for(2s));
+    ASSERT_TRUE(result.get());
+    ASSERT_EQ("ab", printedText());
+}
+
+TEST_F(TestCommandsTestSuite, shallRunWaitingPlansConcurrentlyOnOneThread)
+{
+    TaskScheduler scheduler{1u};
+    TestCommands slowPlan{"w 200 e slow"};
+    TestCommands fastPlan{"w 10 e fast"};
+    std::promise<void> finished;
+
+    slowPlan.start(parameters, scheduler, [&finished](bool) { finished.set_value(); });
+    fastPlan.start(parameters, scheduler);
+
+    ASSERT_EQ(std::future_status::ready, finished.get_future().wait_for(2s));
+    ASSERT_EQ("fastslow", printedText());
+}
+
+TEST_F(TestCommandsTestSuite, shallNotGrowStackWithRepeatCount)
+{
+    TestCommands objectUnderTest{"r 100000 s Sms 1 2 x"};
+    ASSERT_TRUE(objectUnderTest.run(parameters));
+    ASSERT_EQ(100000u, sentCount);
+}
+
+TEST_F(TestCommandsTestSuite, shallReportFailureAndSkipRestOfPlan)
+{
+    parameters.sendMessage = [](const BinaryMessage&, PhoneNumber) -> bool
+    {
+        throw std::runtime_error("no relay");
+    };
+    TestCommands objectUnderTest{"s Sms 1 2 x e never"};
+    ASSERT_FALSE(objectUnderTest.run(parameters));
+    ASSERT_EQ("test commands failed: no relay\n", printedText());
+}
+
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <stdexcept>
+
+#include "AllocationCounter/AllocationCounter.hpp"
+#include "Time/TimingWheel.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+class TimingWheelTestSuite : public Test
+{
+protected:
+    static constexpr std::size_t SLOT_COUNT = 8u;
+
+    // keys expired at each tick
+    std::vector<std::vector<TimingWheel::Key>> advance(std::size_t ticks)
+    {
+        std::vector<std::vector<TimingWheel::Key>> result;
+        for (std::size_t i = 0u; i < ticks; ++i)
+        {
+            std::vector<TimingWheel::Key> expired;
+            objectUnderTest.advance(expired);
+            result.push_back(expired);
+        }
+        return result;
+    }
+
+    TimingWheel objectUnderTest{100ms, SLOT_COUNT};
+};
+
+TEST_F(TimingWheelTestSuite, shallRejectZeroTickOrSlots)
+{
+    ASSERT_THROW(TimingWheel(0ms), std::invalid_argument);
+    ASSERT_THROW(TimingWheel(100ms, 0u), std::invalid_argument);
+}
+
+TEST_F(TimingWheelTestSuite, shallExpireAfterDelayRoundedUpToTicks)
+{
+    objectUnderTest.schedule(1u, 250ms);
+    objectUnderTest.schedule(2u, 0ms);
+
+    auto expired = advance(3u);
+
+    ASSERT_THAT(expired, ElementsAre(ElementsAre(2u), IsEmpty(), ElementsAre(1u)));
+    ASSERT_EQ(0u, objectUnderTest.size());
+}
+
+TEST_F(TimingWheelTestSuite, shallWaitExtraTurnsForDelayBeyondWheel)
+{
+    const auto turn = 100ms * SLOT_COUNT;
+    objectUnderTest.schedule(1u, 2 * turn + 100ms);
+
+    auto expired = advance(2u * SLOT_COUNT);
+    ASSERT_THAT(expired, Each(IsEmpty()));
+
+    ASSERT_THAT(advance(1u), ElementsAre(ElementsAre(1u)));
+}
+
+TEST_F(TimingWheelTestSuite, shallExpireExactlyAtWholeTurn)
+{
+    objectUnderTest.schedule(1u, 100ms * SLOT_COUNT);
+
+    auto expired = advance(SLOT_COUNT);
+
+    ASSERT_THAT(expired.back(), ElementsAre(1u));
+}
+
+TEST_F(TimingWheelTestSuite, shallCancel)
+{
+    objectUnderTest.schedule(1u, 100ms);
+    objectUnderTest.schedule(2u, 100ms);
+    objectUnderTest.schedule(3u, 100ms);
+
+    ASSERT_TRUE(objectUnderTest.cancel(2u));
+    ASSERT_FALSE(objectUnderTest.cancel(2u));
+    ASSERT_FALSE(objectUnderTest.isScheduled(2u));
+
+    ASSERT_THAT(advance(1u), ElementsAre(ElementsAre(1u, 3u)));
+}
+
+TEST_F(TimingWheelTestSuite, shallReplaceTimerOfSameKey)
+{
+    objectUnderTest.schedule(1u, 100ms);
+    objectUnderTest.schedule(1u, 300ms);
+    ASSERT_EQ(1u, objectUnderTest.size());
+
+    ASSERT_THAT(advance(3u), ElementsAre(IsEmpty(), IsEmpty(), ElementsAre(1u)));
+}
+
+TEST_F(TimingWheelTestSuite, shallReuseNodesOfExpiredTimers)
+{
+    for (TimingWheel::Key key = 0u; key < 1000u; ++key)
+    {
+        objectUnderTest.schedule(key, 100ms);
+        ASSERT_THAT(advance(1u), ElementsAre(ElementsAre(key)));
+    }
+    ASSERT_EQ(0u, objectUnderTest.size());
+}
+
+TEST_F(TimingWheelTestSuite, shallRescheduleKnownKeyWithoutAllocation)
+{
+    objectUnderTest.schedule(1u, 100ms);
+    objectUnderTest.schedule(2u, 100ms);
+    advance(1u);
+    ASSERT_FALSE(objectUnderTest.isScheduled(1u));
+    std::vector<TimingWheel::Key> expired;
+    expired.reserve(2u);
+
+    ScopedAllocationCounter counter;
+    for (int i = 0; i < 100; ++i)
+    {
+        objectUnderTest.schedule(1u, 100ms);
+        objectUnderTest.schedule(2u, 200ms);
+        objectUnderTest.schedule(2u, 100ms);
+        expired.clear();
+        objectUnderTest.advance(expired);
+    }
+
+    ASSERT_EQ(0u, counter.count().allocations) << counter.count();
+    ASSERT_THAT(expired, ElementsAre(1u, 2u));
+}
+
+TEST_F(TimingWheelTestSuite, shallForgetExpiredKeyOnCancel)
+{
+    objectUnderTest.schedule(1u, 100ms);
+    advance(1u);
+
+    ASSERT_FALSE(objectUnderTest.cancel(1u));
+    ASSERT_FALSE(objectUnderTest.cancel(1u));
+    ASSERT_EQ(0u, objectUnderTest.size());
+}
+
+}
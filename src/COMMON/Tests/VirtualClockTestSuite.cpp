@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "Time/VirtualClock.hpp"
+
+namespace common
+{
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+class VirtualClockTestSuite : public Test
+{
+protected:
+    const IClock::TimePoint START = IClock::TimePoint{} + 1h;
+
+    VirtualClock objectUnderTest{START};
+    std::vector<std::string> fired;
+
+    IClock::Callback record(std::string name)
+    {
+        return [this, name] { fired.push_back(name); };
+    }
+};
+
+TEST_F(VirtualClockTestSuite, shallStandStillUntilAdvanced)
+{
+    ASSERT_EQ(START, objectUnderTest.now());
+    objectUnderTest.advance(5s);
+    ASSERT_EQ(START + 5s, objectUnderTest.now());
+}
+
+TEST_F(VirtualClockTestSuite, shallFireDueTimersInTimeOrderThenSchedulingOrder)
+{
+    objectUnderTest.scheduleAfter(20ms, record("c"));
+    objectUnderTest.scheduleAfter(10ms, record("a"));
+    objectUnderTest.scheduleAfter(10ms, record("b"));
+    objectUnderTest.scheduleAfter(30ms, record("not yet"));
+
+    ASSERT_EQ(3u, objectUnderTest.advance(20ms));
+    ASSERT_THAT(fired, ElementsAre("a", "b", "c"));
+    ASSERT_EQ(1u, objectUnderTest.pendingCount());
+}
+
+TEST_F(VirtualClockTestSuite, shallSetNowToDueTimeOfFiringTimer)
+{
+    IClock::TimePoint firedAt;
+    objectUnderTest.scheduleAfter(7ms, [this, &firedAt] { firedAt = objectUnderTest.now(); });
+    objectUnderTest.advance(1s);
+    ASSERT_EQ(START + 7ms, firedAt);
+}
+
+TEST_F(VirtualClockTestSuite, shallFireTimersScheduledByCallbacksWithinSameAdvance)
+{
+    // periodic timer - 1 hour of 100ms ticks
+    std::size_t ticks = 0u;
+    std::function<void()> tick = [&]
+    {
+        ++ticks;
+        objectUnderTest.scheduleAfter(100ms, tick);
+    };
+    objectUnderTest.scheduleAfter(100ms, tick);
+
+    ASSERT_EQ(36000u, objectUnderTest.advance(1h));
+    ASSERT_EQ(36000u, ticks);
+}
+
+TEST_F(VirtualClockTestSuite, shallNotFireCancelledTimer)
+{
+    auto timerId = objectUnderTest.scheduleAfter(10ms, record("cancelled"));
+    ASSERT_TRUE(objectUnderTest.cancel(timerId));
+    ASSERT_FALSE(objectUnderTest.cancel(timerId));
+
+    ASSERT_EQ(0u, objectUnderTest.advance(1s));
+    ASSERT_THAT(fired, IsEmpty());
+}
+
+TEST_F(VirtualClockTestSuite, shallFireTimerFromPastAtCurrentTime)
+{
+    objectUnderTest.advance(1s);
+    objectUnderTest.scheduleAt(START, record("late"));
+    ASSERT_EQ(1u, objectUnderTest.advance(0ms));
+    ASSERT_EQ(START + 1s, objectUnderTest.now());
+}
+
+}
@@ -0,0 +1,11 @@
+#include "IClock.hpp"
+
+namespace common
+{
+
+IClock::TimerId IClock::scheduleAfter(Duration delay, Callback callback)
+{
+    return scheduleAt(now() + delay, std::move(callback));
+}
+
+}
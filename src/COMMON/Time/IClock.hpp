@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace common
+{
+
+/**
+ * Source of time and one-shot timers - real one for applications, virtual one for tests.
+ * Thread and context in which callback is called is defined by implementation.
+ */
+class IClock
+{
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+    using Duration = std::chrono::steady_clock::duration;
+    using TimerId = std::uint64_t;
+    using Callback = std::function<void()>;
+
+    virtual ~IClock() = default;
+
+    virtual TimePoint now() const = 0;
+    /**
+     * Timers due at the same time point fire in scheduling order
+     */
+    virtual TimerId scheduleAt(TimePoint when, Callback callback) = 0;
+    /**
+     * @return false when timer already fired (or is firing right now) or was already cancelled
+     */
+    virtual bool cancel(TimerId timerId) = 0;
+
+    TimerId scheduleAfter(Duration delay, Callback callback);
+};
+
+using ClockPtr = std::shared_ptr<IClock>;
+
+}
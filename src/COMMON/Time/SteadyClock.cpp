@@ -0,0 +1,86 @@
+#include "SteadyClock.hpp"
+
+namespace common
+{
+
+SteadyClock::SteadyClock()
+    : dispatcher(&SteadyClock::dispatch, this)
+{}
+
+SteadyClock::~SteadyClock()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        timers.clear();
+    }
+    changed.notify_all();
+    dispatcher.join();
+}
+
+IClock::TimePoint SteadyClock::now() const
+{
+    return std::chrono::steady_clock::now();
+}
+
+IClock::TimerId SteadyClock::scheduleAt(TimePoint when, Callback callback)
+{
+    TimerId timerId;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        timerId = timers.add(when, std::move(callback));
+    }
+    // new timer might be earlier than the one dispatcher waits for
+    changed.notify_all();
+    return timerId;
+}
+
+bool SteadyClock::cancel(TimerId timerId)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (timers.remove(timerId))
+    {
+        return true;
+    }
+    if (std::this_thread::get_id() != dispatcher.get_id())
+    {
+        changed.wait(lock, [this, timerId] { return firingTimerId != timerId; });
+    }
+    return false;
+}
+
+std::size_t SteadyClock::pendingCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return timers.size();
+}
+
+void SteadyClock::dispatch()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (not stopping)
+    {
+        auto due = timers.popDue(now());
+        if (not due)
+        {
+            auto nextDue = timers.nextDue();
+            if (nextDue)
+            {
+                changed.wait_until(lock, *nextDue);
+            }
+            else
+            {
+                changed.wait(lock);
+            }
+            continue;
+        }
+        firingTimerId = due->timerId;
+        lock.unlock();
+        due->callback();
+        lock.lock();
+        firingTimerId = 0u;
+        changed.notify_all();
+    }
+}
+
+}
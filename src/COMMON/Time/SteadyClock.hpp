@@ -0,0 +1,46 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "IClock.hpp"
+#include "TimerQueue.hpp"
+
+namespace common
+{
+
+/**
+ * Real time clock - callbacks are called one by one from its own dispatcher thread.
+ * Callbacks shall not throw.
+ */
+class SteadyClock : public IClock
+{
+public:
+    SteadyClock();
+    /** Drops pending timers, waits for the one being called */
+    ~SteadyClock() override;
+    SteadyClock(const SteadyClock&) = delete;
+    SteadyClock& operator=(const SteadyClock&) = delete;
+
+    TimePoint now() const override;
+    TimerId scheduleAt(TimePoint when, Callback callback) override;
+    /**
+     * When the timer is being called from other thread - waits until the call finishes,
+     * so nothing captured by the callback is used after cancel returns
+     */
+    bool cancel(TimerId timerId) override;
+
+    std::size_t pendingCount() const;
+
+private:
+    void dispatch();
+
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    bool stopping = false;
+    TimerQueue timers;
+    TimerId firingTimerId = 0u;
+    std::thread dispatcher;
+};
+
+}
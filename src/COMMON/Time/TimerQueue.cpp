@@ -0,0 +1,59 @@
+#include "TimerQueue.hpp"
+
+namespace common
+{
+
+IClock::TimerId TimerQueue::add(IClock::TimePoint when, IClock::Callback callback)
+{
+    const IClock::TimerId timerId = ++lastTimerId;
+    timers.emplace(Key{when, timerId}, std::move(callback));
+    dueTimes.emplace(timerId, when);
+    return timerId;
+}
+
+bool TimerQueue::remove(IClock::TimerId timerId)
+{
+    auto found = dueTimes.find(timerId);
+    if (found == dueTimes.end())
+    {
+        return false;
+    }
+    timers.erase(Key{found->second, timerId});
+    dueTimes.erase(found);
+    return true;
+}
+
+std::optional<TimerQueue::DueTimer> TimerQueue::popDue(IClock::TimePoint limit)
+{
+    if (timers.empty() or timers.begin()->first.first > limit)
+    {
+        return std::nullopt;
+    }
+    auto first = timers.begin();
+    DueTimer result{first->first.second, first->first.first, std::move(first->second)};
+    dueTimes.erase(result.timerId);
+    timers.erase(first);
+    return result;
+}
+
+std::optional<IClock::TimePoint> TimerQueue::nextDue() const
+{
+    if (timers.empty())
+    {
+        return std::nullopt;
+    }
+    return timers.begin()->first.first;
+}
+
+std::size_t TimerQueue::size() const noexcept
+{
+    return timers.size();
+}
+
+void TimerQueue::clear() noexcept
+{
+    timers.clear();
+    dueTimes.clear();
+}
+
+}
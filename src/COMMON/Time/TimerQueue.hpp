@@ -0,0 +1,44 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include "IClock.hpp"
+
+namespace common
+{
+
+/**
+ * Ordered set of pending timers shared by clock implementations - not synchronized
+ */
+class TimerQueue
+{
+public:
+    struct DueTimer
+    {
+        IClock::TimerId timerId;
+        IClock::TimePoint when;
+        IClock::Callback callback;
+    };
+
+    IClock::TimerId add(IClock::TimePoint when, IClock::Callback callback);
+    bool remove(IClock::TimerId timerId);
+    /**
+     * Removes and returns the earliest timer, when it is due not later than given time point
+     */
+    std::optional<DueTimer> popDue(IClock::TimePoint limit);
+    std::optional<IClock::TimePoint> nextDue() const;
+
+    std::size_t size() const noexcept;
+    void clear() noexcept;
+
+private:
+    // timer ids grow, so timers due at the same time point keep scheduling order
+    using Key = std::pair<IClock::TimePoint, IClock::TimerId>;
+    std::map<Key, IClock::Callback> timers;
+    std::unordered_map<IClock::TimerId, IClock::TimePoint> dueTimes;
+    IClock::TimerId lastTimerId = 0u;
+};
+
+}
@@ -0,0 +1,120 @@
+#include "TimingWheel.hpp"
+#include <stdexcept>
+
+namespace common
+{
+
+TimingWheel::TimingWheel(Duration tick, std::size_t slotCount)
+    : tick(tick),
+      slots(slotCount)
+{
+    if (tick <= Duration::zero() or slotCount == 0u)
+    {
+        throw std::invalid_argument("TimingWheel needs positive tick and at least one slot");
+    }
+}
+
+void TimingWheel::schedule(Key key, Duration delay)
+{
+    auto location = locations.find(key);
+    if (location == locations.end())
+    {
+        location = locations.emplace(key, NONE).first;
+    }
+    else if (location->second != NONE)
+    {
+        unlink(location->second);
+        --scheduled;
+    }
+    // at least one tick - the current slot has already been visited
+    const std::uint64_t ticks = delay <= tick ? 1u : std::uint64_t((delay.count() + tick.count() - 1) / tick.count());
+    const std::uint32_t index = takeNode();
+    Node& node = nodes[index];
+    node.key = key;
+    node.rounds = (ticks - 1u) / slots.size();
+    node.slot = static_cast<std::uint32_t>((current + ticks) % slots.size());
+    link(index);
+    location->second = index;
+    ++scheduled;
+}
+
+bool TimingWheel::cancel(Key key)
+{
+    auto location = locations.find(key);
+    if (location == locations.end())
+    {
+        return false;
+    }
+    const bool pending = location->second != NONE;
+    if (pending)
+    {
+        unlink(location->second);
+        --scheduled;
+    }
+    locations.erase(location);
+    return pending;
+}
+
+bool TimingWheel::isScheduled(Key key) const
+{
+    auto location = locations.find(key);
+    return location != locations.end() and location->second != NONE;
+}
+
+void TimingWheel::advance(std::vector<Key> &expired)
+{
+    current = (current + 1u) % slots.size();
+    std::uint32_t index = slots[current].head;
+    while (index != NONE)
+    {
+        Node& node = nodes[index];
+        const std::uint32_t next = node.next;
+        if (node.rounds == 0u)
+        {
+            expired.push_back(node.key);
+            locations.find(node.key)->second = NONE;
+            --scheduled;
+            unlink(index);
+        }
+        else
+        {
+            --node.rounds;
+        }
+        index = next;
+    }
+}
+
+std::uint32_t TimingWheel::takeNode()
+{
+    if (freeNodes != NONE)
+    {
+        const std::uint32_t index = freeNodes;
+        freeNodes = nodes[index].next;
+        return index;
+    }
+    nodes.emplace_back();
+    return static_cast<std::uint32_t>(nodes.size() - 1u);
+}
+
+void TimingWheel::link(std::uint32_t index)
+{
+    Node& node = nodes[index];
+    Slot& slot = slots[node.slot];
+    node.previous = slot.tail;
+    node.next = NONE;
+    (slot.tail == NONE ? slot.head : nodes[slot.tail].next) = index;
+    slot.tail = index;
+}
+
+void TimingWheel::unlink(std::uint32_t index)
+{
+    Node& node = nodes[index];
+    Slot& slot = slots[node.slot];
+    (node.previous == NONE ? slot.head : nodes[node.previous].next) = node.next;
+    (node.next == NONE ? slot.tail : nodes[node.next].previous) = node.previous;
+    // back to free list - linked through next
+    node.next = freeNodes;
+    freeNodes = index;
+}
+
+}
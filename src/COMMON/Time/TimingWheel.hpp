@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace common
+{
+
+/**
+ * Hashed timing wheel (Varghese, Lauck) - schedule, cancel and expiry of a timer cost O(1) whatever the number
+ * of timers, for many long timeouts of which most are cancelled or pushed back. Time is moved by the owner one tick
+ * at a time: delays are rounded up to whole ticks, timers further than one turn wait extra turns in their slot.
+ * Timers are identified by keys given by the owner. Not thread-safe.
+ * A key stays known after its timer expires, so scheduling it again allocates nothing - cancel forgets it.
+ */
+class TimingWheel
+{
+public:
+    using Key = std::uint64_t;
+    using Duration = std::chrono::milliseconds;
+    static constexpr std::size_t DEFAULT_SLOT_COUNT = 64u;
+
+    /**
+     * @throw std::invalid_argument for zero tick or zero slots
+     */
+    explicit TimingWheel(Duration tick, std::size_t slotCount = DEFAULT_SLOT_COUNT);
+
+    /**
+     * Pending timer of the same key is replaced. Zero delay expires on next tick.
+     */
+    void schedule(Key key, Duration delay);
+    /**
+     * Forgets the key - shall be called for every key the owner is done with, expired or not
+     * @return false when there was no pending timer of this key
+     */
+    bool cancel(Key key);
+    bool isScheduled(Key key) const;
+    /** pending timers */
+    std::size_t size() const noexcept { return scheduled; }
+    Duration tickDuration() const noexcept { return tick; }
+
+    /**
+     * Moves the wheel by one tick - keys of expired timers are appended to expired, in scheduling order
+     */
+    void advance(std::vector<Key>& expired);
+
+private:
+    static constexpr std::uint32_t NONE = ~std::uint32_t{0u};
+
+    // doubly linked within its slot, index into nodes - with known keys no allocation per timer once nodes has grown
+    struct Node
+    {
+        Key key;
+        std::uint64_t rounds;
+        std::uint32_t slot;
+        std::uint32_t previous;
+        std::uint32_t next;
+    };
+    struct Slot
+    {
+        std::uint32_t head = NONE;
+        std::uint32_t tail = NONE;
+    };
+
+    std::uint32_t takeNode();
+    void link(std::uint32_t index);
+    void unlink(std::uint32_t index);
+
+    const Duration tick;
+    std::vector<Slot> slots;
+    std::size_t current = 0u;
+    std::vector<Node> nodes;
+    std::uint32_t freeNodes = NONE;
+    // NONE for known keys without pending timer - expiry and rescheduling update the entry in place
+    std::unordered_map<Key, std::uint32_t> locations;
+    std::size_t scheduled = 0u;
+};
+
+}
@@ -0,0 +1,62 @@
+#include "VirtualClock.hpp"
+
+namespace common
+{
+
+VirtualClock::VirtualClock(TimePoint start)
+    : currentTime(start)
+{}
+
+IClock::TimePoint VirtualClock::now() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return currentTime;
+}
+
+IClock::TimerId VirtualClock::scheduleAt(TimePoint when, Callback callback)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return timers.add(when, std::move(callback));
+}
+
+bool VirtualClock::cancel(TimerId timerId)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return timers.remove(timerId);
+}
+
+std::size_t VirtualClock::advance(Duration duration)
+{
+    return advanceTo(now() + duration);
+}
+
+std::size_t VirtualClock::advanceTo(TimePoint when)
+{
+    std::size_t calledCount = 0u;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (auto due = timers.popDue(when))
+    {
+        // timer scheduled in the past fires "now", time never goes back
+        if (due->when > currentTime)
+        {
+            currentTime = due->when;
+        }
+        lock.unlock();
+        due->callback();
+        ++calledCount;
+        lock.lock();
+    }
+    if (when > currentTime)
+    {
+        currentTime = when;
+    }
+    return calledCount;
+}
+
+std::size_t VirtualClock::pendingCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return timers.size();
+}
+
+}
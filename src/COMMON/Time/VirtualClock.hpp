@@ -0,0 +1,38 @@
+#pragma once
+
+#include <mutex>
+#include "IClock.hpp"
+#include "TimerQueue.hpp"
+
+namespace common
+{
+
+/**
+ * Clock for tests - time stands still until advanced, due callbacks are called
+ * synchronously from advance(), in due time order, with now() set to their due time.
+ * Callbacks may schedule and cancel timers, these are honored within the same advance().
+ */
+class VirtualClock : public IClock
+{
+public:
+    explicit VirtualClock(TimePoint start = TimePoint{});
+
+    TimePoint now() const override;
+    TimerId scheduleAt(TimePoint when, Callback callback) override;
+    bool cancel(TimerId timerId) override;
+
+    /**
+     * @return number of callbacks called
+     */
+    std::size_t advance(Duration duration);
+    std::size_t advanceTo(TimePoint when);
+
+    std::size_t pendingCount() const;
+
+private:
+    mutable std::mutex mutex;
+    TimePoint currentTime;
+    TimerQueue timers;
+};
+
+}
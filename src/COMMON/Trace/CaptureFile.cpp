@@ -0,0 +1,191 @@
+#include "CaptureFile.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace common
+{
+
+namespace
+{
+
+constexpr char MAGIC[] = {'S', 'T', 'H', 'C', 'A', 'P', '0', '1'};
+constexpr std::size_t RECORD_HEADER_SIZE = 8u + 4u + 1u + 2u;
+
+template <typename T>
+char* putLittleEndian(char* output, T value)
+{
+    for (std::size_t i = 0u; i < sizeof(T); ++i)
+    {
+        *output++ = static_cast<char>(value & 0xFFu);
+        value >>= 8u;
+    }
+    return output;
+}
+
+template <typename T>
+const char* getLittleEndian(const char* input, T& value)
+{
+    value = 0u;
+    for (std::size_t i = 0u; i < sizeof(T); ++i)
+    {
+        value |= T(static_cast<unsigned char>(*input++)) << (8u * i);
+    }
+    return input;
+}
+
+}
+
+CaptureWriter::CaptureWriter(const std::string &path, std::size_t bufferSize, std::chrono::milliseconds flushPeriod)
+    : file(path, std::ios::binary | std::ios::trunc),
+      bufferSize(std::max(bufferSize, RECORD_HEADER_SIZE + BinaryMessage::MAX_SIZE)),
+      flushPeriod(flushPeriod)
+{
+    if (not file)
+    {
+        throw std::runtime_error("Cannot create capture file: " + path);
+    }
+    buffer.reserve(this->bufferSize);
+    buffer.insert(buffer.end(), std::begin(MAGIC), std::end(MAGIC));
+    fileThread = std::thread([this] { writeFile(); });
+}
+
+CaptureWriter::~CaptureWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    bufferFilled.notify_one();
+    fileThread.join();
+}
+
+std::uint32_t CaptureWriter::newConnectionId() noexcept
+{
+    return ++lastConnectionId;
+}
+
+void CaptureWriter::write(std::uint32_t connectionId, CaptureRecord::Direction direction, const BinaryMessage &message)
+{
+    using namespace std::chrono;
+    const std::uint64_t now = duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+    write(CaptureRecord{now, connectionId, direction, message});
+}
+
+void CaptureWriter::write(const CaptureRecord &record)
+{
+    const auto size = static_cast<BinaryMessage::SizeType>(record.message.value.size());
+    char header[RECORD_HEADER_SIZE];
+    char* end = putLittleEndian(header, record.timestampNs);
+    end = putLittleEndian(end, record.connectionId);
+    *end++ = static_cast<char>(record.direction);
+    putLittleEndian(end, size);
+
+    bool filled;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (buffer.size() + sizeof(header) + size > MAX_PENDING_BUFFERS * bufferSize)
+        {
+            ++droppedRecordCount;
+            return;
+        }
+        buffer.insert(buffer.end(), std::begin(header), std::end(header));
+        const char* bytes = reinterpret_cast<const char*>(record.message.value.data());
+        buffer.insert(buffer.end(), bytes, bytes + size);
+        ++recordCount;
+        filled = buffer.size() >= bufferSize;
+    }
+    if (filled)
+    {
+        bufferFilled.notify_one();
+    }
+}
+
+void CaptureWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    const std::uint64_t request = ++flushRequested;
+    bufferFilled.notify_one();
+    fileWritten.wait(lock, [this, request] { return flushDone >= request; });
+}
+
+std::uint64_t CaptureWriter::writtenCount() const noexcept
+{
+    return recordCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t CaptureWriter::droppedCount() const noexcept
+{
+    return droppedRecordCount.load(std::memory_order_relaxed);
+}
+
+void CaptureWriter::writeFile()
+{
+    std::vector<char> written;
+    written.reserve(bufferSize);
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        bufferFilled.wait_for(lock, flushPeriod, [this]
+        {
+            return stopping or flushRequested != flushDone or buffer.size() >= bufferSize;
+        });
+        const bool lastWrite = stopping;
+        const std::uint64_t request = flushRequested;
+        buffer.swap(written);
+        // callers append to the other buffer meanwhile - file is written outside of the mutex
+        lock.unlock();
+        file.write(written.data(), written.size());
+        file.flush();
+        written.clear();
+        lock.lock();
+        flushDone = request;
+        fileWritten.notify_all();
+        if (lastWrite)
+        {
+            return;
+        }
+    }
+}
+
+CaptureReader::CaptureReader(const std::string &path)
+    : file(path, std::ios::binary)
+{
+    char magic[sizeof(MAGIC)];
+    if (not file.read(magic, sizeof(magic)) or std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw std::runtime_error("Not a capture file: " + path);
+    }
+}
+
+bool CaptureReader::read(CaptureRecord &record)
+{
+    char header[RECORD_HEADER_SIZE];
+    if (not file.read(header, sizeof(header)))
+    {
+        if (file.gcount() == 0)
+        {
+            return false;
+        }
+        throw std::runtime_error("Truncated capture record header");
+    }
+    const char* input = getLittleEndian(header, record.timestampNs);
+    input = getLittleEndian(input, record.connectionId);
+    record.direction = static_cast<CaptureRecord::Direction>(*input++);
+    BinaryMessage::SizeType size;
+    getLittleEndian(input, size);
+
+    if (size > BinaryMessage::MAX_SIZE)
+    {
+        throw std::runtime_error("Capture record too big: " + std::to_string(size));
+    }
+    record.message = BinaryMessage{BinaryMessage::Value(size)};
+    if (not file.read(reinterpret_cast<char*>(record.message.value.data()), size))
+    {
+        throw std::runtime_error("Truncated capture record");
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Messages/BinaryMessage.hpp"
+
+namespace common
+{
+
+/**
+ * Frame capture file: "STHCAP01" followed by records, all numbers little endian:
+ *     u64 timestamp (ns since epoch), u32 connection id, u8 direction, u16 size, size bytes of frame
+ */
+struct CaptureRecord
+{
+    enum class Direction : std::uint8_t
+    {
+        Received,
+        Sent
+    };
+
+    std::uint64_t timestampNs;
+    std::uint32_t connectionId;
+    Direction direction;
+    BinaryMessage message;
+};
+
+/**
+ * Thread safe buffered writer - callers only append to the buffer, own thread writes it to the file
+ * every flush period or as soon as it fills up, so at most one period of records is lost when process is killed.
+ * When the file cannot keep up, records beyond MAX_PENDING_BUFFERS of data waiting for it are dropped.
+ */
+class CaptureWriter
+{
+public:
+    static constexpr std::size_t DEFAULT_BUFFER_SIZE = 1u << 16;
+    static constexpr std::size_t MAX_PENDING_BUFFERS = 16u;
+    static constexpr std::chrono::milliseconds DEFAULT_FLUSH_PERIOD{200};
+
+    /** @throw std::runtime_error when file cannot be created */
+    explicit CaptureWriter(const std::string& path, std::size_t bufferSize = DEFAULT_BUFFER_SIZE,
+                           std::chrono::milliseconds flushPeriod = DEFAULT_FLUSH_PERIOD);
+    ~CaptureWriter();
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    std::uint32_t newConnectionId() noexcept;
+    void write(std::uint32_t connectionId, CaptureRecord::Direction direction, const BinaryMessage& message);
+    void write(const CaptureRecord& record);
+    /**
+     * Returns when everything written before is in the file
+     */
+    void flush();
+
+    std::uint64_t writtenCount() const noexcept;
+    std::uint64_t droppedCount() const noexcept;
+
+private:
+    void writeFile();
+
+    std::mutex mutex;
+    std::condition_variable bufferFilled;
+    std::condition_variable fileWritten;
+    // appended by callers, swapped out by file thread
+    std::vector<char> buffer;
+    bool stopping = false;
+    std::uint64_t flushRequested = 0u;
+    std::uint64_t flushDone = 0u;
+
+    std::ofstream file;
+    const std::size_t bufferSize;
+    const std::chrono::milliseconds flushPeriod;
+    std::atomic<std::uint32_t> lastConnectionId{0};
+    std::atomic<std::uint64_t> recordCount{0};
+    std::atomic<std::uint64_t> droppedRecordCount{0};
+    std::thread fileThread;
+};
+
+class CaptureReader
+{
+public:
+    /** @throw std::runtime_error when file cannot be opened or is not a capture */
+    explicit CaptureReader(const std::string& path);
+
+    /**
+     * @return false at the end of file
+     * @throw std::runtime_error for truncated record
+     */
+    bool read(CaptureRecord& record);
+
+private:
+    std::ifstream file;
+};
+
+}
@@ -0,0 +1,325 @@
+#include "FlightRecorder.hpp"
+#include "Messages/MessageId.hpp"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace common
+{
+
+namespace
+{
+
+std::size_t roundUpToPowerOf2(std::size_t value)
+{
+    std::size_t result = 1u;
+    while (result < value)
+    {
+        result <<= 1u;
+    }
+    return result;
+}
+
+std::uint64_t nowNs() noexcept
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+const char* eventTypeName(FlightRecorder::EventType type) noexcept
+{
+    switch (type)
+    {
+    case FlightRecorder::EventType::FrameReceived: return "rx";
+    case FlightRecorder::EventType::FrameSent: return "tx";
+    case FlightRecorder::EventType::Attach: return "attach";
+    case FlightRecorder::EventType::Detach: return "detach";
+    case FlightRecorder::EventType::StateChange: return "state";
+    case FlightRecorder::EventType::TimerStart: return "timer-start";
+    case FlightRecorder::EventType::TimerStop: return "timer-stop";
+    }
+    return "?";
+}
+
+const char* messageIdName(std::uint8_t messageId) noexcept
+{
+#define MESSAGE_ID_NAME(X) #X,
+    static const char* const names[] = { FOR_ALL_MESSAGE_IDS(MESSAGE_ID_NAME) };
+#undef MESSAGE_ID_NAME
+    return messageId < sizeof(names) / sizeof(names[0]) ? names[messageId] : "Unknown";
+}
+
+// async-signal-safe replacement of snprintf for the few formats needed here
+class LineWriter
+{
+public:
+    LineWriter(char* buffer, std::size_t size) : buffer(buffer), size(size) {}
+
+    LineWriter& text(const char* value) noexcept
+    {
+        while (value && *value && length < size)
+        {
+            buffer[length++] = *value++;
+        }
+        return *this;
+    }
+    LineWriter& number(std::uint64_t value, std::size_t minDigits = 1u) noexcept
+    {
+        char digits[20];
+        std::size_t count = 0u;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + value % 10u);
+            value /= 10u;
+        } while (value != 0u && count < sizeof(digits));
+        while (count < minDigits && count < sizeof(digits))
+        {
+            digits[count++] = '0';
+        }
+        while (count > 0u && length < size)
+        {
+            buffer[length++] = digits[--count];
+        }
+        return *this;
+    }
+    std::size_t done() const noexcept { return length; }
+
+private:
+    char* buffer;
+    std::size_t size;
+    std::size_t length = 0u;
+};
+
+constexpr std::size_t LINE_SIZE = 160u;
+
+const std::size_t MAX_DUMP_PATH = 512u;
+char dumpPath[MAX_DUMP_PATH] = {};
+
+}
+
+FlightRecorder::FlightRecorder(std::size_t capacity)
+    : mask(roundUpToPowerOf2(capacity == 0u ? 1u : capacity) - 1u),
+      slots(std::make_unique<Slot[]>(mask + 1u))
+{}
+
+FlightRecorder& FlightRecorder::instance()
+{
+    static FlightRecorder recorder;
+    return recorder;
+}
+
+void FlightRecorder::recordFrameReceived(const BinaryMessage &message) noexcept
+{
+    recordFrame(EventType::FrameReceived, message);
+}
+
+void FlightRecorder::recordFrameSent(const BinaryMessage &message) noexcept
+{
+    recordFrame(EventType::FrameSent, message);
+}
+
+void FlightRecorder::recordAttach(PhoneNumber phoneNumber) noexcept
+{
+    record(EventType::Attach, 0u, phoneNumber.value, 0u, 0u, nullptr);
+}
+
+void FlightRecorder::recordDetach(PhoneNumber phoneNumber) noexcept
+{
+    record(EventType::Detach, 0u, phoneNumber.value, 0u, 0u, nullptr);
+}
+
+void FlightRecorder::recordStateChange(const char *stateName) noexcept
+{
+    record(EventType::StateChange, 0u, 0u, 0u, 0u, stateName);
+}
+
+void FlightRecorder::recordTimerStart(std::chrono::milliseconds duration) noexcept
+{
+    record(EventType::TimerStart, 0u, 0u, 0u, static_cast<std::uint32_t>(duration.count()), nullptr);
+}
+
+void FlightRecorder::recordTimerStop() noexcept
+{
+    record(EventType::TimerStop, 0u, 0u, 0u, 0u, nullptr);
+}
+
+std::uint64_t FlightRecorder::recordedCount() const noexcept
+{
+    return head.load(std::memory_order_relaxed);
+}
+
+void FlightRecorder::recordFrame(EventType type, const BinaryMessage &message) noexcept
+{
+    // header is: MessageId, from, to - each one byte - peek it without full decoding
+    const auto& value = message.value;
+    const std::size_t size = value.size();
+    record(type,
+           size > 0u ? value[0] : 0u,
+           size > 1u ? value[1] : 0u,
+           size > 2u ? value[2] : 0u,
+           static_cast<std::uint32_t>(size),
+           nullptr);
+}
+
+void FlightRecorder::record(EventType type, std::uint8_t messageId, std::uint8_t from, std::uint8_t to,
+                            std::uint32_t value, const char *label) noexcept
+{
+    const std::uint64_t index = head.fetch_add(1u, std::memory_order_relaxed);
+    Slot& slot = slots[index & mask];
+
+    // per-slot seqlock: 0 means "being written", index + 1 means "holds event #index"
+    slot.sequence.store(0u, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timestamp.store(nowNs(), std::memory_order_relaxed);
+    slot.packed.store((std::uint64_t(type) << 56u)
+                      | (std::uint64_t(messageId) << 48u)
+                      | (std::uint64_t(from) << 40u)
+                      | (std::uint64_t(to) << 32u)
+                      | value,
+                      std::memory_order_relaxed);
+    slot.label.store(label, std::memory_order_relaxed);
+    slot.sequence.store(index + 1u, std::memory_order_release);
+}
+
+bool FlightRecorder::read(std::uint64_t index, Event &event) const noexcept
+{
+    const Slot& slot = slots[index & mask];
+    if (slot.sequence.load(std::memory_order_acquire) != index + 1u)
+    {
+        return false;
+    }
+    event.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+    const std::uint64_t packed = slot.packed.load(std::memory_order_relaxed);
+    event.label = slot.label.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != index + 1u)
+    {
+        return false;
+    }
+    event.type = static_cast<EventType>(packed >> 56u);
+    event.messageId = static_cast<std::uint8_t>(packed >> 48u);
+    event.from = static_cast<std::uint8_t>(packed >> 40u);
+    event.to = static_cast<std::uint8_t>(packed >> 32u);
+    event.value = static_cast<std::uint32_t>(packed);
+    return true;
+}
+
+std::size_t FlightRecorder::formatEvent(const Event &event, char *buffer, std::size_t size) noexcept
+{
+    constexpr std::uint64_t NS_IN_S = 1000000000u;
+    LineWriter line(buffer, size);
+    line.number(event.timestamp / NS_IN_S).text(".").number(event.timestamp % NS_IN_S, 9u)
+        .text(" ").text(eventTypeName(event.type));
+
+    switch (event.type)
+    {
+    case EventType::FrameReceived:
+    case EventType::FrameSent:
+        line.text(" ").text(messageIdName(event.messageId))
+            .text(" from: ").number(event.from, PhoneNumber::DIGITS)
+            .text(" to: ").number(event.to, PhoneNumber::DIGITS)
+            .text(" size: ").number(event.value);
+        break;
+    case EventType::Attach:
+    case EventType::Detach:
+        line.text(" phone: ").number(event.from, PhoneNumber::DIGITS);
+        break;
+    case EventType::StateChange:
+        line.text(" ").text(event.label);
+        break;
+    case EventType::TimerStart:
+        line.text(" ").number(event.value).text("ms");
+        break;
+    case EventType::TimerStop:
+        break;
+    }
+    line.text("\n");
+    return line.done();
+}
+
+template <typename Output>
+void FlightRecorder::forEachLine(Output&& output) const
+{
+    const std::uint64_t end = head.load(std::memory_order_acquire);
+    const std::uint64_t begin = end > capacity() ? end - capacity() : 0u;
+    for (std::uint64_t index = begin; index < end; ++index)
+    {
+        Event event;
+        if (read(index, event))
+        {
+            char line[LINE_SIZE];
+            output(line, formatEvent(event, line, sizeof(line)));
+        }
+    }
+}
+
+void FlightRecorder::dump(int fileDescriptor) const noexcept
+{
+    forEachLine([fileDescriptor](const char* line, std::size_t length)
+    {
+        while (length > 0u)
+        {
+            auto written = ::write(fileDescriptor, line, length);
+            if (written <= 0)
+            {
+                return;
+            }
+            line += written;
+            length -= static_cast<std::size_t>(written);
+        }
+    });
+}
+
+void FlightRecorder::dump(std::ostream &os) const
+{
+    forEachLine([&os](const char* line, std::size_t length)
+    {
+        os.write(line, length);
+    });
+}
+
+bool FlightRecorder::dumpToFile(const std::string &path) const noexcept
+{
+    int fileDescriptor = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fileDescriptor < 0)
+    {
+        return false;
+    }
+    dump(fileDescriptor);
+    ::close(fileDescriptor);
+    return true;
+}
+
+void FlightRecorder::onDumpSignal(int) noexcept
+{
+    const int savedErrno = errno;
+    int fileDescriptor = ::open(dumpPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fileDescriptor >= 0)
+    {
+        instance().dump(fileDescriptor);
+        ::close(fileDescriptor);
+    }
+    errno = savedErrno;
+}
+
+void FlightRecorder::installDumpSignalHandler(const std::string &path, int signalNumber)
+{
+    if (path.length() >= MAX_DUMP_PATH)
+    {
+        throw std::invalid_argument("Flight recorder dump path too long: " + path);
+    }
+    // make sure the recorder exists before first signal arrives
+    instance();
+    std::strncpy(dumpPath, path.c_str(), MAX_DUMP_PATH - 1u);
+
+    struct sigaction action{};
+    action.sa_handler = &FlightRecorder::onDumpSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    ::sigaction(signalNumber, &action, nullptr);
+}
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "Messages/BinaryMessage.hpp"
+#include "Messages/PhoneNumber.hpp"
+
+namespace common
+{
+
+/**
+ * Fixed-size, lock-free ring of compact binary events.
+ * Recording is cheap enough to stay always on; only the last capacity() events are kept.
+ * Dumping does not stop the writers - events overwritten during the dump are skipped.
+ */
+class FlightRecorder
+{
+public:
+    enum class EventType : std::uint8_t
+    {
+        FrameReceived,
+        FrameSent,
+        Attach,
+        Detach,
+        StateChange,
+        TimerStart,
+        TimerStop
+    };
+
+    static constexpr std::size_t DEFAULT_CAPACITY = 1u << 14;
+
+    /**
+     * @param capacity rounded up to power of 2
+     */
+    explicit FlightRecorder(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * Process wide recorder - used by BTS and UE instrumentation
+     */
+    static FlightRecorder& instance();
+
+    void recordFrameReceived(const BinaryMessage& message) noexcept;
+    void recordFrameSent(const BinaryMessage& message) noexcept;
+    void recordAttach(PhoneNumber phoneNumber) noexcept;
+    void recordDetach(PhoneNumber phoneNumber) noexcept;
+    /**
+     * @param stateName must outlive the recorder - string literal
+     */
+    void recordStateChange(const char* stateName) noexcept;
+    void recordTimerStart(std::chrono::milliseconds duration) noexcept;
+    void recordTimerStop() noexcept;
+
+    std::size_t capacity() const noexcept { return mask + 1u; }
+    std::uint64_t recordedCount() const noexcept;
+
+    /**
+     * Async-signal-safe - one event per line, oldest first
+     */
+    void dump(int fileDescriptor) const noexcept;
+    void dump(std::ostream& os) const;
+    /**
+     * @return false when file cannot be created
+     */
+    bool dumpToFile(const std::string& path) const noexcept;
+
+    /**
+     * On given signal the process wide recorder is dumped to path (file is overwritten).
+     */
+    static void installDumpSignalHandler(const std::string& path, int signalNumber);
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<std::uint64_t> timestamp{0};
+        std::atomic<std::uint64_t> packed{0};
+        std::atomic<const char*> label{nullptr};
+    };
+    struct Event
+    {
+        std::uint64_t timestamp;
+        EventType type;
+        std::uint8_t messageId;
+        std::uint8_t from;
+        std::uint8_t to;
+        std::uint32_t value;
+        const char* label;
+    };
+
+    void record(EventType type, std::uint8_t messageId, std::uint8_t from, std::uint8_t to,
+                std::uint32_t value, const char* label) noexcept;
+    void recordFrame(EventType type, const BinaryMessage& message) noexcept;
+    bool read(std::uint64_t index, Event& event) const noexcept;
+
+    template <typename Output>
+    void forEachLine(Output&& output) const;
+
+    static std::size_t formatEvent(const Event& event, char* buffer, std::size_t size) noexcept;
+    static void onDumpSignal(int) noexcept;
+
+    const std::uint64_t mask;
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<std::uint64_t> head{0};
+};
+
+}
@@ -0,0 +1,156 @@
+#include "FrameTracer.hpp"
+#include "Messages/MessageId.hpp"
+#include <iomanip>
+
+namespace common
+{
+
+namespace
+{
+
+thread_local FrameTracer::Scope* currentScope = nullptr;
+
+const char* stageName(std::size_t stage) noexcept
+{
+    static const char* const names[FrameTracer::STAGE_COUNT] = {
+        "read", "received", "locked", "decoded", "routed", "enqueued", "written", "handled"
+    };
+    return stage < FrameTracer::STAGE_COUNT ? names[stage] : "?";
+}
+
+double toMicroseconds(std::uint64_t nanoseconds)
+{
+    return double(nanoseconds) / 1000.0;
+}
+
+}
+
+FrameTracer::Scope::Scope(Clock::time_point readAt, const BinaryMessage &message, FrameTracer &tracer) noexcept
+    : tracer(tracer.isEnabled() ? &tracer : nullptr),
+      outer(currentScope),
+      last(readAt)
+{
+    if (not this->tracer)
+    {
+        return;
+    }
+    // header is: MessageId, from, to - each one byte - peek it without full decoding
+    const auto& value = message.value;
+    trace.messageId = value.size() > 0u ? value[0] : 0u;
+    trace.from = value.size() > 1u ? value[1] : 0u;
+    trace.to = value.size() > 2u ? value[2] : 0u;
+    trace.marks[std::size_t(Stage::Read)] = readAt;
+    trace.marked = 1u << std::size_t(Stage::Read);
+    currentScope = this;
+    mark(Stage::Received);
+}
+
+FrameTracer::Scope::~Scope()
+{
+    if (tracer)
+    {
+        currentScope = outer;
+        tracer->finish(*this);
+    }
+}
+
+FrameTracer::FrameTracer(std::uint32_t sampling)
+    : sampling(sampling == 0u ? 1u : sampling)
+{}
+
+FrameTracer &FrameTracer::instance()
+{
+    static FrameTracer tracer;
+    return tracer;
+}
+
+void FrameTracer::mark(Stage stage) noexcept
+{
+    Scope* scope = currentScope;
+    const auto bit = std::uint16_t(1u << std::size_t(stage));
+    if (not scope or (scope->trace.marked & bit) != 0u)
+    {
+        return;
+    }
+    const Clock::time_point now = Clock::now();
+    scope->trace.marks[std::size_t(stage)] = now;
+    scope->trace.marked |= bit;
+    scope->tracer->stages[std::size_t(stage)].record(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - scope->last).count());
+    scope->last = now;
+}
+
+const Histogram &FrameTracer::stageLatency(Stage stage) const noexcept
+{
+    return stages[std::size_t(stage)];
+}
+
+void FrameTracer::finish(const Scope &scope) noexcept
+{
+    const auto& trace = scope.trace;
+    total.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     scope.last - trace.marks[std::size_t(Stage::Read)]).count());
+    if (frameCount.fetch_add(1u, std::memory_order_relaxed) % sampling == 0u)
+    {
+        std::lock_guard<std::mutex> lock(sampleMutex);
+        samples[sampleCount++ % SAMPLE_CAPACITY] = trace;
+    }
+}
+
+void FrameTracer::printSummary(std::ostream &os) const
+{
+    const auto flags = os.flags();
+    os << std::fixed << std::setprecision(1)
+       << "stage [us]      count      p50      p90      p99     p100\n";
+    auto printLine = [&os](const char* name, const Histogram& histogram)
+    {
+        os << std::left << std::setw(10) << name << std::right
+           << std::setw(11) << histogram.count()
+           << std::setw(9) << toMicroseconds(histogram.percentile(0.5))
+           << std::setw(9) << toMicroseconds(histogram.percentile(0.9))
+           << std::setw(9) << toMicroseconds(histogram.percentile(0.99))
+           << std::setw(9) << toMicroseconds(histogram.percentile(1.0)) << "\n";
+    };
+    for (std::size_t stage = std::size_t(Stage::Received); stage < STAGE_COUNT; ++stage)
+    {
+        printLine(stageName(stage), stages[stage]);
+    }
+    printLine("total", total);
+    os.flags(flags);
+}
+
+void FrameTracer::printSamples(std::ostream &os) const
+{
+    std::array<Trace, SAMPLE_CAPACITY> copy;
+    std::size_t count;
+    {
+        std::lock_guard<std::mutex> lock(sampleMutex);
+        copy = samples;
+        count = sampleCount;
+    }
+
+    const auto flags = os.flags();
+    os << std::fixed << std::setprecision(1);
+    const std::size_t first = count > SAMPLE_CAPACITY ? count - SAMPLE_CAPACITY : 0u;
+    for (std::size_t index = first; index < count; ++index)
+    {
+        const Trace& trace = copy[index % SAMPLE_CAPACITY];
+        os << to_string(MessageId(trace.messageId))
+           << " from: " << unsigned(trace.from)
+           << " to: " << unsigned(trace.to);
+        Clock::time_point previous = trace.marks[std::size_t(Stage::Read)];
+        for (std::size_t stage = std::size_t(Stage::Received); stage < STAGE_COUNT; ++stage)
+        {
+            if (trace.marked & (1u << stage))
+            {
+                os << " " << stageName(stage) << ": +" << toMicroseconds(
+                          std::chrono::duration_cast<std::chrono::nanoseconds>(trace.marks[stage] - previous).count());
+                previous = trace.marks[stage];
+            }
+        }
+        os << "\n";
+    }
+    os.flags(flags);
+}
+
+}
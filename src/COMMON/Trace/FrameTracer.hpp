@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include "Messages/BinaryMessage.hpp"
+#include "Metrics/Metrics.hpp"
+
+namespace common
+{
+
+/**
+ * Per stage latency of frames handled synchronously on one thread - from socket read to write of what it caused.
+ * Transport opens a Scope for each received frame, layers above mark stages they reach, latency from the previous
+ * mark goes to the stage histogram. Every Nth frame is also kept whole as a sample.
+ * Marks outside a Scope (e.g. SIB sent from timer) are ignored, so instrumented code does not care who calls it.
+ */
+class FrameTracer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Stage : std::uint8_t
+    {
+        Read,     // socket reported data
+        Received, // frame read from socket
+        Locked,   // application lock taken
+        Decoded,  // header decoded
+        Routed,   // destination found
+        Enqueued, // handed to destination transport
+        Written,  // written to destination socket
+        Handled   // application done with the frame
+    };
+    static constexpr std::size_t STAGE_COUNT = 8u;
+    static constexpr std::uint32_t DEFAULT_SAMPLING = 64u;
+    static constexpr std::size_t SAMPLE_CAPACITY = 32u;
+
+    struct Trace
+    {
+        std::uint8_t messageId = 0u;
+        std::uint8_t from = 0u;
+        std::uint8_t to = 0u;
+        std::uint16_t marked = 0u; // bit per Stage
+        std::array<Clock::time_point, STAGE_COUNT> marks{};
+    };
+
+    /**
+     * Traces frames on the current thread until destroyed - not copyable, keep it on the stack
+     */
+    class Scope
+    {
+    public:
+        /**
+         * @param readAt when socket reported data - frames read in one batch share it
+         */
+        Scope(Clock::time_point readAt, const BinaryMessage& message, FrameTracer& tracer = instance()) noexcept;
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        friend class FrameTracer;
+
+        FrameTracer* tracer;
+        Scope* outer;
+        Trace trace;
+        Clock::time_point last;
+    };
+
+    explicit FrameTracer(std::uint32_t sampling = DEFAULT_SAMPLING);
+
+    /**
+     * Process wide tracer - used by BTS transport and application
+     */
+    static FrameTracer& instance();
+
+    /**
+     * Only the first mark of each stage counts
+     */
+    static void mark(Stage stage) noexcept;
+
+    void setEnabled(bool value) noexcept { enabled.store(value, std::memory_order_relaxed); }
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Nanoseconds from previous mark to given stage
+     */
+    const Histogram& stageLatency(Stage stage) const noexcept;
+    const Histogram& totalLatency() const noexcept { return total; }
+
+    void printSummary(std::ostream& os) const;
+    void printSamples(std::ostream& os) const;
+
+private:
+    void finish(const Scope& scope) noexcept;
+
+    const std::uint32_t sampling;
+    std::atomic<bool> enabled{true};
+    std::atomic<std::uint64_t> frameCount{0u};
+    std::array<Histogram, STAGE_COUNT> stages;
+    Histogram total;
+
+    // only sampled frames take the mutex
+    mutable std::mutex sampleMutex;
+    std::array<Trace, SAMPLE_CAPACITY> samples{};
+    std::size_t sampleCount = 0u;
+};
+
+}
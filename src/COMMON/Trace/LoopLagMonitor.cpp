@@ -0,0 +1,175 @@
+#include "LoopLagMonitor.hpp"
+#include <iomanip>
+#include "Logger/LogLimit.hpp"
+
+namespace common
+{
+
+namespace
+{
+
+double toMilliseconds(std::uint64_t nanoseconds)
+{
+    return double(nanoseconds) / 1e6;
+}
+
+std::uint64_t toNanoseconds(IClock::Duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+}
+
+LoopLagMonitor::Wakeup::Wakeup(LoopLagMonitor &monitor) noexcept
+    : monitor(monitor),
+      startedAt(Clock::now())
+{}
+
+LoopLagMonitor::Wakeup::~Wakeup()
+{
+    monitor.callbackHistogram.record(toNanoseconds(Clock::now() - startedAt));
+    monitor.framesHistogram.record(frames);
+}
+
+LoopLagMonitor &LoopLagMonitor::instance()
+{
+    static LoopLagMonitor monitor;
+    return monitor;
+}
+
+void LoopLagMonitor::start(IClock &timerClock, Post newPost, ILogger &newLogger)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running)
+    {
+        logger->logError("attempt to restart!");
+        return;
+    }
+    clock = &timerClock;
+    post = std::move(newPost);
+    logger = std::make_unique<PrefixedLogger>(newLogger, "[LOOP]");
+    running = true;
+    probePostedAt.reset();
+    logger->logDebug("started - period: ", period.count(), "ms, warn above: ", warnThreshold.count(), "ms");
+    probeTimer = clock->scheduleAfter(period, [this] { onTimer(); });
+}
+
+void LoopLagMonitor::stop()
+{
+    std::optional<IClock::TimerId> lastTimer;
+    IClock* lastClock;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (not running)
+        {
+            return;
+        }
+        running = false;
+        // probe still queued to the loop finds nothing to measure
+        probePostedAt.reset();
+        lastTimer = probeTimer;
+        probeTimer.reset();
+        lastClock = clock;
+        logger->logDebug("finished");
+    }
+    // not under mutex - cancel waits for the timer being run, and that timer needs the mutex to finish
+    if (lastTimer)
+    {
+        lastClock->cancel(*lastTimer);
+    }
+}
+
+void LoopLagMonitor::reconfigure(std::chrono::milliseconds newPeriod, std::chrono::milliseconds newWarnThreshold)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (newPeriod <= std::chrono::milliseconds::zero())
+    {
+        newPeriod = DEFAULT_PERIOD;
+    }
+    if (logger and (newPeriod != period or newWarnThreshold != warnThreshold))
+    {
+        logger->logInfo("reconfigured: period: ", newPeriod.count(), "ms, warn above: ", newWarnThreshold.count(), "ms");
+    }
+    period = newPeriod;
+    warnThreshold = newWarnThreshold;
+}
+
+void LoopLagMonitor::scheduleProbe()
+{
+    if (running)
+    {
+        probeTimer = clock->scheduleAfter(period, [this] { onTimer(); });
+    }
+}
+
+void LoopLagMonitor::onTimer()
+{
+    Post postProbe;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (not running)
+        {
+            return;
+        }
+        const auto now = clock->now();
+        if (not probePostedAt)
+        {
+            probePostedAt = now;
+            stallReported = false;
+            postProbe = post;
+        }
+        else if (not stallReported and now - *probePostedAt > warnThreshold)
+        {
+            stallReported = true;
+            stalls.fetch_add(1u, std::memory_order_relaxed);
+            static LogLimit logLimit = LogLimit::rateLimited();
+            logger->logError(logLimit, "Event loop stalled for: ", toMilliseconds(toNanoseconds(now - *probePostedAt)), "ms");
+        }
+        scheduleProbe();
+    }
+    // not under mutex - post may wake the loop, and the loop may be just running the previous probe
+    if (postProbe)
+    {
+        postProbe([this] { onProbe(); });
+    }
+}
+
+void LoopLagMonitor::onProbe()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not probePostedAt)
+    {
+        return;
+    }
+    const auto lag = clock->now() - *probePostedAt;
+    probePostedAt.reset();
+    lagHistogram.record(toNanoseconds(lag));
+    if (lag > warnThreshold)
+    {
+        static LogLimit logLimit = LogLimit::rateLimited();
+        logger->logError(logLimit, "Event loop lag: ", toMilliseconds(toNanoseconds(lag)), "ms");
+    }
+}
+
+void LoopLagMonitor::print(std::ostream &os) const
+{
+    const auto flags = os.flags();
+    os << std::fixed << std::setprecision(3)
+       << "loop [ms]            count      p50      p90      p99     p100\n";
+    auto printLine = [&os](const char* name, const Histogram& histogram, double scale)
+    {
+        os << std::left << std::setw(16) << name << std::right
+           << std::setw(10) << histogram.count()
+           << std::setw(9) << double(histogram.percentile(0.5)) * scale
+           << std::setw(9) << double(histogram.percentile(0.9)) * scale
+           << std::setw(9) << double(histogram.percentile(0.99)) * scale
+           << std::setw(9) << double(histogram.percentile(1.0)) * scale << "\n";
+    };
+    printLine("lag", lagHistogram, 1e-6);
+    printLine("callback", callbackHistogram, 1e-6);
+    printLine("frames/wakeup", framesHistogram, 1.0);
+    os << "stalls: " << stallCount() << "\n";
+    os.flags(flags);
+}
+
+}
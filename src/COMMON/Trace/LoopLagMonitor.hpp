@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include "Logger/PrefixedLogger.hpp"
+#include "Metrics/Metrics.hpp"
+#include "Time/IClock.hpp"
+
+namespace common
+{
+
+/**
+ * Saturation signal of an event loop that does all the work of a process.
+ * Every period a probe is posted to the loop from a timer running outside of it - how late the probe runs
+ * is the scheduling delay (lag) of any event queued at that moment. When the probe is still not run on the next
+ * timer tick the loop is stalled right now, this is reported without waiting for the loop to recover.
+ * Socket callbacks run on the loop are measured with Wakeup: time spent and frames handled per wakeup.
+ */
+class LoopLagMonitor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    /**
+     * Queues callback to the monitored loop - callable from any thread, shall not call the callback inline
+     */
+    using Post = std::function<void(std::function<void()>)>;
+
+    static constexpr std::chrono::milliseconds DEFAULT_PERIOD{100};
+    static constexpr std::chrono::milliseconds DEFAULT_WARN_THRESHOLD{50};
+
+    /**
+     * Measures one callback on the loop until destroyed - keep it on the stack
+     */
+    class Wakeup
+    {
+    public:
+        explicit Wakeup(LoopLagMonitor& monitor = instance()) noexcept;
+        ~Wakeup();
+        Wakeup(const Wakeup&) = delete;
+        Wakeup& operator=(const Wakeup&) = delete;
+
+        void frame() noexcept { ++frames; }
+
+    private:
+        LoopLagMonitor& monitor;
+        Clock::time_point startedAt;
+        std::uint64_t frames = 0u;
+    };
+
+    LoopLagMonitor() = default;
+    LoopLagMonitor(const LoopLagMonitor&) = delete;
+    LoopLagMonitor& operator=(const LoopLagMonitor&) = delete;
+
+    /**
+     * Process wide monitor - one event loop per process
+     */
+    static LoopLagMonitor& instance();
+
+    /**
+     * @param timerClock shall not call back on the monitored loop - stalls would not be seen
+     * Probes posted and not run yet when the monitor is destroyed shall never run.
+     */
+    void start(IClock& timerClock, Post post, ILogger& logger);
+    void stop();
+    /**
+     * Safe to call while running - takes effect from next probe
+     */
+    void reconfigure(std::chrono::milliseconds period, std::chrono::milliseconds warnThreshold);
+
+    /**
+     * Nanoseconds from posting a probe to running it
+     */
+    const Histogram& lag() const noexcept { return lagHistogram; }
+    /**
+     * Nanoseconds spent in one Wakeup
+     */
+    const Histogram& callbackTime() const noexcept { return callbackHistogram; }
+    const Histogram& framesPerWakeup() const noexcept { return framesHistogram; }
+    std::uint64_t stallCount() const noexcept { return stalls.load(std::memory_order_relaxed); }
+
+    void print(std::ostream& os) const;
+
+private:
+    void scheduleProbe();
+    void onTimer();
+    void onProbe();
+
+    Histogram lagHistogram;
+    Histogram callbackHistogram;
+    Histogram framesHistogram;
+    std::atomic<std::uint64_t> stalls{0u};
+
+    mutable std::mutex mutex;
+    IClock* clock = nullptr;
+    Post post;
+    std::unique_ptr<PrefixedLogger> logger;
+    std::chrono::milliseconds period = DEFAULT_PERIOD;
+    std::chrono::milliseconds warnThreshold = DEFAULT_WARN_THRESHOLD;
+    bool running = false;
+    std::optional<IClock::TimerId> probeTimer;
+    // one probe in flight at most - the rest of them would only queue behind it
+    std::optional<IClock::TimePoint> probePostedAt;
+    bool stallReported = false;
+};
+
+}
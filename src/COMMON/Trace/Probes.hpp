@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * USDT static tracepoints of provider "sth" - a nop instruction plus ELF note when sys/sdt.h is available,
+ * nothing at all otherwise (or when built with -DSTH_NO_PROBES). List them with:
+ *     bpftrace -l 'usdt:./BTS:sth:*'
+ * Probes and their arguments:
+ *     frame_received, frame_sent   connection id, MessageId, from, to, size
+ *     ue_attach, ue_detach         connection id, phone
+ *     sync_wait, sync_acquired, sync_release   guard address
+ *     sib_sent                     connection id, BTS id
+ *     ue_state                     phone, state name (string)
+ * Connection id is the address of the connection object (IUeConnection in BTS, BtsPort in UE) - stable for
+ * connection lifetime.
+ * Arguments are evaluated only when probes are compiled in - keep them cheap.
+ */
+
+#if defined(__has_include) && not defined(STH_NO_PROBES)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define STH_PROBES_ENABLED 1
+#endif
+#endif
+
+#include <cstdint>
+#include "Messages/BinaryMessage.hpp"
+
+namespace common
+{
+
+/**
+ * Frame header peeked without decoding - MessageId, from, to are the first bytes
+ */
+struct ProbeFrame
+{
+    explicit ProbeFrame(const BinaryMessage& message) noexcept
+        : messageId(message.value.size() > 0u ? message.value[0] : 0u),
+          from(message.value.size() > 1u ? message.value[1] : 0u),
+          to(message.value.size() > 2u ? message.value[2] : 0u),
+          size(static_cast<std::uint32_t>(message.value.size()))
+    {}
+
+    std::uint8_t messageId;
+    std::uint8_t from;
+    std::uint8_t to;
+    std::uint32_t size;
+};
+
+inline std::uintptr_t probeId(const void* object) noexcept
+{
+    return reinterpret_cast<std::uintptr_t>(object);
+}
+
+}
+
+#ifdef STH_PROBES_ENABLED
+#define STH_PROBE(name, ...) STAP_PROBEV(sth, name, ##__VA_ARGS__)
+#define STH_PROBE_FRAME(name, connection, message)                                            \
+    do                                                                                        \
+    {                                                                                         \
+        const ::common::ProbeFrame probeFrame(message);                                       \
+        STH_PROBE(name, ::common::probeId(connection), probeFrame.messageId, probeFrame.from, \
+                  probeFrame.to, probeFrame.size);                                            \
+    } while (false)
+#else
+#define STH_PROBE(name, ...) ((void)0)
+#define STH_PROBE_FRAME(name, connection, message) ((void)0)
+#endif
@@ -2,7 +2,8 @@
 
 #include <type_traits>
 #include <utility>
-#include <stdexcept>
+#include <array>
+#include <cstddef>
 
 namespace common
 {
@@ -28,65 +29,197 @@ template <typename Enum, Enum Current>
 struct EnumNext : std::integral_constant<Enum, enumValue<Enum>(enumUnderlyingValue(Current) + 1)>
 {};
 
-template <typename Enum, Enum First = EnumFirst<Enum>::value, Enum Last = EnumLast<Enum>::value>
-class EnumRange;
+namespace detail
+{
 
-template <typename Enum, Enum Value>
-class EnumRange<Enum, Value, Value>
+// contiguous enums (EnumNext not specialized) are handled without recursion,
+// for others values are collected once by walking EnumNext chain
+constexpr std::size_t MAX_CONTIGUOUS_ENUM_SPAN = 1024u;
+
+template <typename Enum, Enum First, Enum Last>
+constexpr std::size_t enumSpan()
 {
-public:
-    template <template <Enum> class Functor, typename ...Args>
-    static constexpr decltype(auto) forEach(Args&& ...args);
-    template <template <Enum> class Functor, typename ...Args>
-    static /*constexpr*/ decltype(auto) forOne(Enum theOne, Args&& ...args);
-    static constexpr std::size_t size() { return 1u; }
-};
+    return enumUnderlyingValue(First) <= enumUnderlyingValue(Last)
+            ? std::size_t(enumUnderlyingValue(Last) - enumUnderlyingValue(First)) + 1u
+            : 0u;
+}
+
+template <typename Enum, Enum First, std::size_t Index>
+inline constexpr Enum contiguousEnumAt = enumValue<Enum>(enumUnderlyingValue(First) + Index);
+
+template <typename Enum, Enum First, std::size_t ...Index>
+constexpr bool followsEnumNext(std::index_sequence<Index...>)
+{
+    return ((EnumNext<Enum, contiguousEnumAt<Enum, First, Index>>::value == contiguousEnumAt<Enum, First, Index + 1u>) && ...);
+}
 
 template <typename Enum, Enum First, Enum Last>
+constexpr bool isContiguousEnum()
+{
+    constexpr std::size_t span = enumSpan<Enum, First, Last>();
+    if constexpr (span == 0u or span > MAX_CONTIGUOUS_ENUM_SPAN)
+    {
+        return false;
+    }
+    else
+    {
+        return followsEnumNext<Enum, First>(std::make_index_sequence<span - 1u>{});
+    }
+}
+
+template <typename Enum, Enum Current, Enum Last>
+constexpr std::size_t walkEnumSize()
+{
+    if constexpr (Current == Last)
+    {
+        return 1u;
+    }
+    else
+    {
+        return 1u + walkEnumSize<Enum, EnumNext<Enum, Current>::value, Last>();
+    }
+}
+
+template <typename Enum, Enum Current, Enum Last, std::size_t Size>
+constexpr void walkEnumValues(std::array<Enum, Size>& values, std::size_t index)
+{
+    values[index] = Current;
+    if constexpr (Current != Last)
+    {
+        walkEnumValues<Enum, EnumNext<Enum, Current>::value, Last>(values, index + 1u);
+    }
+}
+
+template <typename Enum, Enum First, Enum Last>
+struct EnumValues
+{
+    static constexpr bool contiguous = isContiguousEnum<Enum, First, Last>();
+
+    static constexpr std::size_t size()
+    {
+        if constexpr (contiguous)
+        {
+            return enumSpan<Enum, First, Last>();
+        }
+        else
+        {
+            return walkEnumSize<Enum, First, Last>();
+        }
+    }
+
+    static constexpr std::array<Enum, size()> make()
+    {
+        std::array<Enum, size()> result{};
+        if constexpr (contiguous)
+        {
+            for (std::size_t index = 0u; index < result.size(); ++index)
+            {
+                result[index] = enumValue<Enum>(enumUnderlyingValue(First) + index);
+            }
+        }
+        else
+        {
+            walkEnumValues<Enum, First, Last>(result, 0u);
+        }
+        return result;
+    }
+
+    static constexpr std::array<Enum, size()> values = make();
+};
+
+}
+
+/**
+ * Compile time iteration over enum values: [First, Last] following EnumNext.
+ * Functor<Value>{}(args...) is called for each value (forEach) or for one selected at run time (forOne).
+ */
+template <typename Enum, Enum First = EnumFirst<Enum>::value, Enum Last = EnumLast<Enum>::value>
 class EnumRange
 {
+    using Values = detail::EnumValues<Enum, First, Last>;
+
 public:
     template <template <Enum> class Functor, typename ...Args>
     static constexpr decltype(auto) forEach(Args&& ...args);
+    /**
+     * Single indexed jump for contiguous enums.
+     * For value out of range nothing is called and default constructed result is returned.
+     */
     template <template <Enum> class Functor, typename ...Args>
     static constexpr decltype(auto) forOne(Enum theOne, Args&& ...args);
-    static constexpr std::size_t size() { return ForFirst::size() + ForSecondToLast::size(); }
+
+    static constexpr bool contains(Enum value) { return indexOf(value) < size(); }
+    static constexpr std::size_t size() { return Values::size(); }
+
 private:
-    using ForFirst = EnumRange<Enum, First, First>;
-    using ForSecondToLast = EnumRange<Enum, EnumNext<Enum, First>::value, Last>;
-};
+    static constexpr std::size_t indexOf(Enum value);
 
-template <typename Enum, Enum Value>
-template <template <Enum> class Functor, typename ...Args>
-constexpr decltype(auto) EnumRange<Enum, Value, Value>::forEach(Args&& ...args)
-{
-    return Functor<Value>{}(std::forward<Args>(args)...);
-};
+    template <template <Enum> class Functor, typename ...Args>
+    using Result = decltype(Functor<First>{}(std::declval<Args>()...));
 
-template <typename Enum, Enum Value>
-template <template <Enum> class Functor, typename ...Args>
-/*constexpr*/ decltype(auto) EnumRange<Enum, Value, Value>::forOne(Enum theOne, Args&& ...args)
-{
-    return (Value == theOne) ? EnumRange<Enum, Value, Value>::template forEach<Functor>(std::forward<Args>(args)...)
-                             : throw std::out_of_range(std::to_string(enumUnderlyingValue(theOne))
-                                                       + "!="
-                                                       +  std::to_string(enumUnderlyingValue(Value)));
+    template <template <Enum> class Functor, Enum Value, typename ...Args>
+    static constexpr Result<Functor, Args...> call(Args&& ...args)
+    {
+        return Functor<Value>{}(std::forward<Args>(args)...);
+    }
+
+    template <template <Enum> class Functor, typename ...Args, std::size_t ...Index>
+    static constexpr decltype(auto) forEachImpl(std::index_sequence<Index...>, Args&& ...args)
+    {
+        return (Functor<Values::values[Index]>{}(std::forward<Args>(args)...), ...);
+    }
+
+    template <template <Enum> class Functor, typename ...Args, std::size_t ...Index>
+    static constexpr auto makeTable(std::index_sequence<Index...>)
+    {
+        using Function = Result<Functor, Args...> (*)(Args&&...);
+        return std::array<Function, sizeof...(Index)>{ &call<Functor, Values::values[Index], Args...>... };
+    }
+
+    template <template <Enum> class Functor, typename ...Args>
+    static constexpr auto table = makeTable<Functor, Args...>(std::make_index_sequence<size()>{});
 };
 
 template <typename Enum, Enum First, Enum Last>
 template <template <Enum> class Functor, typename ...Args>
 constexpr decltype(auto) EnumRange<Enum, First, Last>::forEach(Args&& ...args)
 {
-    return ForFirst::template forEach<Functor>(std::forward<Args>(args)...),
-           ForSecondToLast::template forEach<Functor>(std::forward<Args>(args)...);
-};
+    return forEachImpl<Functor>(std::make_index_sequence<size()>{}, std::forward<Args>(args)...);
+}
 
 template <typename Enum, Enum First, Enum Last>
 template <template <Enum> class Functor, typename ...Args>
 constexpr decltype(auto) EnumRange<Enum, First, Last>::forOne(Enum theOne, Args&& ...args)
 {
-    return (First == theOne) ? ForFirst::template forEach<Functor>(std::forward<Args>(args)...)
-                             : ForSecondToLast::template forOne<Functor>(theOne, std::forward<Args>(args)...);
-};
+    using R = Result<Functor, Args...>;
+    static_assert(std::is_void_v<R> or std::is_default_constructible_v<R>,
+                  "forOne result must be void or default constructible - it is returned for values out of range");
+
+    const std::size_t index = indexOf(theOne);
+    if (index >= size())
+    {
+        return R();
+    }
+    return table<Functor, Args...>[index](std::forward<Args>(args)...);
+}
+
+template <typename Enum, Enum First, Enum Last>
+constexpr std::size_t EnumRange<Enum, First, Last>::indexOf(Enum value)
+{
+    if constexpr (Values::contiguous)
+    {
+        // unsigned wrap-around makes values below First out of range too
+        return std::size_t(enumUnderlyingValue(value)) - std::size_t(enumUnderlyingValue(First));
+    }
+    else
+    {
+        std::size_t index = 0u;
+        while (index < size() and Values::values[index] != value)
+        {
+            ++index;
+        }
+        return index;
+    }
+}
 
 }
@@ -0,0 +1,452 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Config/MultiLineConfig.hpp"
+#include "Messages/IncomingMessage.hpp"
+#include "Messages/OutgoingMessage.hpp"
+#include "FrameSocket.hpp"
+
+/**
+ * End-to-end relay load test: N UE connections attach to BTS and exchange Sms/CallTalk at given total rate.
+ * Usage: LoadTest [bts=<BTS executable>] [bts_args="key=value ..."] [host=127.0.0.1] [port=8181]
+ *                 [ues=10] [rate=1000] [duration_ms=5000] [sms_percent=50] [size=32] [drain_ms=500]
+ *                 [sib_period_ms=<5000, 10 with bts=>]
+ * With bts= the BTS is started here (and stopped at the end) and its CPU time per message is reported - it is
+ * started with SIB sent every 10ms, bts_args may override that (then give sib_period_ms to match).
+ * All UEs connect first, then attach together - each one on the SIB it gets, SIBs go round robin to not attached
+ * UEs, so setup may take ues * sib_period_ms.
+ * Every payload starts with send timestamp - forward latency is measured on the receiving UE.
+ */
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+using common::BinaryMessage;
+using common::MessageId;
+using common::PhoneNumber;
+using tools::FrameSocket;
+
+constexpr std::size_t TIMESTAMP_SIZE = sizeof(std::uint64_t);
+constexpr std::size_t MAX_UE_COUNT = 255u; // one byte phone numbers, 0 is not allowed
+const std::chrono::seconds SETUP_TIMEOUT{5};
+// SIB cadence of BTS started here: sib_tick_ms * sib_ticks
+const std::chrono::milliseconds OWN_BTS_SIB_TICK{10};
+constexpr unsigned OWN_BTS_SIB_TICKS = 1u;
+const std::chrono::milliseconds DEFAULT_SIB_PERIOD{5000};
+
+struct Settings
+{
+    std::string btsExecutable;
+    std::string btsArguments;
+    std::string host;
+    std::uint16_t port;
+    std::size_t ueCount;
+    double rate;
+    std::chrono::milliseconds duration;
+    unsigned smsPercent;
+    std::size_t payloadSize;
+    std::chrono::milliseconds drainTime;
+    std::chrono::milliseconds sibPeriod;
+};
+
+Settings readSettings(const common::MultiLineConfig& configuration)
+{
+    Settings settings;
+    settings.btsExecutable = configuration.getString("bts", "");
+    settings.btsArguments = configuration.getString("bts_args", "");
+    settings.host = configuration.getString("host", "127.0.0.1");
+    settings.port = configuration.getNumber<std::uint16_t>("port", 8181);
+    settings.ueCount = configuration.getNumber<std::size_t>("ues", 10u);
+    settings.rate = std::stod(configuration.getString("rate", "1000"));
+    settings.duration = std::chrono::milliseconds(configuration.getNumber<unsigned>("duration_ms", 5000u));
+    settings.smsPercent = configuration.getNumber<unsigned>("sms_percent", 50u);
+    settings.payloadSize = configuration.getNumber<std::size_t>("size", 32u);
+    settings.drainTime = std::chrono::milliseconds(configuration.getNumber<unsigned>("drain_ms", 500u));
+    const auto sibPeriod = settings.btsExecutable.empty() ? DEFAULT_SIB_PERIOD : OWN_BTS_SIB_TICK * OWN_BTS_SIB_TICKS;
+    settings.sibPeriod = std::chrono::milliseconds(configuration.getNumber<unsigned>("sib_period_ms",
+                                                                                     unsigned(sibPeriod.count())));
+
+    if (settings.ueCount < 2u or settings.ueCount > MAX_UE_COUNT)
+    {
+        throw std::invalid_argument("ues shall be in range 2.." + std::to_string(MAX_UE_COUNT));
+    }
+    if (not (settings.rate > 0.0) or settings.smsPercent > 100u)
+    {
+        throw std::invalid_argument("rate shall be positive, sms_percent at most 100");
+    }
+    settings.payloadSize = std::max(settings.payloadSize, TIMESTAMP_SIZE);
+    return settings;
+}
+
+std::uint64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+/** BTS child process - console on stdin pipe, stopped with its quit command */
+class BtsProcess
+{
+public:
+    BtsProcess(const Settings& settings)
+    {
+        int stdinPipe[2];
+        if (::pipe(stdinPipe) != 0)
+        {
+            throw std::runtime_error("Cannot create pipe");
+        }
+        // extra arguments come last - later value of a key wins
+        std::vector<std::string> arguments{settings.btsExecutable, "port=" + std::to_string(settings.port),
+                                           "sib_tick_ms=" + std::to_string(OWN_BTS_SIB_TICK.count()),
+                                           "sib_ticks=" + std::to_string(OWN_BTS_SIB_TICKS)};
+        std::istringstream extraArguments(settings.btsArguments);
+        for (std::string argument; extraArguments >> argument; )
+        {
+            arguments.push_back(argument);
+        }
+
+        pid = ::fork();
+        if (pid < 0)
+        {
+            throw std::runtime_error("Cannot fork");
+        }
+        if (pid == 0)
+        {
+            ::dup2(stdinPipe[0], STDIN_FILENO);
+            ::close(stdinPipe[0]);
+            ::close(stdinPipe[1]);
+            std::freopen("/dev/null", "w", stdout);
+            std::vector<char*> argv;
+            for (auto& argument : arguments)
+            {
+                argv.push_back(argument.data());
+            }
+            argv.push_back(nullptr);
+            ::execv(argv[0], argv.data());
+            std::perror("execv");
+            ::_exit(127);
+        }
+        ::close(stdinPipe[0]);
+        console = stdinPipe[1];
+    }
+
+    ~BtsProcess()
+    {
+        const char quit[] = "q\n";
+        [[maybe_unused]] auto written = ::write(console, quit, sizeof(quit) - 1u);
+        ::close(console);
+        for (int i = 0; i < 50; ++i)
+        {
+            if (::waitpid(pid, nullptr, WNOHANG) == pid)
+            {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        ::kill(pid, SIGKILL);
+        ::waitpid(pid, nullptr, 0);
+    }
+
+    /** user + system time consumed so far */
+    std::chrono::microseconds cpuTime() const
+    {
+        std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+        std::string content((std::istreambuf_iterator<char>(stat)), std::istreambuf_iterator<char>());
+        // fields after process name (which may contain spaces): state is 3rd, utime 14th, stime 15th
+        std::istringstream fields(content.substr(content.rfind(')') + 2u));
+        std::string skip;
+        for (int field = 3; field < 14; ++field)
+        {
+            fields >> skip;
+        }
+        unsigned long long userTicks = 0u, systemTicks = 0u;
+        fields >> userTicks >> systemTicks;
+        const long ticksPerSecond = ::sysconf(_SC_CLK_TCK);
+        return std::chrono::microseconds((userTicks + systemTicks) * 1000000u / ticksPerSecond);
+    }
+
+private:
+    pid_t pid;
+    int console;
+};
+
+FrameSocket connectWithRetry(const Settings& settings)
+{
+    const auto deadline = Clock::now() + SETUP_TIMEOUT;
+    for (;;)
+    {
+        try
+        {
+            return FrameSocket::connect(settings.host, settings.port);
+        }
+        catch (std::runtime_error&)
+        {
+            if (Clock::now() > deadline)
+            {
+                throw;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    }
+}
+
+PhoneNumber phoneOf(std::size_t ueIndex)
+{
+    return PhoneNumber{static_cast<PhoneNumber::Value>(ueIndex + 1u)};
+}
+
+/** AttachRequest on SIB, checked AttachResponse - for all sockets at once, UE i gets phone i + 1 */
+void attachAll(std::vector<FrameSocket>& sockets, const Settings& settings)
+{
+    enum class State { WaitingForSib, WaitingForResponse, Attached };
+    std::vector<State> states(sockets.size(), State::WaitingForSib);
+    std::size_t attached = 0u;
+    // worst case: SIBs go round robin and every UE waits for all others
+    const auto deadline = Clock::now() + SETUP_TIMEOUT + settings.sibPeriod * sockets.size();
+
+    std::vector<pollfd> descriptors;
+    std::vector<BinaryMessage> messages;
+    while (attached < sockets.size())
+    {
+        if (Clock::now() > deadline)
+        {
+            throw std::runtime_error("Timeout attaching, attached: " + std::to_string(attached)
+                                     + " of " + std::to_string(sockets.size()));
+        }
+        descriptors.clear();
+        for (auto& socket : sockets)
+        {
+            descriptors.push_back(pollfd{socket.fileDescriptor(), POLLIN, 0});
+        }
+        if (::poll(descriptors.data(), descriptors.size(), 100) <= 0)
+        {
+            continue;
+        }
+        for (std::size_t i = 0u; i < sockets.size(); ++i)
+        {
+            if (descriptors[i].revents == 0)
+            {
+                continue;
+            }
+            messages.clear();
+            if (not sockets[i].receive(messages))
+            {
+                throw std::runtime_error("BTS closed connection during setup");
+            }
+            for (auto& message : messages)
+            {
+                common::IncomingMessage reader(message);
+                const auto header = reader.readMessageHeader();
+                if (header.messageId == MessageId::Sib and states[i] == State::WaitingForSib)
+                {
+                    common::OutgoingMessage attachRequest{MessageId::AttachRequest, phoneOf(i), PhoneNumber{}};
+                    attachRequest.writeBtsId(reader.readBtsId());
+                    sockets[i].send(attachRequest.getMessage());
+                    states[i] = State::WaitingForResponse;
+                }
+                else if (header.messageId == MessageId::AttachResponse and states[i] == State::WaitingForResponse)
+                {
+                    if (not reader.readNumber<bool>())
+                    {
+                        throw std::runtime_error("Attach rejected for: " + std::to_string(phoneOf(i).value));
+                    }
+                    states[i] = State::Attached;
+                    ++attached;
+                }
+            }
+        }
+    }
+}
+
+struct Statistics
+{
+    std::mutex mutex;
+    std::vector<std::uint64_t> latenciesNs;
+    std::size_t rejected = 0u;
+    // connections closed by BTS - not polled any more (POLLHUP would wake poll at once forever)
+    std::size_t closed = 0u;
+};
+
+void receiveAll(std::vector<FrameSocket>& sockets, std::vector<bool>& open, Statistics& statistics,
+                std::chrono::milliseconds timeout)
+{
+    std::vector<pollfd> descriptors;
+    std::vector<std::size_t> indexes;
+    for (std::size_t i = 0u; i < sockets.size(); ++i)
+    {
+        if (open[i])
+        {
+            descriptors.push_back(pollfd{sockets[i].fileDescriptor(), POLLIN, 0});
+            indexes.push_back(i);
+        }
+    }
+    // with nothing open it just waits the timeout
+    if (::poll(descriptors.data(), descriptors.size(), static_cast<int>(timeout.count())) <= 0)
+    {
+        return;
+    }
+    std::vector<BinaryMessage> messages;
+    std::size_t closedNow = 0u;
+    for (std::size_t d = 0u; d < descriptors.size(); ++d)
+    {
+        if (descriptors[d].revents != 0 and not sockets[indexes[d]].receive(messages))
+        {
+            open[indexes[d]] = false;
+            ++closedNow;
+        }
+    }
+    const std::uint64_t now = nowNs();
+    std::lock_guard<std::mutex> lock(statistics.mutex);
+    statistics.closed += closedNow;
+    for (auto& message : messages)
+    {
+        common::IncomingMessage reader(message);
+        auto header = reader.readMessageHeader();
+        if (header.messageId == MessageId::Sms or header.messageId == MessageId::CallTalk)
+        {
+            std::uint64_t sentNs = 0u;
+            const std::string timestamp = reader.readText(TIMESTAMP_SIZE);
+            std::copy(timestamp.begin(), timestamp.end(), reinterpret_cast<char*>(&sentNs));
+            statistics.latenciesNs.push_back(now - sentNs);
+        }
+        else if (header.messageId == MessageId::UnknownRecipient or header.messageId == MessageId::UnknownSender)
+        {
+            ++statistics.rejected;
+        }
+    }
+}
+
+BinaryMessage trafficMessage(MessageId messageId, PhoneNumber from, PhoneNumber to, std::size_t payloadSize)
+{
+    const std::uint64_t timestamp = nowNs();
+    std::string payload(payloadSize, 'x');
+    std::copy_n(reinterpret_cast<const char*>(&timestamp), TIMESTAMP_SIZE, payload.begin());
+    common::OutgoingMessage builder{messageId, from, to};
+    builder.writeText(payload);
+    return builder.getMessage();
+}
+
+void printReport(std::ostream& os, std::size_t sent, std::size_t failed, Clock::duration elapsed,
+                 Statistics& statistics, std::optional<std::chrono::microseconds> btsCpu)
+{
+    std::lock_guard<std::mutex> lock(statistics.mutex);
+    auto& latencies = statistics.latenciesNs;
+    std::sort(latencies.begin(), latencies.end());
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+
+    os << std::fixed << std::setprecision(1)
+       << "sent: " << sent << ", send failures: " << failed
+       << ", forwarded: " << latencies.size() << ", rejected: " << statistics.rejected
+       << ", lost: " << (sent - std::min(sent, latencies.size() + statistics.rejected))
+       << ", connections closed by BTS: " << statistics.closed << "\n"
+       << "elapsed: " << seconds * 1000.0 << "ms"
+       << ", sent/s: " << sent / seconds
+       << ", forwarded/s: " << latencies.size() / seconds << "\n";
+    if (not latencies.empty())
+    {
+        auto percentileUs = [&latencies](double fraction)
+        {
+            return latencies[std::min(latencies.size() - 1u, std::size_t(fraction * latencies.size()))] / 1000.0;
+        };
+        os << "latency us: p50: " << percentileUs(0.5)
+           << ", p99: " << percentileUs(0.99)
+           << ", p999: " << percentileUs(0.999)
+           << ", max: " << latencies.back() / 1000.0 << "\n";
+    }
+    if (btsCpu and sent > 0u)
+    {
+        os << "BTS cpu: " << btsCpu->count() / 1000.0 << "ms"
+           << ", per message: " << double(btsCpu->count()) / sent << "us\n";
+    }
+    os.flush();
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    std::signal(SIGPIPE, SIG_IGN);
+    common::MultiLineConfig configuration(argc - 1, argv + 1);
+    try
+    {
+        const Settings settings = readSettings(configuration);
+        std::unique_ptr<BtsProcess> bts;
+        if (not settings.btsExecutable.empty())
+        {
+            bts = std::make_unique<BtsProcess>(settings);
+        }
+
+        std::vector<FrameSocket> sockets;
+        for (std::size_t i = 0u; i < settings.ueCount; ++i)
+        {
+            sockets.push_back(connectWithRetry(settings));
+        }
+        attachAll(sockets, settings);
+        std::clog << settings.ueCount << " UE attached, sending " << settings.rate << " msg/s for "
+                  << settings.duration.count() << "ms" << std::endl;
+
+        Statistics statistics;
+        std::atomic_bool receiving{true};
+        std::thread receiver([&]
+        {
+            std::vector<bool> open(sockets.size(), true);
+            while (receiving)
+            {
+                receiveAll(sockets, open, statistics, std::chrono::milliseconds(10));
+            }
+        });
+
+        std::mt19937 random{std::random_device{}()};
+        std::uniform_int_distribution<std::size_t> ueDistribution(0u, settings.ueCount - 1u);
+        std::uniform_int_distribution<unsigned> percentDistribution(0u, 99u);
+        const std::chrono::duration<double> interval{1.0 / settings.rate};
+        const auto cpuAtStart = bts ? bts->cpuTime() : std::chrono::microseconds{};
+
+        std::size_t sent = 0u;
+        std::size_t failed = 0u;
+        const auto start = Clock::now();
+        const auto end = start + settings.duration;
+        for (std::size_t index = 0u; ; ++index)
+        {
+            const auto sendTime = start + std::chrono::duration_cast<Clock::duration>(interval * double(index));
+            if (sendTime >= end)
+            {
+                break;
+            }
+            std::this_thread::sleep_until(sendTime);
+            const std::size_t from = ueDistribution(random);
+            const std::size_t to = (from + 1u + ueDistribution(random) % (settings.ueCount - 1u)) % settings.ueCount;
+            const MessageId messageId = percentDistribution(random) < settings.smsPercent ? MessageId::Sms : MessageId::CallTalk;
+            auto message = trafficMessage(messageId, phoneOf(from), phoneOf(to), settings.payloadSize);
+            sockets[from].send(message) ? ++sent : ++failed;
+        }
+        const auto elapsed = Clock::now() - start;
+
+        std::this_thread::sleep_for(settings.drainTime);
+        std::optional<std::chrono::microseconds> btsCpu;
+        if (bts)
+        {
+            btsCpu = bts->cpuTime() - cpuAtStart;
+        }
+        receiving = false;
+        receiver.join();
+        printReport(std::cout, sent, failed, elapsed, statistics, btsCpu);
+    }
+    catch (std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+}
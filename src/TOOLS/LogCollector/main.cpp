@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <thread>
+#include "Config/MultiLineConfig.hpp"
+#include "Logger/SharedMemoryLogRing.hpp"
+
+/**
+ * Drains host wide log ring into one time-ordered file.
+ * Usage: LogCollector [name=/sth_log_ring] [slots=8192] [out=ue_syslog.txt] [reorder_ms=200]
+ * UE processes started with log_shm=<name> write to the ring instead of own files.
+ * Records are held back for reorder_ms and merged by timestamp across drains - a record whose writer was
+ * stalled longer than that between taking its timestamp and committing it is still written, out of order.
+ * The ring stays after the collector exits - producers keep writing to it and the next collector attaches to it.
+ */
+
+namespace
+{
+
+std::atomic_bool running{true};
+
+void onStopSignal(int)
+{
+    running = false;
+}
+
+void print(std::ostream& os, const common::SharedMemoryLogRing::Record& record)
+{
+    constexpr std::uint64_t NS_IN_S = 1000000000u;
+    std::time_t seconds = record.timestampNs / NS_IN_S;
+    std::tm local{};
+    localtime_r(&seconds, &local);
+    os << std::put_time(&local, "%Y-%m-%d %H:%M:%S")
+       << "." << std::setw(6) << std::setfill('0') << (record.timestampNs % NS_IN_S) / 1000u << std::setfill(' ')
+       << " [phone:" << record.phoneNumber << "] [pid:" << record.pid << "] "
+       << record.text << '\n';
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    using common::SharedMemoryLogRing;
+    common::MultiLineConfig configuration(argc - 1, argv + 1);
+    const std::string name = configuration.getString("name", SharedMemoryLogRing::DEFAULT_NAME);
+    const std::string outputFile = configuration.getString("out", "ue_syslog.txt");
+    const auto slotCount = configuration.getNumber<std::size_t>("slots", SharedMemoryLogRing::DEFAULT_SLOT_COUNT);
+    const std::chrono::milliseconds reorderWindow{configuration.getNumber<long>("reorder_ms", 200)};
+
+    std::signal(SIGINT, &onStopSignal);
+    std::signal(SIGTERM, &onStopSignal);
+
+    try
+    {
+        auto ring = SharedMemoryLogRing::create(name, slotCount);
+        std::ofstream output(outputFile);
+        std::clog << "Collecting \"" << name << "\" (" << ring->slotCount() << " slots) into: " << outputFile << std::endl;
+
+        std::vector<SharedMemoryLogRing::Record> records;
+        // sorted by timestamp, not older than any record written so far
+        std::vector<SharedMemoryLogRing::Record> pending;
+        auto byTimestamp = [](auto const& lhs, auto const& rhs)
+        {
+            return lhs.timestampNs < rhs.timestampNs;
+        };
+        std::uint64_t totalLost = 0u;
+        bool lastDrain = false;
+        while (not lastDrain)
+        {
+            lastDrain = not running;
+            records.clear();
+            std::uint64_t lost = ring->drain(records);
+            // records come in ring order - fix small reorderings between processes
+            std::stable_sort(records.begin(), records.end(), byTimestamp);
+            const auto merged = pending.insert(pending.end(), std::make_move_iterator(records.begin()),
+                                               std::make_move_iterator(records.end()));
+            std::inplace_merge(pending.begin(), merged, pending.end(), byTimestamp);
+
+            // records older than watermark shall not come any more
+            const std::uint64_t watermarkNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                (std::chrono::system_clock::now() - reorderWindow).time_since_epoch()).count();
+            auto ready = lastDrain ? pending.end()
+                                   : std::find_if(pending.begin(), pending.end(), [watermarkNs](auto const& record)
+                                     {
+                                         return record.timestampNs > watermarkNs;
+                                     });
+            std::for_each(pending.begin(), ready, [&output](auto const& record) { print(output, record); });
+            pending.erase(pending.begin(), ready);
+            if (lost != 0u)
+            {
+                output << "--- " << lost << " records lost ---\n";
+                totalLost += lost;
+            }
+            output.flush();
+            if (not lastDrain)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        std::clog << "Done, records lost: " << totalLost << std::endl;
+    }
+    catch (std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,141 @@
+#include "FrameSocket.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace tools
+{
+
+namespace
+{
+constexpr std::size_t SIZE_SIZE = sizeof(common::BinaryMessage::SizeType);
+}
+
+FrameSocket FrameSocket::connect(const std::string &host, std::uint16_t port)
+{
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (int error = ::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses))
+    {
+        throw std::runtime_error("Cannot resolve " + host + ": " + ::gai_strerror(error));
+    }
+    int socketDescriptor = ::socket(addresses->ai_family, addresses->ai_socktype, addresses->ai_protocol);
+    if (socketDescriptor < 0 or ::connect(socketDescriptor, addresses->ai_addr, addresses->ai_addrlen) != 0)
+    {
+        const std::string reason = std::strerror(errno);
+        ::freeaddrinfo(addresses);
+        if (socketDescriptor >= 0)
+        {
+            ::close(socketDescriptor);
+        }
+        throw std::runtime_error("Cannot connect to " + host + ":" + std::to_string(port) + ": " + reason);
+    }
+    ::freeaddrinfo(addresses);
+    // frames are small and latency is what is measured
+    int noDelay = 1;
+    ::setsockopt(socketDescriptor, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    return FrameSocket{socketDescriptor};
+}
+
+FrameSocket::FrameSocket(int socketDescriptor)
+    : socketDescriptor(socketDescriptor)
+{}
+
+FrameSocket::FrameSocket(FrameSocket &&other) noexcept
+    : socketDescriptor(other.socketDescriptor),
+      received(std::move(other.received))
+{
+    other.socketDescriptor = -1;
+}
+
+FrameSocket &FrameSocket::operator=(FrameSocket &&other) noexcept
+{
+    std::swap(socketDescriptor, other.socketDescriptor);
+    std::swap(received, other.received);
+    return *this;
+}
+
+FrameSocket::~FrameSocket()
+{
+    if (socketDescriptor >= 0)
+    {
+        ::close(socketDescriptor);
+    }
+}
+
+bool FrameSocket::send(const common::BinaryMessage &message)
+{
+    const std::size_t size = message.value.size();
+    std::vector<std::uint8_t> frame;
+    frame.reserve(SIZE_SIZE + size);
+    frame.push_back(static_cast<std::uint8_t>(size >> 8u));
+    frame.push_back(static_cast<std::uint8_t>(size & 0xFFu));
+    frame.insert(frame.end(), message.value.begin(), message.value.end());
+
+    std::size_t sent = 0u;
+    while (sent < frame.size())
+    {
+        auto result = ::send(socketDescriptor, frame.data() + sent, frame.size() - sent, MSG_NOSIGNAL);
+        if (result < 0 and errno == EINTR)
+        {
+            continue;
+        }
+        if (result <= 0)
+        {
+            return false;
+        }
+        sent += static_cast<std::size_t>(result);
+    }
+    return true;
+}
+
+bool FrameSocket::receive(std::vector<common::BinaryMessage> &messages)
+{
+    std::uint8_t chunk[4096];
+    for (;;)
+    {
+        auto result = ::recv(socketDescriptor, chunk, sizeof(chunk), MSG_DONTWAIT);
+        if (result == 0)
+        {
+            return false;
+        }
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno != EAGAIN and errno != EWOULDBLOCK)
+            {
+                return false;
+            }
+            break;
+        }
+        received.insert(received.end(), chunk, chunk + result);
+    }
+
+    std::size_t offset = 0u;
+    while (received.size() - offset >= SIZE_SIZE)
+    {
+        const std::size_t size = (std::size_t(received[offset]) << 8u) | received[offset + 1u];
+        if (received.size() - offset < SIZE_SIZE + size)
+        {
+            break;
+        }
+        common::BinaryMessage message{common::BinaryMessage::Value(static_cast<common::BinaryMessage::SizeType>(size))};
+        std::copy_n(received.begin() + offset + SIZE_SIZE, size, message.value.begin());
+        messages.push_back(std::move(message));
+        offset += SIZE_SIZE + size;
+    }
+    received.erase(received.begin(), received.begin() + offset);
+    return true;
+}
+
+}
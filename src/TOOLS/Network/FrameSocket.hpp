@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Messages/BinaryMessage.hpp"
+
+namespace tools
+{
+
+/**
+ * Client side TCP connection speaking the BTS framing: u16 big endian size, then frame bytes.
+ * send() and receive() may be called concurrently from two threads.
+ */
+class FrameSocket
+{
+public:
+    /** @throw std::runtime_error */
+    static FrameSocket connect(const std::string& host, std::uint16_t port);
+
+    FrameSocket(FrameSocket&& other) noexcept;
+    FrameSocket& operator=(FrameSocket&& other) noexcept;
+    ~FrameSocket();
+
+    /** @return false when connection is broken */
+    bool send(const common::BinaryMessage& message);
+    /**
+     * Reads what is available without blocking, complete frames are appended
+     * @return false when peer closed connection
+     */
+    bool receive(std::vector<common::BinaryMessage>& messages);
+
+    int fileDescriptor() const { return socketDescriptor; }
+
+private:
+    explicit FrameSocket(int socketDescriptor);
+
+    int socketDescriptor;
+    std::vector<std::uint8_t> received;
+};
+
+}
@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <poll.h>
+#include <unistd.h>
+#include "Config/MultiLineConfig.hpp"
+#include "Trace/CaptureFile.hpp"
+#include "FrameSocket.hpp"
+
+/**
+ * Re-injects frames received by BTS in a capture (BTS started with capture=<file>) over real TCP connections.
+ * Usage: Replay file=<capture> [host=127.0.0.1] [port=8181] [speed=1] [drain_ms=500]
+ *     speed: 1 - original timing, N - N times faster, 0 - as fast as possible
+ * Latency is measured for frames that BTS forwards unchanged to other replayed connection.
+ */
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+using common::BinaryMessage;
+using common::CaptureRecord;
+using tools::FrameSocket;
+
+std::string key(const BinaryMessage& message)
+{
+    return std::string(message.value.begin(), message.value.end());
+}
+
+class LatencyTracker
+{
+public:
+    void sent(const BinaryMessage& message, Clock::time_point when)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        inFlight[key(message)].push_back(when);
+    }
+
+    // send failed - nothing will be forwarded, later identical frame shall not be matched with this one
+    void notSent(const BinaryMessage& message, Clock::time_point when)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = inFlight.find(key(message));
+        if (it == inFlight.end())
+        {
+            return;
+        }
+        auto& sentTimes = it->second;
+        auto sentTime = std::find(sentTimes.rbegin(), sentTimes.rend(), when);
+        if (sentTime != sentTimes.rend())
+        {
+            sentTimes.erase(std::next(sentTime).base());
+        }
+        if (sentTimes.empty())
+        {
+            inFlight.erase(it);
+        }
+    }
+
+    void received(const BinaryMessage& message, Clock::time_point when)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = inFlight.find(key(message));
+        if (it == inFlight.end())
+        {
+            return;
+        }
+        latencies.push_back(when - it->second.front());
+        it->second.pop_front();
+        if (it->second.empty())
+        {
+            inFlight.erase(it);
+        }
+    }
+
+    std::vector<Clock::duration> sortedLatencies()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto result = latencies;
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+private:
+    std::mutex mutex;
+    std::map<std::string, std::deque<Clock::time_point>> inFlight;
+    std::vector<Clock::duration> latencies;
+};
+
+class Connections
+{
+public:
+    Connections(std::string host, std::uint16_t port) : host(std::move(host)), port(port)
+    {
+        if (::pipe(wakeUpPipe) != 0)
+        {
+            throw std::runtime_error("Cannot create pipe");
+        }
+    }
+    ~Connections()
+    {
+        ::close(wakeUpPipe[0]);
+        ::close(wakeUpPipe[1]);
+    }
+
+    /** @return null when connection could not be opened - it is not retried */
+    FrameSocket* get(std::uint32_t connectionId)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = sockets.find(connectionId);
+        if (it == sockets.end())
+        {
+            std::unique_ptr<FrameSocket> socket;
+            try
+            {
+                socket = std::make_unique<FrameSocket>(FrameSocket::connect(host, port));
+            }
+            catch (std::exception& ex)
+            {
+                std::cerr << "connection #" << connectionId << ": " << ex.what() << std::endl;
+            }
+            it = sockets.emplace(connectionId, std::move(socket)).first;
+            // let receiver poll new socket right away
+            const char wakeUp = 0;
+            [[maybe_unused]] auto written = ::write(wakeUpPipe[1], &wakeUp, 1);
+        }
+        return it->second.get();
+    }
+
+    std::size_t count()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return sockets.size();
+    }
+
+    void receiveAll(LatencyTracker& latencyTracker, std::chrono::milliseconds timeout)
+    {
+        std::vector<pollfd> descriptors{pollfd{wakeUpPipe[0], POLLIN, 0}};
+        std::vector<FrameSocket*> polled{nullptr};
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& socket : sockets)
+            {
+                if (not socket.second)
+                {
+                    continue;
+                }
+                descriptors.push_back(pollfd{socket.second->fileDescriptor(), POLLIN, 0});
+                polled.push_back(socket.second.get());
+            }
+        }
+        if (::poll(descriptors.data(), descriptors.size(), static_cast<int>(timeout.count())) <= 0)
+        {
+            return;
+        }
+        std::vector<BinaryMessage> messages;
+        if (descriptors[0].revents != 0)
+        {
+            char wakeUps[64];
+            [[maybe_unused]] auto read = ::read(wakeUpPipe[0], wakeUps, sizeof(wakeUps));
+        }
+        for (std::size_t i = 1u; i < descriptors.size(); ++i)
+        {
+            if (descriptors[i].revents != 0)
+            {
+                // sockets are never removed while replay runs
+                polled[i]->receive(messages);
+            }
+        }
+        const auto now = Clock::now();
+        for (auto& message : messages)
+        {
+            latencyTracker.received(message, now);
+        }
+    }
+
+private:
+    const std::string host;
+    const std::uint16_t port;
+    std::mutex mutex;
+    std::map<std::uint32_t, std::unique_ptr<FrameSocket>> sockets;
+    int wakeUpPipe[2];
+};
+
+std::vector<CaptureRecord> readReceivedFrames(const std::string& file)
+{
+    common::CaptureReader reader(file);
+    std::vector<CaptureRecord> records;
+    CaptureRecord record;
+    while (reader.read(record))
+    {
+        if (record.direction == CaptureRecord::Direction::Received)
+        {
+            records.push_back(record);
+        }
+    }
+    std::stable_sort(records.begin(), records.end(), [](auto const& lhs, auto const& rhs)
+    {
+        return lhs.timestampNs < rhs.timestampNs;
+    });
+    return records;
+}
+
+double toMicroseconds(Clock::duration duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+void printReport(std::ostream& os, std::size_t connections, std::size_t sent, std::size_t failed,
+                 Clock::duration elapsed, const std::vector<Clock::duration>& latencies)
+{
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    os << std::fixed << std::setprecision(1)
+       << "connections: " << connections
+       << ", sent: " << sent
+       << ", failed: " << failed
+       << ", elapsed: " << seconds * 1000.0 << "ms"
+       << ", throughput: " << (seconds > 0.0 ? sent / seconds : 0.0) << " frames/s\n"
+       << "forwarded: " << latencies.size();
+    if (not latencies.empty())
+    {
+        auto percentile = [&latencies](double fraction)
+        {
+            return toMicroseconds(latencies[std::min(latencies.size() - 1u, std::size_t(fraction * latencies.size()))]);
+        };
+        os << ", latency us: p50: " << percentile(0.50)
+           << ", p90: " << percentile(0.90)
+           << ", p99: " << percentile(0.99)
+           << ", max: " << toMicroseconds(latencies.back());
+    }
+    os << std::endl;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    common::MultiLineConfig configuration(argc - 1, argv + 1);
+    try
+    {
+        const std::string file = configuration.getString("file");
+        const std::string host = configuration.getString("host", "127.0.0.1");
+        const auto port = configuration.getNumber<std::uint16_t>("port", 8181);
+        const double speed = std::stod(configuration.getString("speed", "1"));
+        const std::chrono::milliseconds drainTime{configuration.getNumber<unsigned>("drain_ms", 500u)};
+        if (speed < 0.0)
+        {
+            throw std::invalid_argument("speed shall not be negative");
+        }
+
+        const auto records = readReceivedFrames(file);
+        std::clog << "Replaying " << records.size() << " frames from: " << file << std::endl;
+        if (records.empty())
+        {
+            return 0;
+        }
+
+        Connections connections(host, port);
+        LatencyTracker latencyTracker;
+        std::atomic_bool receiving{true};
+        std::thread receiver([&]
+        {
+            while (receiving)
+            {
+                connections.receiveAll(latencyTracker, std::chrono::milliseconds(10));
+            }
+        });
+
+        std::size_t sent = 0u;
+        std::size_t failed = 0u;
+        const auto start = Clock::now();
+        for (auto& record : records)
+        {
+            if (speed > 0.0)
+            {
+                std::chrono::duration<double, std::nano> offset((record.timestampNs - records.front().timestampNs) / speed);
+                std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(offset));
+            }
+            FrameSocket* socket = connections.get(record.connectionId);
+            if (not socket)
+            {
+                ++failed;
+                continue;
+            }
+            // before sending - forwarded copy may arrive before send() returns
+            const auto sentAt = Clock::now();
+            latencyTracker.sent(record.message, sentAt);
+            if (socket->send(record.message))
+            {
+                ++sent;
+            }
+            else
+            {
+                latencyTracker.notSent(record.message, sentAt);
+                ++failed;
+            }
+        }
+        const auto elapsed = Clock::now() - start;
+
+        std::this_thread::sleep_for(drainTime);
+        receiving = false;
+        receiver.join();
+        printReport(std::cout, connections.count(), sent, failed, elapsed, latencyTracker.sortedLatencies());
+    }
+    catch (std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,114 @@
+#include "SimulatedBts.hpp"
+#include "ApplicationFactory.hpp"
+#include "IApplicationEnvironment.hpp"
+
+namespace tools
+{
+
+namespace
+{
+
+class NullConsole : public bts::IConsole
+{
+public:
+    void addCommand(std::string, const std::string&, CommandCallback) override {}
+    void addCloseCommand(std::string, const std::string&, CommandCallback) override {}
+    void addHelpCommand(std::string, const std::string&) override {}
+};
+
+}
+
+class SimulatedBts::Environment : public bts::IApplicationEnvironment
+{
+public:
+    Environment(common::ClockPtr clock,
+                common::ILogger& logger,
+                common::BtsId btsId,
+                std::shared_ptr<const common::MultiLineConfig> configuration)
+        : logger(logger),
+          btsId(btsId),
+          configuration(std::move(configuration)),
+          application(bts::createApplication(*this, std::move(clock)))
+    {}
+
+    bts::IConsole& getConsole() override
+    {
+        return console;
+    }
+
+    void registerUeConnectedCallback(bts::UeConnectedCallback callback) override
+    {
+        ueConnectedCallback = std::move(callback);
+    }
+
+    common::ILogger& getLogger() override
+    {
+        return logger;
+    }
+
+    common::BtsId getBtsId() const override
+    {
+        return btsId;
+    }
+
+    std::string getAddress() const override
+    {
+        return "simulation";
+    }
+
+    common::ReloadableConfig& getConfiguration() override
+    {
+        return configuration;
+    }
+
+    void startMessageLoop() override
+    {}
+
+    void connect(std::shared_ptr<common::ITransport> transport)
+    {
+        if (ueConnectedCallback)
+        {
+            ueConnectedCallback(std::move(transport));
+        }
+    }
+
+    bts::IComponent& getApplication()
+    {
+        return *application;
+    }
+
+private:
+    NullConsole console;
+    common::ILogger& logger;
+    common::BtsId btsId;
+    common::ReloadableConfig configuration;
+    bts::UeConnectedCallback ueConnectedCallback;
+    // last - created when the environment is complete
+    std::unique_ptr<bts::IComponent> application;
+};
+
+SimulatedBts::SimulatedBts(common::ClockPtr clock,
+                           common::ILogger &logger,
+                           common::BtsId btsId,
+                           std::shared_ptr<const common::MultiLineConfig> configuration)
+    : environment(std::make_unique<Environment>(std::move(clock), logger, btsId, std::move(configuration)))
+{}
+
+SimulatedBts::~SimulatedBts() = default;
+
+void SimulatedBts::start()
+{
+    environment->getApplication().start();
+}
+
+void SimulatedBts::stop()
+{
+    environment->getApplication().stop();
+}
+
+void SimulatedBts::connect(std::shared_ptr<common::ITransport> transport)
+{
+    environment->connect(std::move(transport));
+}
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include "CommonEnvironment/ITransport.hpp"
+#include "Config/MultiLineConfig.hpp"
+#include "Logger/ILogger.hpp"
+#include "Messages/BtsId.hpp"
+#include "Time/IClock.hpp"
+
+namespace tools
+{
+
+/**
+ * Real BTS application (relay, spawner, SIB molester) in an environment without console and sockets.
+ * UE connections are handed over by connect() instead of being accepted on a socket.
+ */
+class SimulatedBts
+{
+public:
+    /**
+     * @param configuration the same keys as BTS configuration file (e.g. sib_tick_ms, sib_ticks)
+     */
+    SimulatedBts(common::ClockPtr clock,
+                 common::ILogger& logger,
+                 common::BtsId btsId,
+                 std::shared_ptr<const common::MultiLineConfig> configuration);
+    ~SimulatedBts();
+
+    void start();
+    void stop();
+    void connect(std::shared_ptr<common::ITransport> transport);
+
+private:
+    class Environment;
+
+    std::unique_ptr<Environment> environment;
+};
+
+}
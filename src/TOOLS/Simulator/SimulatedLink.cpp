@@ -0,0 +1,159 @@
+#include "SimulatedLink.hpp"
+#include <string>
+
+namespace tools
+{
+
+class SimulatedLink::End : public common::ITransport
+{
+public:
+    End(common::IClock& clock, std::size_t linkId, Direction sendDirection,
+        common::IClock::Duration latency, FrameObserver observer)
+        : clock(clock),
+          linkId(linkId),
+          sendDirection(sendDirection),
+          latency(latency),
+          observer(std::move(observer))
+    {}
+
+    void registerMessageCallback(MessageCallback callback) override
+    {
+        messageCallback = std::move(callback);
+    }
+
+    void registerDisconnectedCallback(DisconnectedCallback callback) override
+    {
+        disconnectedCallback = std::move(callback);
+    }
+
+    bool sendMessage(common::BinaryMessage message) override
+    {
+        auto target = peer.lock();
+        if (not connected or not target)
+        {
+            return false;
+        }
+        clock.scheduleAfter(latency, [target, linkId = linkId, direction = sendDirection,
+                                      observer = observer, message = std::move(message)]() mutable
+        {
+            if (target->connected and target->messageCallback)
+            {
+                if (observer)
+                {
+                    observer(linkId, direction, message);
+                }
+                target->messageCallback(std::move(message));
+            }
+        });
+        return true;
+    }
+
+    void close() override
+    {
+        auto target = peer.lock();
+        if (not target)
+        {
+            return;
+        }
+        // both ends see disconnection, as with a real socket - later, from the clock
+        clock.scheduleAfter(common::IClock::Duration::zero(), [thisEnd = target->peer, otherEnd = peer]
+        {
+            for (auto& end : {thisEnd.lock(), otherEnd.lock()})
+            {
+                if (end)
+                {
+                    end->disconnect();
+                }
+            }
+        });
+    }
+
+    std::string addressToString() const override
+    {
+        return "link#" + std::to_string(linkId);
+    }
+
+    void disconnect()
+    {
+        if (connected)
+        {
+            connected = false;
+            if (disconnectedCallback)
+            {
+                // callback may unregister itself
+                auto callback = disconnectedCallback;
+                callback();
+            }
+            if (disconnectionObserver)
+            {
+                disconnectionObserver();
+            }
+        }
+    }
+
+    void relink(std::weak_ptr<End> newPeer)
+    {
+        peer = std::move(newPeer);
+        connected = true;
+    }
+
+    std::weak_ptr<End> peer;
+    std::function<void()> disconnectionObserver;
+
+private:
+    common::IClock& clock;
+    const std::size_t linkId;
+    const Direction sendDirection;
+    const common::IClock::Duration latency;
+    const FrameObserver observer;
+    bool connected = true;
+    MessageCallback messageCallback;
+    DisconnectedCallback disconnectedCallback;
+};
+
+SimulatedLink::SimulatedLink(common::IClock &clock, std::size_t linkId, common::IClock::Duration latency,
+                             FrameObserver observer)
+    : clock(clock),
+      linkId(linkId),
+      latency(latency),
+      observer(observer),
+      ue(std::make_shared<End>(clock, linkId, Direction::UeToBts, latency, observer)),
+      bts(std::make_shared<End>(clock, linkId, Direction::BtsToUe, latency, observer))
+{
+    ue->peer = bts;
+    bts->peer = ue;
+}
+
+SimulatedLink::~SimulatedLink() = default;
+
+std::shared_ptr<common::ITransport> SimulatedLink::ueEnd() const
+{
+    return ue;
+}
+
+std::shared_ptr<common::ITransport> SimulatedLink::btsEnd() const
+{
+    return bts;
+}
+
+void SimulatedLink::disconnect()
+{
+    ue->disconnect();
+    bts->disconnect();
+}
+
+void SimulatedLink::setDisconnectionObserver(std::function<void()> observer)
+{
+    ue->disconnectionObserver = std::move(observer);
+}
+
+std::shared_ptr<common::ITransport> SimulatedLink::reconnect()
+{
+    // old BTS end stays with its connection object until BTS drops it
+    bts = std::make_shared<End>(clock, linkId, Direction::BtsToUe, latency, observer);
+    bts->peer = ue;
+    ue->relink(bts);
+    return bts;
+}
+
+}
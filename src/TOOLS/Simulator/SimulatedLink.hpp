@@ -0,0 +1,47 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include "CommonEnvironment/ITransport.hpp"
+#include "Time/IClock.hpp"
+
+namespace tools
+{
+
+/**
+ * In-memory connection between one UE and BTS - frames are delivered by clock timers after fixed latency.
+ * Both ends must be used from the thread advancing the clock.
+ */
+class SimulatedLink
+{
+public:
+    enum class Direction { UeToBts, BtsToUe };
+    using FrameObserver = std::function<void(std::size_t linkId, Direction, const common::BinaryMessage&)>;
+
+    SimulatedLink(common::IClock& clock, std::size_t linkId, common::IClock::Duration latency, FrameObserver observer);
+    ~SimulatedLink();
+
+    std::shared_ptr<common::ITransport> ueEnd() const;
+    std::shared_ptr<common::ITransport> btsEnd() const;
+
+    /** Both ends get disconnected callback, frames in flight are dropped */
+    void disconnect();
+    /** Called after UE end got disconnected - from the clock */
+    void setDisconnectionObserver(std::function<void()> observer);
+    /**
+     * After disconnection: UE end is linked to a new BTS end - to be given to BTS as a new connection
+     */
+    std::shared_ptr<common::ITransport> reconnect();
+
+private:
+    class End;
+
+    common::IClock& clock;
+    const std::size_t linkId;
+    const common::IClock::Duration latency;
+    const FrameObserver observer;
+    std::shared_ptr<End> ue;
+    std::shared_ptr<End> bts;
+};
+
+}
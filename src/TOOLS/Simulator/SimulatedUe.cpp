@@ -0,0 +1,520 @@
+#include "SimulatedUe.hpp"
+#include <optional>
+#include "Application.hpp"
+#include "Ports/BtsPort.hpp"
+#include "Ports/TimerPort.hpp"
+#include "Ports/UserPort.hpp"
+#include "UeGui/ICallMode.hpp"
+#include "UeGui/IDialMode.hpp"
+#include "UeGui/IListViewMode.hpp"
+#include "UeGui/ISmsComposeMode.hpp"
+#include "UeGui/ITextMode.hpp"
+
+namespace tools
+{
+
+using common::PhoneNumber;
+
+namespace
+{
+
+// menu of ConnectedState
+constexpr unsigned COMPOSE_SMS_ITEM = 0u;
+constexpr unsigned DIAL_ITEM = 2u;
+
+/**
+ * Screen content is kept only as far as UE reads it back - selection, typed number and text
+ */
+class SimulatedGui : public ue::IUeGui
+{
+public:
+    class ListViewMode : public IListViewMode
+    {
+    public:
+        OptionalSelection getCurrentItemIndex() const override
+        {
+            return {selection.has_value(), selection.value_or(0u)};
+        }
+        void addSelectionListItem(const std::string&, const std::string&) override {}
+        void clearSelectionList() override
+        {
+            selection.reset();
+        }
+
+        std::optional<Selection> selection;
+    };
+
+    class SmsComposeMode : public ISmsComposeMode
+    {
+    public:
+        PhoneNumber getPhoneNumber() const override
+        {
+            return phoneNumber;
+        }
+        std::string getSmsText() const override
+        {
+            return text;
+        }
+        void clearSmsText() override
+        {
+            text.clear();
+        }
+
+        PhoneNumber phoneNumber;
+        std::string text;
+    };
+
+    class DialMode : public IDialMode
+    {
+    public:
+        PhoneNumber getPhoneNumber() const override
+        {
+            return phoneNumber;
+        }
+
+        PhoneNumber phoneNumber;
+    };
+
+    class CallMode : public ICallMode
+    {
+    public:
+        void appendIncomingText(const std::string&) override {}
+        void clearIncomingText() override {}
+        void clearOutgoingText() override
+        {
+            outgoingText.clear();
+        }
+        std::string getOutgoingText() const override
+        {
+            return outgoingText;
+        }
+
+        std::string outgoingText;
+    };
+
+    class TextMode : public ITextMode
+    {
+    public:
+        void setText(const std::string&) override {}
+    };
+
+    void setCloseGuard(CloseGuard) override {}
+    void setAcceptCallback(Callback callback) override
+    {
+        acceptCallback = std::move(callback);
+    }
+    void setRejectCallback(Callback callback) override
+    {
+        rejectCallback = std::move(callback);
+    }
+    void setTitle(const std::string&) override {}
+    void showConnected() override {}
+    void showConnecting() override {}
+    void showNotConnected() override {}
+    void showNewSms(bool) override {}
+    void showPeerUserNotAvailable(PhoneNumber) override {}
+    IListViewMode& setListViewMode() override
+    {
+        return listViewMode;
+    }
+    ISmsComposeMode& setSmsComposeMode() override
+    {
+        return smsComposeMode;
+    }
+    IDialMode& setDialMode() override
+    {
+        return dialMode;
+    }
+    ICallMode& setCallMode() override
+    {
+        return callMode;
+    }
+    ITextMode& setAlertMode() override
+    {
+        return textMode;
+    }
+    ITextMode& setViewTextMode() override
+    {
+        return textMode;
+    }
+
+    // callbacks replace themselves (new UE state) - so call a copy
+    void pressAccept()
+    {
+        if (auto callback = acceptCallback)
+        {
+            callback();
+        }
+    }
+    void pressReject()
+    {
+        if (auto callback = rejectCallback)
+        {
+            callback();
+        }
+    }
+
+    ListViewMode listViewMode;
+    SmsComposeMode smsComposeMode;
+    DialMode dialMode;
+    CallMode callMode;
+    TextMode textMode;
+
+private:
+    Callback acceptCallback;
+    Callback rejectCallback;
+};
+
+}
+
+/**
+ * Sits between ports and application - every event goes to the application first, then activity follows
+ * what the UE state machine did with it
+ */
+class SimulatedUe::Impl : public ue::IBtsEventsHandler, public ue::ITimerEventsHandler
+{
+public:
+    Impl(SimulatedUe& owner,
+         common::IClock& clock,
+         common::ILogger& logger,
+         common::PhoneNumber phoneNumber,
+         std::shared_ptr<common::ITransport> transport,
+         SimulationStatistics& statistics)
+        : owner(owner),
+          clock(clock),
+          statistics(statistics),
+          phoneNumber(phoneNumber),
+          transport(std::move(transport)),
+          btsPort(logger, *this->transport, phoneNumber),
+          userPort(logger, gui, phoneNumber),
+          timerPort(logger, clock),
+          application(phoneNumber, logger, btsPort, userPort, timerPort)
+    {
+        btsPort.start(*this);
+        userPort.start(application);
+        timerPort.start(*this);
+    }
+
+    ~Impl()
+    {
+        timerPort.stop();
+        userPort.stop();
+        btsPort.stop();
+    }
+
+    void handleTimeout() override
+    {
+        application.handleTimeout();
+        switch (activity)
+        {
+        case Activity::Connecting:
+            ++statistics.attachTimeouts;
+            changeActivity(Activity::NotConnected);
+            break;
+        case Activity::Dialling:
+            ++statistics.callsTimedOut;
+            changeActivity(Activity::Idle);
+            break;
+        case Activity::Ringing:
+            ++statistics.callsMissed;
+            changeActivity(Activity::Idle);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void handleSib(common::BtsId btsId) override
+    {
+        application.handleSib(btsId);
+        if (activity == Activity::NotConnected)
+        {
+            ++statistics.attachRequests;
+            activityStart = clock.now();
+            changeActivity(Activity::Connecting);
+        }
+    }
+
+    void handleAttachAccept() override
+    {
+        application.handleAttachAccept();
+        if (activity == Activity::Connecting)
+        {
+            ++statistics.attachAccepts;
+            statistics.attachLatencies.push_back(clock.now() - activityStart);
+            changeActivity(Activity::Idle);
+        }
+    }
+
+    void handleAttachReject() override
+    {
+        application.handleAttachReject();
+        if (activity == Activity::Connecting)
+        {
+            ++statistics.attachRejects;
+            changeActivity(Activity::NotConnected);
+        }
+    }
+
+    void handleDisconnected() override
+    {
+        application.handleDisconnected();
+        // ringing and talking UE goes back to menu, not to "not connected"
+        changeActivity(activity == Activity::Ringing or activity == Activity::Talking
+                       ? Activity::Idle : Activity::NotConnected);
+    }
+
+    void handleSms(common::PhoneNumber from, const std::string& text) override
+    {
+        application.handleSms(from, text);
+        if (activity == Activity::Idle)
+        {
+            ++statistics.smsReceived;
+        }
+        else
+        {
+            ++statistics.smsWhenBusy;
+        }
+    }
+
+    void handleCallRequest(common::PhoneNumber from) override
+    {
+        application.handleCallRequest(from);
+        if (activity == Activity::Idle)
+        {
+            ++statistics.callsOffered;
+            peer = from;
+            changeActivity(Activity::Ringing);
+        }
+        else
+        {
+            ++statistics.callRequestsWhenBusy;
+        }
+    }
+
+    void handleCallAccepted(common::PhoneNumber from) override
+    {
+        application.handleCallAccepted(from);
+        if (activity == Activity::Dialling and from == peer)
+        {
+            ++statistics.callsAccepted;
+            statistics.callSetupLatencies.push_back(clock.now() - activityStart);
+            changeActivity(Activity::Talking);
+        }
+    }
+
+    void handleCallDropped(common::PhoneNumber from) override
+    {
+        application.handleCallDropped(from);
+        if (activity == Activity::Dialling and from == peer)
+        {
+            ++statistics.callsRejected;
+            changeActivity(Activity::Idle);
+        }
+        else if (activity == Activity::Talking and from == peer)
+        {
+            changeActivity(Activity::Idle);
+        }
+    }
+
+    void handleCallTalk(common::PhoneNumber from, const std::string& text) override
+    {
+        application.handleCallTalk(from, text);
+    }
+
+    void handleUnknownRecipient() override
+    {
+        application.handleUnknownRecipient();
+        if (activity == Activity::Dialling)
+        {
+            ++statistics.callsUnknownRecipient;
+            changeActivity(Activity::Idle);
+        }
+        else
+        {
+            ++statistics.smsUnknownRecipient;
+        }
+    }
+
+    bool call(common::PhoneNumber callee)
+    {
+        if (not canAct(Activity::Idle))
+        {
+            return false;
+        }
+        gui.listViewMode.selection = DIAL_ITEM;
+        gui.pressAccept();
+        gui.callMode.outgoingText = to_string(callee);
+        gui.pressAccept();
+        ++statistics.callsAttempted;
+        peer = callee;
+        activityStart = clock.now();
+        changeActivity(Activity::Dialling);
+        return true;
+    }
+
+    bool sendSms(common::PhoneNumber recipient, const std::string& text)
+    {
+        if (not canAct(Activity::Idle))
+        {
+            return false;
+        }
+        gui.listViewMode.selection = COMPOSE_SMS_ITEM;
+        gui.pressAccept();
+        gui.smsComposeMode.phoneNumber = recipient;
+        gui.smsComposeMode.text = text;
+        gui.pressAccept();
+        ++statistics.smsSent;
+        return true;
+    }
+
+    bool answer()
+    {
+        if (not canAct(Activity::Ringing))
+        {
+            return false;
+        }
+        gui.pressAccept();
+        ++statistics.callsAnswered;
+        changeActivity(Activity::Talking);
+        return true;
+    }
+
+    bool decline()
+    {
+        if (not canAct(Activity::Ringing))
+        {
+            return false;
+        }
+        gui.pressReject();
+        ++statistics.callsDeclined;
+        changeActivity(Activity::Idle);
+        return true;
+    }
+
+    bool hangUp()
+    {
+        if (not canAct(Activity::Talking))
+        {
+            return false;
+        }
+        gui.pressReject();
+        ++statistics.callsHungUp;
+        changeActivity(Activity::Idle);
+        return true;
+    }
+
+    SimulatedUe& owner;
+    common::IClock& clock;
+    SimulationStatistics& statistics;
+    common::PhoneNumber phoneNumber;
+    std::shared_ptr<common::ITransport> transport;
+    SimulatedGui gui;
+    ue::BtsPort btsPort;
+    ue::UserPort userPort;
+    ue::TimerPort timerPort;
+    ue::Application application;
+
+    Activity activity = Activity::NotConnected;
+    std::uint64_t activityGeneration = 0u;
+    ActivityObserver activityObserver;
+    common::PhoneNumber peer;
+    common::IClock::TimePoint activityStart;
+
+private:
+    bool canAct(Activity required)
+    {
+        if (activity != required)
+        {
+            ++statistics.userActionsWhenBusy;
+            return false;
+        }
+        return true;
+    }
+
+    void changeActivity(Activity next)
+    {
+        const Activity previous = activity;
+        if (previous == next)
+        {
+            return;
+        }
+        activity = next;
+        ++activityGeneration;
+        if (activityObserver)
+        {
+            activityObserver(owner, previous);
+        }
+    }
+};
+
+SimulatedUe::SimulatedUe(common::IClock &clock,
+                         common::ILogger &logger,
+                         common::PhoneNumber phoneNumber,
+                         std::shared_ptr<common::ITransport> transport,
+                         SimulationStatistics &statistics)
+    : impl(std::make_unique<Impl>(*this, clock, logger, phoneNumber, std::move(transport), statistics))
+{}
+
+SimulatedUe::~SimulatedUe() = default;
+
+common::PhoneNumber SimulatedUe::getPhoneNumber() const
+{
+    return impl->phoneNumber;
+}
+
+SimulatedUe::Activity SimulatedUe::getActivity() const
+{
+    return impl->activity;
+}
+
+std::uint64_t SimulatedUe::getActivityGeneration() const
+{
+    return impl->activityGeneration;
+}
+
+void SimulatedUe::setActivityObserver(ActivityObserver observer)
+{
+    impl->activityObserver = std::move(observer);
+}
+
+bool SimulatedUe::call(common::PhoneNumber callee)
+{
+    return impl->call(callee);
+}
+
+bool SimulatedUe::sendSms(common::PhoneNumber recipient, const std::string &text)
+{
+    return impl->sendSms(recipient, text);
+}
+
+bool SimulatedUe::answer()
+{
+    return impl->answer();
+}
+
+bool SimulatedUe::decline()
+{
+    return impl->decline();
+}
+
+bool SimulatedUe::hangUp()
+{
+    return impl->hangUp();
+}
+
+const char* toString(SimulatedUe::Activity activity)
+{
+    switch (activity)
+    {
+    case SimulatedUe::Activity::NotConnected: return "NotConnected";
+    case SimulatedUe::Activity::Connecting: return "Connecting";
+    case SimulatedUe::Activity::Idle: return "Idle";
+    case SimulatedUe::Activity::Dialling: return "Dialling";
+    case SimulatedUe::Activity::Ringing: return "Ringing";
+    case SimulatedUe::Activity::Talking: return "Talking";
+    }
+    return "?";
+}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include "CommonEnvironment/ITransport.hpp"
+#include "Logger/ILogger.hpp"
+#include "Messages/PhoneNumber.hpp"
+#include "Time/IClock.hpp"
+#include "SimulationStatistics.hpp"
+
+namespace tools
+{
+
+/**
+ * Real UE application (ports, states) operated by simulated user through fake GUI.
+ * Activity mirrors UE state machine as seen from outside - it is what the user can act upon.
+ */
+class SimulatedUe
+{
+public:
+    enum class Activity { NotConnected, Connecting, Idle, Dialling, Ringing, Talking };
+    using ActivityObserver = std::function<void(SimulatedUe&, Activity previous)>;
+
+    SimulatedUe(common::IClock& clock,
+                common::ILogger& logger,
+                common::PhoneNumber phoneNumber,
+                std::shared_ptr<common::ITransport> transport,
+                SimulationStatistics& statistics);
+    ~SimulatedUe();
+
+    common::PhoneNumber getPhoneNumber() const;
+    Activity getActivity() const;
+    /**
+     * Changed on every activity change - lets delayed user actions detect they are stale
+     */
+    std::uint64_t getActivityGeneration() const;
+    void setActivityObserver(ActivityObserver observer);
+
+    // user actions - return false (and do nothing) when not possible in current activity
+    bool call(common::PhoneNumber callee);
+    bool sendSms(common::PhoneNumber recipient, const std::string& text);
+    bool answer();
+    bool decline();
+    bool hangUp();
+
+private:
+    class Impl;
+
+    std::unique_ptr<Impl> impl;
+};
+
+const char* toString(SimulatedUe::Activity activity);
+
+}
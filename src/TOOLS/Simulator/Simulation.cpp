@@ -0,0 +1,270 @@
+#include "Simulation.hpp"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include "Messages/MessageId.hpp"
+
+namespace tools
+{
+
+namespace
+{
+
+constexpr std::size_t MAX_PHONE_NUMBER = 254u; // one byte phone numbers, 0 is not allowed
+constexpr double SECONDS_IN_HOUR = 3600.0;
+// as UE transport retries after lost connection
+constexpr std::chrono::seconds RECONNECT_DELAY{10};
+constexpr std::uint64_t FNV_OFFSET = 0xcbf29ce484222325u;
+constexpr std::uint64_t FNV_PRIME = 0x100000001b3u;
+
+common::PhoneNumber phoneNumberOf(std::size_t ueIndex)
+{
+    return common::PhoneNumber{static_cast<common::PhoneNumber::Value>(ueIndex % MAX_PHONE_NUMBER + 1u)};
+}
+
+}
+
+Simulation::Settings Simulation::readSettings(const common::MultiLineConfig &configuration)
+{
+    Settings settings;
+    settings.ueCount = configuration.getNumber<std::size_t>("ues", MAX_PHONE_NUMBER);
+    settings.seed = configuration.getNumber<std::uint64_t>("seed", 1u);
+    settings.btsId = common::BtsId{configuration.getNumber<std::uint32_t>("bts_id", 1u)};
+    settings.duration = std::chrono::seconds(configuration.getNumber<unsigned>("duration_s", 600u));
+    settings.latency = std::chrono::microseconds(configuration.getNumber<unsigned>("latency_us", 1000u));
+    settings.connectSpread = std::chrono::milliseconds(configuration.getNumber<unsigned>("connect_spread_ms", 1000u));
+    settings.callsPerHour = std::stod(configuration.getString("calls_per_hour", "2"));
+    settings.smsPerHour = std::stod(configuration.getString("sms_per_hour", "4"));
+    settings.answerPercent = configuration.getNumber<unsigned>("answer_percent", 70u);
+    settings.declinePercent = configuration.getNumber<unsigned>("decline_percent", 10u);
+    settings.maxAnswerDelay = std::chrono::milliseconds(configuration.getNumber<unsigned>("answer_delay_ms", 5000u));
+    settings.meanHoldTime = std::chrono::seconds(configuration.getNumber<unsigned>("hold_s", 60u));
+    settings.traceFile = configuration.getString("trace", "");
+    settings.impairment = common::LinkImpairment::fromConfiguration(configuration);
+
+    if (settings.ueCount < 2u)
+    {
+        throw std::invalid_argument("ues shall be at least 2");
+    }
+    if (settings.callsPerHour < 0.0 or settings.smsPerHour < 0.0)
+    {
+        throw std::invalid_argument("calls_per_hour and sms_per_hour shall not be negative");
+    }
+    if (settings.answerPercent + settings.declinePercent > 100u)
+    {
+        throw std::invalid_argument("answer_percent + decline_percent shall be at most 100");
+    }
+    return settings;
+}
+
+Simulation::Simulation(Settings settingsArg,
+                       std::shared_ptr<const common::MultiLineConfig> configuration,
+                       common::ILogger &btsLogger,
+                       common::ILogger &ueLogger)
+    : settings(std::move(settingsArg)),
+      random(settings.seed),
+      clock(std::make_shared<common::VirtualClock>()),
+      bts(clock, btsLogger, settings.btsId, std::move(configuration))
+{
+    statistics.traceDigest = FNV_OFFSET;
+    if (not settings.traceFile.empty())
+    {
+        trace.open(settings.traceFile);
+        if (not trace)
+        {
+            throw std::runtime_error("Cannot create trace file: " + settings.traceFile);
+        }
+    }
+
+    links.reserve(settings.ueCount);
+    ues.reserve(settings.ueCount);
+
+    for (std::size_t ueIndex = 0u; ueIndex < settings.ueCount; ++ueIndex)
+    {
+        links.push_back(std::make_unique<SimulatedLink>(
+            *clock, ueIndex, settings.latency,
+            [this](std::size_t linkId, SimulatedLink::Direction direction, const common::BinaryMessage& message)
+            {
+                onFrame(linkId, direction, message);
+            }));
+        links.back()->setDisconnectionObserver([this, ueIndex] { scheduleReconnect(ueIndex); });
+        std::shared_ptr<common::ITransport> ueTransport = links.back()->ueEnd();
+        if (settings.impairment.isActive())
+        {
+            auto impairment = settings.impairment;
+            impairment.seed += settings.seed * settings.ueCount + ueIndex;
+            ueTransport = std::make_shared<common::ImpairedTransport>(std::move(ueTransport), *clock, impairment);
+        }
+        ues.push_back(std::make_unique<SimulatedUe>(*clock, ueLogger, phoneNumberOf(ueIndex),
+                                                    std::move(ueTransport), statistics));
+        ues.back()->setActivityObserver([this, ueIndex](SimulatedUe&, SimulatedUe::Activity previous)
+        {
+            onActivityChanged(ueIndex, previous);
+        });
+    }
+}
+
+Simulation::~Simulation()
+{
+    bts.stop();
+    ues.clear();
+    links.clear();
+}
+
+void Simulation::run(const std::function<void (std::chrono::seconds)> &progress)
+{
+    bts.start();
+    std::uniform_int_distribution<Duration::rep> connectTime(0, Duration(settings.connectSpread).count());
+    for (std::size_t ueIndex = 0u; ueIndex < settings.ueCount; ++ueIndex)
+    {
+        clock->scheduleAfter(Duration(connectTime(random)), [this, ueIndex]
+        {
+            bts.connect(links[ueIndex]->btsEnd());
+        });
+        scheduleUserAction(ueIndex);
+    }
+
+    for (std::chrono::seconds elapsed{}; elapsed < settings.duration;)
+    {
+        ++elapsed;
+        statistics.events += clock->advance(std::chrono::seconds(1));
+        progress(elapsed);
+    }
+    trace.flush();
+}
+
+SimulationStatistics &Simulation::getStatistics()
+{
+    return statistics;
+}
+
+void Simulation::onFrame(std::size_t ueIndex, SimulatedLink::Direction direction, const common::BinaryMessage &message)
+{
+    const bool toBts = direction == SimulatedLink::Direction::UeToBts;
+    ++(toBts ? statistics.framesToBts : statistics.framesToUe);
+    statistics.bytes += message.value.size();
+
+    // header is: MessageId, from, to - each one byte
+    const auto& value = message.value;
+    std::ostringstream line;
+    line << std::chrono::duration_cast<std::chrono::microseconds>(clock->now().time_since_epoch()).count()
+         << " ue#" << ueIndex << (toBts ? " up " : " down ")
+         << (value.size() > 0u ? to_string(common::MessageId{value[0]}) : std::string("?"))
+         << " from: " << (value.size() > 1u ? unsigned(value[1]) : 0u)
+         << " to: " << (value.size() > 2u ? unsigned(value[2]) : 0u)
+         << " size: " << value.size() << '\n';
+    const std::string text = std::move(line).str();
+    for (char character : text)
+    {
+        statistics.traceDigest = (statistics.traceDigest ^ static_cast<unsigned char>(character)) * FNV_PRIME;
+    }
+    if (trace.is_open())
+    {
+        trace << text;
+    }
+}
+
+void Simulation::onActivityChanged(std::size_t ueIndex, SimulatedUe::Activity previous)
+{
+    SimulatedUe& ue = *ues[ueIndex];
+    if (ue.getActivity() == SimulatedUe::Activity::Ringing)
+    {
+        const unsigned percent = std::uniform_int_distribution<unsigned>(0u, 99u)(random);
+        const Duration delay{std::uniform_int_distribution<Duration::rep>(
+                                 0, Duration(settings.maxAnswerDelay).count())(random)};
+        if (percent < settings.answerPercent)
+        {
+            scheduleIfUnchanged(ueIndex, delay, &SimulatedUe::answer);
+        }
+        else if (percent < settings.answerPercent + settings.declinePercent)
+        {
+            scheduleIfUnchanged(ueIndex, delay, &SimulatedUe::decline);
+        }
+        // else ignored - UE times out
+    }
+    else if (ue.getActivity() == SimulatedUe::Activity::Talking and previous == SimulatedUe::Activity::Dialling)
+    {
+        // caller ends the call
+        scheduleIfUnchanged(ueIndex, exponential(double(settings.meanHoldTime.count())), &SimulatedUe::hangUp);
+    }
+}
+
+void Simulation::scheduleReconnect(std::size_t ueIndex)
+{
+    clock->scheduleAfter(RECONNECT_DELAY, [this, ueIndex]
+    {
+        bts.connect(links[ueIndex]->reconnect());
+    });
+}
+
+void Simulation::scheduleUserAction(std::size_t ueIndex)
+{
+    const double perHour = settings.callsPerHour + settings.smsPerHour;
+    if (perHour > 0.0)
+    {
+        clock->scheduleAfter(exponential(SECONDS_IN_HOUR / perHour), [this, ueIndex]
+        {
+            userAction(ueIndex);
+            scheduleUserAction(ueIndex);
+        });
+    }
+}
+
+void Simulation::userAction(std::size_t ueIndex)
+{
+    SimulatedUe& ue = *ues[ueIndex];
+    const double perHour = settings.callsPerHour + settings.smsPerHour;
+    const bool isCall = std::uniform_real_distribution<double>(0.0, perHour)(random) < settings.callsPerHour;
+    const common::PhoneNumber peer = pickPeer(ue.getPhoneNumber());
+    if (ue.getActivity() == SimulatedUe::Activity::NotConnected
+        or ue.getActivity() == SimulatedUe::Activity::Connecting)
+    {
+        return;
+    }
+    if (isCall)
+    {
+        ue.call(peer);
+    }
+    else
+    {
+        ue.sendSms(peer, "sms #" + std::to_string(statistics.smsSent));
+    }
+}
+
+void Simulation::scheduleIfUnchanged(std::size_t ueIndex, Duration delay, bool (SimulatedUe::*action)())
+{
+    const std::uint64_t generation = ues[ueIndex]->getActivityGeneration();
+    clock->scheduleAfter(delay, [this, ueIndex, generation, action]
+    {
+        SimulatedUe& ue = *ues[ueIndex];
+        if (ue.getActivityGeneration() == generation)
+        {
+            (ue.*action)();
+        }
+    });
+}
+
+common::PhoneNumber Simulation::pickPeer(common::PhoneNumber self)
+{
+    const std::size_t numberCount = std::min(settings.ueCount, MAX_PHONE_NUMBER);
+    std::uniform_int_distribution<std::size_t> distribution(0u, numberCount - 2u);
+    std::size_t ueIndex = distribution(random);
+    // skip self - the last number takes its place
+    if (phoneNumberOf(ueIndex) == self)
+    {
+        ueIndex = numberCount - 1u;
+    }
+    return phoneNumberOf(ueIndex);
+}
+
+Simulation::Duration Simulation::exponential(double meanSeconds)
+{
+    if (not (meanSeconds > 0.0))
+    {
+        return Duration::zero();
+    }
+    const double seconds = std::exponential_distribution<double>(1.0 / meanSeconds)(random);
+    return std::chrono::duration_cast<Duration>(std::chrono::duration<double>(seconds));
+}
+
+}
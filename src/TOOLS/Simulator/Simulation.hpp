@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <vector>
+#include "CommonEnvironment/ImpairedTransport.hpp"
+#include "Config/MultiLineConfig.hpp"
+#include "Logger/ILogger.hpp"
+#include "Time/VirtualClock.hpp"
+#include "SimulatedBts.hpp"
+#include "SimulatedLink.hpp"
+#include "SimulatedUe.hpp"
+#include "SimulationStatistics.hpp"
+
+namespace tools
+{
+
+/**
+ * Discrete-event simulation of one BTS with many UEs - all timers, frame deliveries and user actions
+ * are events of one virtual clock, all randomness comes from one seeded generator.
+ * The same settings (including seed) give the same trace, at any speed of the host.
+ */
+class Simulation
+{
+public:
+    struct Settings
+    {
+        std::size_t ueCount;
+        std::uint64_t seed;
+        common::BtsId btsId;
+        std::chrono::seconds duration;
+        std::chrono::microseconds latency;
+        std::chrono::milliseconds connectSpread;
+        double callsPerHour;
+        double smsPerHour;
+        unsigned answerPercent;
+        unsigned declinePercent;
+        std::chrono::milliseconds maxAnswerDelay;
+        std::chrono::seconds meanHoldTime;
+        std::string traceFile;
+        // of UE side of each link (net_* keys)
+        common::LinkImpairment impairment;
+    };
+
+    /**
+     * @throw std::invalid_argument for inconsistent settings
+     */
+    static Settings readSettings(const common::MultiLineConfig& configuration);
+
+    /**
+     * @param configuration passed to BTS as its configuration (e.g. sib_tick_ms, sib_ticks)
+     * @throw std::runtime_error when trace file cannot be created
+     */
+    Simulation(Settings settings,
+               std::shared_ptr<const common::MultiLineConfig> configuration,
+               common::ILogger& btsLogger,
+               common::ILogger& ueLogger);
+    ~Simulation();
+
+    /**
+     * @param progress called after each simulated second
+     */
+    void run(const std::function<void(std::chrono::seconds)>& progress);
+
+    SimulationStatistics& getStatistics();
+
+private:
+    using Duration = common::IClock::Duration;
+
+    void onFrame(std::size_t ueIndex, SimulatedLink::Direction direction, const common::BinaryMessage& message);
+    void onActivityChanged(std::size_t ueIndex, SimulatedUe::Activity previous);
+    void scheduleReconnect(std::size_t ueIndex);
+    void scheduleUserAction(std::size_t ueIndex);
+    void userAction(std::size_t ueIndex);
+    void scheduleIfUnchanged(std::size_t ueIndex, Duration delay, bool (SimulatedUe::*action)());
+    common::PhoneNumber pickPeer(common::PhoneNumber self);
+    Duration exponential(double meanSeconds);
+
+    const Settings settings;
+    SimulationStatistics statistics;
+    std::mt19937_64 random;
+    std::ofstream trace;
+    std::shared_ptr<common::VirtualClock> clock;
+    SimulatedBts bts;
+    std::vector<std::unique_ptr<SimulatedLink>> links;
+    std::vector<std::unique_ptr<SimulatedUe>> ues;
+};
+
+}
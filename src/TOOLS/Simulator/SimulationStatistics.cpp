@@ -0,0 +1,72 @@
+#include "SimulationStatistics.hpp"
+#include <algorithm>
+#include <iomanip>
+
+namespace tools
+{
+
+namespace
+{
+
+void printLatencies(std::ostream& os, const char* name, std::vector<SimulationStatistics::Duration>& latencies)
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    os << std::setw(26) << std::left << name << std::right;
+    if (latencies.empty())
+    {
+        os << "-\n";
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double fraction)
+    {
+        const auto index = static_cast<std::size_t>(fraction * double(latencies.size() - 1u));
+        return Milliseconds(latencies[index]).count();
+    };
+    os << std::fixed << std::setprecision(3)
+       << "p50: " << percentile(0.5) << "ms, p99: " << percentile(0.99)
+       << "ms, max: " << Milliseconds(latencies.back()).count() << "ms (" << latencies.size() << " samples)\n"
+       << std::defaultfloat;
+}
+
+void printCounter(std::ostream& os, const char* name, std::uint64_t value)
+{
+    os << std::setw(26) << std::left << name << std::right << value << '\n';
+}
+
+}
+
+void SimulationStatistics::print(std::ostream &os)
+{
+    printCounter(os, "attach requests:", attachRequests);
+    printCounter(os, "attach accepts:", attachAccepts);
+    printCounter(os, "attach rejects:", attachRejects);
+    printCounter(os, "attach timeouts:", attachTimeouts);
+    printLatencies(os, "attach latency:", attachLatencies);
+    printCounter(os, "calls attempted:", callsAttempted);
+    printCounter(os, "calls accepted:", callsAccepted);
+    printCounter(os, "calls rejected:", callsRejected);
+    printCounter(os, "calls unknown recipient:", callsUnknownRecipient);
+    printCounter(os, "calls timed out:", callsTimedOut);
+    printCounter(os, "calls hung up:", callsHungUp);
+    printLatencies(os, "call setup:", callSetupLatencies);
+    printCounter(os, "calls offered:", callsOffered);
+    printCounter(os, "calls answered:", callsAnswered);
+    printCounter(os, "calls declined:", callsDeclined);
+    printCounter(os, "calls missed:", callsMissed);
+    printCounter(os, "call requests when busy:", callRequestsWhenBusy);
+    printCounter(os, "sms sent:", smsSent);
+    printCounter(os, "sms received:", smsReceived);
+    printCounter(os, "sms when busy:", smsWhenBusy);
+    printCounter(os, "sms unknown recipient:", smsUnknownRecipient);
+    printCounter(os, "user actions when busy:", userActionsWhenBusy);
+    printCounter(os, "frames to BTS:", framesToBts);
+    printCounter(os, "frames to UE:", framesToUe);
+    printCounter(os, "bytes:", bytes);
+    printCounter(os, "UE error logs:", ueErrorLogs);
+    printCounter(os, "events:", events);
+    os << std::setw(26) << std::left << "trace digest:" << std::right
+       << std::hex << std::setw(16) << std::setfill('0') << traceDigest << std::setfill(' ') << std::dec << '\n';
+}
+
+}
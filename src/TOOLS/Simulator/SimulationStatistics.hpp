@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "Time/IClock.hpp"
+
+namespace tools
+{
+
+/**
+ * Aggregates of one simulation run - counted by simulated UEs (both sides of each call) and links
+ */
+struct SimulationStatistics
+{
+    using Duration = common::IClock::Duration;
+
+    std::uint64_t attachRequests = 0u;
+    std::uint64_t attachAccepts = 0u;
+    std::uint64_t attachRejects = 0u;
+    std::uint64_t attachTimeouts = 0u;
+    std::vector<Duration> attachLatencies;
+
+    // caller side
+    std::uint64_t callsAttempted = 0u;
+    std::uint64_t callsAccepted = 0u;
+    std::uint64_t callsRejected = 0u;
+    std::uint64_t callsUnknownRecipient = 0u;
+    std::uint64_t callsTimedOut = 0u;
+    std::uint64_t callsHungUp = 0u;
+    std::vector<Duration> callSetupLatencies;
+
+    // callee side
+    std::uint64_t callsOffered = 0u;
+    std::uint64_t callsAnswered = 0u;
+    std::uint64_t callsDeclined = 0u;
+    std::uint64_t callsMissed = 0u;
+    std::uint64_t callRequestsWhenBusy = 0u;
+
+    std::uint64_t smsSent = 0u;
+    std::uint64_t smsReceived = 0u;
+    std::uint64_t smsWhenBusy = 0u;
+    std::uint64_t smsUnknownRecipient = 0u;
+
+    std::uint64_t userActionsWhenBusy = 0u;
+    std::uint64_t framesToBts = 0u;
+    std::uint64_t framesToUe = 0u;
+    std::uint64_t bytes = 0u;
+    std::uint64_t ueErrorLogs = 0u;
+    std::uint64_t events = 0u;
+    std::uint64_t traceDigest = 0u;
+
+    void print(std::ostream& os);
+};
+
+}
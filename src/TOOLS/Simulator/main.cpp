@@ -0,0 +1,104 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include "Config/MultiLineConfig.hpp"
+#include "Logger/Logger.hpp"
+#include "Simulation.hpp"
+
+/**
+ * Deterministic discrete-event simulation of BTS with thousands of UEs - real BTS and UE applications,
+ * in-memory links, virtual time. The same arguments give the same trace (and trace digest).
+ * Usage: Simulator [ues=254] [seed=1] [duration_s=600] [latency_us=1000] [connect_spread_ms=1000]
+ *                  [calls_per_hour=2] [sms_per_hour=4] [answer_percent=70] [decline_percent=10]
+ *                  [answer_delay_ms=5000] [hold_s=60] [trace=<file>] [log=<file>] [bts_id=1]
+ *                  [sib_tick_ms=100] [sib_ticks=50]
+ *                  [net_latency_us=0] [net_jitter_us=0] [net_bandwidth_bytes_s=0] [net_reorder_percent=0]
+ *                  [net_disconnect_mtbf_ms=0] [net_outage_ms=1000] [net_seed=0]
+ * net_* keys impair UE side of every link - see common::LinkImpairment. Outage closes the link, the UE reconnects
+ * 10s later (as the real UE transport does) and attaches again on next SIB.
+ * Phone numbers are one byte - UEs above 254 share numbers, so only one UE per number can be attached.
+ * The rest keep getting attach rejects and retry on every SIB: such a run measures reject churn
+ * (10000 UEs for an hour: ~900k rejects, ~1.8M BTS error logs, seconds to minutes of wall time,
+ * and a trace of hundreds of MB), not the traffic of attached UEs.
+ */
+
+namespace
+{
+
+/**
+ * Counts errors, optionally passes everything to file logger
+ */
+class CountingLogger : public common::ILogger
+{
+public:
+    CountingLogger(common::ILogger* next, std::uint64_t& errors)
+        : next(next),
+          errors(errors)
+    {}
+
+    void log(Level level, const std::string& message) override
+    {
+        if (level == ERROR_LEVEL)
+        {
+            ++errors;
+        }
+        if (next)
+        {
+            next->log(level, message);
+        }
+    }
+
+private:
+    common::ILogger* next;
+    std::uint64_t& errors;
+};
+
+}
+
+int main(int argc, char* argv[])
+{
+    auto configuration = std::make_shared<common::MultiLineConfig>(argc - 1, argv + 1);
+    try
+    {
+        const auto settings = tools::Simulation::readSettings(*configuration);
+        const std::string logFile = configuration->getString("log", "");
+        std::ofstream logStream;
+        std::unique_ptr<common::Logger> fileLogger;
+        if (not logFile.empty())
+        {
+            logStream.open(logFile);
+            fileLogger = std::make_unique<common::Logger>(logStream);
+        }
+
+        std::uint64_t btsErrors = 0u;
+        std::uint64_t ueErrors = 0u;
+        CountingLogger btsLogger(fileLogger.get(), btsErrors);
+        CountingLogger ueLogger(fileLogger.get(), ueErrors);
+
+        const auto wallStart = std::chrono::steady_clock::now();
+        tools::Simulation simulation(settings, configuration, btsLogger, ueLogger);
+        const auto progressStep = std::max<std::chrono::seconds::rep>(settings.duration.count() / 10, 1);
+        simulation.run([&](std::chrono::seconds elapsed)
+        {
+            if (elapsed.count() % progressStep == 0)
+            {
+                std::clog << "simulated " << elapsed.count() << "s of " << settings.duration.count() << "s" << std::endl;
+            }
+        });
+        const std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - wallStart;
+
+        auto& statistics = simulation.getStatistics();
+        statistics.ueErrorLogs = ueErrors;
+        std::cout << "UEs: " << settings.ueCount << ", seed: " << settings.seed
+                  << ", simulated: " << settings.duration.count() << "s in " << wallTime.count() << "s of wall time\n";
+        statistics.print(std::cout);
+        // rate limited by wall clock - not part of deterministic results
+        std::cout << "BTS error logs: " << btsErrors << std::endl;
+    }
+    catch (std::exception& ex)
+    {
+        std::cerr << "Simulator failed: " << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -9,7 +9,7 @@ Application::Application(common::PhoneNumber phoneNumber,
                          IBtsPort &bts,
                          IUserPort &user,
                          ITimerPort &timer)
-    : context{iLogger, bts, user, timer},
+    : context{iLogger, bts, user, timer, {}, phoneNumber},
       logger(iLogger, "[APP] ")
 {
     logger.logInfo("Started");
@@ -2,6 +2,8 @@
 
 #include "IEventsHandler.hpp"
 #include "Logger/ILogger.hpp"
+#include "Trace/FlightRecorder.hpp"
+#include "Trace/Probes.hpp"
 #include <memory>
 
 namespace ue
@@ -14,10 +16,15 @@ struct Context
     IUserPort& user;
     ITimerPort& timer;
     std::unique_ptr<IEventsHandler> state{};
+    // only for traces
+    common::PhoneNumber phoneNumber{};
 
+    // State::name() - string literal naming the state in traces
     template <typename State, typename ...Arg>
     void setState(Arg&& ...arg)
     {
+        common::FlightRecorder::instance().recordStateChange(State::name());
+        STH_PROBE(ue_state, phoneNumber.value, State::name());
         state = std::make_unique<State>(*this, std::forward<Arg>(arg)...);
     }
 };
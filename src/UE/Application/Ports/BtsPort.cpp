@@ -1,6 +1,8 @@
 #include "BtsPort.hpp"
 #include "Messages/IncomingMessage.hpp"
 #include "Messages/OutgoingMessage.hpp"
+#include "Trace/FlightRecorder.hpp"
+#include "Trace/Probes.hpp"
 
 namespace ue
 {
@@ -27,6 +29,8 @@ void BtsPort::stop()
 
 void BtsPort::handleMessage(BinaryMessage msg)
 {
+    common::FlightRecorder::instance().recordFrameReceived(msg);
+    STH_PROBE_FRAME(frame_received, this, msg);
     try
     {
         common::IncomingMessage reader{msg};
@@ -89,6 +93,12 @@ void BtsPort::handleMessage(BinaryMessage msg)
             handler->handleUnknownRecipient();
             break;
         }
+        case common::MessageId::Echo:
+        {
+            // answered here - liveness and RTT shall not depend on the state machine
+            sendEchoReply(from, reader);
+            break;
+        }
         default:
             logger.logError("unknow message: ", msgId, ", from: ", from);
         }
@@ -107,7 +117,7 @@ void BtsPort::sendAttachRequest(common::BtsId btsId)
                                 phoneNumber,
                                 common::PhoneNumber{}};
     msg.writeBtsId(btsId);
-    transport.sendMessage(msg.getMessage());
+    send(msg.getMessage());
 }
 
 void BtsPort::sendSms(common::PhoneNumber recipient, const std::string& text)
@@ -117,7 +127,7 @@ void BtsPort::sendSms(common::PhoneNumber recipient, const std::string& text)
                                phoneNumber,
                                recipient};
     msg.writeText(text);
-    transport.sendMessage(msg.getMessage());
+    send(msg.getMessage());
 }
 
 void BtsPort::sendCallRequest(common::PhoneNumber recipient)
@@ -126,7 +136,7 @@ void BtsPort::sendCallRequest(common::PhoneNumber recipient)
     common::OutgoingMessage msg{common::MessageId::CallRequest,
                                phoneNumber,
                                recipient};
-    transport.sendMessage(msg.getMessage());
+    send(msg.getMessage());
 }
 
 void BtsPort::sendCallAccepted(common::PhoneNumber recipient)
@@ -135,7 +145,7 @@ void BtsPort::sendCallAccepted(common::PhoneNumber recipient)
     common::OutgoingMessage msg{common::MessageId::CallAccepted,
                                phoneNumber,
                                recipient};
-    transport.sendMessage(msg.getMessage());
+    send(msg.getMessage());
 }
 
 void BtsPort::sendCallDropped(common::PhoneNumber recipient)
@@ -144,7 +154,7 @@ void BtsPort::sendCallDropped(common::PhoneNumber recipient)
     common::OutgoingMessage msg{common::MessageId::CallDropped,
                                phoneNumber,
                                recipient};
-    transport.sendMessage(msg.getMessage());
+    send(msg.getMessage());
 }
 
 void BtsPort::sendCallTalk(common::PhoneNumber recipient, const std::string& text)
@@ -154,7 +164,26 @@ void BtsPort::sendCallTalk(common::PhoneNumber recipient, const std::string& tex
                                phoneNumber,
                                recipient};
     msg.writeText(text);
-    transport.sendMessage(msg.getMessage());
+    send(msg.getMessage());
+}
+
+void BtsPort::sendEchoReply(common::PhoneNumber bts, common::IncomingMessage& echo)
+{
+    auto sequence = echo.readNumber<std::uint32_t>();
+    auto sentAt = echo.readNumber<std::uint64_t>();
+    common::OutgoingMessage msg{common::MessageId::EchoReply,
+                                phoneNumber,
+                                bts};
+    msg.writeNumber(sequence);
+    msg.writeNumber(sentAt);
+    send(msg.getMessage());
+}
+
+void BtsPort::send(BinaryMessage msg)
+{
+    common::FlightRecorder::instance().recordFrameSent(msg);
+    STH_PROBE_FRAME(frame_sent, this, msg);
+    transport.sendMessage(std::move(msg));
 }
 
 }
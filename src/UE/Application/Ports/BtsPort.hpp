@@ -4,6 +4,7 @@
 #include "Logger/PrefixedLogger.hpp"
 #include "ITransport.hpp"
 #include "Messages/PhoneNumber.hpp"
+#include "Messages/IncomingMessage.hpp"
 
 namespace ue
 {
@@ -24,6 +25,8 @@ public:
 
 private:
     void handleMessage(BinaryMessage msg);
+    void sendEchoReply(common::PhoneNumber bts, common::IncomingMessage& echo);
+    void send(BinaryMessage msg);
 
     common::PrefixedLogger logger;
     common::ITransport& transport;
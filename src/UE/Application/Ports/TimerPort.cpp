@@ -1,10 +1,12 @@
 #include "TimerPort.hpp"
+#include "Trace/FlightRecorder.hpp"
 
 namespace ue
 {
 
-TimerPort::TimerPort(common::ILogger &logger)
-    : logger(logger, "[TIMER PORT]")
+TimerPort::TimerPort(common::ILogger &logger, common::IClock &clock)
+    : logger(logger, "[TIMER PORT]"),
+      clock(clock)
 {}
 
 void TimerPort::start(ITimerEventsHandler &handler)
@@ -16,17 +18,41 @@ void TimerPort::start(ITimerEventsHandler &handler)
 void TimerPort::stop()
 {
     logger.logDebug("Stoped");
+    cancelTimer();
     handler = nullptr;
 }
 
 void TimerPort::startTimer(Duration duration)
 {
     logger.logDebug("Start timer: ", duration.count(), "ms");
+    common::FlightRecorder::instance().recordTimerStart(duration);
+    // only one timer at a time - restart replaces the running one
+    cancelTimer();
+    timer = clock.scheduleAfter(duration, [this]
+    {
+        timer.reset();
+        logger.logDebug("Timeout");
+        if (handler)
+        {
+            handler->handleTimeout();
+        }
+    });
 }
 
 void TimerPort::stopTimer()
 {
     logger.logDebug("Stop timer");
+    common::FlightRecorder::instance().recordTimerStop();
+    cancelTimer();
+}
+
+void TimerPort::cancelTimer()
+{
+    if (timer)
+    {
+        clock.cancel(*timer);
+        timer.reset();
+    }
 }
 
 }
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <optional>
 #include "ITimerPort.hpp"
 #include "Logger/PrefixedLogger.hpp"
+#include "Time/IClock.hpp"
 
 namespace ue
 {
@@ -9,7 +11,7 @@ namespace ue
 class TimerPort : public ITimerPort
 {
 public:
-    TimerPort(common::ILogger& logger);
+    TimerPort(common::ILogger& logger, common::IClock& clock);
 
     void start(ITimerEventsHandler& handler);
     void stop();
@@ -19,8 +21,12 @@ public:
     void stopTimer() override;
 
 private:
+    void cancelTimer();
+
     common::PrefixedLogger logger;
+    common::IClock& clock;
     ITimerEventsHandler* handler = nullptr;
+    std::optional<common::IClock::TimerId> timer;
 };
 
 }
@@ -1,10 +1,12 @@
 #include "SmsDb.hpp"
+#include "Memory/MemoryTag.hpp"
 
 namespace ue
 {
 
 void SmsDb::addSms(PhoneNumber from, const std::string& text)
 {
+    common::MemoryTagScope memoryTag(common::MemoryTag::SmsDb);
     SmsMessage message;
     message.from = from;
     message.to = PhoneNumber{};
@@ -16,6 +18,7 @@ void SmsDb::addSms(PhoneNumber from, const std::string& text)
 
 void SmsDb::addSentSms(PhoneNumber to, const std::string& text)
 {
+    common::MemoryTagScope memoryTag(common::MemoryTag::SmsDb);
     SmsMessage message;
     message.from = PhoneNumber{};  // From field is empty for sent messages
     message.to = to;
@@ -7,7 +7,7 @@ namespace ue
 {
 
 ConnectedState::ConnectedState(Context &context)
-    : BaseState(context, "ConnectedState")
+    : BaseState(context, name())
 {
     // We need to call either showConnected or showMenuView, but not both
     // since showMenuView already calls showConnected internally
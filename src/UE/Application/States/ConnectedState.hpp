@@ -10,6 +10,7 @@ class ConnectedState : public BaseState
 {
 public:
     ConnectedState(Context& context);
+    static const char* name() { return "ConnectedState"; }
 
     // IBtsEventsHandler interface
     void handleDisconnected() override;
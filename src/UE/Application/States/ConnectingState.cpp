@@ -6,7 +6,7 @@ namespace ue
 {
 
 ConnectingState::ConnectingState(Context &context)
-    : BaseState(context, "ConnectingState")
+    : BaseState(context, name())
 {
     context.user.showConnecting();
 }
@@ -9,6 +9,7 @@ class ConnectingState : public BaseState
 {
 public:
     ConnectingState(Context& context);
+    static const char* name() { return "ConnectingState"; }
 
     // IBtsEventsHandler interface
     void handleAttachAccept() override;
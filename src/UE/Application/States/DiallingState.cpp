@@ -11,7 +11,7 @@ namespace ue
 const std::chrono::milliseconds DiallingState::CALL_TIMEOUT{60000}; // 60 seconds timeout
 
 DiallingState::DiallingState(Context &context)
-    : BaseState(context, "DiallingState")
+    : BaseState(context, name())
 {
     logger.logInfo("Dialling");
     showDialView();
@@ -9,6 +9,7 @@ class DiallingState : public BaseState
 {
 public:
     DiallingState(Context& context);
+    static const char* name() { return "DiallingState"; }
     ~DiallingState() override;
 
     // ITimerEventsHandler interface
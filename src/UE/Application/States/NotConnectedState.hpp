@@ -9,6 +9,7 @@ class NotConnectedState : public BaseState
 {
 public:
     NotConnectedState(Context& context);
+    static const char* name() { return "NotConnectedState"; }
 
     // IBtsEventsHandler interface
 public:
@@ -6,7 +6,7 @@ namespace ue
 {
 
 ReceivingCallState::ReceivingCallState(Context &context, common::PhoneNumber caller)
-    : BaseState(context, "ReceivingCallState"),
+    : BaseState(context, name()),
       callerPhoneNumber(caller)
 {
     logger.logInfo("Incoming call from: ", callerPhoneNumber);
@@ -9,6 +9,7 @@ class ReceivingCallState : public BaseState
 {
 public:
     ReceivingCallState(Context& context, common::PhoneNumber caller);
+    static const char* name() { return "ReceivingCallState"; }
     ~ReceivingCallState() override;
 
     // ITimerEventsHandler interface
@@ -5,7 +5,7 @@ namespace ue
 {
 
 TalkingState::TalkingState(Context &context, common::PhoneNumber peer)
-    : BaseState(context, "TalkingState"),
+    : BaseState(context, name()),
       peerPhoneNumber(peer)
 {
     logger.logInfo("Talking with: ", peerPhoneNumber);
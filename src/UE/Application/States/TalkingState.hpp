@@ -9,6 +9,7 @@ class TalkingState : public BaseState
 {
 public:
     TalkingState(Context& context, common::PhoneNumber peer);
+    static const char* name() { return "TalkingState"; }
 
     // IBtsEventsHandler interface
     void handleDisconnected() override;
@@ -4,6 +4,7 @@
 #include "ITransport.hpp"
 #include "Logger/Logger.hpp"
 #include "Messages/PhoneNumber.hpp"
+#include "Time/IClock.hpp"
 
 namespace ue
 {
@@ -18,6 +19,8 @@ public:
     virtual IUeGui& getUeGui() = 0;
     virtual ITransport& getTransportToBts() = 0;
     virtual ILogger& getLogger() = 0;
+    /** Timers fire from the message loop */
+    virtual common::IClock& getClock() = 0;
 
     virtual void startMessageLoop() = 0;
 
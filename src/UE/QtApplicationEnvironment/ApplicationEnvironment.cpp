@@ -5,7 +5,12 @@
 #include <ctime>
 #include <iomanip>
 #include <fstream>
+#include <csignal>
 #include "Messages.hpp"
+#include "Trace/FlightRecorder.hpp"
+#include "Logger/SharedMemoryLogRing.hpp"
+#include "Trace/LoopLagMonitor.hpp"
+#include "Memory/MemoryAccounting.hpp"
 
 namespace ue
 {
@@ -30,18 +35,47 @@ std::string logFilename(PhoneNumber phoneNumber)
     return os.str();
 }
 
+std::string flightDumpFilename(PhoneNumber phoneNumber)
+{
+    std::ostringstream os;
+    os << "ue" << phoneNumber << "_flight.txt";
+    return os.str();
+}
+
 } // namespace
 
 ApplicationEnvironment::ApplicationEnvironment(int& argc, char* argv[])
-    : configuration(ApplicationEnvironment::readConfiguration(argc, argv)),
-      myPhoneNumber(PhoneNumber{configuration->getNumber<decltype(PhoneNumber::value)>("phone", 123)}),
-      logFile(logFilename(myPhoneNumber)),
-      loggerBase(logFile),
+    : commandLineConfiguration(argc - 1, argv + 1),
+      configuration(readConfiguration(commandLineConfiguration)),
+      myPhoneNumber(PhoneNumber{configuration.get()->getNumber<decltype(PhoneNumber::value)>("phone", 123)}),
+      logStream(createLogStream(*configuration.get(), myPhoneNumber)),
+      loggerBase(*logStream),
       logger(loggerBase, getPhoneNumberPrefix(myPhoneNumber)),
       qApplication(argc, argv),
       gui(logger),
-      transport(*configuration, logger)
+      transport(*configuration.get(), logger),
+      configurationWatcher(configurationFilename(commandLineConfiguration), configuration,
+                           [this] { return readConfiguration(commandLineConfiguration); }, logger)
 {
+    configuration.subscribe([this](const common::MultiLineConfig& newConfiguration)
+    {
+        loggerBase.setLevelThreshold(newConfiguration.getNumber("log_level", ILogger::DEBUG_LEVEL));
+        common::LoopLagMonitor::instance().reconfigure(
+            std::chrono::milliseconds(newConfiguration.getNumber<int>("loop_lag_period_ms", 100)),
+            std::chrono::milliseconds(newConfiguration.getNumber<int>("loop_lag_warn_ms", 50)));
+    });
+    common::FlightRecorder::installDumpSignalHandler(flightDumpFilename(myPhoneNumber), SIGUSR1);
+
+    auto linkImpairment = common::LinkImpairment::fromConfiguration(*configuration.get());
+    if (linkImpairment.isActive())
+    {
+        linkImpairment.seed += myPhoneNumber.value;
+        // non-owning - transport is a member
+        impairedTransport = std::make_unique<common::ImpairedTransport>(
+            std::shared_ptr<ITransport>(std::shared_ptr<ITransport>{}, &transport), clock, linkImpairment);
+        logger.logInfo("Link to BTS impaired - latency: ", linkImpairment.latency.count(), "us, jitter: ",
+                       linkImpairment.jitter.count(), "us, bandwidth: ", linkImpairment.bytesPerSecond, "B/s");
+    }
 }
 
 ue::IUeGui& ApplicationEnvironment::getUeGui()
@@ -51,6 +85,10 @@ ue::IUeGui& ApplicationEnvironment::getUeGui()
 
 ue::ITransport& ApplicationEnvironment::getTransportToBts()
 {
+    if (impairedTransport)
+    {
+        return *impairedTransport;
+    }
     return transport;
 }
 
@@ -59,17 +97,44 @@ ILogger &ApplicationEnvironment::getLogger()
     return logger;
 }
 
+common::IClock &ApplicationEnvironment::getClock()
+{
+    return clock;
+}
+
 void ApplicationEnvironment::startMessageLoop()
 {
     gui.start();
+    auto& loopLagMonitor = common::LoopLagMonitor::instance();
+    loopLagMonitor.start(loopLagClock, [this](std::function<void()> probe)
+    {
+        QMetaObject::invokeMethod(&qApplication, std::move(probe), Qt::QueuedConnection);
+    }, logger);
+    suppressedLogReporter.start(loopLagClock, logger);
     qApplication.exec();
+    suppressedLogReporter.stop();
+    loopLagMonitor.stop();
+    // UE has no console - summary goes to the log
+    std::ostringstream summary;
+    loopLagMonitor.print(summary);
+    logger.logInfo("Event loop summary:\n", summary.str());
+    std::ostringstream memory;
+    const auto noPreviousSnapshot = common::MemoryAccounting::Snapshot{};
+    common::MemoryAccounting::print(memory, common::MemoryAccounting::snapshot(), noPreviousSnapshot, 0.0);
+    logger.logInfo("Memory summary:\n", memory.str());
+}
+
+std::string ApplicationEnvironment::configurationFilename(const common::MultiLineConfig& commandLineConfiguration)
+{
+    return commandLineConfiguration.getString("config", "config");
 }
 
-std::unique_ptr<common::MultiLineConfig> ApplicationEnvironment::readConfiguration(int argc, char *argv[])
+common::ReloadableConfig::Snapshot ApplicationEnvironment::readConfiguration(const common::MultiLineConfig& commandLineConfiguration)
 {
-    auto commandLineConfig = std::make_unique<common::MultiLineConfig>(argc - 1, argv + 1);
+    // command line values take precedence over file values
+    auto commandLineConfig = std::make_shared<common::MultiLineConfig>(commandLineConfiguration);
 
-    std::string configFile = commandLineConfig->getString("config", "config");
+    std::string configFile = configurationFilename(commandLineConfiguration);
 
     try
     {
@@ -87,6 +152,25 @@ std::unique_ptr<common::MultiLineConfig> ApplicationEnvironment::readConfigurati
     return commandLineConfig;
 }
 
+std::unique_ptr<std::ostream> ApplicationEnvironment::createLogStream(const common::MultiLineConfig& configuration,
+                                                                      PhoneNumber phoneNumber)
+{
+    // log_shm = <ring name> - logs go to ring drained by LogCollector instead of own file
+    std::string logRingName = configuration.getString("log_shm", "");
+    if (not logRingName.empty())
+    {
+        try
+        {
+            return std::make_unique<common::SharedMemoryLogStream>(logRingName, phoneNumber);
+        }
+        catch (std::exception& ex)
+        {
+            std::clog << "Note: " << ex.what() << "\n\t((is LogCollector running? logging to file))" << std::endl;
+        }
+    }
+    return std::make_unique<std::ofstream>(logFilename(phoneNumber));
+}
+
 PhoneNumber ApplicationEnvironment::getMyPhoneNumber() const
 {
     return myPhoneNumber;
@@ -94,7 +178,7 @@ PhoneNumber ApplicationEnvironment::getMyPhoneNumber() const
 
 std::int32_t ApplicationEnvironment::getProperty(std::string const& name, std::int32_t defaultValue) const
 {
-    return configuration->getNumber<std::int32_t>(name, defaultValue);
+    return configuration.get()->getNumber<std::int32_t>(name, defaultValue);
 }
 
 }
@@ -3,10 +3,16 @@
 #include "IApplicationEnvironment.hpp"
 #include "GUI/QtApplication.hpp"
 #include "Transport/Transport.hpp"
+#include "QtClock.hpp"
 #include <QApplication>
 #include "Logger/Logger.hpp"
+#include "Logger/SuppressedLogReporter.hpp"
 #include "Logger/PrefixedLogger.hpp"
 #include "Config/MultiLineConfig.hpp"
+#include "Config/ReloadableConfig.hpp"
+#include "Config/ConfigFileWatcher.hpp"
+#include "CommonEnvironment/ImpairedTransport.hpp"
+#include "Time/SteadyClock.hpp"
 #include <fstream>
 
 namespace ue
@@ -19,23 +25,35 @@ public:
     IUeGui& getUeGui() override;
     ITransport& getTransportToBts() override;
     ILogger& getLogger() override;
+    common::IClock& getClock() override;
     PhoneNumber getMyPhoneNumber() const override;
     std::int32_t getProperty(std::string const& name, std::int32_t defaultValue) const override;
 
     void startMessageLoop() override;
 
 private:
-    std::unique_ptr<common::MultiLineConfig> configuration;
+    common::MultiLineConfig commandLineConfiguration;
+    common::ReloadableConfig configuration;
     PhoneNumber myPhoneNumber;
-    std::ofstream logFile;
+    std::unique_ptr<std::ostream> logStream;
     common::Logger loggerBase;
     common::PrefixedLogger logger;
 
+    // timers of event loop lag probes - QtClock would run them on the loop they measure
+    common::SteadyClock loopLagClock;
+    // its timers run on loopLagClock too
+    common::SuppressedLogReporter suppressedLogReporter;
     QApplication qApplication;
+    QtClock clock;
     QtUeGui gui;
     Transport transport;
+    // net_* configuration keys - null when impairment is off
+    std::unique_ptr<common::ImpairedTransport> impairedTransport;
+    common::ConfigFileWatcher configurationWatcher;
 
-    static std::unique_ptr<common::MultiLineConfig> readConfiguration(int argc, char* argv[]);
+    static common::ReloadableConfig::Snapshot readConfiguration(const common::MultiLineConfig& commandLineConfiguration);
+    static std::string configurationFilename(const common::MultiLineConfig& commandLineConfiguration);
+    static std::unique_ptr<std::ostream> createLogStream(const common::MultiLineConfig& configuration, PhoneNumber phoneNumber);
 
 
 };
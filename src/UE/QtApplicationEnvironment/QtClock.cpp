@@ -0,0 +1,66 @@
+#include "QtClock.hpp"
+#include <QTimer>
+#include <algorithm>
+#include <limits>
+
+namespace ue
+{
+
+QtClock::QtClock() = default;
+QtClock::~QtClock() = default;
+
+common::IClock::TimePoint QtClock::now() const
+{
+    return std::chrono::steady_clock::now();
+}
+
+common::IClock::TimerId QtClock::scheduleAt(TimePoint when, Callback callback)
+{
+    using namespace std::chrono;
+    const TimerId timerId = ++lastTimerId;
+    // rounded up - timer shall never fire before its time point
+    const auto delay = ceil<milliseconds>(std::max(when - now(), Duration::zero()));
+    const auto interval = std::min<milliseconds::rep>(delay.count(), std::numeric_limits<int>::max());
+
+    auto qTimer = std::make_unique<QTimer>();
+    qTimer->setSingleShot(true);
+    qTimer->setTimerType(Qt::PreciseTimer);
+    QObject::connect(qTimer.get(), &QTimer::timeout, [this, timerId] { fire(timerId); });
+    qTimer->start(static_cast<int>(interval));
+
+    timers.emplace(timerId, Timer{std::move(qTimer), std::move(callback)});
+    return timerId;
+}
+
+bool QtClock::cancel(TimerId timerId)
+{
+    auto found = timers.find(timerId);
+    if (found == timers.end())
+    {
+        return false;
+    }
+    dispose(found->second);
+    timers.erase(found);
+    return true;
+}
+
+void QtClock::fire(TimerId timerId)
+{
+    auto found = timers.find(timerId);
+    if (found == timers.end())
+    {
+        return;
+    }
+    Callback callback = std::move(found->second.callback);
+    dispose(found->second);
+    timers.erase(found);
+    callback();
+}
+
+void QtClock::dispose(Timer &timer)
+{
+    timer.qTimer->stop();
+    timer.qTimer.release()->deleteLater();
+}
+
+}
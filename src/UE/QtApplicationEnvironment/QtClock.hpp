@@ -0,0 +1,42 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include "Time/IClock.hpp"
+
+class QTimer;
+
+namespace ue
+{
+
+/**
+ * Real time clock for Qt application - callbacks are called from the Qt event loop,
+ * so they are serialized with GUI and transport events.
+ * To be used from Qt main thread only.
+ */
+class QtClock : public common::IClock
+{
+public:
+    QtClock();
+    ~QtClock() override;
+
+    TimePoint now() const override;
+    TimerId scheduleAt(TimePoint when, Callback callback) override;
+    bool cancel(TimerId timerId) override;
+
+private:
+    struct Timer
+    {
+        std::unique_ptr<QTimer> qTimer;
+        Callback callback;
+    };
+
+    void fire(TimerId timerId);
+    // sender of the signal being handled must not be deleted right away
+    static void dispose(Timer& timer);
+
+    std::map<TimerId, Timer> timers;
+    TimerId lastTimerId = 0u;
+};
+
+}
@@ -5,12 +5,14 @@
 #include "Config/MultiLineConfig.hpp"
 #include "Messages/OutgoingMessage.hpp"
 #include "Messages/IncomingMessage.hpp"
+#include "Trace/LoopLagMonitor.hpp"
+#include "Memory/MemoryTag.hpp"
 #include <functional>
 
 namespace ue
 {
 
-Transport::Transport(common::MultiLineConfig& configuration, common::ILogger &loggerBase)
+Transport::Transport(const common::MultiLineConfig& configuration, common::ILogger &loggerBase)
     : logger(loggerBase, "[TRANSPORT]"),
       port(configuration.getNumber("port", 8181)),
       server(configuration.getString("server", "localhost")),
@@ -41,6 +43,11 @@ Transport::Transport(common::MultiLineConfig& configuration, common::ILogger &lo
 
 void Transport::connectToServer()
 {
+    // error and disconnection of the same socket both ask for reconnection
+    if (socket->state() != QAbstractSocket::UnconnectedState)
+    {
+        return;
+    }
     socket->connectToHost(server.data(), port);
 }
 
@@ -52,6 +59,7 @@ bool Transport::sendMessageSlot(const QByteArray &message)
         return false;
     }
     logger.logDebug("Send message of size: ", message.size());
+    common::MemoryTagScope memoryTag(common::MemoryTag::Transport);
     socket->write(message);
     socket->flush();
     return true;
@@ -79,6 +87,7 @@ void Transport::registerDisconnectedCallback(ITransport::DisconnectedCallback di
 
 bool Transport::sendMessage(BinaryMessage message)
 {
+    common::MemoryTagScope memoryTag(common::MemoryTag::Transport);
     common::OutgoingMessage sizeEncoder;
     sizeEncoder.writeNumber<BinaryMessage::SizeType>(message.value.size());
     BinaryMessage size = sizeEncoder.getMessage();
@@ -89,6 +98,11 @@ bool Transport::sendMessage(BinaryMessage message)
     return emit sendMessageSignal(array);
 }
 
+void Transport::close()
+{
+    QMetaObject::invokeMethod(socket.get(), [this] { socket->abort(); }, Qt::QueuedConnection);
+}
+
 std::string Transport::addressToString() const
 {
     if(not isConnected())
@@ -100,6 +114,7 @@ std::string Transport::addressToString() const
 
 void Transport::readData()
 {
+    common::LoopLagMonitor::Wakeup wakeup;
     const std::size_t sizeSize = sizeof(BinaryMessage::SizeType);
     quint64 bytesAvailable;
     while ((bytesAvailable = socket->bytesAvailable()) >= sizeSize)
@@ -118,6 +133,7 @@ void Transport::readData()
 
         BinaryMessage message{ BinaryMessage::Value(messageLength) };
         socket->read(reinterpret_cast<char*>(message.value.data()), messageLength);
+        wakeup.frame();
         if (messageCallback)
         {
             messageCallback(std::move(message));
@@ -141,8 +157,7 @@ void Transport::handleError(QAbstractSocket::SocketError socketError)
         default:
             logger.logError(socket->errorString().toStdString());
     }
-    //QTimer::singleShot(10000,[this](){this->connectToServer();});
-     QTimer::singleShot(10000, this, SLOT(connectToServer()));
+    QTimer::singleShot(RECONNECT_DELAY_MS, this, SLOT(connectToServer()));
 }
 
 void Transport::handleClosingConnection()
@@ -156,6 +171,8 @@ void Transport::handleClosingConnection()
     {
         logger.logError("Connection lost! - application not interested!");
     }
+    // also after close() - e.g. outage of impaired link
+    QTimer::singleShot(RECONNECT_DELAY_MS, this, SLOT(connectToServer()));
 }
 
 }
@@ -22,11 +22,12 @@ class Transport: public QObject, public ITransport
 public slots:
 	void connectToServer();
 public:
-    Transport(common::MultiLineConfig& configuration, common::ILogger& logger);
+    Transport(const common::MultiLineConfig& configuration, common::ILogger& logger);
     ~Transport();
     void registerMessageCallback(MessageCallback messageCallback) override;
     void registerDisconnectedCallback(DisconnectedCallback disconnectedCallback) override;
     bool sendMessage(BinaryMessage message) override;
+    void close() override;
     std::string addressToString() const override;
 
 private slots:
@@ -35,6 +36,8 @@ signals:
     bool sendMessageSignal(const QByteArray & message);
 
 private:
+    static constexpr int RECONNECT_DELAY_MS = 10000;
+
     void readData();
     void handleError(QAbstractSocket::SocketError socketError);
     void handleClosingConnection();
@@ -7,7 +7,9 @@
 #include "Mocks/IUserPortMock.hpp"
 #include "Mocks/ITimerPortMock.hpp"
 #include "Messages/PhoneNumber.hpp"
+#include "Trace/FlightRecorder.hpp"
 #include <memory>
+#include <sstream>
 
 namespace ue
 {
@@ -49,6 +51,13 @@ TEST_F(ApplicationNotConnectedTestSuite, shallSendAttachRequestOnSib)
     sendAttachRequestOnSib();
 }
 
+TEST_F(ApplicationNotConnectedTestSuite, shallRecordReadableStateName)
+{
+    std::ostringstream dump;
+    common::FlightRecorder::instance().dump(dump);
+    ASSERT_THAT(dump.str(), HasSubstr("state NotConnectedState\n"));
+}
+
 class ApplicationConnectingTestSuite : public ApplicationTestSuite
 {
 protected:
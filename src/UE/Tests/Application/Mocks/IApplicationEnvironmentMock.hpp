@@ -15,6 +15,7 @@ struct IApplicationEnvironmentMock : public IApplicationEnvironment
     MOCK_METHOD(IUeGui&, getUeGui, (), (final));
     MOCK_METHOD(common::ITransport&, getTransportToBts, (), (final));
     MOCK_METHOD(common::ILogger&, getLogger, (), (final));
+    MOCK_METHOD(common::IClock&, getClock, (), (final));
     MOCK_METHOD(void, startMessageLoop, (), (final));
     MOCK_METHOD(common::PhoneNumber, getMyPhoneNumber, (), (const, final));
     MOCK_METHOD(int32_t, getProperty, (const std::string &name, int32_t defaultValue), (const, final));
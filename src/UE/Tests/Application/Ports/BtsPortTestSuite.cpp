@@ -245,4 +245,31 @@ TEST_F(BtsPortTestSuite, shallSendCallTalk)
     ASSERT_NO_THROW(EXPECT_EQ(TALK_TEXT, reader.readRemainingText()));
 }
 
+TEST_F(BtsPortTestSuite, shallAnswerEchoWithoutHandler)
+{
+    const std::uint32_t SEQUENCE = 7u;
+    const std::uint64_t SENT_AT = 123456789ull;
+    common::BinaryMessage reply;
+
+    EXPECT_CALL(transportMock, sendMessage(_)).WillOnce([&reply](auto param) {
+        reply = std::move(param);
+        return true;
+    });
+
+    common::OutgoingMessage echo{common::MessageId::Echo,
+                                 common::PhoneNumber{},
+                                 PHONE_NUMBER};
+    echo.writeNumber(SEQUENCE);
+    echo.writeNumber(SENT_AT);
+    messageCallback(echo.getMessage());
+
+    common::IncomingMessage reader(reply);
+    ASSERT_NO_THROW(EXPECT_EQ(common::MessageId::EchoReply, reader.readMessageId()));
+    ASSERT_NO_THROW(EXPECT_EQ(PHONE_NUMBER, reader.readPhoneNumber()));
+    ASSERT_NO_THROW(EXPECT_EQ(common::PhoneNumber{}, reader.readPhoneNumber()));
+    ASSERT_NO_THROW(EXPECT_EQ(SEQUENCE, reader.readNumber<std::uint32_t>()));
+    ASSERT_NO_THROW(EXPECT_EQ(SENT_AT, reader.readNumber<std::uint64_t>()));
+    ASSERT_NO_THROW(reader.checkEndOfMessage());
+}
+
 }
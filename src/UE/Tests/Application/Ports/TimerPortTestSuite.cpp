@@ -5,10 +5,12 @@
 #include "Mocks/ILoggerMock.hpp"
 #include "Mocks/ITimerPortMock.hpp"
 #include "Messages/PhoneNumber.hpp"
+#include "Time/VirtualClock.hpp"
 
 namespace ue
 {
 using namespace ::testing;
+using namespace std::chrono_literals;
 
 class TimerPortTestSuite : public Test
 {
@@ -16,9 +18,9 @@ protected:
     const common::PhoneNumber PHONE_NUMBER{112};
     NiceMock<common::ILoggerMock> loggerMock;
     StrictMock<ITimerEventsHandlerMock> handlerMock;
+    common::VirtualClock clock;
 
-
-    TimerPort objectUnderTest{loggerMock};
+    TimerPort objectUnderTest{loggerMock, clock};
 
     TimerPortTestSuite()
     {
@@ -34,4 +36,48 @@ TEST_F(TimerPortTestSuite, shallStart)
 {
 }
 
+TEST_F(TimerPortTestSuite, shallHandleTimeoutAfterDuration)
+{
+    objectUnderTest.startTimer(30000ms);
+    clock.advance(29999ms);
+
+    EXPECT_CALL(handlerMock, handleTimeout());
+    clock.advance(1ms);
+    ASSERT_EQ(0u, clock.pendingCount());
+}
+
+TEST_F(TimerPortTestSuite, shallNotHandleTimeoutWhenTimerStopped)
+{
+    objectUnderTest.startTimer(500ms);
+    objectUnderTest.stopTimer();
+    clock.advance(1h);
+}
+
+TEST_F(TimerPortTestSuite, shallReplaceRunningTimerOnStart)
+{
+    objectUnderTest.startTimer(500ms);
+    clock.advance(400ms);
+    objectUnderTest.startTimer(500ms);
+    clock.advance(499ms);
+
+    EXPECT_CALL(handlerMock, handleTimeout());
+    clock.advance(1ms);
+}
+
+TEST_F(TimerPortTestSuite, shallAllowTimerRestartFromTimeoutHandler)
+{
+    EXPECT_CALL(handlerMock, handleTimeout())
+            .WillOnce([this] { objectUnderTest.startTimer(500ms); })
+            .WillOnce(Return());
+    objectUnderTest.startTimer(500ms);
+    clock.advance(1000ms);
+}
+
+TEST_F(TimerPortTestSuite, shallCancelTimerOnStop)
+{
+    objectUnderTest.startTimer(500ms);
+    objectUnderTest.stop();
+    ASSERT_EQ(0u, clock.pendingCount());
+}
+
 }
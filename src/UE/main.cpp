@@ -17,7 +17,7 @@ int main(int argc, char* argv[])
 
     BtsPort bts(logger, tranport, phoneNumber);
     UserPort user(logger, gui, phoneNumber);
-    TimerPort timer(logger);
+    TimerPort timer(logger, appEnv->getClock());
     Application app(phoneNumber, logger, bts, user, timer);
     bts.start(app);
     user.start(app);
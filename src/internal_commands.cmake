@@ -35,6 +35,30 @@ macro(target_link_gtest)
 target_link_libraries(${PROJECT_NAME} gmock_main)
 endmacro()
 
+# Replaced global operator new/delete (AllocationCounter) cost a block header and counter updates on every
+# allocation - tests and benchmarks link it always, BTS and UE only with -DSTH_HEAP_ACCOUNTING=ON.
+# Without it MemoryAccounting counts only tagged allocators and slab pools.
+option(STH_HEAP_ACCOUNTING "Link AllocationCounter into BTS and UE executables" OFF)
+
+macro(target_link_heap_accounting)
+if (STH_HEAP_ACCOUNTING)
+target_link_libraries(${PROJECT_NAME} AllocationCounter)
+endif()
+endmacro()
+
+# Google Benchmark is optional - benchmark targets are skipped when it is not installed.
+# Build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+macro(find_benchmark)
+find_package(benchmark QUIET)
+if (NOT benchmark_FOUND)
+message(STATUS "Google Benchmark not found - ${PROJECT_NAME} skipped")
+endif()
+endmacro()
+
+macro(target_link_benchmark)
+target_link_libraries(${PROJECT_NAME} benchmark::benchmark_main)
+endmacro()
+
 macro(copy_images)
 file(COPY ${IMAGES_DIRECTORY}/images DESTINATION .)
 endmacro()